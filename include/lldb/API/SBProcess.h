@@ -124,6 +124,37 @@ public:
     lldb::SBThread
     GetSelectedThread () const;
 
+    //------------------------------------------------------------------
+    /// Unwind the stacks of all threads in one go.
+    ///
+    /// Computes the first \a max_frames frames (all frames by default)
+    /// of every thread, on several host threads if the process setting
+    /// "unwind-threads-in-parallel" allows it. Afterwards the frames of
+    /// each SBThread are served from its cached frame list.
+    ///
+    /// @return
+    ///     The number of threads that were unwound, zero if the process
+    ///     isn't stopped.
+    //------------------------------------------------------------------
+    uint32_t
+    ComputeAllThreadStacks (uint32_t max_frames = UINT32_MAX);
+
+    //------------------------------------------------------------------
+    /// Profile the process by sampling the stacks of all its threads.
+    ///
+    /// The stopped process is resumed and interrupted \a frequency times
+    /// a second for \a duration_msec milliseconds, and left stopped.
+    /// The aggregated samples are written to \a call_tree as an indented
+    /// call tree with counts and to \a collapsed_stacks in the collapsed
+    /// stack format used by flame graph tools.
+    //------------------------------------------------------------------
+    lldb::SBError
+    Sample (uint32_t frequency,
+            uint32_t duration_msec,
+            uint32_t max_frames,
+            lldb::SBStream &call_tree,
+            lldb::SBStream &collapsed_stacks);
+
     //------------------------------------------------------------------
     // Function for lazily creating a thread using the current OS
     // plug-in. This function will be removed in the future when there
@@ -317,6 +348,27 @@ public:
     const char *
     GetExtendedBacktraceTypeAtIndex (uint32_t idx);
 
+    //------------------------------------------------------------------
+    /// Return how many helper functions lldb has compiled for this
+    /// process.
+    ///
+    /// The helpers that lldb and its runtime plug-ins run in the
+    /// inferior, like the one "po" calls, are compiled the first time
+    /// they are needed and then reused for the life of the process.
+    ///
+    /// @return
+    ///   The number of helper functions compiled so far.
+    //------------------------------------------------------------------
+    uint32_t
+    GetNumCompiledFunctions ();
+
+    //------------------------------------------------------------------
+    /// Return how long compiling the helper functions counted by
+    /// GetNumCompiledFunctions() took in total, in nanoseconds.
+    //------------------------------------------------------------------
+    uint64_t
+    GetCompiledFunctionsTime ();
+
 protected:
     friend class SBAddress;
     friend class SBBreakpoint;
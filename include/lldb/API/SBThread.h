@@ -171,6 +171,17 @@ public:
     uint32_t
     GetNumFrames ();
 
+    //------------------------------------------------------------------
+    /// Get the program counters of up to \a max_pcs frames by following
+    /// the frame pointer chain, without creating frames or looking up
+    /// symbols. Meant for sampling profilers.
+    ///
+    /// @return
+    ///     The number of pcs written to \a pcs.
+    //------------------------------------------------------------------
+    size_t
+    GetRawBacktrace (lldb::addr_t *pcs, size_t max_pcs);
+
     lldb::SBFrame
     GetFrameAtIndex (uint32_t idx);
 
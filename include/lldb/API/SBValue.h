@@ -228,6 +228,26 @@ public:
                      lldb::DynamicValueType use_dynamic,
                      bool can_create_synthetic);
 
+    //------------------------------------------------------------------
+    /// Get a window of child values by index.
+    ///
+    /// Only the children in the window are created, and the memory
+    /// they need is read with as few reads as possible, which makes
+    /// this the cheap way to walk very large arrays and containers.
+    ///
+    /// @param[in] start_idx
+    ///     The index of the first child value to get.
+    ///
+    /// @param[in] count
+    ///     The number of child values to get.  Fewer are returned if
+    ///     the window runs past the last child.
+    ///
+    /// @return
+    ///     A list of the child values in the window.
+    //------------------------------------------------------------------
+    lldb::SBValueList
+    GetChildrenAtIndexRange (uint32_t start_idx, uint32_t count);
+
     // Matches children of this object only and will match base classes and
     // member names if this is a clang typed object.
     uint32_t
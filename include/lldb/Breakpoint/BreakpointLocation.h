@@ -182,6 +182,14 @@ public:
     bool
     ConditionSaysStop (ExecutionContext &exe_ctx, Error &error);
 
+    //------------------------------------------------------------------
+    /// Take back a condition that was injected into the process, so
+    /// that every hit traps into the debugger again.  Called whenever
+    /// the condition or the ignore count changes.
+    //------------------------------------------------------------------
+    void
+    RemoveInjectedCondition ();
+
 
     //------------------------------------------------------------------
     /// Set the valid thread to be checked when the breakpoint is hit.
@@ -444,6 +452,18 @@ private:
     ClangUserExpression::ClangUserExpressionSP m_user_expression_sp; ///< The compiled expression to use in testing our condition.
     Mutex m_condition_mutex; ///< Guards parsing and evaluation of the condition, which could be evaluated by multiple processes.
     size_t m_condition_hash; ///< For testing whether the condition source code changed.
+    size_t m_injected_condition_hash; ///< The hash of the condition that injection was last tried for, or 0.
+
+    //------------------------------------------------------------------
+    /// Try to have the process evaluate the condition itself, so that
+    /// hits for which it is false never stop.  Only done once per
+    /// condition, after it has been evaluated successfully.
+    //------------------------------------------------------------------
+    void
+    InjectCondition (ExecutionContext &exe_ctx,
+                     const char *condition_text,
+                     size_t condition_hash,
+                     ValueObject &result);
 
     void
     SetShouldResolveIndirectFunctions (bool do_resolve)
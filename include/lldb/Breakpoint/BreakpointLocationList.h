@@ -142,6 +142,13 @@ public:
     void
     ClearAllBreakpointSites ();
 
+    //------------------------------------------------------------------
+    /// Takes back any conditions the locations in this list injected
+    /// into the process.
+    //------------------------------------------------------------------
+    void
+    RemoveInjectedConditions ();
+
     //------------------------------------------------------------------
     /// Tells all the breakpoint locations in this list to attempt to
     /// resolve any possible breakpoint sites.
@@ -260,12 +267,29 @@ protected:
                      lldb::BreakpointLocationSP,
                      Address::ModulePointerAndOffsetLessThanFunctionObject> addr_map;
 
+    //------------------------------------------------------------------
+    /// While deferring, AddLocation() doesn't resolve the breakpoint
+    /// site of new locations. StopDeferringSiteResolution() resolves
+    /// them all at once so the process can insert the breakpoints
+    /// together. Calls can be nested.
+    //------------------------------------------------------------------
+    void
+    StartDeferringSiteResolution();
+
+    void
+    StopDeferringSiteResolution();
+
+    void
+    ResolveBreakpointSites (const collection &locations);
+
     Breakpoint &m_owner;
     collection m_locations;         // Vector of locations, sorted by ID 
     addr_map m_address_to_location;
     mutable Mutex m_mutex;
     lldb::break_id_t m_next_id;
     BreakpointLocationCollection *m_new_location_recorder;
+    uint32_t m_defer_site_resolution;
+    collection m_deferred_locations;
 };
 
 } // namespace lldb_private
@@ -256,6 +256,25 @@ public:
         m_type = type;
     }
 
+    //------------------------------------------------------------------
+    /// Tells whether the trap opcode of this site is a jump to code in
+    /// the process that evaluates the owner's condition and only traps
+    /// when it is true.
+    ///
+    /// @see Process::InjectBreakpointCondition()
+    //------------------------------------------------------------------
+    bool
+    IsConditionInjected () const
+    {
+        return m_condition_injected;
+    }
+
+    void
+    SetConditionInjected (bool injected)
+    {
+        m_condition_injected = injected;
+    }
+
 private:
     friend class Process;
     friend class BreakpointLocation;
@@ -274,6 +293,7 @@ private:
     uint8_t m_saved_opcode[8];  ///< The saved opcode bytes if this breakpoint site uses trap opcodes.
     uint8_t m_trap_opcode[8];   ///< The opcode that was used to create the breakpoint if it is a software breakpoint site.
     bool m_enabled;             ///< Boolean indicating if this breakpoint site enabled or not.
+    bool m_condition_injected;  ///< True if m_trap_opcode jumps to an injected condition instead of trapping.
 
     // Consider adding an optimization where if there is only one
     // owner, we don't store a list.  The usual case will be only one owner...
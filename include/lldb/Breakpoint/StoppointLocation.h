@@ -134,6 +134,12 @@ protected:
         ++m_hit_count;
     }
 
+    void
+    IncrementHitCount (uint32_t count)
+    {
+        m_hit_count += count;
+    }
+
 private:
     //------------------------------------------------------------------
     // For StoppointLocation only
@@ -131,6 +131,7 @@ namespace llvm
 {
     class LLVMContext;
     class ExecutionEngine;
+    class Function;
 }
 
 #endif  // #if defined(__cplusplus)
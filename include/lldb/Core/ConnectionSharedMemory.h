@@ -12,6 +12,7 @@
 
 // C Includes
 // C++ Includes
+#include <atomic>
 #include <string>
 
 // Other libraries and framework includes
@@ -21,11 +22,28 @@
 
 namespace lldb_private {
 
+//----------------------------------------------------------------------
+// A duplex connection between two processes on the same host that
+// share a memory mapped region.
+//
+// The region starts with a small header followed by two single
+// producer/single consumer ring buffers, one for each direction. The
+// side that creates the region (using a "shm-create://NAME" URL) writes
+// into the first ring and reads from the second, the side that attaches
+// (using a "shm-connect://NAME" URL) does the opposite. Data never goes
+// through the kernel; readers poll the ring with a short spin followed
+// by an exponential sleep backoff. While they sleep they also check that
+// the other side's process still exists, since one that crashed never
+// marks its ring closed.
+//----------------------------------------------------------------------
 class ConnectionSharedMemory :
     public Connection
 {
 public:
 
+    // Default size of the mapped region including the header
+    static const size_t k_default_size = 1024 * 1024;
+
     ConnectionSharedMemory ();
 
     virtual
@@ -44,10 +62,10 @@ public:
     Disconnect (Error *error_ptr);
 
     virtual size_t
-    Read (void *dst, 
-          size_t dst_len, 
+    Read (void *dst,
+          size_t dst_len,
           uint32_t timeout_usec,
-          lldb::ConnectionStatus &status, 
+          lldb::ConnectionStatus &status,
           Error *error_ptr);
 
     virtual size_t
@@ -56,11 +74,70 @@ public:
     lldb::ConnectionStatus
     Open (bool create, const char *name, size_t size, Error *error_ptr);
 
+    //------------------------------------------------------------------
+    // Wait for the other side to attach to a region we created. Returns
+    // true immediately for the attaching side.
+    //------------------------------------------------------------------
+    bool
+    WaitForPeer (uint32_t timeout_usec);
+
+    const char *
+    GetName () const
+    {
+        return m_name.c_str();
+    }
+
+    //------------------------------------------------------------------
+    // Returns a unique name that can be used with Open() or a
+    // "shm-create://" URL by a process on the current host.
+    //------------------------------------------------------------------
+    static std::string
+    GetUniqueName ();
+
 protected:
 
+    struct RingHeader;
+    struct Header;
+
+    // Keeps Disconnect() from unmapping the region while a call that
+    // uses it is in progress.
+    class MappingUse;
+
+    Header *
+    GetHeader () const;
+
+    uint8_t *
+    GetRingData (uint32_t ring_idx) const;
+
+    // The ring this side reads from
+    uint32_t
+    GetReadRingIndex () const
+    {
+        return m_is_creator ? 1 : 0;
+    }
+
+    // The ring this side writes to
+    uint32_t
+    GetWriteRingIndex () const
+    {
+        return m_is_creator ? 0 : 1;
+    }
+
+    bool
+    PeerClosed () const;
+
+    // True if the process on the other side is known to have exited.
+    bool
+    PeerDied () const;
+
     std::string m_name;
     int m_fd;    // One buffer that contains all we need
+    bool m_is_creator;
+    uint8_t *m_bytes;
+    size_t m_size;
     DataBufferMemoryMap m_mmap;
+    std::atomic<uint32_t> m_users;      // Calls that are using the mapped region
+    std::atomic<bool> m_closing;        // Set by Disconnect(), new and waiting calls give up
 private:
     DISALLOW_COPY_AND_ASSIGN (ConnectionSharedMemory);
 };
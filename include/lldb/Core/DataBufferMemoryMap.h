@@ -146,6 +146,41 @@ public:
                                  bool write,
                                  bool fd_is_file);
 
+    //------------------------------------------------------------------
+    /// Access patterns that can be passed to Advise().
+    //------------------------------------------------------------------
+    enum AccessHint
+    {
+        eAccessHintNormal,      ///< No special treatment
+        eAccessHintSequential,  ///< Pages will be read in order, read ahead aggressively
+        eAccessHintWillNeed     ///< Pages will be needed soon, start reading them in now
+    };
+
+    //------------------------------------------------------------------
+    /// Tell the host how a range of the mapped data is about to be
+    /// accessed.
+    ///
+    /// This is only a hint and never changes the contents of the
+    /// buffer. The range is expanded to page boundaries as needed and
+    /// clipped to the mapped data.
+    ///
+    /// @param[in] offset
+    ///     The offset in bytes from the start of the data returned by
+    ///     GetBytes().
+    ///
+    /// @param[in] length
+    ///     The number of bytes the hint applies to.
+    ///
+    /// @param[in] hint
+    ///     The expected access pattern.
+    ///
+    /// @return
+    ///      true if the hint was passed on to the host,  false
+    ///     otherwise.
+    //------------------------------------------------------------------
+    bool
+    Advise (lldb::offset_t offset, size_t length, AccessHint hint) const;
+
 protected:
     //------------------------------------------------------------------
     // Classes that inherit from DataBufferMemoryMap can see and modify these
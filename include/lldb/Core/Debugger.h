@@ -241,6 +241,17 @@ public:
                   Stream &s,
                   ValueObject* valobj = NULL);
 
+    //------------------------------------------------------------------
+    /// Get the parts of a frame's symbol context that FormatPrompt
+    /// needs for a format string, as SymbolContextItem bits.
+    ///
+    /// Frames look up their symbol context a piece at a time as it is
+    /// asked for, so a format that shows only the pc and the function
+    /// name never parses line tables.
+    //------------------------------------------------------------------
+    static uint32_t
+    GetSymbolContextScopeForFormat (const char *format);
+
 
     void
     ClearIOHandlers ();
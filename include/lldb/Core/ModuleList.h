@@ -94,9 +94,13 @@ public:
     ///
     /// @param[in] module_sp
     ///     A shared pointer to a module to add to this collection.
+    ///
+    /// @param[in] notify
+    ///     If true, and a notifier function is set, the notifier function
+    ///     will be called.  Defaults to true.
     //------------------------------------------------------------------
     void
-    Append (const lldb::ModuleSP &module_sp);
+    Append (const lldb::ModuleSP &module_sp, bool notify = true);
 
     //------------------------------------------------------------------
     /// Append a module to the module list and remove any equivalent
@@ -112,7 +116,7 @@ public:
     ReplaceEquivalent (const lldb::ModuleSP &module_sp);
 
     bool
-    AppendIfNeeded (const lldb::ModuleSP &module_sp);
+    AppendIfNeeded (const lldb::ModuleSP &module_sp, bool notify = true);
 
     void
     Append (const ModuleList& module_list);
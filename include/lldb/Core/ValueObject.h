@@ -542,6 +542,67 @@ public:
     virtual lldb::ValueObjectSP
     GetChildAtIndex (size_t idx, bool can_create);
 
+    //------------------------------------------------------------------
+    /// Get the children in [start_idx, start_idx + count), creating
+    /// them if needed.  Only the children in the window are created,
+    /// and the memory they will read is fetched into the process memory
+    /// cache with as few reads as possible.
+    ///
+    /// @param[in] start_idx
+    ///     The index of the first child to get.
+    ///
+    /// @param[in] count
+    ///     The number of children to get.  The window is cut short at
+    ///     the last child.
+    ///
+    /// @param[out] children
+    ///     Filled in with one entry per index in the window.  Entries
+    ///     for children that couldn't be created are empty.
+    ///
+    /// @param[in] prefetch_pointees
+    ///     If \b true, also read what the pointers in the window point
+    ///     to, for callers that are about to follow them.
+    ///
+    /// @param[in] cache_children
+    ///     If \b false, children that haven't been made yet are not kept
+    ///     by this value, and are freed along with their own children
+    ///     once the last reference to them goes away.  Use this to walk
+    ///     more children than should stay in memory at once.
+    ///
+    /// @return
+    ///     The number of entries in \a children.
+    //------------------------------------------------------------------
+    size_t
+    GetChildrenAtIndexRange (size_t start_idx,
+                             size_t count,
+                             std::vector<lldb::ValueObjectSP> &children,
+                             bool prefetch_pointees = false,
+                             bool cache_children = true);
+
+    //------------------------------------------------------------------
+    /// Get the bytes of a child that lives inside this value's bytes.
+    /// The first time a child asks, all of this value's bytes are read
+    /// at once, or sliced from the aggregate this value is part of, so
+    /// that children don't each read their own.
+    ///
+    /// @param[in] offset
+    ///     The offset of the child's bytes within this value.
+    ///
+    /// @param[in] size
+    ///     The size of the child's bytes.
+    ///
+    /// @param[out] data
+    ///     Set to the child's bytes, sharing this value's buffer.
+    ///
+    /// @return
+    ///     \b true if \a data was set; \b false if the child has to
+    ///     read its bytes itself.
+    //------------------------------------------------------------------
+    bool
+    GetDataForChild (uint64_t offset,
+                     uint64_t size,
+                     DataExtractor &data);
+
     // this will always create the children if necessary
     lldb::ValueObjectSP
     GetChildAtIndexPath (const std::initializer_list<size_t> &idxs,
@@ -652,6 +713,17 @@ public:
     lldb::addr_t
     GetPointerValue (AddressType *address_type = NULL);
     
+    //------------------------------------------------------------------
+    /// Return the load address this value reads its data from when it
+    /// is updated, without reading anything itself, or
+    /// LLDB_INVALID_ADDRESS if that isn't known up front.
+    //------------------------------------------------------------------
+    virtual lldb::addr_t
+    GetPrefetchAddress ()
+    {
+        return LLDB_INVALID_ADDRESS;
+    }
+    
     lldb::ValueObjectSP
     GetSyntheticChild (const ConstString &key) const;
     
@@ -1004,6 +1076,7 @@ protected:
                                         // the context & stop id are the same before updating.
     ConstString         m_name;         // The name of this object
     DataExtractor       m_data;         // A data extractor that can be used to extract the value.
+    DataExtractor       m_children_data;// All of this value's bytes, read at once for the children that live inside them to slice.
     Value               m_value;
     Error               m_error;        // An error object that can describe any errors that occur when updating values.
     std::string         m_value_str;    // Cached value string that will get cleared if/when the value is updated.
@@ -1030,6 +1103,8 @@ protected:
     
     lldb::ValueObjectSP m_addr_of_valobj_sp; // We have to hold onto a shared pointer to this one because it is created
                                              // as an independent ValueObjectConstResult, which isn't managed by us.
+    lldb::ValueObjectSP m_parent_sp;         // Set for children that aren't cached by their parent.  They get a manager
+                                             // of their own, so they hold onto their parent to keep it alive.
 
     lldb::Format                m_format;
     lldb::Format                m_last_format;
@@ -1049,7 +1124,9 @@ protected:
                         m_is_bitfield_for_scalar:1,
                         m_is_child_at_offset:1,
                         m_is_getting_summary:1,
-                        m_did_calculate_complete_objc_class_type:1;
+                        m_did_calculate_complete_objc_class_type:1,
+                        m_children_data_read:1,
+                        m_make_uncached_child:1;
     
     friend class ClangExpressionDeclMap;  // For GetValue
     friend class ClangExpressionVariable; // For SetName
@@ -1107,6 +1184,24 @@ protected:
     virtual ValueObject *
     CreateChildAtIndex (size_t idx, bool synthetic_array_member, int32_t synthetic_index);
 
+    // Returns the child at "idx" if it has been made already, otherwise
+    // makes one that isn't cached in m_children and is freed with the
+    // last shared pointer to it.
+    virtual lldb::ValueObjectSP
+    GetUncachedChildAtIndex (size_t idx);
+
+    //------------------------------------------------------------------
+    /// Get bytes at \a offset within this value from the aggregate it
+    /// is part of, if it lives inside one.
+    //------------------------------------------------------------------
+    virtual bool
+    GetDataFromParent (uint64_t offset,
+                       uint64_t size,
+                       DataExtractor &data)
+    {
+        return false;
+    }
+
     // Should only be called by ValueObject::GetNumChildren()
     virtual size_t
     CalculateNumChildren() = 0;
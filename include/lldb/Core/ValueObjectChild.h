@@ -80,10 +80,18 @@ public:
         return m_is_deref_of_parent;
     }
 
+    virtual lldb::addr_t
+    GetPrefetchAddress ();
+
 protected:
     virtual bool
     UpdateValue ();
 
+    virtual bool
+    GetDataFromParent (uint64_t offset,
+                       uint64_t size,
+                       DataExtractor &data);
+
     virtual ClangASTType
     GetClangTypeImpl ()
     {
@@ -62,6 +62,9 @@ public:
     virtual lldb::ModuleSP
     GetModule();
 
+    virtual lldb::addr_t
+    GetPrefetchAddress ();
+
 protected:
     virtual bool
     UpdateValue ();
@@ -149,6 +149,9 @@ protected:
     virtual void
     CreateSynthFilter ();
 
+    virtual lldb::ValueObjectSP
+    GetUncachedChildAtIndex (size_t idx);
+
     // we need to hold on to the SyntheticChildren because someone might delete the type binding while we are alive
     lldb::SyntheticChildrenSP m_synth_sp;
     std::unique_ptr<SyntheticChildrenFrontEnd> m_synth_filter_ap;
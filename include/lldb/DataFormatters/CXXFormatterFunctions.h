@@ -13,6 +13,10 @@
 #include <stdint.h>
 #include <time.h>
 
+#include <functional>
+#include <set>
+#include <vector>
+
 #include "lldb/lldb-forward.h"
 
 #include "lldb/Core/ConstString.h"
@@ -697,6 +701,66 @@ namespace lldb_private {
         
         SyntheticChildrenFrontEnd* LibcxxStdVectorSyntheticFrontEndCreator (CXXSyntheticChildren*, lldb::ValueObjectSP);
         
+        //----------------------------------------------------------------------
+        // The libc++ node based containers can only reach an element by
+        // following the links from the first one.  This remembers where the
+        // walks got to, so that enumerating a container in order takes one
+        // step per element rather than a walk from the start for each, and
+        // reads the nodes ahead of a walk into the process memory cache a
+        // window at a time.
+        //----------------------------------------------------------------------
+        class LibcxxNodeIteratorCache
+        {
+        public:
+            typedef std::function <lldb::addr_t (lldb::addr_t node_addr)> NextNodeCallback;
+            
+            LibcxxNodeIteratorCache ();
+            
+            void
+            Clear ();
+            
+            void
+            SetNodeByteSize (uint64_t node_byte_size)
+            {
+                m_node_byte_size = node_byte_size;
+            }
+            
+            // Get the address of the node at idx, walking with next_node from
+            // the closest node at or before idx that an earlier walk reached,
+            // or from first_node_addr.  Returns LLDB_INVALID_ADDRESS if the
+            // walk runs off the end or the links loop.
+            lldb::addr_t
+            GetNodeAtIndex (size_t idx,
+                            lldb::addr_t first_node_addr,
+                            NextNodeCallback const &next_node);
+            
+            // Read the pointer offset bytes into the node at node_addr,
+            // reading the window of memory starting at the node into the
+            // memory cache if the last window didn't cover it.  Returns
+            // LLDB_INVALID_ADDRESS if the memory can't be read.
+            lldb::addr_t
+            ReadNodePointer (Process &process,
+                             lldb::addr_t node_addr,
+                             uint32_t offset);
+            
+        private:
+            bool
+            SetNode (size_t idx, lldb::addr_t node_addr);
+            
+            void
+            PrefetchNode (Process &process, lldb::addr_t node_addr);
+            
+            std::vector<lldb::addr_t> m_checkpoints; // The node at every g_node_checkpoint_interval-th index
+            std::set<lldb::addr_t> m_checkpoint_addrs;
+            size_t m_last_idx;
+            lldb::addr_t m_last_addr;
+            uint64_t m_node_byte_size;
+            lldb::addr_t m_window_start;
+            lldb::addr_t m_window_end;
+            uint64_t m_window_size;
+            uint32_t m_window_hits;
+        };
+        
         class LibcxxStdListSyntheticFrontEnd : public SyntheticChildrenFrontEnd
         {
         public:
@@ -723,14 +787,23 @@ namespace lldb_private {
             bool
             HasLoop();
             
+            bool
+            GetValueOffset ();
+            
+            lldb::addr_t
+            GetNextNode (Process &process, lldb::addr_t node_addr);
+            
             size_t m_list_capping_size;
             static const bool g_use_loop_detect = true;
             lldb::addr_t m_node_address;
             ValueObject* m_head;
             ValueObject* m_tail;
             ClangASTType m_element_type;
+            uint32_t m_next_offset;
+            uint32_t m_value_offset;
             size_t m_count;
             std::map<size_t,lldb::ValueObjectSP> m_children;
+            LibcxxNodeIteratorCache m_iterator_cache;
         };
         
         SyntheticChildrenFrontEnd* LibcxxStdListSyntheticFrontEndCreator (CXXSyntheticChildren*, lldb::ValueObjectSP);
@@ -761,15 +834,19 @@ namespace lldb_private {
             bool
             GetDataType();
             
-            void
-            GetValueOffset (const lldb::ValueObjectSP& node);
+            lldb::addr_t
+            GetNextNode (Process &process, lldb::addr_t node_addr);
             
             ValueObject* m_tree;
             ValueObject* m_root_node;
             ClangASTType m_element_type;
             uint32_t m_skip_size;
+            uint32_t m_left_offset;
+            uint32_t m_right_offset;
+            uint32_t m_parent_offset;
             size_t m_count;
             std::map<size_t,lldb::ValueObjectSP> m_children;
+            LibcxxNodeIteratorCache m_iterator_cache;
         };
         
         SyntheticChildrenFrontEnd* LibcxxStdMapSyntheticFrontEndCreator (CXXSyntheticChildren*, lldb::ValueObjectSP);
@@ -797,12 +874,16 @@ namespace lldb_private {
             virtual
             ~LibcxxStdUnorderedMapSyntheticFrontEnd ();
         private:
+            bool
+            GetDataType ();
             
             ValueObject* m_tree;
             size_t m_num_elements;
-            ValueObject* m_next_element;
+            ClangASTType m_element_type;
+            uint32_t m_next_offset;
+            uint32_t m_value_offset;
             std::map<size_t,lldb::ValueObjectSP> m_children;
-            std::vector<std::pair<ValueObject*, uint64_t> > m_elements_cache;
+            LibcxxNodeIteratorCache m_iterator_cache;
         };
         
         SyntheticChildrenFrontEnd* LibcxxStdUnorderedMapSyntheticFrontEndCreator (CXXSyntheticChildren*, lldb::ValueObjectSP);
@@ -130,6 +130,19 @@ public:
     virtual bool
     NeedsVariableResolution () = 0;
 
+    //------------------------------------------------------------------
+    /// Called with the expression's function once the IR has been
+    /// rewritten for the target, before any dynamic checks are added
+    /// to it.
+    ///
+    /// @param[in] function
+    ///     The function that will be JIT compiled.
+    //------------------------------------------------------------------
+    virtual void
+    DidRewriteIR (llvm::Function &function)
+    {
+    }
+
     //------------------------------------------------------------------
     /// Return the address of the function's JIT-compiled code, or
     /// LLDB_INVALID_ADDRESS if the function is not JIT compiled
@@ -117,6 +117,65 @@ public:
     bool
     MatchesContext (ExecutionContext &exe_ctx);
     
+    //------------------------------------------------------------------
+    /// Parse the expression so that it can be called directly from
+    /// code in the inferior, without the debugger.
+    ///
+    /// The expression is always JIT compiled, without validation code,
+    /// and is rejected unless it is a plain C expression that only
+    /// reads globals and has no side effects other than storing its
+    /// result.
+    ///
+    /// @param[in] error_stream
+    ///     A stream to print parse errors and the reason the expression
+    ///     is unsuitable to.
+    ///
+    /// @param[in] exe_ctx
+    ///     The execution context to parse the expression in.
+    ///
+    /// @return
+    ///     True if the expression can be called from the inferior;
+    ///     false otherwise.
+    //------------------------------------------------------------------
+    bool
+    ParseForInjection (Stream &error_stream,
+                       ExecutionContext &exe_ctx);
+    
+    //------------------------------------------------------------------
+    /// Materialize the arguments of an expression parsed with
+    /// ParseForInjection() once, for every later call from the
+    /// inferior.  The arguments are never dematerialized.
+    ///
+    /// @param[in] error_stream
+    ///     A stream to print errors to.
+    ///
+    /// @param[in] exe_ctx
+    ///     The execution context to materialize the arguments in.
+    ///
+    /// @param[out] function_address
+    ///     The address of the JIT compiled function.
+    ///
+    /// @param[out] struct_address
+    ///     The address of the argument struct to pass to the function.
+    ///
+    /// @param[out] struct_size
+    ///     The size of the argument struct.
+    ///
+    /// @param[out] result_ptr_offset
+    ///     The offset of the slot in the argument struct that holds
+    ///     the location of the result.
+    ///
+    /// @return
+    ///     True on success; false otherwise.
+    //------------------------------------------------------------------
+    bool
+    PrepareForInjection (Stream &error_stream,
+                         ExecutionContext &exe_ctx,
+                         lldb::addr_t &function_address,
+                         lldb::addr_t &struct_address,
+                         size_t &struct_size,
+                         uint32_t &result_ptr_offset);
+    
     //------------------------------------------------------------------
     /// Execute the parsed expression
     ///
@@ -254,12 +313,13 @@ public:
     
     //------------------------------------------------------------------
     /// Return true if validation code should be inserted into the
-    /// expression.
+    /// expression.  Expressions parsed for injection run without the
+    /// debugger, so they can't call the checker functions.
     //------------------------------------------------------------------
     bool
     NeedsValidation ()
     {
-        return true;
+        return !m_for_injection;
     }
     
     //------------------------------------------------------------------
@@ -272,6 +332,13 @@ public:
         return true;
     }
 
+    //------------------------------------------------------------------
+    /// Check expressions parsed for injection for side effects once
+    /// their IR has been rewritten for the target.
+    //------------------------------------------------------------------
+    void
+    DidRewriteIR (llvm::Function &function);
+
     //------------------------------------------------------------------
     /// Evaluate one expression and return its result.
     ///
@@ -361,6 +428,8 @@ private:
     bool                                        m_can_interpret;        ///< True if the expression could be evaluated statically; false otherwise.
     lldb::addr_t                                m_materialized_address; ///< The address at which the arguments to the expression have been materialized.
     Materializer::DematerializerSP              m_dematerializer_sp;    ///< The dematerializer.
+    bool                                        m_for_injection;        ///< True if the expression is being parsed to be called from the inferior.
+    Error                                       m_injection_error;      ///< Why the expression can't be called from the inferior, if it can't.
 };
     
 } // namespace lldb_private
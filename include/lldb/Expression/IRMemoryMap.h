@@ -63,6 +63,30 @@ public:
     
     void GetMemoryData (DataExtractor &extractor, lldb::addr_t process_address, size_t size, Error &error);
     
+    //------------------------------------------------------------------
+    /// Route accesses to a mirrored allocation through its host copy.
+    ///
+    /// Until EndBuffering() is called, reads of the allocation are served
+    /// from the host and writes only mark the range they touch as dirty,
+    /// so a caller that fills in or picks apart a struct piece by piece
+    /// talks to the process once instead of once per field.  Allocations
+    /// with other policies are left alone.
+    ///
+    /// @param[in] process_address
+    ///     The address returned by Malloc() for the allocation.
+    ///
+    /// @param[in] fetch
+    ///     If true, the host copy is refreshed from the process with a
+    ///     single read first.  Pass false if the caller will only write.
+    //------------------------------------------------------------------
+    void BeginBuffering (lldb::addr_t process_address, bool fetch, Error &error);
+    
+    //------------------------------------------------------------------
+    /// Stop buffering an allocation, writing everything that was written
+    /// since BeginBuffering() back to the process in one transfer.
+    //------------------------------------------------------------------
+    void EndBuffering (lldb::addr_t process_address, Error &error);
+    
     lldb::ByteOrder GetByteOrder();
     uint32_t GetAddressByteSize();
     
@@ -90,6 +114,9 @@ private:
         ///< Flags
         AllocationPolicy    m_policy;
         bool                m_leak;
+        bool                m_buffered;     ///< True between BeginBuffering() and EndBuffering()
+        size_t              m_dirty_start;  ///< The first offset written while buffered
+        size_t              m_dirty_end;    ///< One past the last offset written while buffered
     public:
         Allocation (lldb::addr_t process_alloc,
                     lldb::addr_t process_start,
@@ -106,7 +133,10 @@ private:
             m_alignment (0),
             m_data (),
             m_policy (eAllocationPolicyInvalid),
-            m_leak (false)
+            m_leak (false),
+            m_buffered (false),
+            m_dirty_start (0),
+            m_dirty_end (0)
         {
         }
     };
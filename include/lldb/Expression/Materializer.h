@@ -107,6 +107,24 @@ public:
         else
             return UINT32_MAX;
     }
+
+    //------------------------------------------------------------------
+    /// Returns true if every entity refers to storage that outlives the
+    /// current frame -- global and static variables, symbols and the
+    /// result -- so the struct can be materialized once and used by code
+    /// that runs without the debugger.
+    //------------------------------------------------------------------
+    bool IsFrameIndependent ()
+    {
+        return m_frame_independent;
+    }
+
+    //------------------------------------------------------------------
+    /// Returns the size of the memory that the pointer at the given
+    /// offset in the struct points to, or zero if there is no such
+    /// pointer or its size isn't known.
+    //------------------------------------------------------------------
+    uint64_t GetPointeeByteSize (uint32_t offset);
     
     class Entity
     {
@@ -128,6 +146,12 @@ public:
         virtual void DumpToLog (IRMemoryMap &map, lldb::addr_t process_address, Log *log) = 0;
         virtual void Wipe (IRMemoryMap &map, lldb::addr_t process_address) = 0;
         
+        // The size of the memory the entity's slot points to, if known.
+        virtual uint64_t GetPointeeByteSize ()
+        {
+            return 0;
+        }
+        
         uint32_t GetAlignment ()
         {
             return m_alignment;
@@ -166,6 +190,7 @@ private:
     Entity                         *m_result_entity;
     uint32_t                        m_current_offset;
     uint32_t                        m_struct_alignment;
+    bool                            m_frame_independent;
 };
     
 }
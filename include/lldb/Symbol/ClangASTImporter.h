@@ -12,11 +12,14 @@
 
 #include <map>
 #include <set>
+#include <vector>
 
 #include "lldb/lldb-types.h"
 #include "clang/AST/ASTImporter.h"
 #include "clang/Basic/FileManager.h"
 #include "clang/Basic/FileSystemOptions.h"
+#include "lldb/Core/ConstString.h"
+#include "lldb/Host/Mutex.h"
 #include "lldb/Symbol/ClangNamespaceDecl.h"
 
 namespace lldb_private {
@@ -27,7 +30,7 @@ public:
     static void DumpCounters (Log *log);
     static void ClearLocalCounters ()
     {
-        local_counters = { 0, 0, 0, 0, 0, 0 };
+        local_counters = { 0, 0, 0, 0, 0, 0, 0, 0 };
     }
     
     static void RegisterVisibleQuery ()
@@ -66,6 +69,18 @@ public:
         ++local_counters.m_record_layout_count;
     }
     
+    static void RegisterLookupAvoided ()
+    {
+        ++global_counters.m_lookups_avoided_count;
+        ++local_counters.m_lookups_avoided_count;
+    }
+    
+    static void RegisterLookupPerformed ()
+    {
+        ++global_counters.m_lookups_performed_count;
+        ++local_counters.m_lookups_performed_count;
+    }
+    
 private:
     struct Counters
     {
@@ -75,6 +90,8 @@ private:
         uint64_t    m_clang_import_count;
         uint64_t    m_decls_completed_count;
         uint64_t    m_record_layout_count;
+        uint64_t    m_lookups_avoided_count;
+        uint64_t    m_lookups_performed_count;
     };
     
     static Counters global_counters;
@@ -87,7 +104,8 @@ class ClangASTImporter
 {
 public:
     ClangASTImporter () :
-        m_file_manager(clang::FileSystemOptions())
+        m_file_manager(clang::FileSystemOptions()),
+        m_lookup_mutex(Mutex::eMutexTypeNormal)
     {
     }
     
@@ -199,6 +217,27 @@ public:
     
     void ForgetDestination (clang::ASTContext *dst_ctx);
     void ForgetSource (clang::ASTContext *dst_ctx, clang::ASTContext *src_ctx);
+    
+    //
+    // Lookup cache
+    //
+    // Remembers what searching all of the target's modules for a name at
+    // the root namespace found, including finding nothing, so that later
+    // expressions using the same names don't search the symbol files again.
+    // The Find functions return true if the name has been searched for
+    // before.  The target clears the cache whenever its modules change.
+    //
+    
+    bool FindCachedTypeLookup (const ConstString &name, lldb::TypeSP &type_sp);
+    void CacheTypeLookup (const ConstString &name, const lldb::TypeSP &type_sp);
+    
+    bool FindCachedNamespaceLookup (const ConstString &name, NamespaceMap &namespace_map);
+    void CacheNamespaceLookup (const ConstString &name, const NamespaceMap &namespace_map);
+    
+    bool FindCachedVariableLookup (const ConstString &name, std::vector<lldb::VariableSP> &variables);
+    void CacheVariableLookup (const ConstString &name, const std::vector<lldb::VariableSP> &variables);
+    
+    void ClearLookupCache ();
 private:
     struct DeclOrigin 
     {
@@ -366,6 +405,16 @@ private:
     GetDeclOrigin (const clang::Decl *decl);
         
     clang::FileManager      m_file_manager;
+    
+    // The lookup cache is keyed by the unique C string of the name.
+    typedef std::map<const char *, lldb::TypeSP> TypeLookupMap;
+    typedef std::map<const char *, NamespaceMap> NamespaceLookupMap;
+    typedef std::map<const char *, std::vector<lldb::VariableSP> > VariableLookupMap;
+    
+    Mutex                   m_lookup_mutex;
+    TypeLookupMap           m_type_lookups;
+    NamespaceLookupMap      m_namespace_lookups;
+    VariableLookupMap       m_variable_lookups;
 };
     
 }
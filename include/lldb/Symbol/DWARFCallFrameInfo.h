@@ -116,6 +116,17 @@ private:
     void
     GetFDEIndex ();
 
+    // Read the binary search table in .eh_frame_hdr, if there is one we
+    // can use, so single FDEs can be found without scanning .eh_frame.
+    void
+    GetEHFrameHdr ();
+
+    bool
+    GetFDEEntryFromEHFrameHdr (lldb::addr_t file_addr, FDEEntryMap::Entry& fde_entry);
+
+    bool
+    ParseFDEAddressRange (dw_offset_t fde_offset, FDEEntryMap::Entry& fde_entry);
+
     bool
     FDEToUnwindPlan (uint32_t offset, Address startaddr, UnwindPlan& unwind_plan);
 
@@ -140,6 +151,14 @@ private:
 
     bool                        m_is_eh_frame;
 
+    DataExtractor               m_eh_frame_hdr_data;      // .eh_frame_hdr contents if its search table is usable
+    lldb::addr_t                m_eh_frame_hdr_addr;      // file address of .eh_frame_hdr
+    lldb::offset_t              m_fde_table_offset;       // offset of the search table in m_eh_frame_hdr_data
+    uint32_t                    m_fde_table_count;        // number of entries in the search table
+    uint32_t                    m_fde_table_entry_size;   // byte size of each of the two fields of an entry
+    uint8_t                     m_fde_table_encoding;     // DW_EH_PE encoding of the search table fields
+    bool                        m_eh_frame_hdr_initialized;
+
     CIESP
     ParseCIE (const uint32_t cie_offset);
 
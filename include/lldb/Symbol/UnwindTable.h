@@ -11,16 +11,24 @@
 #ifndef liblldb_UnwindTable_h
 #define liblldb_UnwindTable_h
 
+#include <atomic>
 #include <map>
+#include <memory>
 
 #include "lldb/lldb-private.h" 
 #include "lldb/Host/Mutex.h"
+#include "lldb/Symbol/UnwindPlan.h"
 
 namespace lldb_private {
 
 // A class which holds all the FuncUnwinders objects for a given ObjectFile.
 // The UnwindTable is populated with FuncUnwinders objects lazily during
 // the debug session.
+//
+// The function bounds come from a sorted index of ranges that is built
+// once from the symbol table (or from the eh_frame FDEs for stripped
+// object files). Looking up an address in the index needs no lock, only
+// addresses outside of it go through the mutex and a symbol context.
 
 class UnwindTable
 {
@@ -46,23 +54,114 @@ public:
     bool
     GetArchitecture (lldb_private::ArchSpec &arch);
 
+    // The assembly profiler for this object file's architecture, made
+    // once and shared by all of its FuncUnwinders.
+    lldb::UnwindAssemblySP
+    GetUnwindAssemblyProfiler ();
+
+    // The UnwindPlan the assembly profiler makes for the function in
+    // range, either the full non call site plan or the fast one.  Plans
+    // are made once per address range and kept for the life of the
+    // object file, as are failures to make one, so a function is only
+    // profiled again if it gets a FuncUnwinders with a different range.
+    lldb::UnwindPlanSP
+    GetAssemblyUnwindPlan (const AddressRange &range, Thread &thread, bool fast);
+
+    // The UnwindPlans an unwinder picked for a frame at a given pc, and
+    // the row it found in them.  Frames above ordinary function calls
+    // always resolve to the same row for the same return address, so
+    // this is remembered across stops instead of being looked up again.
+    enum UnwindRowSource
+    {
+        eUnwindRowFromFastPlan,
+        eUnwindRowFromFullPlan
+    };
+
+    struct UnwindRowCacheEntry
+    {
+        UnwindRowSource source;
+        lldb::UnwindPlanSP fast_unwind_plan_sp;
+        lldb::UnwindPlanSP full_unwind_plan_sp;
+        lldb::UnwindPlanSP fallback_unwind_plan_sp;
+        UnwindPlan::RowSP active_row;
+    };
+
+    // Look up the cached row for the return address with this file
+    // address, and keep count of hits and misses.
+    bool
+    LookupUnwindRow (lldb::addr_t file_addr, UnwindRowCacheEntry &entry);
+
+    void
+    AddUnwindRow (lldb::addr_t file_addr, const UnwindRowCacheEntry &entry);
+
+    // Forget all cached rows, e.g. when the module is unloaded.
+    void
+    ClearUnwindRowCache ();
+
+    void
+    GetUnwindRowCacheStatistics (uint32_t &hits, uint32_t &misses);
+
 private:
     void
     Dump (Stream &s);
     
     void Initialize ();
 
+    void BuildFunctionRangeIndex ();
+
+    // Returns the FuncUnwinders of the indexed function that contains
+    // file_addr, creating it if needed, or an empty pointer if the
+    // address isn't in any indexed function.
+    lldb::FuncUnwindersSP
+    GetIndexedFuncUnwinders (lldb::addr_t file_addr);
+
     typedef std::map<lldb::addr_t, lldb::FuncUnwindersSP> collection;
     typedef collection::iterator iterator;
     typedef collection::const_iterator const_iterator;
 
+    // A function in the index. The vector of these is sorted and never
+    // changes after Initialize(), so it is searched without the lock.
+    struct FunctionRange
+    {
+        lldb::addr_t start;
+        lldb::addr_t end;
+    };
+    typedef std::vector<FunctionRange> FunctionRanges;
+
+    // The FuncUnwinders of the function at the same index in
+    // m_function_ranges. It is made with m_mutex held the first time it
+    // is asked for and published by setting "ready", after which it
+    // never changes and is read without the lock.
+    struct IndexedUnwinders
+    {
+        IndexedUnwinders () : ready (false), unwinders () {}
+        std::atomic<bool> ready;
+        lldb::FuncUnwindersSP unwinders;
+    };
+
     ObjectFile&         m_object_file;
-    collection          m_unwinds;
+    collection          m_unwinds;      // functions that aren't in m_function_ranges
+    FunctionRanges      m_function_ranges;
+    std::unique_ptr<IndexedUnwinders[]> m_indexed_unwinders;
 
-    bool                m_initialized;  // delay some initialization until ObjectFile is set up
+    std::atomic<bool>   m_initialized;  // delay some initialization until ObjectFile is set up
     Mutex               m_mutex;
 
     DWARFCallFrameInfo* m_eh_frame;
+
+    typedef std::map<lldb::addr_t, UnwindRowCacheEntry> UnwindRowCache;
+    UnwindRowCache      m_unwind_row_cache;
+    uint32_t            m_unwind_row_cache_hits;
+    uint32_t            m_unwind_row_cache_misses;
+
+    // Assembly profiled UnwindPlans by function start file address and
+    // size, an empty pointer if profiling failed.
+    typedef std::map<std::pair<lldb::addr_t, lldb::addr_t>, lldb::UnwindPlanSP> AssemblyUnwindPlans;
+    Mutex               m_assembly_mutex;   // profiling doesn't hold m_mutex
+    lldb::UnwindAssemblySP m_assembly_profiler_sp;
+    bool                m_tried_assembly_profiler;
+    AssemblyUnwindPlans m_assembly_unwind_plans;
+    AssemblyUnwindPlans m_fast_assembly_unwind_plans;
     
     DISALLOW_COPY_AND_ASSIGN (UnwindTable);
 };
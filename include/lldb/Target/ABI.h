@@ -12,6 +12,7 @@
 
 // C Includes
 // C++ Includes
+#include <vector>
 // Other libraries and framework includes
 // Project includes
 #include "lldb/Core/Error.h"
@@ -152,6 +153,49 @@ public:
     virtual bool
     FunctionCallsChangeCFA () = 0;
 
+    // Injected breakpoint conditions replace a breakpoint trap with a jump
+    // to code in the process that calls the JIT-compiled condition and only
+    // traps when it is true.  ABIs that can't build that code leave these
+    // returning zero and false.
+
+    // Fill in "opcode" with a jump from "from_addr" to "to_addr" and return
+    // its size, or zero if it can't reach or doesn't fit in "opcode_max_size"
+    // bytes.
+    virtual size_t
+    GetJumpOpcode (lldb::addr_t from_addr,
+                   lldb::addr_t to_addr,
+                   uint8_t *opcode,
+                   size_t opcode_max_size)
+    {
+        return 0;
+    }
+
+    // Build the code to place at "code_addr" that calls "function_addr" with
+    // a private copy of the "arg_size" bytes at "arg_addr", preserving every
+    // register.  The pointer "result_ptr_offset" bytes into the copy is
+    // pointed at a private "result_size" byte integer, so threads running
+    // the code at the same time don't share a result.  When the result is
+    // zero the code adds one to the 64 bit counter at "hit_count_addr",
+    // runs "insn", the instruction at "insn_addr" that the jump displaced,
+    // and continues after it.  Otherwise it traps at "trap_addr" with the
+    // registers as they were at "insn_addr".  Returns false if "insn" can't
+    // run from somewhere else.
+    virtual bool
+    CreateConditionTrampoline (Instruction &insn,
+                               lldb::addr_t insn_addr,
+                               lldb::addr_t code_addr,
+                               lldb::addr_t function_addr,
+                               lldb::addr_t arg_addr,
+                               size_t arg_size,
+                               uint32_t result_ptr_offset,
+                               size_t result_size,
+                               lldb::addr_t hit_count_addr,
+                               std::vector<uint8_t> &code,
+                               lldb::addr_t &trap_addr)
+    {
+        return false;
+    }
+
     bool
     GetRegisterInfoByName (const ConstString &name, RegisterInfo &info);
 
@@ -48,6 +48,17 @@ namespace lldb_private {
               void *dst, 
               size_t dst_len,
               Error &error);
+
+        //------------------------------------------------------------------
+        // Fill the cache lines that cover [addr, addr + size) with as few
+        // reads from the process as possible. Lines that are already
+        // cached are not read again. Returns the number of bytes starting
+        // at addr that are in the cache when it is done.
+        //------------------------------------------------------------------
+        size_t
+        Prefetch (lldb::addr_t addr,
+                  size_t size,
+                  Error &error);
         
         uint32_t
         GetMemoryCacheLineSize() const
@@ -72,6 +83,7 @@ namespace lldb_private {
         Mutex m_mutex;
         BlockMap m_cache;
         InvalidRanges m_invalid_ranges;
+        uint32_t m_flush_generation; // Bumped by Clear() and Flush(), so reads made without m_mutex can tell the cache changed
     private:
         DISALLOW_COPY_AND_ASSIGN (MemoryCache);
     };
@@ -18,11 +18,13 @@
 // C++ Includes
 #include <list>
 #include <iosfwd>
+#include <map>
 #include <vector>
 
 // Other libraries and framework includes
 // Project includes
 #include "lldb/lldb-private.h"
+#include "lldb/Core/Address.h"
 #include "lldb/Core/ArchSpec.h"
 #include "lldb/Core/Broadcaster.h"
 #include "lldb/Core/Communication.h"
@@ -103,6 +105,15 @@ public:
     
     void
     SetDetachKeepsStopped (bool keep_stopped);
+
+    bool
+    GetUnwindThreadsInParallel () const;
+
+    void
+    SetUnwindThreadsInParallel (bool parallel);
+
+    uint64_t
+    GetUnwindStackPrefetchSize () const;
 };
 
 typedef std::shared_ptr<ProcessProperties> ProcessPropertiesSP;
@@ -2014,6 +2025,41 @@ public:
                 size_t size,
                 Error &error);
 
+    //------------------------------------------------------------------
+    /// Get a read only view of process memory.
+    ///
+    /// This is equivalent to calling Process::ReadMemory() into a new
+    /// buffer and wrapping it in  data, which is what the default
+    /// implementation does. Process plug-ins whose memory is backed by
+    /// a file (like core files) can override this to hand out a view
+    /// that shares the bytes with the file mapping, so large reads
+    /// don't have to be copied.
+    ///
+    /// @param[in] vm_addr
+    ///     A virtual load address that indicates where to start reading
+    ///     memory from.
+    ///
+    /// @param[in] size
+    ///     The number of bytes to read.
+    ///
+    /// @param[out] data
+    ///     A data extractor that will be set to the memory that was
+    ///     read, using the process byte order and address size.
+    ///
+    /// @param[out] error
+    ///     An error that will be set if no bytes could be read.
+    ///
+    /// @return
+    ///     The number of bytes in \a data, which can be less than \a
+    ///     size if only part of the range is readable. Zero is returned
+    ///     to indicate an error.
+    //------------------------------------------------------------------
+    virtual size_t
+    GetMemoryView (lldb::addr_t vm_addr,
+                   size_t size,
+                   DataExtractor &data,
+                   Error &error);
+
     //------------------------------------------------------------------
     /// Read a NULL terminated string from memory
     ///
@@ -2070,6 +2116,22 @@ public:
                            std::string &out_str,
                            Error &error);
 
+    //------------------------------------------------------------------
+    /// Read a range of memory into the memory cache ahead of time.
+    ///
+    /// Useful when many small reads from a known range are about to
+    /// follow, like when unwinding a stack. Does nothing if the memory
+    /// cache is disabled.
+    ///
+    /// @return
+    ///     The number of bytes starting at \a vm_addr that are now in
+    ///     the memory cache.
+    //------------------------------------------------------------------
+    size_t
+    PrefetchMemory (lldb::addr_t vm_addr,
+                    size_t size,
+                    Error &error);
+
     size_t
     ReadMemoryFromInferior (lldb::addr_t vm_addr, 
                             void *buf, 
@@ -2242,6 +2304,31 @@ public:
         return LLDB_INVALID_ADDRESS;
     }
 
+    //------------------------------------------------------------------
+    /// Actually allocate memory in the process, at \a hint_addr if that
+    /// memory is free and wherever the system puts it otherwise.
+    ///
+    /// The memory doesn't come out of the allocated memory cache, free
+    /// it with DoDeallocateMemory().
+    ///
+    /// @param[in] hint_addr
+    ///     The address the allocation should preferably start at.
+    ///
+    /// @param[in] size
+    ///     The size of the allocation requested.
+    ///
+    /// @return
+    ///     The address of the allocated buffer in the process, or
+    ///     LLDB_INVALID_ADDRESS if the allocation failed or the plug-in
+    ///     can't place allocations.
+    //------------------------------------------------------------------
+    virtual lldb::addr_t
+    DoAllocateMemoryNear (lldb::addr_t hint_addr, size_t size, uint32_t permissions, Error &error)
+    {
+        error.SetErrorStringWithFormat("error: %s does not support placing allocations in the debug process", GetPluginName().GetCString());
+        return LLDB_INVALID_ADDRESS;
+    }
+
 
     //------------------------------------------------------------------
     /// The public interface to allocating memory in the process.
@@ -2296,6 +2383,17 @@ public:
         return error;
     }
 
+    //------------------------------------------------------------------
+    /// Get all of the mapped memory regions of the process, sorted by
+    /// address. Unmapped gaps between regions are not included.
+    ///
+    /// The default implementation walks the address space with
+    /// GetMemoryRegionInfo(). Plug-ins that can list every region in one
+    /// request should override this.
+    //------------------------------------------------------------------
+    virtual Error
+    GetMemoryRegions (std::vector<MemoryRegionInfo> &regions);
+
     virtual Error
     GetWatchpointSupportInfo (uint32_t &num)
     {
@@ -2523,6 +2621,25 @@ public:
         return error;
     }
 
+    //------------------------------------------------------------------
+    /// Enable or disable many breakpoint sites at once.
+    ///
+    /// The default implementations call EnableBreakpointSite() or
+    /// DisableBreakpointSite() for each site. Plug-ins that can change
+    /// many breakpoints in one round trip should override them.
+    ///
+    /// @param[out] errors
+    ///     Filled in with the result for each site in \a bp_sites.
+    ///
+    /// @return
+    ///     An error if any of the sites couldn't be changed.
+    //------------------------------------------------------------------
+    virtual Error
+    EnableBreakpointSites (const std::vector<BreakpointSite *> &bp_sites, std::vector<Error> &errors);
+
+    virtual Error
+    DisableBreakpointSites (const std::vector<BreakpointSite *> &bp_sites, std::vector<Error> &errors);
+
 
     // This is implemented completely using the lldb::Process API. Subclasses
     // don't need to implement this function unless the standard flow of
@@ -2554,6 +2671,17 @@ public:
     CreateBreakpointSite (const lldb::BreakpointLocationSP &owner,
                           bool use_hardware);
 
+    //------------------------------------------------------------------
+    /// Create breakpoint sites for all of the locations in \a owners.
+    /// The new sites are enabled with one EnableBreakpointSites() call.
+    ///
+    /// @return
+    ///     The number of locations that have a breakpoint site.
+    //------------------------------------------------------------------
+    size_t
+    CreateBreakpointSites (const std::vector<lldb::BreakpointLocationSP> &owners,
+                           bool use_hardware);
+
     Error
     DisableBreakpointSiteByID (lldb::user_id_t break_id);
 
@@ -2568,6 +2696,77 @@ public:
                                    lldb::user_id_t owner_loc_id,
                                    lldb::BreakpointSiteSP &bp_site_sp);
 
+    //------------------------------------------------------------------
+    /// Replace the trap at a breakpoint site with a jump to code in the
+    /// process that calls a JIT-compiled condition and only traps when
+    /// the condition is true.
+    ///
+    /// The code is placed near the site and is never freed, since a
+    /// thread can be inside it whenever the process stops.  For the
+    /// same reason the process keeps the compiled condition, and the
+    /// memory its code and arguments live in, until it exits or execs.
+    ///
+    /// The code counts the hits it filters out, and those are added to
+    /// the hit counts of the site and its owner each time the process
+    /// stops (see UpdateInjectedConditionHitCounts()).
+    ///
+    /// @param[in] bp_site
+    ///     An enabled breakpoint site whose only owner has the condition.
+    ///
+    /// @param[in] condition_sp
+    ///     The condition, compiled to be called from the process.
+    ///
+    /// @param[in] function_addr
+    ///     The address of the condition's JIT-compiled function.
+    ///
+    /// @param[in] arg_addr
+    ///     The materialized arguments to call the function with.  Each
+    ///     call gets its own copy, so threads don't share a result.
+    ///
+    /// @param[in] arg_size
+    ///     The size of the materialized arguments.
+    ///
+    /// @param[in] result_ptr_offset
+    ///     The offset into the arguments of the pointer to the result.
+    ///
+    /// @param[in] result_size
+    ///     The size of the integer result.
+    ///
+    /// @return
+    ///     An error if the condition couldn't be injected, in which case
+    ///     the site traps as it did before.
+    //------------------------------------------------------------------
+    Error
+    InjectBreakpointCondition (BreakpointSite *bp_site,
+                               const std::shared_ptr<ClangUserExpression> &condition_sp,
+                               lldb::addr_t function_addr,
+                               lldb::addr_t arg_addr,
+                               size_t arg_size,
+                               uint32_t result_ptr_offset,
+                               size_t result_size);
+
+    //------------------------------------------------------------------
+    /// Put the ordinary trap back at a site with an injected condition.
+    //------------------------------------------------------------------
+    Error
+    RemoveInjectedBreakpointCondition (BreakpointSite *bp_site);
+
+    //------------------------------------------------------------------
+    /// Add the hits that injected conditions filtered out since the
+    /// last update to the hit counts of their sites and owners.
+    //------------------------------------------------------------------
+    void
+    UpdateInjectedConditionHitCounts ();
+
+    //------------------------------------------------------------------
+    /// Process plug-ins call this for traps that aren't at a breakpoint
+    /// site.  If \a pc is at, or just past, the trap of an injected
+    /// condition, the thread's PC is moved back to the breakpoint site,
+    /// \a pc is updated to match and the site is returned.
+    //------------------------------------------------------------------
+    lldb::BreakpointSiteSP
+    ResolveInjectedConditionTrap (Thread &thread, lldb::addr_t &pc);
+
     //----------------------------------------------------------------------
     // Process Watchpoints (optional)
     //----------------------------------------------------------------------
@@ -2609,6 +2808,19 @@ public:
         return m_thread_list.Threads();
     }
 
+    //------------------------------------------------------------------
+    /// Compute the stack frames of several threads up front.
+    ///
+    /// Unwinds each thread in \a threads far enough to have its first
+    /// \a max_frames frames (all of them if \a max_frames is UINT32_MAX)
+    /// cached in its stack frame list. When the process is stopped and
+    /// the "unwind-threads-in-parallel" setting is on, the threads are
+    /// unwound on a pool of host threads. Callers print or otherwise
+    /// walk the frames afterwards, in whatever order they like.
+    //------------------------------------------------------------------
+    void
+    ComputeStackFrames (const std::vector<lldb::ThreadSP> &threads, uint32_t max_frames);
+
     uint32_t
     GetNextThreadIndexID (uint64_t thread_id);
 
@@ -2786,6 +2998,105 @@ public:
         m_dynamic_checkers_ap.reset(dynamic_checkers);
     }
 
+    //------------------------------------------------------------------
+    /// Get a utility function compiled from some source text and
+    /// installed in this process, compiling and installing it the first
+    /// time it is asked for.
+    ///
+    /// Runtime plug-ins and formatters that run helpers in the inferior
+    /// use this so that each helper is compiled once per process rather
+    /// than once per call or per stop.  The JITted code stays resident in
+    /// the inferior until the process goes away or execs.
+    ///
+    /// @param[in] text
+    ///     The source code of the utility function.
+    ///
+    /// @param[in] name
+    ///     The name of the function defined by \a text.
+    ///
+    /// @param[in] exe_ctx
+    ///     The execution context to install the function with.
+    ///
+    /// @param[in] error_stream
+    ///     A stream to print compile errors to.
+    ///
+    /// @return
+    ///     The installed function, which the process owns, or NULL if
+    ///     it couldn't be compiled.
+    //------------------------------------------------------------------
+    ClangUtilityFunction *
+    GetUtilityFunction (const char *text,
+                        const char *name,
+                        ExecutionContext &exe_ctx,
+                        Stream &error_stream);
+
+    //------------------------------------------------------------------
+    /// Get a caller for functions with a given signature, whose wrapper
+    /// is compiled and written into this process the first time it is
+    /// asked for.
+    ///
+    /// The wrapper doesn't depend on the function it calls or on the
+    /// argument values, so callers pass their own to
+    /// ClangFunction::WriteFunctionArguments() for every call and free
+    /// the argument struct with ClangFunction::DeallocateFunctionResults()
+    /// when they are done.
+    ///
+    /// @param[in] function_address
+    ///     The address of a function with this signature.
+    ///
+    /// @param[in] return_type
+    ///     The return type of the function.
+    ///
+    /// @param[in] arg_value_list
+    ///     Values whose types are the types of the function's arguments.
+    ///
+    /// @param[in] name
+    ///     A name for the caller, for logging.
+    ///
+    /// @param[in] exe_ctx
+    ///     The execution context to install the wrapper with.
+    ///
+    /// @param[in] error_stream
+    ///     A stream to print compile errors to.
+    ///
+    /// @return
+    ///     The caller, which the process owns, or NULL if its wrapper
+    ///     couldn't be compiled.
+    //------------------------------------------------------------------
+    ClangFunction *
+    GetCallerFunction (const Address &function_address,
+                       const ClangASTType &return_type,
+                       ValueList &arg_value_list,
+                       const char *name,
+                       ExecutionContext &exe_ctx,
+                       Stream &error_stream);
+
+    //------------------------------------------------------------------
+    /// Find a function that helpers call directly in the inferior, like
+    /// mmap, remembering where it is for the rest of the process's life.
+    ///
+    /// @param[in] name
+    ///     The full name of the function.
+    ///
+    /// @param[out] address
+    ///     The start address of the function.
+    ///
+    /// @return
+    ///     \b true if the function was found, \b false otherwise. A
+    ///     function that isn't found is looked for again next time, as
+    ///     the image that defines it may not be loaded yet.
+    //------------------------------------------------------------------
+    bool
+    GetHelperFunctionAddress (const ConstString &name, Address &address);
+
+    //------------------------------------------------------------------
+    /// Get how many utility functions and function callers have been
+    /// compiled for this process, and how long that took in total.
+    //------------------------------------------------------------------
+    void
+    GetCompiledFunctionStatistics (uint32_t &num_compiled,
+                                   uint64_t &compile_time_nsec);
+
     //------------------------------------------------------------------
     /// Call this to set the lldb in the mode where it breaks on new thread
     /// creations, and then auto-restarts.  This is useful when you are trying
@@ -3042,9 +3353,25 @@ protected:
     std::vector<lldb::addr_t>   m_image_tokens;
     Listener                    &m_listener;
     BreakpointSiteList          m_breakpoint_site_list; ///< This is the list of breakpoint locations we intend to insert in the target.
+    std::map<lldb::addr_t, lldb::addr_t> m_injected_condition_traps; ///< Maps the trap in each injected condition's code to its breakpoint site address.
+    struct InjectedConditionHits
+    {
+        lldb::addr_t counter_addr;  ///< Where the injected code counts the hits it filters out.
+        uint64_t counted;           ///< How many of those have been added to the hit counts.
+    };
+    std::map<lldb::addr_t, InjectedConditionHits> m_injected_condition_hits; ///< The filtered hit counters of the sites with an injected condition, by site address.
+    std::vector<std::shared_ptr<ClangUserExpression> > m_injected_conditions; ///< Every condition ever injected, since its code can still be running.
     std::unique_ptr<DynamicLoader> m_dyld_ap;
     std::unique_ptr<JITLoaderList> m_jit_loaders_ap;
     std::unique_ptr<DynamicCheckerFunctions> m_dynamic_checkers_ap; ///< The functions used by the expression parser to validate data that expressions use.
+    typedef std::map<std::string, std::shared_ptr<ClangUtilityFunction> > UtilityFunctionMap;
+    typedef std::map<std::string, std::shared_ptr<ClangFunction> > CallerFunctionMap;
+    Mutex                       m_compiled_functions_mutex;
+    UtilityFunctionMap          m_utility_functions;    ///< Utility functions installed in this process, keyed by name and source text.
+    CallerFunctionMap           m_caller_functions;     ///< Function callers whose wrappers are installed in this process, keyed by signature.
+    uint32_t                    m_num_functions_compiled; ///< How many entries have been compiled for the two maps above.
+    uint64_t                    m_function_compile_nsec;  ///< How long compiling them took in total.
+    std::map<ConstString, Address> m_helper_function_addresses; ///< Functions helpers call directly, keyed by name.
     std::unique_ptr<OperatingSystem> m_os_ap;
     std::unique_ptr<SystemRuntime> m_system_runtime_ap;
     UnixSignals                 m_unix_signals;         /// This is the current signal set for this process.
@@ -3163,6 +3490,12 @@ private:
     // For Process only
     //------------------------------------------------------------------
     void ControlPrivateStateThread (uint32_t signal);
+
+    bool
+    ShouldReportBreakpointSiteErrors ();
+
+    lldb::addr_t
+    GetBreakpointSiteLoadAddress (const lldb::BreakpointLocationSP &owner, bool show_error);
     
     DISALLOW_COPY_AND_ASSIGN (Process);
 
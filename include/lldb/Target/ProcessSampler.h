@@ -0,0 +1,123 @@
+//===-- ProcessSampler.h ----------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef liblldb_ProcessSampler_h_
+#define liblldb_ProcessSampler_h_
+
+// C Includes
+// C++ Includes
+#include <map>
+#include <vector>
+
+// Other libraries and framework includes
+// Project includes
+#include "lldb/lldb-private.h"
+#include "lldb/Core/ConstString.h"
+#include "lldb/Core/Error.h"
+
+namespace lldb_private {
+
+//----------------------------------------------------------------------
+// ProcessSampler:
+// A statistical profiler for a live process.
+//
+// The process is repeatedly resumed and interrupted, and each time it
+// is stopped the pcs of all its threads are collected as cheaply as
+// possible (see Thread::GetRawBacktrace). Identical stacks are only
+// counted. Nothing is symbolicated until the results are dumped, and
+// then every distinct address is looked up once.
+//----------------------------------------------------------------------
+class ProcessSampler
+{
+public:
+
+    ProcessSampler (const lldb::ProcessSP &process_sp);
+
+    ~ProcessSampler ();
+
+    //------------------------------------------------------------------
+    /// Sample the process.
+    ///
+    /// The process must be stopped. It is resumed and interrupted
+    /// \a frequency times a second for \a duration_msec milliseconds,
+    /// and is left stopped afterwards. Sampling ends early, with an
+    /// error, if the process exits or can't be stopped, or if it stops
+    /// by itself, at a breakpoint or on a signal, in which case it is
+    /// left stopped there and the error says why. The samples taken
+    /// until then are kept.
+    ///
+    /// @param[in] frequency
+    ///     The number of samples to take per second.
+    ///
+    /// @param[in] duration_msec
+    ///     How long to sample for, in milliseconds.
+    ///
+    /// @param[in] max_frames
+    ///     The maximum number of frames to collect for each thread.
+    //------------------------------------------------------------------
+    Error
+    Sample (uint32_t frequency, uint32_t duration_msec, uint32_t max_frames);
+
+    uint32_t
+    GetNumSamples () const
+    {
+        return m_num_samples;
+    }
+
+    //------------------------------------------------------------------
+    /// Dump the samples as a call tree, outermost frames first, with
+    /// the number of samples each function was on the stack in.
+    //------------------------------------------------------------------
+    void
+    DumpCallTree (Stream &s);
+
+    //------------------------------------------------------------------
+    /// Dump the samples in the collapsed stack format used by flame
+    /// graph tools: one line per distinct stack with the function names
+    /// from outermost to innermost separated by ';', followed by the
+    /// number of samples.
+    //------------------------------------------------------------------
+    void
+    DumpCollapsedStacks (Stream &s);
+
+    void
+    Clear ();
+
+protected:
+
+    // Stacks are the pcs from the innermost frame out, with return
+    // addresses already backed up into the calling instruction.
+    typedef std::vector<lldb::addr_t> Stack;
+    typedef std::map<Stack, uint32_t> StackCounts;
+
+    struct FrameName
+    {
+        ConstString function;
+        ConstString module;
+    };
+    typedef std::map<lldb::addr_t, FrameName> FrameNames;
+
+    void
+    TakeSample (Process &process, uint32_t max_frames);
+
+    void
+    Symbolicate ();
+
+    lldb::ProcessWP m_process_wp;
+    StackCounts m_stack_counts;
+    FrameNames m_frame_names;
+    uint32_t m_num_samples;
+
+private:
+    DISALLOW_COPY_AND_ASSIGN (ProcessSampler);
+};
+
+} // namespace lldb_private
+
+#endif  // liblldb_ProcessSampler_h_
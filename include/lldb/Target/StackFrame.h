@@ -179,6 +179,11 @@ public:
     /// to it on an as-needed basis.  This helps to avoid different functions
     /// looking up symbolic information for a given pc value multiple times.
     ///
+    /// A new frame knows only its pc.  Asking for eSymbolContextSymbol only
+    /// searches the module's symbol table; the compile unit, function,
+    /// block and line entry need the debug information and are looked up
+    /// the first time they are asked for.
+    ///
     /// @params [in] resolve_scope
     ///   Flags from the SymbolContextItem enumerated type which specify what
     ///   type of symbol context is needed by this caller.
@@ -13,6 +13,7 @@
 // C Includes
 // C++ Includes
 #include <list>
+#include <map>
 
 // Other libraries and framework includes
 // Project includes
@@ -170,6 +171,12 @@ public:
 
     bool
     GetUseFastStepping() const;
+
+    uint32_t
+    GetExpressionCacheSize () const;
+
+    bool
+    GetInjectBreakpointConditions () const;
     
     bool
     GetDisplayExpressionsInCrashlogs () const;
@@ -530,9 +537,19 @@ public:
 //    void
 //    UpdateInstanceName ();
 
+    //------------------------------------------------------------------
+    /// Find or create the module for \a module_spec and add it to the
+    /// target's images if it isn't there already.
+    ///
+    /// @param[in] notify
+    ///     If false, a module that is added doesn't send ModulesDidLoad()
+    ///     right away, so its load address can be set first.  The caller
+    ///     has to call ModulesDidLoad() for it.
+    //------------------------------------------------------------------
     lldb::ModuleSP
     GetSharedModule (const ModuleSpec &module_spec,
-                     Error *error_ptr = NULL);
+                     Error *error_ptr = NULL,
+                     bool notify = true);
 
     //----------------------------------------------------------------------
     // Settings accessors
@@ -1088,6 +1105,53 @@ public:
         return m_section_load_history.GetCurrentSectionLoadList();
     }
 
+    //------------------------------------------------------------------
+    /// Get the disassembly of a range of code in this target.
+    ///
+    /// The disassembly is cached by load address and size until modules
+    /// are unloaded or the process goes away, so stepping through the
+    /// same code again doesn't disassemble it again.
+    ///
+    /// @param[in] range
+    ///     The address range to disassemble.
+    ///
+    /// @return
+    ///     The disassembler holding the instructions for  range, or
+    ///     an empty shared pointer if the range couldn't be disassembled.
+    //------------------------------------------------------------------
+    lldb::DisassemblerSP
+    GetDisassemblyForRange (const AddressRange &range);
+
+    void
+    ClearDisassemblyCache ();
+
+    //------------------------------------------------------------------
+    /// Take a compiled user expression out of the cache.
+    ///
+    /// Compiled expressions are cached so evaluating the same expression
+    /// in the same context again, like a breakpoint condition or a
+    /// "display" expression does, only has to materialize its variables
+    /// and run it. Expressions are taken out while they are used, so no
+    /// two evaluations ever share one, and put back with
+    /// CacheUserExpression() when they completed.
+    ///
+    /// @param[in] key
+    ///     The key made by ClangUserExpression for the expression text,
+    ///     its options and the context it is evaluated in.
+    ///
+    /// @return
+    ///     The compiled expression, or an empty shared pointer if none
+    ///     is cached for \a key.
+    //------------------------------------------------------------------
+    std::shared_ptr<ClangUserExpression>
+    TakeCachedUserExpression (const std::string &key);
+
+    void
+    CacheUserExpression (const std::string &key, const std::shared_ptr<ClangUserExpression> &expr_sp);
+
+    void
+    ClearUserExpressionCache ();
+
 //    const SectionLoadList&
 //    GetSectionLoadList() const
 //    {
@@ -1378,6 +1442,15 @@ protected:
     lldb::user_id_t         m_stop_hook_next_id;
     bool                    m_valid;
     bool                    m_suppress_stop_hooks;
+
+    // Disassembled code ranges keyed by load address and byte size
+    typedef std::map<std::pair<lldb::addr_t, lldb::addr_t>, lldb::DisassemblerSP> DisassemblyCache;
+    Mutex                   m_disassembly_mutex;
+    DisassemblyCache        m_disassembly_cache;
+    // Compiled user expressions, most recently used first
+    typedef std::list<std::pair<std::string, std::shared_ptr<ClangUserExpression> > > UserExpressionCache;
+    Mutex                   m_user_expression_mutex;
+    UserExpressionCache     m_user_expression_cache;
     
     static void
     ImageSearchPathsChanged (const PathMappingList &path_list,
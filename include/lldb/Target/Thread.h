@@ -439,6 +439,31 @@ public:
     
     virtual lldb::StackFrameSP
     GetFrameWithConcreteFrameIndex (uint32_t unwind_idx);
+
+    //------------------------------------------------------------------
+    /// Get the program counters of the stack as cheaply as possible.
+    ///
+    /// Meant for sampling: follows the frame pointer chain through
+    /// stack memory that is read in bulk, and doesn't create StackFrame
+    /// objects or run the regular unwinder. Frame zero's eh_frame, when
+    /// its function has one, tells whether the record the frame pointer
+    /// points at is frame zero's or its caller's, so frameless leaf
+    /// functions, prologues and epilogues don't hide the caller. Where
+    /// the chain is clearly broken it falls back to the regular unwinder
+    /// for the whole stack.
+    ///
+    /// @param[out] pcs
+    ///     Filled in with the pc of frame zero followed by the return
+    ///     address of each caller frame, as found in the stack.
+    ///
+    /// @param[in] max_frames
+    ///     The maximum number of frames to get.
+    ///
+    /// @return
+    ///     The number of pcs in \a pcs.
+    //------------------------------------------------------------------
+    size_t
+    GetRawBacktrace (std::vector<lldb::addr_t> &pcs, uint32_t max_frames);
     
     bool
     DecrementCurrentInlinedDepth()
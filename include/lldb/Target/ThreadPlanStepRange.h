@@ -72,6 +72,12 @@ protected:
     
     bool
     NextRangeBreakpointExplainsStop (lldb::StopInfoSP stop_info_sp);
+
+    // Work out where the branch instruction at the pc will go by emulating it
+    // with the thread's current registers.  Returns false if there is no
+    // emulator for this architecture or it couldn't handle the instruction.
+    bool
+    EmulateBranchAtPC (Instruction &branch_insn, lldb::addr_t &next_pc);
     
     SymbolContext             m_addr_context;
     std::vector<AddressRange> m_address_ranges;
@@ -85,7 +91,9 @@ protected:
     bool                      m_use_fast_step;
 
 private:
-    std::vector<lldb::DisassemblerSP> m_instruction_ranges;
+    std::vector<lldb::DisassemblerSP> m_instruction_ranges;   // Shared with the target's disassembly cache
+    std::unique_ptr<EmulateInstruction> m_emulator_ap;
+    bool                      m_tried_emulator;
     DISALLOW_COPY_AND_ASSIGN (ThreadPlanStepRange);
 
 };
@@ -164,6 +164,29 @@ public:
     lldb::SBThread
     GetSelectedThread () const;
 
+    %feature("autodoc", "
+    Unwinds the first max_frames frames (all frames by default) of every
+    thread in one go, in parallel when the process setting
+    'unwind-threads-in-parallel' is on. The frames of each thread are
+    cached afterwards. Returns the number of threads that were unwound.
+    ") ComputeAllThreadStacks;
+    uint32_t
+    ComputeAllThreadStacks (uint32_t max_frames = UINT32_MAX);
+
+    %feature("autodoc", "
+    Profiles the stopped process by resuming and interrupting it frequency
+    times a second for duration_msec milliseconds and collecting up to
+    max_frames frames of every thread each time. The process is left stopped.
+    The samples are written to call_tree as an indented call tree with counts
+    and to collapsed_stacks in the collapsed stack format of flame graph tools.
+    ") Sample;
+    lldb::SBError
+    Sample (uint32_t frequency,
+            uint32_t duration_msec,
+            uint32_t max_frames,
+            lldb::SBStream &call_tree,
+            lldb::SBStream &collapsed_stacks);
+
     %feature("autodoc", "
     Lazily create a thread on demand through the current OperatingSystem plug-in, if the current OperatingSystem plug-in supports it.
     ") CreateOSPluginThread;
@@ -389,6 +412,24 @@ public:
     const char *
     GetExtendedBacktraceTypeAtIndex (uint32_t idx);
 
+    %feature("autodoc", "
+    Return how many helper functions lldb has compiled for this process.
+    The helpers that lldb and its runtime plug-ins run in the inferior,
+    like the one 'po' calls, are compiled the first time they are needed
+    and then reused for the life of the process.
+    ") GetNumCompiledFunctions;
+
+    uint32_t
+    GetNumCompiledFunctions ();
+
+    %feature("autodoc", "
+    Return how long compiling the helper functions counted by
+    GetNumCompiledFunctions() took in total, in nanoseconds.
+    ") GetCompiledFunctionsTime;
+
+    uint64_t
+    GetCompiledFunctionsTime ();
+
     %pythoncode %{
         def __get_is_alive__(self):
             '''Returns "True" if the process is currently alive, "False" otherwise'''
@@ -444,9 +485,24 @@ public:
                 threads.append(accessor[idx])
             return threads
         
+        def get_thread_stacks(self, max_frames=0xffffffff):
+            '''Returns a list() with a list() of lldb.SBFrame objects for each thread in this process, in thread index order. All threads are unwound at once before the lists are made.'''
+            self.ComputeAllThreadStacks(max_frames)
+            stacks = []
+            for thread in self.get_process_thread_list():
+                num_frames = min(thread.GetNumFrames(), max_frames)
+                stacks.append([thread.GetFrameAtIndex(idx) for idx in range(num_frames)])
+            return stacks
+
+        def get_process_thread_stacks(self):
+            return self.get_thread_stacks()
+
         __swig_getmethods__["threads"] = get_process_thread_list
         if _newclass: threads = property(get_process_thread_list, None, doc='''A read only property that returns a list() of lldb.SBThread objects for this process.''')
         
+        __swig_getmethods__["thread_stacks"] = get_process_thread_stacks
+        if _newclass: thread_stacks = property(get_process_thread_stacks, None, doc='''A read only property that returns a list() with a list() of lldb.SBFrame objects for each thread in this process, with all threads unwound at once.''')
+        
         __swig_getmethods__["thread"] = get_threads_access_object
         if _newclass: thread = property(get_threads_access_object, None, doc='''A read only property that returns an object that can access threads by thread index (thread = lldb.process.thread[12]).''')
 
@@ -259,6 +259,16 @@ public:
     uint32_t
     GetNumFrames ();
 
+    %feature("autodoc", "
+    GetRawBacktrace(self, int max_pcs) -> list
+
+    Returns a list with the program counters of up to max_pcs frames,
+    found by following the frame pointer chain without creating frames or
+    looking up symbols. Meant for sampling profilers.
+    ") GetRawBacktrace;
+    size_t
+    GetRawBacktrace (lldb::addr_t *pcs, size_t max_pcs);
+
     lldb::SBFrame
     GetFrameAtIndex (uint32_t idx);
 
@@ -231,6 +231,20 @@ public:
     GetChildAtIndex (uint32_t idx, 
                      lldb::DynamicValueType use_dynamic,
                      bool can_create_synthetic);
+
+    %feature("docstring", "
+    //------------------------------------------------------------------
+    /// Get a window of child values by index.
+    ///
+    /// Only the children in the window are created, and the memory
+    /// they need is read with as few reads as possible, which makes
+    /// this the cheap way to walk very large arrays and containers.
+    /// Fewer than count values are returned if the window runs past
+    /// the last child.
+    //------------------------------------------------------------------
+    ") GetChildrenAtIndexRange;
+    lldb::SBValueList
+    GetChildrenAtIndexRange (uint32_t start_idx, uint32_t count);
     
     lldb::SBValue
     CreateChildAtOffset (const char *name, uint32_t offset, lldb::SBType type);
@@ -25,6 +25,7 @@
 #include "lldb/Core/Stream.h"
 #include "lldb/Core/StreamFile.h"
 #include "lldb/Target/Process.h"
+#include "lldb/Target/ProcessSampler.h"
 #include "lldb/Target/RegisterContext.h"
 #include "lldb/Target/SystemRuntime.h"
 #include "lldb/Target/Target.h"
@@ -262,6 +263,82 @@ SBProcess::GetNumThreads ()
     return num_threads;
 }
 
+uint32_t
+SBProcess::ComputeAllThreadStacks (uint32_t max_frames)
+{
+    Log *log(lldb_private::GetLogIfAllCategoriesSet (LIBLLDB_LOG_API));
+
+    uint32_t num_threads = 0;
+    ProcessSP process_sp(GetSP());
+    if (process_sp)
+    {
+        Process::StopLocker stop_locker;
+        if (stop_locker.TryLock(&process_sp->GetRunLock()))
+        {
+            Mutex::Locker api_locker (process_sp->GetTarget().GetAPIMutex());
+            std::vector<ThreadSP> thread_sps;
+            {
+                ThreadList &thread_list = process_sp->GetThreadList();
+                Mutex::Locker locker (thread_list.GetMutex());
+                const uint32_t num_threads_in_list = thread_list.GetSize();
+                for (uint32_t idx = 0; idx < num_threads_in_list; ++idx)
+                    thread_sps.push_back(thread_list.GetThreadAtIndex(idx));
+            }
+            process_sp->ComputeStackFrames (thread_sps, max_frames);
+            num_threads = thread_sps.size();
+        }
+        else
+        {
+            if (log)
+                log->Printf ("SBProcess(%p)::ComputeAllThreadStacks() => error: process is running",
+                             static_cast<void*>(process_sp.get()));
+        }
+    }
+
+    if (log)
+        log->Printf ("SBProcess(%p)::ComputeAllThreadStacks (max_frames=%u) => %u",
+                     static_cast<void*>(process_sp.get()), max_frames, num_threads);
+
+    return num_threads;
+}
+
+SBError
+SBProcess::Sample (uint32_t frequency,
+                   uint32_t duration_msec,
+                   uint32_t max_frames,
+                   SBStream &call_tree,
+                   SBStream &collapsed_stacks)
+{
+    Log *log(lldb_private::GetLogIfAllCategoriesSet (LIBLLDB_LOG_API));
+
+    SBError sb_error;
+    ProcessSP process_sp(GetSP());
+    if (process_sp)
+    {
+        Mutex::Locker api_locker (process_sp->GetTarget().GetAPIMutex());
+        ProcessSampler sampler (process_sp);
+        sb_error.SetError (sampler.Sample (frequency, duration_msec, max_frames));
+        if (sampler.GetNumSamples() > 0)
+        {
+            sampler.DumpCallTree (call_tree.ref());
+            sampler.DumpCollapsedStacks (collapsed_stacks.ref());
+        }
+    }
+    else
+        sb_error.SetErrorString ("SBProcess is invalid");
+
+    if (log)
+    {
+        SBStream sstr;
+        sb_error.GetDescription (sstr);
+        log->Printf ("SBProcess(%p)::Sample (frequency=%u, duration_msec=%u, max_frames=%u) => SBError (%p): %s",
+                     static_cast<void*>(process_sp.get()), frequency, duration_msec, max_frames,
+                     static_cast<void*>(sb_error.get()), sstr.GetData());
+    }
+
+    return sb_error;
+}
+
 SBThread
 SBProcess::GetSelectedThread () const
 {
@@ -1381,3 +1458,31 @@ SBProcess::GetExtendedBacktraceTypeAtIndex (uint32_t idx)
     }
     return NULL;
 }
+
+uint32_t
+SBProcess::GetNumCompiledFunctions ()
+{
+    ProcessSP process_sp(GetSP());
+    if (process_sp)
+    {
+        uint32_t num_compiled = 0;
+        uint64_t compile_time_nsec = 0;
+        process_sp->GetCompiledFunctionStatistics (num_compiled, compile_time_nsec);
+        return num_compiled;
+    }
+    return 0;
+}
+
+uint64_t
+SBProcess::GetCompiledFunctionsTime ()
+{
+    ProcessSP process_sp(GetSP());
+    if (process_sp)
+    {
+        uint32_t num_compiled = 0;
+        uint64_t compile_time_nsec = 0;
+        process_sp->GetCompiledFunctionStatistics (num_compiled, compile_time_nsec);
+        return compile_time_nsec;
+    }
+    return 0;
+}
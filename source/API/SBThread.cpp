@@ -1254,6 +1254,40 @@ SBThread::GetNumFrames ()
     return num_frames;
 }
 
+size_t
+SBThread::GetRawBacktrace (lldb::addr_t *pcs, size_t max_pcs)
+{
+    Log *log(lldb_private::GetLogIfAllCategoriesSet (LIBLLDB_LOG_API));
+
+    size_t num_pcs = 0;
+    Mutex::Locker api_locker;
+    ExecutionContext exe_ctx (m_opaque_sp.get(), api_locker);
+
+    if (pcs && max_pcs > 0 && exe_ctx.HasThreadScope())
+    {
+        Process::StopLocker stop_locker;
+        if (stop_locker.TryLock(&exe_ctx.GetProcessPtr()->GetRunLock()))
+        {
+            std::vector<addr_t> raw_pcs;
+            const uint32_t max_frames = max_pcs < UINT32_MAX ? max_pcs : UINT32_MAX;
+            num_pcs = exe_ctx.GetThreadPtr()->GetRawBacktrace (raw_pcs, max_frames);
+            std::copy (raw_pcs.begin(), raw_pcs.end(), pcs);
+        }
+        else
+        {
+            if (log)
+                log->Printf ("SBThread(%p)::GetRawBacktrace() => error: process is running",
+                             static_cast<void*>(exe_ctx.GetThreadPtr()));
+        }
+    }
+
+    if (log)
+        log->Printf ("SBThread(%p)::GetRawBacktrace (max_pcs=%" PRIu64 ") => %" PRIu64,
+                     static_cast<void*>(exe_ctx.GetThreadPtr()), (uint64_t)max_pcs, (uint64_t)num_pcs);
+
+    return num_pcs;
+}
+
 SBFrame
 SBThread::GetFrameAtIndex (uint32_t idx)
 {
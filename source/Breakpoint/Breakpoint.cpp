@@ -162,6 +162,7 @@ Breakpoint::SetIgnoreCount (uint32_t n)
         return;
         
     m_options.SetIgnoreCount(n);
+    m_locations.RemoveInjectedConditions();
     SendBreakpointChangedEvent (eBreakpointEventTypeIgnoreChanged);
 }
 
@@ -295,6 +296,7 @@ void
 Breakpoint::SetCondition (const char *condition)
 {
     m_options.SetCondition (condition);
+    m_locations.RemoveInjectedConditions();
     SendBreakpointChangedEvent (eBreakpointEventTypeConditionChanged);
 }
 
@@ -345,14 +347,22 @@ void
 Breakpoint::ResolveBreakpoint ()
 {
     if (m_resolver_sp)
+    {
+        m_locations.StartDeferringSiteResolution();
         m_resolver_sp->ResolveBreakpoint(*m_filter_sp);
+        m_locations.StopDeferringSiteResolution();
+    }
 }
 
 void
 Breakpoint::ResolveBreakpointInModules (ModuleList &module_list)
 {
     if (m_resolver_sp)
+    {
+        m_locations.StartDeferringSiteResolution();
         m_resolver_sp->ResolveBreakpointInModules(*m_filter_sp, module_list);
+        m_locations.StopDeferringSiteResolution();
+    }
 }
 
 void
@@ -51,7 +51,8 @@ BreakpointLocation::BreakpointLocation
     m_owner (owner),
     m_options_ap (),
     m_bp_site_sp (),
-    m_condition_mutex ()
+    m_condition_mutex (),
+    m_injected_condition_hash (0)
 {
     if (check_for_resolver)
     {
@@ -250,6 +251,7 @@ void
 BreakpointLocation::SetCondition (const char *condition)
 {
     GetLocationOptions()->SetCondition (condition);
+    RemoveInjectedCondition ();
     SendBreakpointLocationChangedEvent (eBreakpointEventTypeConditionChanged);
 }
 
@@ -348,6 +350,7 @@ BreakpointLocation::ConditionSaysStop (ExecutionContext &exe_ctx, Error &error)
                 if (log)
                     log->Printf("Condition successfully evaluated, result is %s.\n",
                                 ret ? "true" : "false");
+                InjectCondition (exe_ctx, condition_text, condition_hash, *result_value_sp);
             }
             else
             {
@@ -370,6 +373,87 @@ BreakpointLocation::ConditionSaysStop (ExecutionContext &exe_ctx, Error &error)
     return ret;
 }
 
+void
+BreakpointLocation::InjectCondition (ExecutionContext &exe_ctx,
+                                     const char *condition_text,
+                                     size_t condition_hash,
+                                     ValueObject &result)
+{
+    Log *log = lldb_private::GetLogIfAllCategoriesSet (LIBLLDB_LOG_BREAKPOINTS);
+
+    if (condition_hash == m_injected_condition_hash)
+        return;
+
+    Target &target = m_owner.GetTarget();
+    if (!target.GetInjectBreakpointConditions())
+        return;
+
+    // Only try each condition once, whether or not it can be injected.
+    m_injected_condition_hash = condition_hash;
+
+    // The process can't count down an ignore count, and a shared site would
+    // filter out hits for the other locations too.
+    Process *process = exe_ctx.GetProcessPtr();
+    if (!process || !m_bp_site_sp || m_bp_site_sp->GetNumberOfOwners() != 1 || GetIgnoreCount() != 0)
+        return;
+
+    bool is_signed = false;
+    ClangASTType result_type (result.GetClangType());
+    const uint64_t result_size = result.GetByteSize();
+    if (!(result_type.IsIntegerType (is_signed) || result_type.IsPointerType()) || result_size == 0 || result_size > 8)
+    {
+        if (log)
+            log->Printf ("Condition \"%s\" can't be injected: the result isn't an integer or a pointer", condition_text);
+        return;
+    }
+
+    ClangUserExpression::ClangUserExpressionSP expression_sp (new ClangUserExpression (condition_text,
+                                                                                      NULL,
+                                                                                      lldb::eLanguageTypeUnknown,
+                                                                                      ClangUserExpression::eResultTypeAny));
+    StreamString errors;
+    addr_t function_addr = LLDB_INVALID_ADDRESS;
+    addr_t struct_addr = LLDB_INVALID_ADDRESS;
+    size_t struct_size = 0;
+    uint32_t result_ptr_offset = UINT32_MAX;
+
+    if (!expression_sp->ParseForInjection (errors, exe_ctx) ||
+        !expression_sp->PrepareForInjection (errors, exe_ctx, function_addr, struct_addr, struct_size, result_ptr_offset))
+    {
+        if (log)
+            log->Printf ("Condition \"%s\" can't be injected:\n%s", condition_text, errors.GetData());
+        return;
+    }
+
+    // On success the process keeps the compiled condition, and the memory
+    // it uses, alive until it exits: a thread could be running it long
+    // after the condition is removed or this location goes away.
+    Error error (process->InjectBreakpointCondition (m_bp_site_sp.get(), expression_sp, function_addr, struct_addr, struct_size, result_ptr_offset, result_size));
+
+    if (log)
+        log->Printf ("Condition \"%s\" %s injected%s%s",
+                     condition_text,
+                     error.Success() ? "was" : "couldn't be",
+                     error.Success() ? "" : ": ",
+                     error.Success() ? "" : error.AsCString("unknown error"));
+}
+
+void
+BreakpointLocation::RemoveInjectedCondition ()
+{
+    {
+        Mutex::Locker locker (m_condition_mutex);
+        m_injected_condition_hash = 0;
+    }
+
+    if (!m_bp_site_sp || !m_bp_site_sp->IsConditionInjected())
+        return;
+
+    ProcessSP process_sp(m_owner.GetTarget().GetProcessSP());
+    if (process_sp)
+        process_sp->RemoveInjectedBreakpointCondition (m_bp_site_sp.get());
+}
+
 uint32_t
 BreakpointLocation::GetIgnoreCount ()
 {
@@ -380,6 +464,7 @@ void
 BreakpointLocation::SetIgnoreCount (uint32_t n)
 {
     GetLocationOptions()->SetIgnoreCount(n);
+    RemoveInjectedCondition ();
     SendBreakpointLocationChangedEvent (eBreakpointEventTypeIgnoreChanged);
 }
 
@@ -532,6 +617,8 @@ BreakpointLocation::ClearBreakpointSite ()
             m_bp_site_sp->RemoveOwner(GetBreakpoint().GetID(), GetID());
         
         m_bp_site_sp.reset();
+        Mutex::Locker locker (m_condition_mutex);
+        m_injected_condition_hash = 0;
         return true;
     }
     return false;
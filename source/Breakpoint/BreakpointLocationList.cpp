@@ -14,11 +14,14 @@
 // Project includes
 #include "lldb/Breakpoint/BreakpointLocationList.h"
 
+#include "lldb/lldb-private-log.h"
 #include "lldb/Breakpoint/BreakpointLocation.h"
 #include "lldb/Breakpoint/Breakpoint.h"
 #include "lldb/Core/ArchSpec.h"
 #include "lldb/Core/Module.h"
+#include "lldb/Core/Log.h"
 #include "lldb/Core/Section.h"
+#include "lldb/Target/Process.h"
 #include "lldb/Target/SectionLoadList.h"
 #include "lldb/Target/Target.h"
 
@@ -32,7 +35,9 @@ BreakpointLocationList::BreakpointLocationList(Breakpoint &owner) :
     m_address_to_location (),
     m_mutex (Mutex::eMutexTypeRecursive),
     m_next_id (0),
-    m_new_location_recorder (NULL)
+    m_new_location_recorder (NULL),
+    m_defer_site_resolution (0),
+    m_deferred_locations ()
 {
 }
 
@@ -195,17 +200,58 @@ BreakpointLocationList::ClearAllBreakpointSites ()
         (*pos)->ClearBreakpointSite();
 }
 
+void
+BreakpointLocationList::RemoveInjectedConditions ()
+{
+    Mutex::Locker locker (m_mutex);
+    collection::iterator pos, end = m_locations.end();
+    for (pos = m_locations.begin(); pos != end; ++pos)
+        (*pos)->RemoveInjectedCondition();
+}
+
 void
 BreakpointLocationList::ResolveAllBreakpointSites ()
 {
     Mutex::Locker locker (m_mutex);
     collection::iterator pos, end = m_locations.end();
 
+    collection enabled_locations;
     for (pos = m_locations.begin(); pos != end; ++pos)
     {
         if ((*pos)->IsEnabled())
+            enabled_locations.push_back (*pos);
+    }
+    ResolveBreakpointSites (enabled_locations);
+}
+
+void
+BreakpointLocationList::ResolveBreakpointSites (const collection &locations)
+{
+    Mutex::Locker locker (m_mutex);
+
+    collection unresolved_locations;
+    collection::const_iterator pos, end = locations.end();
+    for (pos = locations.begin(); pos != end; ++pos)
+    {
+        if (!(*pos)->IsResolved())
+            unresolved_locations.push_back (*pos);
+    }
+
+    // Hand all of the locations to the process at once so it can insert
+    // the breakpoints together.
+    Process *process = m_owner.GetTarget().GetProcessSP().get();
+    if (process == NULL || unresolved_locations.size() < 2)
+    {
+        for (pos = unresolved_locations.begin(), end = unresolved_locations.end(); pos != end; ++pos)
             (*pos)->ResolveBreakpointSite();
+        return;
     }
+
+    const size_t num_resolved = process->CreateBreakpointSites (unresolved_locations, m_owner.IsHardware());
+    Log *log (lldb_private::GetLogIfAllCategoriesSet (LIBLLDB_LOG_BREAKPOINTS));
+    if (log)
+        log->Printf ("BreakpointLocationList::%s resolved %" PRIu64 " of %" PRIu64 " breakpoint sites for breakpoint %d",
+                     __FUNCTION__, (uint64_t)num_resolved, (uint64_t)unresolved_locations.size(), m_owner.GetID());
 }
 
 uint32_t
@@ -259,7 +305,10 @@ BreakpointLocationList::AddLocation (const Address &addr, bool resolve_indirect_
 		bp_loc_sp = Create (addr, resolve_indirect_symbols);
 		if (bp_loc_sp)
 		{
-	    	bp_loc_sp->ResolveBreakpointSite();
+            if (m_defer_site_resolution > 0)
+                m_deferred_locations.push_back (bp_loc_sp);
+            else
+                bp_loc_sp->ResolveBreakpointSite();
 
 		    if (new_location)
 	    	    *new_location = true;
@@ -345,3 +394,31 @@ BreakpointLocationList::StopRecordingNewLocations ()
     m_new_location_recorder = NULL;
 }
 
+void
+BreakpointLocationList::StartDeferringSiteResolution ()
+{
+    Mutex::Locker locker (m_mutex);
+    ++m_defer_site_resolution;
+}
+
+void
+BreakpointLocationList::StopDeferringSiteResolution ()
+{
+    Mutex::Locker locker (m_mutex);
+    assert (m_defer_site_resolution > 0);
+    if (--m_defer_site_resolution > 0)
+        return;
+
+    // Skip any locations that were removed while we were deferring.
+    collection deferred_locations;
+    deferred_locations.swap (m_deferred_locations);
+    collection live_locations;
+    collection::iterator pos, end = deferred_locations.end();
+    for (pos = deferred_locations.begin(); pos != end; ++pos)
+    {
+        if (FindByAddress ((*pos)->GetAddress()) == *pos)
+            live_locations.push_back (*pos);
+    }
+    ResolveBreakpointSites (live_locations);
+}
+
@@ -32,6 +32,7 @@ BreakpointSite::BreakpointSite
     m_saved_opcode(),
     m_trap_opcode(),
     m_enabled(false), // Need to create it disabled, so the first enable turns it on.
+    m_condition_injected(false),
     m_owners(),
     m_owners_mutex(Mutex::eMutexTypeRecursive)
 {
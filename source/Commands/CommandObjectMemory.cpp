@@ -15,6 +15,8 @@
 #include <inttypes.h>
 
 // C++ Includes
+#include <algorithm>
+
 // Other libraries and framework includes
 // Project includes
 #include "lldb/Core/DataBufferHeap.h"
@@ -1188,29 +1190,36 @@ protected:
             uint8_t* buffer,
             size_t buffer_size)
     {
+        // Read the range a chunk at a time, overlapping consecutive chunks
+        // by buffer_size - 1 bytes so matches that straddle two chunks are
+        // found. Processes backed by a file (like core files) can hand out
+        // their memory without copying it.
+        static const size_t k_chunk_size = 1024 * 1024;
+        if (buffer_size == 0)
+            return LLDB_INVALID_ADDRESS;
+
         Process *process = m_exe_ctx.GetProcessPtr();
-        DataBufferHeap heap(buffer_size, 0);
-        lldb::addr_t fictional_ptr = low;
-        for (auto ptr = low;
-             low < high;
-             fictional_ptr++)
+        const size_t chunk_size = std::max<size_t>(k_chunk_size, buffer_size);
+        lldb::addr_t ptr = low;
+        while (ptr < high)
         {
+            const size_t bytes_to_read = std::min<lldb::addr_t>(chunk_size, high - ptr);
+            DataExtractor data;
             Error error;
-            if (ptr == low || buffer_size == 1)
-                process->ReadMemory(ptr, heap.GetBytes(), buffer_size, error);
-            else
-            {
-                memmove(heap.GetBytes(), heap.GetBytes()+1, buffer_size-1);
-                process->ReadMemory(ptr, heap.GetBytes()+buffer_size-1, 1, error);
-            }
-            if (error.Fail())
+            const size_t bytes_read = process->GetMemoryView(ptr, bytes_to_read, data, error);
+            if (bytes_read < buffer_size)
                 return LLDB_INVALID_ADDRESS;
-            if (memcmp(heap.GetBytes(), buffer, buffer_size) == 0)
-                return fictional_ptr;
-            if (ptr == low)
-                ptr += buffer_size;
-            else
-                ptr += 1;
+
+            const uint8_t *bytes = data.GetDataStart();
+            const uint8_t *match = std::search(bytes, bytes + bytes_read, buffer, buffer + buffer_size);
+            if (match != bytes + bytes_read)
+                return ptr + (match - bytes);
+
+            // The rest of the range can't be read
+            if (bytes_read < bytes_to_read)
+                return LLDB_INVALID_ADDRESS;
+
+            ptr += bytes_read - (buffer_size - 1);
         }
         return LLDB_INVALID_ADDRESS;
     }
@@ -28,6 +28,7 @@
 #include "lldb/Interpreter/CommandReturnObject.h"
 #include "lldb/Target/Platform.h"
 #include "lldb/Target/Process.h"
+#include "lldb/Target/ProcessSampler.h"
 #include "lldb/Target/StopInfo.h"
 #include "lldb/Target/Target.h"
 #include "lldb/Target/Thread.h"
@@ -1564,6 +1565,165 @@ protected:
     }
 };
 
+//-------------------------------------------------------------------------
+// CommandObjectProcessSample
+//-------------------------------------------------------------------------
+#pragma mark CommandObjectProcessSample
+
+class CommandObjectProcessSample : public CommandObjectParsed
+{
+public:
+
+    CommandObjectProcessSample (CommandInterpreter &interpreter) :
+        CommandObjectParsed (interpreter,
+                             "process sample",
+                             "Profile the current process by interrupting it repeatedly and collecting the stacks of all its threads.",
+                             "process sample [<cmd-options>]",
+                             eFlagRequiresProcess       |
+                             eFlagTryTargetAPILock      |
+                             eFlagProcessMustBeLaunched |
+                             eFlagProcessMustBePaused   ),
+        m_options(interpreter)
+    {
+    }
+
+    ~CommandObjectProcessSample ()
+    {
+    }
+
+    Options *
+    GetOptions ()
+    {
+        return &m_options;
+    }
+
+protected:
+
+    class CommandOptions : public Options
+    {
+    public:
+
+        CommandOptions (CommandInterpreter &interpreter) :
+            Options(interpreter)
+        {
+            // Keep default values of all options in one place: OptionParsingStarting ()
+            OptionParsingStarting ();
+        }
+
+        ~CommandOptions ()
+        {
+        }
+
+        Error
+        SetOptionValue (uint32_t option_idx, const char *option_arg)
+        {
+            Error error;
+            const int short_option = m_getopt_table[option_idx].val;
+            bool success = false;
+            switch (short_option)
+            {
+                case 'f':
+                    m_frequency = Args::StringToUInt32 (option_arg, 0, 0, &success);
+                    if (!success || m_frequency == 0)
+                        error.SetErrorStringWithFormat ("invalid value for frequency: \"%s\", should be a positive number.", option_arg);
+                    break;
+
+                case 'd':
+                    m_duration = Args::StringToUInt32 (option_arg, 0, 0, &success);
+                    if (!success || m_duration == 0)
+                        error.SetErrorStringWithFormat ("invalid value for duration: \"%s\", should be a positive number.", option_arg);
+                    break;
+
+                case 'm':
+                    m_max_frames = Args::StringToUInt32 (option_arg, 0, 0, &success);
+                    if (!success || m_max_frames == 0)
+                        error.SetErrorStringWithFormat ("invalid value for max frames: \"%s\", should be a positive number.", option_arg);
+                    break;
+
+                case 'c':
+                    m_collapsed = true;
+                    break;
+
+                default:
+                    error.SetErrorStringWithFormat("invalid short option character '%c'", short_option);
+                    break;
+            }
+            return error;
+        }
+
+        void
+        OptionParsingStarting ()
+        {
+            m_frequency = 100;
+            m_duration = 1000;
+            m_max_frames = 128;
+            m_collapsed = false;
+        }
+
+        const OptionDefinition*
+        GetDefinitions ()
+        {
+            return g_option_table;
+        }
+
+        // Options table: Required for subclasses of Options.
+
+        static OptionDefinition g_option_table[];
+
+        uint32_t m_frequency;
+        uint32_t m_duration;
+        uint32_t m_max_frames;
+        bool m_collapsed;
+    };
+
+    bool
+    DoExecute (Args& command, CommandReturnObject &result)
+    {
+        if (command.GetArgumentCount() != 0)
+        {
+            result.AppendErrorWithFormat ("The '%s' command does not take any arguments.\n", m_cmd_name.c_str());
+            result.SetStatus (eReturnStatusFailed);
+            return false;
+        }
+
+        ProcessSampler sampler (m_exe_ctx.GetProcessSP());
+        Error error (sampler.Sample (m_options.m_frequency, m_options.m_duration, m_options.m_max_frames));
+        result.SetDidChangeProcessState (true);
+        if (sampler.GetNumSamples() == 0)
+        {
+            result.AppendErrorWithFormat ("no samples taken: %s\n", error.Fail() ? error.AsCString() : "duration too short");
+            result.SetStatus (eReturnStatusFailed);
+            return false;
+        }
+        if (error.Fail())
+            result.AppendWarningWithFormat ("%s\n", error.AsCString());
+
+        Stream &strm = result.GetOutputStream();
+        if (m_options.m_collapsed)
+            sampler.DumpCollapsedStacks (strm);
+        else
+            sampler.DumpCallTree (strm);
+        result.SetStatus (eReturnStatusSuccessFinishResult);
+        return true;
+    }
+
+    CommandOptions m_options;
+};
+
+OptionDefinition
+CommandObjectProcessSample::CommandOptions::g_option_table[] =
+{
+{ LLDB_OPT_SET_ALL, false, "frequency",  'f', OptionParser::eRequiredArgument, NULL, NULL, 0, eArgTypeUnsignedInteger,
+                           "The number of samples to take per second (default 100)."},
+{ LLDB_OPT_SET_ALL, false, "duration",   'd', OptionParser::eRequiredArgument, NULL, NULL, 0, eArgTypeUnsignedInteger,
+                           "How long to sample the process for, in milliseconds (default 1000)."},
+{ LLDB_OPT_SET_ALL, false, "max-frames", 'm', OptionParser::eRequiredArgument, NULL, NULL, 0, eArgTypeCount,
+                           "The maximum number of frames to collect for each thread (default 128)."},
+{ LLDB_OPT_SET_ALL, false, "collapsed",  'c', OptionParser::eNoArgument,       NULL, NULL, 0, eArgTypeNone,
+                           "Print the stacks in the collapsed format used by flame graph tools instead of as a call tree."},
+{ 0, false, NULL, 0, 0, NULL, NULL, 0, eArgTypeNone, NULL }
+};
+
 //-------------------------------------------------------------------------
 // CommandObjectProcessStatus
 //-------------------------------------------------------------------------
@@ -1936,6 +2096,7 @@ CommandObjectMultiwordProcess::CommandObjectMultiwordProcess (CommandInterpreter
     LoadSubCommand ("kill",        CommandObjectSP (new CommandObjectProcessKill      (interpreter)));
     LoadSubCommand ("plugin",      CommandObjectSP (new CommandObjectProcessPlugin    (interpreter)));
     LoadSubCommand ("save-core",   CommandObjectSP (new CommandObjectProcessSaveCore  (interpreter)));
+    LoadSubCommand ("sample",      CommandObjectSP (new CommandObjectProcessSample    (interpreter)));
 }
 
 CommandObjectMultiwordProcess::~CommandObjectMultiwordProcess ()
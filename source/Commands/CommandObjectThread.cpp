@@ -223,8 +223,22 @@ protected:
         else if (command.GetArgumentCount() == 1 && ::strcmp (command.GetArgumentAtIndex(0), "all") == 0)
         {
             Process *process = m_exe_ctx.GetProcessPtr();
+            std::vector<ThreadSP> thread_sps;
+            {
+                Mutex::Locker locker (process->GetThreadList().GetMutex());
+                for (ThreadSP thread_sp : process->Threads())
+                    thread_sps.push_back(thread_sp);
+            }
+
+            // Unwind all the threads first, possibly in parallel, then
+            // print them in order from the cached frames.
+            uint32_t max_frames = UINT32_MAX;
+            if (m_options.m_count != UINT32_MAX && m_options.m_start < UINT32_MAX - m_options.m_count)
+                max_frames = m_options.m_start + m_options.m_count;
+            process->ComputeStackFrames (thread_sps, max_frames);
+
             uint32_t idx = 0;
-            for (ThreadSP thread_sp : process->Threads())
+            for (ThreadSP thread_sp : thread_sps)
             {
                 if (idx != 0)
                     result.AppendMessage("");
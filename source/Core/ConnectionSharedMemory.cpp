@@ -12,31 +12,114 @@
 // C Includes
 #include <errno.h>
 #include <stdlib.h>
+#include <string.h>
 #ifdef _WIN32
 #include "lldb/Host/windows/windows.h"
 #else
+#include <fcntl.h>
 #include <sys/file.h>
 #include <sys/mman.h>
 #include <sys/stat.h>
+#include <signal.h>
 #include <sys/types.h>
+#include <unistd.h>
 #endif
 
 // C++ Includes
+#include <atomic>
+
 // Other libraries and framework includes
 // Project includes
 #include "llvm/Support/MathExtras.h"
 #include "lldb/lldb-private-log.h"
 #include "lldb/Core/Communication.h"
 #include "lldb/Core/Log.h"
+#include "lldb/Core/StreamString.h"
+#include "lldb/Host/Host.h"
+#include "lldb/Host/TimeValue.h"
 
 using namespace lldb;
 using namespace lldb_private;
 
+// The header at the start of the shared region. Everything in here must
+// be lock free since it is accessed from two different processes.
+struct ConnectionSharedMemory::RingHeader
+{
+    std::atomic<uint32_t> read_pos;     // Only modified by the reader of this ring
+    std::atomic<uint32_t> write_pos;    // Only modified by the writer of this ring
+    std::atomic<uint32_t> closed;       // Set to non-zero when the writer of this ring goes away
+    uint32_t padding;
+};
+
+struct ConnectionSharedMemory::Header
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t ring_size;                 // Size in bytes of each ring, always a power of two
+    std::atomic<uint32_t> attached;     // Set to non-zero once the other side has opened the region
+    std::atomic<uint32_t> pids[2];      // The process that writes each ring, 0 until it is known
+    RingHeader rings[2];
+};
+
+static const uint32_t k_shm_magic = 0x6c6c7368; // 'llsh'
+static const uint32_t k_shm_version = 2;
+// Number of times a waiter will poll the ring before it starts sleeping
+static const uint32_t k_shm_spin_count = 256;
+// Maximum amount of time a waiter will sleep between polls
+static const uint32_t k_shm_max_sleep_usec = 1000;
+
+static void
+BackOff (uint32_t &iteration)
+{
+    if (iteration < k_shm_spin_count)
+    {
+        ++iteration;
+        return;
+    }
+    const uint32_t shift = std::min<uint32_t>(iteration - k_shm_spin_count, 10);
+    const uint32_t sleep_usec = std::min<uint32_t>(1u << shift, k_shm_max_sleep_usec);
+    ++iteration;
+    ::usleep (sleep_usec);
+}
+
+class ConnectionSharedMemory::MappingUse
+{
+public:
+    MappingUse (ConnectionSharedMemory &connection) :
+        m_connection (connection)
+    {
+        // Disconnect() sets m_closing before it waits for m_users to drop
+        // to zero, so either it sees us here or we see it closing.
+        m_connection.m_users.fetch_add (1);
+        m_valid = !m_connection.m_closing.load() && m_connection.m_bytes != NULL;
+    }
+
+    ~MappingUse ()
+    {
+        m_connection.m_users.fetch_sub (1);
+    }
+
+    bool
+    IsValid () const
+    {
+        return m_valid;
+    }
+
+private:
+    ConnectionSharedMemory &m_connection;
+    bool m_valid;
+};
+
 ConnectionSharedMemory::ConnectionSharedMemory () :
     Connection(),
     m_name(),
     m_fd (-1),
-    m_mmap()
+    m_is_creator (false),
+    m_bytes (NULL),
+    m_size (0),
+    m_mmap(),
+    m_users (0),
+    m_closing (false)
 {
 }
 
@@ -45,27 +128,69 @@ ConnectionSharedMemory::~ConnectionSharedMemory ()
     Disconnect (NULL);
 }
 
+std::string
+ConnectionSharedMemory::GetUniqueName ()
+{
+    static std::atomic<uint32_t> g_unique_id (0);
+    StreamString name;
+#ifdef _WIN32
+    name.Printf ("lldb-shm-%" PRIu64 "-%u", Host::GetCurrentProcessID(), g_unique_id++);
+#else
+    // Darwin limits shared memory names to 31 characters so keep this short
+    name.Printf ("/lldb-%" PRIu64 "-%u", Host::GetCurrentProcessID(), g_unique_id++);
+#endif
+    return name.GetString();
+}
+
+ConnectionSharedMemory::Header *
+ConnectionSharedMemory::GetHeader () const
+{
+    return (Header *)m_bytes;
+}
+
+uint8_t *
+ConnectionSharedMemory::GetRingData (uint32_t ring_idx) const
+{
+    Header *header = GetHeader();
+    return m_bytes + sizeof(Header) + ring_idx * header->ring_size;
+}
+
+bool
+ConnectionSharedMemory::PeerClosed () const
+{
+    return GetHeader()->rings[GetReadRingIndex()].closed.load(std::memory_order_acquire) != 0;
+}
+
+bool
+ConnectionSharedMemory::PeerDied () const
+{
+#ifndef _WIN32
+    const uint32_t peer_pid = GetHeader()->pids[GetReadRingIndex()].load(std::memory_order_acquire);
+    if (peer_pid != 0 && ::kill ((pid_t)peer_pid, 0) != 0 && errno == ESRCH)
+        return true;
+#endif
+    return false;
+}
+
 bool
 ConnectionSharedMemory::IsConnected () const
 {
-    return m_fd >= 0;
+    return m_bytes != NULL && !m_closing.load();
 }
 
 ConnectionStatus
 ConnectionSharedMemory::Connect (const char *s, Error *error_ptr)
 {
-//    if (s && s[0])
-//    {
-//        if (strstr(s, "shm-create://"))
-//        {
-//        }
-//        else if (strstr(s, "shm-connect://"))
-//        {
-//        }
-//        if (error_ptr)
-//            error_ptr->SetErrorStringWithFormat ("unsupported connection URL: '%s'", s);
-//        return eConnectionStatusError;
-//    }
+    if (s && s[0])
+    {
+        if (strstr(s, "shm-create://") == s)
+            return Open (true, s + strlen("shm-create://"), k_default_size, error_ptr);
+        else if (strstr(s, "shm-connect://") == s)
+            return Open (false, s + strlen("shm-connect://"), 0, error_ptr);
+        if (error_ptr)
+            error_ptr->SetErrorStringWithFormat ("unsupported connection URL: '%s'", s);
+        return eConnectionStatusError;
+    }
     if (error_ptr)
         error_ptr->SetErrorString("invalid connect arguments");
     return eConnectionStatusError;
@@ -74,44 +199,236 @@ ConnectionSharedMemory::Connect (const char *s, Error *error_ptr)
 ConnectionStatus
 ConnectionSharedMemory::Disconnect (Error *error_ptr)
 {
+    Log *log(lldb_private::GetLogIfAnyCategoriesSet (LIBLLDB_LOG_CONNECTION));
+    if (log && m_bytes)
+        log->Printf ("%p ConnectionSharedMemory::Disconnect () name = '%s'",
+                     static_cast<void*>(this), m_name.c_str());
+
+    if (m_bytes)
+    {
+        m_closing.store (true);
+
+        // Let the other side know no more data will be coming
+        GetHeader()->rings[GetWriteRingIndex()].closed.store(1, std::memory_order_release);
+
+        // Calls on other threads that are waiting for data or space see
+        // m_closing and return, wait for them before unmapping.
+        uint32_t iteration = 0;
+        while (m_users.load() != 0)
+            BackOff (iteration);
+#ifndef _WIN32
+        ::munmap (m_bytes, m_size);
+#endif
+        m_bytes = NULL;
+        m_size = 0;
+    }
     m_mmap.Clear();
-    if (!m_name.empty())
+    if (m_fd >= 0)
     {
-#ifdef _WIN32
         close(m_fd);
         m_fd = -1;
-#else
-        shm_unlink (m_name.c_str());
+    }
+    if (!m_name.empty())
+    {
+#ifndef _WIN32
+        if (m_is_creator)
+            shm_unlink (m_name.c_str());
 #endif
         m_name.clear();
     }
+    m_is_creator = false;
     return eConnectionStatusSuccess;
 }
 
 size_t
-ConnectionSharedMemory::Read (void *dst, 
-                              size_t dst_len, 
+ConnectionSharedMemory::Read (void *dst,
+                              size_t dst_len,
                               uint32_t timeout_usec,
-                              ConnectionStatus &status, 
+                              ConnectionStatus &status,
                               Error *error_ptr)
 {
-    status = eConnectionStatusSuccess;
-    return 0;
+    MappingUse use (*this);
+    status = BytesAvailable (timeout_usec, error_ptr);
+    if (status != eConnectionStatusSuccess)
+        return 0;
+
+    Header *header = GetHeader();
+    RingHeader &ring = header->rings[GetReadRingIndex()];
+    const uint8_t *ring_data = GetRingData(GetReadRingIndex());
+    const uint32_t ring_mask = header->ring_size - 1;
+
+    const uint32_t read_pos = ring.read_pos.load(std::memory_order_relaxed);
+    const uint32_t write_pos = ring.write_pos.load(std::memory_order_acquire);
+    const size_t bytes_read = std::min<size_t>(write_pos - read_pos, dst_len);
+
+    // Copy out in at most two pieces if the data wraps around the end of the ring
+    const uint32_t start = read_pos & ring_mask;
+    const size_t first_len = std::min<size_t>(bytes_read, header->ring_size - start);
+    ::memcpy (dst, ring_data + start, first_len);
+    if (first_len < bytes_read)
+        ::memcpy ((uint8_t *)dst + first_len, ring_data, bytes_read - first_len);
+    ring.read_pos.store(read_pos + bytes_read, std::memory_order_release);
+
+    Log *log(lldb_private::GetLogIfAnyCategoriesSet (LIBLLDB_LOG_CONNECTION));
+    if (log)
+        log->Printf ("%p ConnectionSharedMemory::Read (dst = %p, dst_len = %" PRIu64 ") => %" PRIu64,
+                     static_cast<void*>(this),
+                     static_cast<void*>(dst),
+                     static_cast<uint64_t>(dst_len),
+                     static_cast<uint64_t>(bytes_read));
+    return bytes_read;
 }
 
 size_t
 ConnectionSharedMemory::Write (const void *src, size_t src_len, ConnectionStatus &status, Error *error_ptr)
 {
+    MappingUse use (*this);
+    if (!use.IsValid())
+    {
+        if (error_ptr)
+            error_ptr->SetErrorString("not connected");
+        status = eConnectionStatusNoConnection;
+        return 0;
+    }
+
+    Header *header = GetHeader();
+    RingHeader &ring = header->rings[GetWriteRingIndex()];
+    uint8_t *ring_data = GetRingData(GetWriteRingIndex());
+    const uint32_t ring_mask = header->ring_size - 1;
+
+    size_t bytes_written = 0;
+    uint32_t iteration = 0;
+    while (bytes_written < src_len)
+    {
+        const uint32_t write_pos = ring.write_pos.load(std::memory_order_relaxed);
+        const uint32_t read_pos = ring.read_pos.load(std::memory_order_acquire);
+        const size_t bytes_free = header->ring_size - (write_pos - read_pos);
+        if (bytes_free == 0)
+        {
+            // The reader isn't keeping up, wait for it unless it has gone away
+            if (PeerClosed() || (iteration >= k_shm_spin_count && PeerDied()))
+            {
+                if (error_ptr)
+                    error_ptr->SetErrorString("shared memory peer closed the connection");
+                status = eConnectionStatusLostConnection;
+                return bytes_written;
+            }
+            if (m_closing.load())
+            {
+                if (error_ptr)
+                    error_ptr->SetErrorString("not connected");
+                status = eConnectionStatusNoConnection;
+                return bytes_written;
+            }
+            BackOff (iteration);
+            continue;
+        }
+        iteration = 0;
+
+        const size_t chunk_len = std::min<size_t>(bytes_free, src_len - bytes_written);
+        const uint32_t start = write_pos & ring_mask;
+        const size_t first_len = std::min<size_t>(chunk_len, header->ring_size - start);
+        const uint8_t *chunk = (const uint8_t *)src + bytes_written;
+        ::memcpy (ring_data + start, chunk, first_len);
+        if (first_len < chunk_len)
+            ::memcpy (ring_data, chunk + first_len, chunk_len - first_len);
+        ring.write_pos.store(write_pos + chunk_len, std::memory_order_release);
+        bytes_written += chunk_len;
+    }
+
+    Log *log(lldb_private::GetLogIfAnyCategoriesSet (LIBLLDB_LOG_CONNECTION));
+    if (log)
+        log->Printf ("%p ConnectionSharedMemory::Write (src = %p, src_len = %" PRIu64 ") => %" PRIu64,
+                     static_cast<const void*>(this),
+                     static_cast<const void*>(src),
+                     static_cast<uint64_t>(src_len),
+                     static_cast<uint64_t>(bytes_written));
     status = eConnectionStatusSuccess;
-    return 0;
+    return bytes_written;
 }
 
 ConnectionStatus
 ConnectionSharedMemory::BytesAvailable (uint32_t timeout_usec, Error *error_ptr)
 {
+    MappingUse use (*this);
+    if (!use.IsValid())
+    {
+        if (error_ptr)
+            error_ptr->SetErrorString("not connected");
+        return eConnectionStatusNoConnection;
+    }
+
+    const RingHeader &ring = GetHeader()->rings[GetReadRingIndex()];
+    TimeValue deadline;
+    if (timeout_usec != UINT32_MAX && timeout_usec > 0)
+    {
+        deadline = TimeValue::Now();
+        deadline.OffsetWithMicroSeconds (timeout_usec);
+    }
+
+    uint32_t iteration = 0;
+    while (1)
+    {
+        const uint32_t read_pos = ring.read_pos.load(std::memory_order_relaxed);
+        const uint32_t write_pos = ring.write_pos.load(std::memory_order_acquire);
+        if (read_pos != write_pos)
+            return eConnectionStatusSuccess;
+
+        // Only report end of file once the ring has been drained
+        if (PeerClosed())
+            return eConnectionStatusEndOfFile;
+
+        if (timeout_usec == 0)
+            return eConnectionStatusTimedOut;
+
+        if (m_closing.load())
+        {
+            if (error_ptr)
+                error_ptr->SetErrorString("not connected");
+            return eConnectionStatusNoConnection;
+        }
+
+        // Only look at the clock and the other process once we start
+        // sleeping
+        if (iteration >= k_shm_spin_count)
+        {
+            if (deadline.IsValid() && TimeValue::Now() >= deadline)
+                return eConnectionStatusTimedOut;
+            if (PeerDied())
+            {
+                if (error_ptr)
+                    error_ptr->SetErrorString("shared memory peer exited without closing the connection");
+                return eConnectionStatusLostConnection;
+            }
+        }
+
+        BackOff (iteration);
+    }
     return eConnectionStatusLostConnection;
 }
 
+bool
+ConnectionSharedMemory::WaitForPeer (uint32_t timeout_usec)
+{
+    MappingUse use (*this);
+    if (!use.IsValid())
+        return false;
+    if (!m_is_creator)
+        return true;
+
+    Header *header = GetHeader();
+    TimeValue deadline (TimeValue::Now());
+    deadline.OffsetWithMicroSeconds (timeout_usec);
+    uint32_t iteration = 0;
+    while (header->attached.load(std::memory_order_acquire) == 0)
+    {
+        if (PeerClosed() || m_closing.load() || TimeValue::Now() >= deadline)
+            return false;
+        BackOff (iteration);
+    }
+    return true;
+}
+
 ConnectionStatus
 ConnectionSharedMemory::Open (bool create, const char *name, size_t size, Error *error_ptr)
 {
@@ -121,8 +438,23 @@ ConnectionSharedMemory::Open (bool create, const char *name, size_t size, Error
             error_ptr->SetErrorString("already open");
         return eConnectionStatusError;
     }
-    
+
+    if (name == NULL || name[0] == '\0')
+    {
+        if (error_ptr)
+            error_ptr->SetErrorString("invalid shared memory name");
+        return eConnectionStatusError;
+    }
+
+    if (create && size <= sizeof(Header))
+    {
+        if (error_ptr)
+            error_ptr->SetErrorStringWithFormat("shared memory size %" PRIu64 " is too small", (uint64_t)size);
+        return eConnectionStatusError;
+    }
+
     m_name.assign (name);
+    m_closing.store (false);
 
 #ifdef _WIN32
     HANDLE handle;
@@ -137,22 +469,97 @@ ConnectionSharedMemory::Open (bool create, const char *name, size_t size, Error
     }
     else
         handle = OpenFileMapping(FILE_MAP_ALL_ACCESS, FALSE, name);
+    m_is_creator = create && handle != NULL;
 
     m_fd = _open_osfhandle((intptr_t)handle, 0);
+
+    if (m_mmap.MemoryMapFromFileDescriptor(m_fd, 0, size, true, false) == size)
+    {
+        m_bytes = m_mmap.GetBytes();
+        m_size = size;
+    }
 #else
     int oflag = O_RDWR;
     if (create)
-        oflag |= O_CREAT;
+        oflag |= O_CREAT | O_EXCL;
     m_fd = ::shm_open (m_name.c_str(), oflag, S_IRUSR|S_IWUSR);
+    // Only unlink the region in Disconnect() if we created it; a failed
+    // create means another process owns a region with this name
+    m_is_creator = create && m_fd >= 0;
 
-    if (create)
-        ::ftruncate (m_fd, size);
+    if (m_fd >= 0)
+    {
+        bool size_ok = true;
+        if (create)
+            size_ok = ::ftruncate (m_fd, size) == 0;
+        else
+        {
+            struct stat st;
+            size_ok = ::fstat (m_fd, &st) == 0 && st.st_size > (off_t)sizeof(Header);
+            if (size_ok)
+                size = st.st_size;
+        }
+
+        if (size_ok)
+        {
+            // The region must be mapped shared so both sides see each other's writes
+            void *bytes = ::mmap (NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+            if (bytes != MAP_FAILED)
+            {
+                m_bytes = (uint8_t *)bytes;
+                m_size = size;
+            }
+        }
+    }
 #endif
 
-    if (m_mmap.MemoryMapFromFileDescriptor(m_fd, 0, size, true, false) == size)
+    if (m_bytes)
+    {
+        Header *header = GetHeader();
+        if (create)
+        {
+            // Each ring gets a power of two size so positions can be masked
+            const size_t max_ring_size = (size - sizeof(Header)) / 2;
+            header->ring_size = 1u << llvm::Log2_32 ((uint32_t)std::min<size_t>(max_ring_size, UINT32_MAX));
+            header->version = k_shm_version;
+            header->attached.store(0);
+            header->pids[GetWriteRingIndex()].store((uint32_t)Host::GetCurrentProcessID());
+            header->pids[GetReadRingIndex()].store(0);
+            for (uint32_t i = 0; i < 2; ++i)
+            {
+                header->rings[i].read_pos.store(0);
+                header->rings[i].write_pos.store(0);
+                header->rings[i].closed.store(0);
+            }
+            std::atomic_thread_fence (std::memory_order_release);
+            header->magic = k_shm_magic;
+        }
+        else
+        {
+            std::atomic_thread_fence (std::memory_order_acquire);
+            if (header->magic != k_shm_magic ||
+                header->version != k_shm_version ||
+                !llvm::isPowerOf2_32 (header->ring_size) ||
+                sizeof(Header) + 2 * (size_t)header->ring_size > m_size)
+            {
+                if (error_ptr)
+                    error_ptr->SetErrorStringWithFormat("'%s' is not a valid shared memory connection", name);
+                Disconnect(NULL);
+                return eConnectionStatusError;
+            }
+            header->pids[GetWriteRingIndex()].store((uint32_t)Host::GetCurrentProcessID(), std::memory_order_release);
+            header->attached.store(1, std::memory_order_release);
+        }
+
+        Log *log(lldb_private::GetLogIfAnyCategoriesSet (LIBLLDB_LOG_CONNECTION));
+        if (log)
+            log->Printf ("%p ConnectionSharedMemory::Open (create = %i, name = '%s', size = %" PRIu64 ") ring_size = %u",
+                         static_cast<void*>(this), create, name, (uint64_t)m_size, header->ring_size);
         return eConnectionStatusSuccess;
+    }
 
+    if (error_ptr)
+        error_ptr->SetErrorToErrno();
     Disconnect(NULL);
     return eConnectionStatusError;
 }
-
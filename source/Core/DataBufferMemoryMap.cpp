@@ -317,3 +317,47 @@ DataBufferMemoryMap::MemoryMapFromFileDescriptor (int fd,
     }
     return GetByteSize ();
 }
+
+//----------------------------------------------------------------------
+// Pass an access pattern hint for part of the mapped data on to the
+// host so large files can be paged in ahead of time or in order.
+//----------------------------------------------------------------------
+bool
+DataBufferMemoryMap::Advise (lldb::offset_t offset, size_t length, AccessHint hint) const
+{
+    if (m_data == NULL || offset >= m_size || length == 0)
+        return false;
+
+    if (length > m_size - offset)
+        length = m_size - offset;
+
+#ifdef _WIN32
+    return false;
+#else
+    int advice = MADV_NORMAL;
+    switch (hint)
+    {
+        case eAccessHintNormal:     advice = MADV_NORMAL; break;
+        case eAccessHintSequential: advice = MADV_SEQUENTIAL; break;
+        case eAccessHintWillNeed:   advice = MADV_WILLNEED; break;
+    }
+
+    // madvise() requires a page aligned start address
+    const uintptr_t page_size = Host::GetPageSize();
+    const uintptr_t start = (uintptr_t)(m_data + offset);
+    const uintptr_t aligned_start = start - (start % page_size);
+    if (::madvise ((void *)aligned_start, length + (start - aligned_start), advice) != 0)
+    {
+        Log *log (lldb_private::GetLogIfAllCategoriesSet (LIBLLDB_LOG_MMAP));
+        if (log)
+        {
+            Error error;
+            error.SetErrorToErrno();
+            log->Printf("DataBufferMemoryMap::Advise() madvise (%p, %" PRIu64 ", %i) failed: %s",
+                        (void *)aligned_start, (uint64_t)(length + (start - aligned_start)), advice, error.AsCString());
+        }
+        return false;
+    }
+    return true;
+#endif
+}
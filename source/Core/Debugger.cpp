@@ -2738,6 +2738,35 @@ Debugger::FormatPrompt
     return FormatPromptRecurse (format, sc, exe_ctx, addr, s, NULL, valobj);
 }
 
+uint32_t
+Debugger::GetSymbolContextScopeForFormat (const char *format)
+{
+    if (format == NULL)
+        return eSymbolContextEverything;
+
+    // The target and module come along with the frame's pc
+    uint32_t resolve_scope = eSymbolContextTarget | eSymbolContextModule;
+    for (const char *var_name_begin = ::strstr (format, "${");
+         var_name_begin != NULL;
+         var_name_begin = ::strstr (var_name_begin, "${"))
+    {
+        var_name_begin += 2;
+        if (IsToken (var_name_begin, "function."))
+        {
+            // Inlined functions are named by their block, functions without
+            // debug information by their symbol.
+            resolve_scope |= eSymbolContextFunction | eSymbolContextBlock | eSymbolContextSymbol;
+            if (IsToken (var_name_begin, "function.line-offset}"))
+                resolve_scope |= eSymbolContextCompUnit | eSymbolContextLineEntry;
+        }
+        else if (IsToken (var_name_begin, "line."))
+            resolve_scope |= eSymbolContextCompUnit | eSymbolContextLineEntry;
+        else if (IsToken (var_name_begin, "file."))
+            resolve_scope |= eSymbolContextCompUnit;
+    }
+    return resolve_scope;
+}
+
 void
 Debugger::SetLoggingCallback (lldb::LogOutputCallback log_callback, void *baton)
 {
@@ -113,9 +113,9 @@ ModuleList::AppendImpl (const ModuleSP &module_sp, bool use_notifier)
 }
 
 void
-ModuleList::Append (const ModuleSP &module_sp)
+ModuleList::Append (const ModuleSP &module_sp, bool notify)
 {
-    AppendImpl (module_sp);
+    AppendImpl (module_sp, notify);
 }
 
 void
@@ -145,7 +145,7 @@ ModuleList::ReplaceEquivalent (const ModuleSP &module_sp)
 }
 
 bool
-ModuleList::AppendIfNeeded (const ModuleSP &module_sp)
+ModuleList::AppendIfNeeded (const ModuleSP &module_sp, bool notify)
 {
     if (module_sp)
     {
@@ -157,7 +157,7 @@ ModuleList::AppendIfNeeded (const ModuleSP &module_sp)
                 return false; // Already in the list
         }
         // Only push module_sp on the list if it wasn't already in there.
-        Append(module_sp);
+        Append(module_sp, notify);
         return true;
     }
     return false;
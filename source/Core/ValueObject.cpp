@@ -15,6 +15,8 @@
 #include <stdlib.h>
 
 // C++ Includes
+#include <algorithm>
+
 // Other libraries and framework includes
 #include "llvm/Support/raw_ostream.h"
 #include "clang/AST/Type.h"
@@ -70,6 +72,7 @@ ValueObject::ValueObject (ValueObject &parent) :
     m_update_point (parent.GetUpdatePoint ()),
     m_name (),
     m_data (),
+    m_children_data (),
     m_value (),
     m_error (),
     m_value_str (),
@@ -100,8 +103,19 @@ ValueObject::ValueObject (ValueObject &parent) :
     m_is_bitfield_for_scalar(false),
     m_is_child_at_offset(false),
     m_is_getting_summary(false),
-    m_did_calculate_complete_objc_class_type(false)
+    m_did_calculate_complete_objc_class_type(false),
+    m_children_data_read(false),
+    m_make_uncached_child(false)
 {
+    if (parent.m_make_uncached_child)
+    {
+        // Our parent isn't going to cache us, so don't join its cluster
+        // where we would live as long as it does.  Start our own and keep
+        // the parent alive for as long as we are.
+        parent.m_make_uncached_child = false;
+        m_manager = new ValueObjectManager();
+        m_parent_sp = parent.GetSP();
+    }
     m_manager->ManageObject(this);
 }
 
@@ -116,6 +130,7 @@ ValueObject::ValueObject (ExecutionContextScope *exe_scope,
     m_update_point (exe_scope),
     m_name (),
     m_data (),
+    m_children_data (),
     m_value (),
     m_error (),
     m_value_str (),
@@ -146,7 +161,9 @@ ValueObject::ValueObject (ExecutionContextScope *exe_scope,
     m_is_bitfield_for_scalar(false),
     m_is_child_at_offset(false),
     m_is_getting_summary(false),
-    m_did_calculate_complete_objc_class_type(false)
+    m_did_calculate_complete_objc_class_type(false),
+    m_children_data_read(false),
+    m_make_uncached_child(false)
 {
     m_manager = new ValueObjectManager();
     m_manager->ManageObject (this);
@@ -201,6 +218,8 @@ ValueObject::UpdateValueIfNeeded (bool update_format)
         }
 
         ClearUserVisibleData();
+        m_children_data.Clear();
+        m_children_data_read = false;
         
         if (IsInScope())
         {
@@ -265,6 +284,12 @@ ValueObject::SetNeedsUpdate ()
     // We have to clear the value string here so ConstResult children will notice if their values are
     // changed by hand (i.e. with SetValueAsCString).
     ClearUserVisibleData(eClearUserVisibleDataItemsValue);
+    // The aggregates we are part of may have our old bytes.
+    for (ValueObject *parent = m_parent; parent != NULL; parent = parent->m_parent)
+    {
+        parent->m_children_data.Clear();
+        parent->m_children_data_read = false;
+    }
 }
 
 void
@@ -520,6 +545,190 @@ ValueObject::GetChildAtIndex (size_t idx, bool can_create)
     return child_sp;
 }
 
+ValueObjectSP
+ValueObject::GetUncachedChildAtIndex (size_t idx)
+{
+    if (IsPossibleDynamicType ())
+        UpdateValueIfNeeded(false);
+    if (idx >= GetNumChildren())
+        return ValueObjectSP();
+
+    ValueObject* child = m_children.GetChildAtIndex(idx);
+    if (child == NULL)
+    {
+        // The first value object constructed with us as its parent picks
+        // this up and gets a manager of its own.
+        m_make_uncached_child = true;
+        child = CreateChildAtIndex (idx, false, 0);
+        m_make_uncached_child = false;
+    }
+    if (child != NULL)
+        return child->GetSP();
+    return ValueObjectSP();
+}
+
+// Gaps up to this size, like padding or members of elements that aren't
+// children, are read along with the ranges around them.
+static const addr_t g_max_prefetch_gap = 256;
+static const addr_t g_max_prefetch_size = 1024 * 1024;
+
+// Aggregates up to this size are read whole the first time one of their
+// children needs its bytes.
+static const uint64_t g_max_children_data_size = 4096;
+
+//----------------------------------------------------------------------
+// Read memory ranges into the process memory cache, coalescing ranges
+// that are close together so that each cluster costs a single read.
+//----------------------------------------------------------------------
+static void
+PrefetchRanges (Process &process, std::vector< std::pair<addr_t, addr_t> > &ranges)
+{
+    std::sort (ranges.begin(), ranges.end());
+
+    size_t i = 0;
+    while (i < ranges.size())
+    {
+        const addr_t start_addr = ranges[i].first;
+        addr_t end_addr = ranges[i].second;
+        for (++i; i < ranges.size() && ranges[i].first <= end_addr + g_max_prefetch_gap; ++i)
+            end_addr = std::max (end_addr, ranges[i].second);
+        if (end_addr - start_addr > g_max_prefetch_size)
+            end_addr = start_addr + g_max_prefetch_size;
+
+        Error error;
+        process.PrefetchMemory (start_addr, end_addr - start_addr, error);
+    }
+}
+
+//----------------------------------------------------------------------
+// Read the memory a window of children will read when they are updated
+// into the process memory cache.  An array window costs a single read.
+//----------------------------------------------------------------------
+static void
+PrefetchChildren (const std::vector<ValueObjectSP> &children)
+{
+    if (children.size() < 2)
+        return;
+
+    ProcessSP process_sp;
+    std::vector< std::pair<addr_t, addr_t> > ranges;
+    for (const ValueObjectSP &child_sp : children)
+    {
+        if (!child_sp)
+            continue;
+        const addr_t addr = child_sp->GetPrefetchAddress();
+        const uint64_t byte_size = child_sp->GetByteSize();
+        if (addr == LLDB_INVALID_ADDRESS || byte_size == 0)
+            continue;
+        if (!process_sp)
+            process_sp = child_sp->GetProcessSP();
+        ranges.push_back (std::make_pair (addr, addr + byte_size));
+    }
+
+    if (process_sp && ranges.size() >= 2)
+        PrefetchRanges (*process_sp, ranges);
+}
+
+//----------------------------------------------------------------------
+// Read what the pointers in a window of children point to, so that
+// following all of them costs a read per cluster of pointees rather
+// than one per pointer.
+//----------------------------------------------------------------------
+static void
+PrefetchPointees (const std::vector<ValueObjectSP> &children)
+{
+    ProcessSP process_sp;
+    std::vector< std::pair<addr_t, addr_t> > ranges;
+    for (const ValueObjectSP &child_sp : children)
+    {
+        if (!child_sp || !child_sp->IsPointerType())
+            continue;
+        const uint64_t byte_size = child_sp->GetClangType().GetPointeeType().GetByteSize();
+        if (byte_size == 0 || byte_size > g_max_children_data_size)
+            continue;
+        AddressType address_type = eAddressTypeInvalid;
+        const addr_t addr = child_sp->GetPointerValue (&address_type);
+        if (addr == LLDB_INVALID_ADDRESS || addr == 0 || address_type != eAddressTypeLoad)
+            continue;
+        if (!process_sp)
+            process_sp = child_sp->GetProcessSP();
+        ranges.push_back (std::make_pair (addr, addr + byte_size));
+    }
+
+    if (process_sp && ranges.size() >= 2)
+        PrefetchRanges (*process_sp, ranges);
+}
+
+size_t
+ValueObject::GetChildrenAtIndexRange (size_t start_idx,
+                                      size_t count,
+                                      std::vector<ValueObjectSP> &children,
+                                      bool prefetch_pointees,
+                                      bool cache_children)
+{
+    children.clear();
+
+    const size_t num_children = GetNumChildren();
+    if (start_idx >= num_children)
+        return 0;
+    if (count > num_children - start_idx)
+        count = num_children - start_idx;
+
+    children.reserve (count);
+    for (size_t idx = start_idx; idx < start_idx + count; ++idx)
+    {
+        if (cache_children)
+            children.push_back (GetChildAtIndex (idx, true));
+        else
+            children.push_back (GetUncachedChildAtIndex (idx));
+    }
+
+    PrefetchChildren (children);
+    if (prefetch_pointees)
+        PrefetchPointees (children);
+    return children.size();
+}
+
+bool
+ValueObject::GetDataForChild (uint64_t offset,
+                              uint64_t size,
+                              DataExtractor &data)
+{
+    if (size == 0)
+        return false;
+
+    // If we are part of an aggregate, slice its bytes so that a whole
+    // nest of structs costs a single read.
+    if (GetDataFromParent (offset, size, data))
+        return true;
+
+    if (!m_children_data_read)
+    {
+        m_children_data_read = true;
+
+        const uint64_t byte_size = GetByteSize();
+        const addr_t addr = m_value.GetValueType() == Value::eValueTypeLoadAddress ? m_value.GetScalar().ULongLong(LLDB_INVALID_ADDRESS) : LLDB_INVALID_ADDRESS;
+        ProcessSP process_sp (GetProcessSP());
+        if (process_sp && addr != LLDB_INVALID_ADDRESS && addr != 0 && byte_size > 0 && byte_size <= g_max_children_data_size)
+        {
+            DataBufferSP buffer_sp (new DataBufferHeap (byte_size, 0));
+            Error error;
+            if (process_sp->ReadMemory (addr, buffer_sp->GetBytes(), byte_size, error) == byte_size)
+            {
+                m_children_data.SetData (buffer_sp);
+                m_children_data.SetByteOrder (process_sp->GetByteOrder());
+                m_children_data.SetAddressByteSize (process_sp->GetAddressByteSize());
+            }
+        }
+    }
+
+    if (!m_children_data.ValidOffsetForDataOfSize (offset, size))
+        return false;
+
+    data.SetData (m_children_data, offset, size);
+    return true;
+}
+
 ValueObjectSP
 ValueObject::GetChildAtIndexPath (const std::initializer_list<size_t>& idxs,
                                   size_t* index_of_error)
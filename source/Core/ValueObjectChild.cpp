@@ -209,7 +209,15 @@ ValueObjectChild::UpdateValue ()
                 const bool thread_and_frame_only_if_stopped = true;
                 ExecutionContext exe_ctx (GetExecutionContextRef().Lock(thread_and_frame_only_if_stopped));
                 if (GetClangType().GetTypeInfo() & ClangASTType::eTypeHasValue)
-                    m_error = m_value.GetValueAsData (&exe_ctx, m_data, 0, GetModule().get());
+                {
+                    // Values inside their parent's bytes slice them, so the
+                    // members of a struct don't each cost a read.
+                    if (m_value.GetValueType() == Value::eValueTypeLoadAddress &&
+                        GetDataFromParent (0, m_byte_size, m_data))
+                        m_error.Clear();
+                    else
+                        m_error = m_value.GetValueAsData (&exe_ctx, m_data, 0, GetModule().get());
+                }
                 else
                     m_error.Clear(); // No value so nothing to read...
             }
@@ -228,6 +236,44 @@ ValueObjectChild::UpdateValue ()
 }
 
 
+bool
+ValueObjectChild::GetDataFromParent (uint64_t offset,
+                                     uint64_t size,
+                                     DataExtractor &data)
+{
+    // Only children that aren't reached through a pointer live inside
+    // their parent's bytes.
+    ValueObject* parent = m_parent;
+    if (parent == NULL || m_is_deref_of_parent || m_byte_offset < 0 || parent->GetClangType().IsPointerOrReferenceType ())
+        return false;
+    return parent->GetDataForChild (m_byte_offset + offset, size, data);
+}
+
+lldb::addr_t
+ValueObjectChild::GetPrefetchAddress ()
+{
+    // This follows UpdateValue(), which reads from the parent's address
+    // or the address the parent points to, plus our offset.
+    ValueObject* parent = m_parent;
+    if (parent == NULL || !parent->UpdateValueIfNeeded(false))
+        return LLDB_INVALID_ADDRESS;
+
+    lldb::addr_t addr = LLDB_INVALID_ADDRESS;
+    if (parent->GetClangType().IsPointerOrReferenceType ())
+    {
+        if (parent->GetAddressTypeOfChildren() == eAddressTypeLoad)
+            addr = parent->GetPointerValue ();
+    }
+    else if (parent->GetValue().GetValueType() == Value::eValueTypeLoadAddress)
+    {
+        addr = parent->GetValue().GetScalar().ULongLong(LLDB_INVALID_ADDRESS);
+    }
+
+    if (addr == LLDB_INVALID_ADDRESS || addr == 0)
+        return LLDB_INVALID_ADDRESS;
+    return addr + m_byte_offset;
+}
+
 bool
 ValueObjectChild::IsInScope ()
 {
@@ -265,6 +265,15 @@ ValueObjectMemory::UpdateValue ()
 
 
 
+lldb::addr_t
+ValueObjectMemory::GetPrefetchAddress ()
+{
+    lldb::TargetSP target_sp (GetTargetSP());
+    if (!target_sp)
+        return LLDB_INVALID_ADDRESS;
+    return m_address.GetLoadAddress (target_sp.get());
+}
+
 bool
 ValueObjectMemory::IsInScope ()
 {
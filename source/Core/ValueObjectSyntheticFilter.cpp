@@ -221,6 +221,23 @@ ValueObjectSynthetic::GetChildAtIndex (size_t idx, bool can_create)
         return iter->second->GetSP();
 }
 
+lldb::ValueObjectSP
+ValueObjectSynthetic::GetUncachedChildAtIndex (size_t idx)
+{
+    UpdateValueIfNeeded();
+    
+    ByIndexIterator iter = m_children_byindex.find(idx);
+    
+    if (iter != m_children_byindex.end())
+        return iter->second->GetSP();
+    
+    // The front end decides how long the children it makes live, we just
+    // don't remember this one.
+    if (m_synth_filter_ap.get() == NULL)
+        return lldb::ValueObjectSP();
+    return m_synth_filter_ap->GetChildAtIndex (idx);
+}
+
 lldb::ValueObjectSP
 ValueObjectSynthetic::GetChildMemberWithName (const ConstString &name, bool can_create)
 {
@@ -20,6 +20,7 @@
 #include "lldb/Host/Endian.h"
 #include "lldb/Symbol/ClangASTContext.h"
 #include "lldb/Target/ObjCLanguageRuntime.h"
+#include "lldb/Target/Process.h"
 #include "lldb/Target/Target.h"
 
 using namespace lldb;
@@ -565,3 +566,136 @@ lldb_private::formatters::LibcxxContainerSummaryProvider (ValueObject& valobj, S
     }
     return Debugger::FormatPrompt("size=${svar%#}", NULL, NULL, NULL, stream, &valobj);
 }
+
+// Walks remember the node at every this many indexes, so that going back
+// to an index behind the last one reached doesn't start over from the
+// first node.  This also bounds the memory a walk of any length keeps.
+static const size_t g_node_checkpoint_interval = 64;
+
+// The window read ahead of a walk doubles while the nodes it visits are
+// next to each other, as they are when a container is filled in order,
+// and halves while they are scattered.
+static const uint64_t g_min_node_window_size = 512;
+static const uint64_t g_max_node_window_size = 64 * 1024;
+
+lldb_private::formatters::LibcxxNodeIteratorCache::LibcxxNodeIteratorCache () :
+    m_checkpoints(),
+    m_checkpoint_addrs(),
+    m_last_idx(0),
+    m_last_addr(LLDB_INVALID_ADDRESS),
+    m_node_byte_size(0),
+    m_window_start(LLDB_INVALID_ADDRESS),
+    m_window_end(LLDB_INVALID_ADDRESS),
+    m_window_size(g_min_node_window_size * 8),
+    m_window_hits(0)
+{
+}
+
+void
+lldb_private::formatters::LibcxxNodeIteratorCache::Clear ()
+{
+    // The nodes may have changed, but their size hasn't.
+    m_checkpoints.clear();
+    m_checkpoint_addrs.clear();
+    m_last_idx = 0;
+    m_last_addr = LLDB_INVALID_ADDRESS;
+    m_window_start = m_window_end = LLDB_INVALID_ADDRESS;
+    m_window_size = g_min_node_window_size * 8;
+    m_window_hits = 0;
+}
+
+bool
+lldb_private::formatters::LibcxxNodeIteratorCache::SetNode (size_t idx, lldb::addr_t node_addr)
+{
+    // A node can only be at one index; seeing it again means the links
+    // loop.  Checking the checkpoints catches any loop within a few
+    // trips around it without remembering every node.
+    if (node_addr == m_last_addr && idx != m_last_idx)
+        return false;
+    if (idx % g_node_checkpoint_interval == 0 && idx / g_node_checkpoint_interval == m_checkpoints.size())
+    {
+        if (!m_checkpoint_addrs.insert(node_addr).second)
+            return false;
+        m_checkpoints.push_back(node_addr);
+    }
+    m_last_idx = idx;
+    m_last_addr = node_addr;
+    return true;
+}
+
+lldb::addr_t
+lldb_private::formatters::LibcxxNodeIteratorCache::GetNodeAtIndex (size_t idx,
+                                                                   lldb::addr_t first_node_addr,
+                                                                   NextNodeCallback const &next_node)
+{
+    size_t node_idx = 0;
+    lldb::addr_t node_addr = first_node_addr;
+    if (m_checkpoints.empty())
+    {
+        if (node_addr == 0 || node_addr == LLDB_INVALID_ADDRESS || !SetNode(0, node_addr))
+            return LLDB_INVALID_ADDRESS;
+    }
+    else
+    {
+        const size_t checkpoint = std::min(idx / g_node_checkpoint_interval, m_checkpoints.size() - 1);
+        node_idx = checkpoint * g_node_checkpoint_interval;
+        node_addr = m_checkpoints[checkpoint];
+        if (m_last_idx <= idx && m_last_idx > node_idx)
+        {
+            node_idx = m_last_idx;
+            node_addr = m_last_addr;
+        }
+    }
+    
+    while (node_idx < idx)
+    {
+        node_addr = next_node(node_addr);
+        if (node_addr == 0 || node_addr == LLDB_INVALID_ADDRESS)
+            return LLDB_INVALID_ADDRESS;
+        if (!SetNode(++node_idx, node_addr))
+            return LLDB_INVALID_ADDRESS;
+    }
+    return node_addr;
+}
+
+void
+lldb_private::formatters::LibcxxNodeIteratorCache::PrefetchNode (Process &process, lldb::addr_t node_addr)
+{
+    const uint64_t node_byte_size = std::max<uint64_t>(m_node_byte_size, 1);
+    if (m_window_start != LLDB_INVALID_ADDRESS &&
+        node_addr >= m_window_start &&
+        node_addr + node_byte_size <= m_window_end)
+    {
+        ++m_window_hits;
+        return;
+    }
+    
+    if (m_window_start != LLDB_INVALID_ADDRESS)
+    {
+        if (m_window_hits > 0)
+            m_window_size = std::min(m_window_size * 2, g_max_node_window_size);
+        else
+            m_window_size = std::max(m_window_size / 2, g_min_node_window_size);
+    }
+    
+    Error error;
+    const size_t bytes_cached = process.PrefetchMemory(node_addr, std::max(m_window_size, node_byte_size), error);
+    m_window_start = node_addr;
+    m_window_end = node_addr + bytes_cached;
+    m_window_hits = 0;
+}
+
+lldb::addr_t
+lldb_private::formatters::LibcxxNodeIteratorCache::ReadNodePointer (Process &process,
+                                                                    lldb::addr_t node_addr,
+                                                                    uint32_t offset)
+{
+    if (node_addr == 0 || node_addr == LLDB_INVALID_ADDRESS)
+        return LLDB_INVALID_ADDRESS;
+    PrefetchNode(process, node_addr);
+    Error error;
+    lldb::addr_t pointer = process.ReadPointerFromMemory(node_addr + offset, error);
+    if (error.Fail())
+        return LLDB_INVALID_ADDRESS;
+    return pointer;
+}
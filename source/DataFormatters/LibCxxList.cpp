@@ -19,134 +19,13 @@
 #include "lldb/Host/Endian.h"
 #include "lldb/Symbol/ClangASTContext.h"
 #include "lldb/Target/ObjCLanguageRuntime.h"
+#include "lldb/Target/Process.h"
 #include "lldb/Target/Target.h"
 
 using namespace lldb;
 using namespace lldb_private;
 using namespace lldb_private::formatters;
 
-class ListEntry
-{
-public:
-    ListEntry () {}
-    ListEntry (ValueObjectSP entry_sp) : m_entry_sp(entry_sp) {}
-    ListEntry (const ListEntry& rhs) : m_entry_sp(rhs.m_entry_sp) {}
-    ListEntry (ValueObject* entry) : m_entry_sp(entry ? entry->GetSP() : ValueObjectSP()) {}
-    
-    ListEntry
-    next ()
-    {
-        if (!m_entry_sp)
-            return ListEntry();
-        return ListEntry(m_entry_sp->GetChildMemberWithName(ConstString("__next_"), true));
-    }
-    
-    ListEntry
-    prev ()
-    {
-        if (!m_entry_sp)
-            return ListEntry();
-        return ListEntry(m_entry_sp->GetChildMemberWithName(ConstString("__prev_"), true));
-    }
-    
-    uint64_t
-    value ()
-    {
-        if (!m_entry_sp)
-            return 0;
-        return m_entry_sp->GetValueAsUnsigned(0);
-    }
-
-    bool
-    null()
-    {
-        return (value() == 0);
-    }
-    
-    explicit operator bool ()
-    {
-        return GetEntry().get() != nullptr && null() == false;
-    }
-    
-    ValueObjectSP
-    GetEntry ()
-    {
-        return m_entry_sp;
-    }
-    
-    void
-    SetEntry (ValueObjectSP entry)
-    {
-        m_entry_sp = entry;
-    }
-    
-    bool
-    operator == (const ListEntry& rhs) const
-    {
-        return (rhs.m_entry_sp.get() == m_entry_sp.get());
-    }
-    
-private:
-    ValueObjectSP m_entry_sp;
-};
-
-class ListIterator
-{
-public:
-    ListIterator () {}
-    ListIterator (ListEntry entry) : m_entry(entry) {}
-    ListIterator (ValueObjectSP entry) : m_entry(entry) {}
-    ListIterator (const ListIterator& rhs) : m_entry(rhs.m_entry) {}
-    ListIterator (ValueObject* entry) : m_entry(entry) {}
-
-    ValueObjectSP
-    value ()
-    {
-        return m_entry.GetEntry();
-    }
-    
-    ValueObjectSP
-    advance (size_t count)
-    {
-        if (count == 0)
-            return m_entry.GetEntry();
-        if (count == 1)
-        {
-            next ();
-            return m_entry.GetEntry();
-        }
-        while (count > 0)
-        {
-            next ();
-            count--;
-            if (m_entry.null())
-                return lldb::ValueObjectSP();
-        }
-        return m_entry.GetEntry();
-    }
-    
-    bool
-    operator == (const ListIterator& rhs) const
-    {
-        return (rhs.m_entry == m_entry);
-    }
-    
-protected:
-    void
-    next ()
-    {
-        m_entry = m_entry.next();
-    }
-    
-    void
-    prev ()
-    {
-        m_entry = m_entry.prev();
-    }
-private:
-    ListEntry m_entry;
-};
-
 lldb_private::formatters::LibcxxStdListSyntheticFrontEnd::LibcxxStdListSyntheticFrontEnd (lldb::ValueObjectSP valobj_sp) :
 SyntheticChildrenFrontEnd(*valobj_sp.get()),
 m_list_capping_size(0),
@@ -154,8 +33,11 @@ m_node_address(),
 m_head(NULL),
 m_tail(NULL),
 m_element_type(),
+m_next_offset(0),
+m_value_offset(UINT32_MAX),
 m_count(UINT32_MAX),
-m_children()
+m_children(),
+m_iterator_cache()
 {
     if (valobj_sp)
         Update();
@@ -169,18 +51,21 @@ lldb_private::formatters::LibcxxStdListSyntheticFrontEnd::HasLoop()
     // don't bother checking for a loop if we won't actually need to jump nodes
     if (m_count < 2)
         return false;
+    ProcessSP process_sp(m_backend.GetProcessSP());
+    if (!process_sp)
+        return false;
+    // The list is circular through the end node, so only a walk that
+    // comes back around without passing it has a loop.
     auto steps_left = m_count;
-    ListEntry slow(m_head);
-    ListEntry fast(m_head);
+    lldb::addr_t slow = m_head->GetValueAsUnsigned(0);
+    lldb::addr_t fast = slow;
     while (steps_left-- > 0)
     {
-        slow = slow.next();
-        fast = fast.next();
-        if (fast.next())
-            fast = fast.next().next();
-        else
-            fast = nullptr;
-        if (!slow || !fast)
+        slow = GetNextNode(*process_sp, slow);
+        fast = GetNextNode(*process_sp, fast);
+        if (fast != LLDB_INVALID_ADDRESS)
+            fast = GetNextNode(*process_sp, fast);
+        if (slow == LLDB_INVALID_ADDRESS || fast == LLDB_INVALID_ADDRESS)
             return false;
         if (slow == fast)
             return true;
@@ -188,6 +73,38 @@ lldb_private::formatters::LibcxxStdListSyntheticFrontEnd::HasLoop()
     return false;
 }
 
+lldb::addr_t
+lldb_private::formatters::LibcxxStdListSyntheticFrontEnd::GetNextNode (Process &process, lldb::addr_t node_addr)
+{
+    if (node_addr == m_node_address)
+        return LLDB_INVALID_ADDRESS;
+    lldb::addr_t next = m_iterator_cache.ReadNodePointer(process, node_addr, m_next_offset);
+    if (next == 0 || next == m_node_address)
+        return LLDB_INVALID_ADDRESS;
+    return next;
+}
+
+bool
+lldb_private::formatters::LibcxxStdListSyntheticFrontEnd::GetValueOffset ()
+{
+    if (m_value_offset != UINT32_MAX)
+        return true;
+    Error error;
+    ValueObjectSP node_sp(m_head->Dereference(error));
+    if (!node_sp || error.Fail())
+        return false;
+    ValueObjectSP value_sp(node_sp->GetChildMemberWithName(ConstString("__value_"), true));
+    if (!value_sp)
+        return false;
+    const lldb::addr_t node_addr = node_sp->GetAddressOf();
+    const lldb::addr_t value_addr = value_sp->GetAddressOf();
+    if (node_addr == LLDB_INVALID_ADDRESS || value_addr == LLDB_INVALID_ADDRESS || value_addr < node_addr)
+        return false;
+    m_value_offset = value_addr - node_addr;
+    m_iterator_cache.SetNodeByteSize(m_value_offset + m_element_type.GetByteSize());
+    return true;
+}
+
 size_t
 lldb_private::formatters::LibcxxStdListSyntheticFrontEnd::CalculateNumChildren ()
 {
@@ -222,12 +139,18 @@ lldb_private::formatters::LibcxxStdListSyntheticFrontEnd::CalculateNumChildren (
             return 1;
         if (HasLoop())
             return 0;
+        ProcessSP process_sp(m_backend.GetProcessSP());
+        if (!process_sp)
+            return 0;
         uint64_t size = 2;
-        ListEntry current(m_head);
-        while (current.next() && current.next().value() != m_node_address)
+        lldb::addr_t current = next_val;
+        while (true)
         {
+            lldb::addr_t next = GetNextNode(*process_sp, current);
+            if (next == LLDB_INVALID_ADDRESS)
+                break;
             size++;
-            current = current.next();
+            current = next;
             if (size > m_list_capping_size)
                 break;
         }
@@ -248,23 +171,20 @@ lldb_private::formatters::LibcxxStdListSyntheticFrontEnd::GetChildAtIndex (size_
     if (cached != m_children.end())
         return cached->second;
     
-    ListIterator current(m_head);
-    ValueObjectSP current_sp(current.advance(idx));
-    if (!current_sp)
-        return lldb::ValueObjectSP();
-    current_sp = current_sp->GetChildMemberWithName(ConstString("__value_"), true);
-    if (!current_sp)
+    ProcessSP process_sp(m_backend.GetProcessSP());
+    if (!process_sp || !GetValueOffset())
         return lldb::ValueObjectSP();
-    // we need to copy current_sp into a new object otherwise we will end up with all items named __value_
-    DataExtractor data;
-    Error error;
-    current_sp->GetData(data, error);
-    if (error.Fail())
+    
+    Process &process = *process_sp;
+    lldb::addr_t node_addr = m_iterator_cache.GetNodeAtIndex(idx,
+                                                             m_head->GetValueAsUnsigned(0),
+                                                             [this, &process] (lldb::addr_t addr) { return GetNextNode(process, addr); });
+    if (node_addr == LLDB_INVALID_ADDRESS || node_addr == m_node_address)
         return lldb::ValueObjectSP();
     
     StreamString name;
     name.Printf("[%" PRIu64 "]", (uint64_t)idx);
-    return (m_children[idx] = ValueObject::CreateValueObjectFromData(name.GetData(), data, m_backend.GetExecutionContextRef(), m_element_type));
+    return (m_children[idx] = ValueObject::CreateValueObjectFromAddress(name.GetData(), node_addr + m_value_offset, m_backend.GetExecutionContextRef(), m_element_type));
 }
 
 bool
@@ -273,6 +193,8 @@ lldb_private::formatters::LibcxxStdListSyntheticFrontEnd::Update()
     m_head = m_tail = NULL;
     m_node_address = 0;
     m_count = UINT32_MAX;
+    m_children.clear();
+    m_iterator_cache.Clear();
     Error err;
     ValueObjectSP backend_addr(m_backend.AddressOf(err));
     m_list_capping_size = 0;
@@ -298,6 +220,16 @@ lldb_private::formatters::LibcxxStdListSyntheticFrontEnd::Update()
     m_element_type = list_type.GetTemplateArgument(0, kind);
     m_head = impl_sp->GetChildMemberWithName(ConstString("__next_"), true).get();
     m_tail = impl_sp->GetChildMemberWithName(ConstString("__prev_"), true).get();
+    if (!m_head || !m_tail)
+        return false;
+    const lldb::addr_t end_addr = impl_sp->GetAddressOf();
+    const lldb::addr_t next_addr = m_head->GetAddressOf();
+    if (end_addr == LLDB_INVALID_ADDRESS || next_addr == LLDB_INVALID_ADDRESS || next_addr < end_addr)
+    {
+        m_head = m_tail = NULL;
+        return false;
+    }
+    m_next_offset = next_addr - end_addr;
     return false;
 }
 
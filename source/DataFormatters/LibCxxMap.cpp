@@ -19,232 +19,25 @@
 #include "lldb/Host/Endian.h"
 #include "lldb/Symbol/ClangASTContext.h"
 #include "lldb/Target/ObjCLanguageRuntime.h"
+#include "lldb/Target/Process.h"
 #include "lldb/Target/Target.h"
 
 using namespace lldb;
 using namespace lldb_private;
 using namespace lldb_private::formatters;
 
-class MapEntry
-{
-public:
-    MapEntry () {}
-    MapEntry (ValueObjectSP entry_sp) : m_entry_sp(entry_sp) {}
-    MapEntry (const MapEntry& rhs) : m_entry_sp(rhs.m_entry_sp) {}
-    MapEntry (ValueObject* entry) : m_entry_sp(entry ? entry->GetSP() : ValueObjectSP()) {}
-    
-    ValueObjectSP
-    left ()
-    {
-        if (!m_entry_sp)
-            return m_entry_sp;
-        return m_entry_sp->GetChildMemberWithName(ConstString("__left_"), true);
-    }
-    
-    ValueObjectSP
-    right ()
-    {
-        if (!m_entry_sp)
-            return m_entry_sp;
-        return m_entry_sp->GetChildMemberWithName(ConstString("__right_"), true);
-    }
-    
-    ValueObjectSP
-    parent ()
-    {
-        if (!m_entry_sp)
-            return m_entry_sp;
-        return m_entry_sp->GetChildMemberWithName(ConstString("__parent_"), true);
-    }
-    
-    uint64_t
-    value ()
-    {
-        if (!m_entry_sp)
-            return 0;
-        return m_entry_sp->GetValueAsUnsigned(0);
-    }
-    
-    bool
-    error ()
-    {
-        if (!m_entry_sp)
-            return true;
-        return m_entry_sp->GetError().Fail();
-    }
-    
-    bool
-    null()
-    {
-        return (value() == 0);
-    }
-    
-    ValueObjectSP
-    GetEntry ()
-    {
-        return m_entry_sp;
-    }
-    
-    void
-    SetEntry (ValueObjectSP entry)
-    {
-        m_entry_sp = entry;
-    }
-    
-    bool
-    operator == (const MapEntry& rhs) const
-    {
-        return (rhs.m_entry_sp.get() == m_entry_sp.get());
-    }
-    
-private:
-    ValueObjectSP m_entry_sp;
-};
-
-class MapIterator
-{
-public:
-    MapIterator () {}
-    MapIterator (MapEntry entry, size_t depth = 0) : m_entry(entry), m_max_depth(depth), m_error(false) {}
-    MapIterator (ValueObjectSP entry, size_t depth = 0) : m_entry(entry), m_max_depth(depth), m_error(false) {}
-    MapIterator (const MapIterator& rhs) : m_entry(rhs.m_entry),m_max_depth(rhs.m_max_depth), m_error(false) {}
-    MapIterator (ValueObject* entry, size_t depth = 0) : m_entry(entry), m_max_depth(depth), m_error(false) {}
-    
-    ValueObjectSP
-    value ()
-    {
-        return m_entry.GetEntry();
-    }
-    
-    ValueObjectSP
-    advance (size_t count)
-    {
-        if (m_error)
-            return lldb::ValueObjectSP();
-        if (count == 0)
-            return m_entry.GetEntry();
-        if (count == 1)
-        {
-            next ();
-            return m_entry.GetEntry();
-        }
-        size_t steps = 0;
-        while (count > 0)
-        {
-            if (m_error)
-                return lldb::ValueObjectSP();
-            next ();
-            count--;
-            if (m_entry.null())
-                return lldb::ValueObjectSP();
-            steps++;
-            if (steps > m_max_depth)
-                return lldb::ValueObjectSP();
-        }
-        return m_entry.GetEntry();
-    }
-protected:
-    void
-    next ()
-    {
-        m_entry.SetEntry(increment(m_entry.GetEntry()));
-    }
-
-private:
-    ValueObjectSP
-    tree_min (ValueObjectSP x_sp)
-    {
-        MapEntry x(x_sp);
-        if (x.null())
-            return ValueObjectSP();
-        MapEntry left(x.left());
-        size_t steps = 0;
-        while (left.null() == false)
-        {
-            if (left.error())
-            {
-                m_error = true;
-                return lldb::ValueObjectSP();
-            }
-            x.SetEntry(left.GetEntry());
-            left.SetEntry(x.left());
-            steps++;
-            if (steps > m_max_depth)
-                return lldb::ValueObjectSP();
-        }
-        return x.GetEntry();
-    }
-    
-    ValueObjectSP
-    tree_max (ValueObjectSP x_sp)
-    {
-        MapEntry x(x_sp);
-        if (x.null())
-            return ValueObjectSP();
-        MapEntry right(x.right());
-        size_t steps = 0;
-        while (right.null() == false)
-        {
-            if (right.error())
-                return lldb::ValueObjectSP();
-            x.SetEntry(right.GetEntry());
-            right.SetEntry(x.right());
-            steps++;
-            if (steps > m_max_depth)
-                return lldb::ValueObjectSP();
-        }
-        return x.GetEntry();
-    }
-    
-    bool
-    is_left_child (ValueObjectSP x_sp)
-    {
-        MapEntry x(x_sp);
-        if (x.null())
-            return false;
-        MapEntry rhs(x.parent());
-        rhs.SetEntry(rhs.left());
-        return x.value() == rhs.value();
-    }
-    
-    ValueObjectSP
-    increment (ValueObjectSP x_sp)
-    {
-        MapEntry node(x_sp);
-        if (node.null())
-            return ValueObjectSP();
-        MapEntry right(node.right());
-        if (right.null() == false)
-            return tree_min(right.GetEntry());
-        size_t steps = 0;
-        while (!is_left_child(node.GetEntry()))
-        {
-            if (node.error())
-            {
-                m_error = true;
-                return lldb::ValueObjectSP();
-            }
-            node.SetEntry(node.parent());
-            steps++;
-            if (steps > m_max_depth)
-                return lldb::ValueObjectSP();
-        }
-        return node.parent();
-    }
-        
-    MapEntry m_entry;
-    size_t m_max_depth;
-    bool m_error;
-};
-
 lldb_private::formatters::LibcxxStdMapSyntheticFrontEnd::LibcxxStdMapSyntheticFrontEnd (lldb::ValueObjectSP valobj_sp) :
 SyntheticChildrenFrontEnd(*valobj_sp.get()),
 m_tree(NULL),
 m_root_node(NULL),
 m_element_type(),
 m_skip_size(UINT32_MAX),
+m_left_offset(0),
+m_right_offset(0),
+m_parent_offset(0),
 m_count(UINT32_MAX),
-m_children()
+m_children(),
+m_iterator_cache()
 {
     if (valobj_sp)
         Update();
@@ -278,25 +71,75 @@ lldb_private::formatters::LibcxxStdMapSyntheticFrontEnd::GetDataType()
     deref = m_root_node->Dereference(error);
     if (!deref || error.Fail())
         return false;
-    deref = deref->GetChildMemberWithName(ConstString("__value_"), true);
-    if (!deref)
+    // The links live in base classes of the node, so find where all the
+    // members we need are from their addresses rather than the node type.
+    const lldb::addr_t node_addr = deref->GetAddressOf();
+    if (node_addr == LLDB_INVALID_ADDRESS)
+        return false;
+    ValueObjectSP left_sp(deref->GetChildMemberWithName(ConstString("__left_"), true));
+    ValueObjectSP right_sp(deref->GetChildMemberWithName(ConstString("__right_"), true));
+    ValueObjectSP parent_sp(deref->GetChildMemberWithName(ConstString("__parent_"), true));
+    ValueObjectSP value_sp(deref->GetChildMemberWithName(ConstString("__value_"), true));
+    if (!left_sp || !right_sp || !parent_sp || !value_sp)
         return false;
-    m_element_type = deref->GetClangType();
+    const lldb::addr_t left_addr = left_sp->GetAddressOf();
+    const lldb::addr_t right_addr = right_sp->GetAddressOf();
+    const lldb::addr_t parent_addr = parent_sp->GetAddressOf();
+    const lldb::addr_t value_addr = value_sp->GetAddressOf();
+    if (left_addr < node_addr || right_addr < node_addr || parent_addr < node_addr || value_addr < node_addr ||
+        left_addr == LLDB_INVALID_ADDRESS || right_addr == LLDB_INVALID_ADDRESS ||
+        parent_addr == LLDB_INVALID_ADDRESS || value_addr == LLDB_INVALID_ADDRESS)
+        return false;
+    m_left_offset = left_addr - node_addr;
+    m_right_offset = right_addr - node_addr;
+    m_parent_offset = parent_addr - node_addr;
+    m_skip_size = value_addr - node_addr;
+    m_element_type = value_sp->GetClangType();
+    m_iterator_cache.SetNodeByteSize(m_skip_size + m_element_type.GetByteSize());
     return true;
 }
 
-void
-lldb_private::formatters::LibcxxStdMapSyntheticFrontEnd::GetValueOffset (const lldb::ValueObjectSP& node)
+lldb::addr_t
+lldb_private::formatters::LibcxxStdMapSyntheticFrontEnd::GetNextNode (Process &process, lldb::addr_t node_addr)
 {
-    if (m_skip_size != UINT32_MAX)
-        return;
-    if (!node)
-        return;
-    ClangASTType node_type(node->GetClangType());
-    uint64_t bit_offset;
-    if (node_type.GetIndexOfFieldWithName("__value_", NULL, &bit_offset) == UINT32_MAX)
-        return;
-    m_skip_size = bit_offset / 8u;
+    // This is the in-order successor libc++'s __tree_next finds.  No
+    // path in a tree of m_count nodes is longer than m_count, so a walk
+    // longer than that means the tree is garbage.
+    size_t steps = 0;
+    lldb::addr_t right = m_iterator_cache.ReadNodePointer(process, node_addr, m_right_offset);
+    if (right == LLDB_INVALID_ADDRESS)
+        return LLDB_INVALID_ADDRESS;
+    if (right != 0)
+    {
+        // The next node is the leftmost one in the right subtree.
+        node_addr = right;
+        while (true)
+        {
+            lldb::addr_t left = m_iterator_cache.ReadNodePointer(process, node_addr, m_left_offset);
+            if (left == LLDB_INVALID_ADDRESS)
+                return LLDB_INVALID_ADDRESS;
+            if (left == 0)
+                return node_addr;
+            node_addr = left;
+            if (++steps > m_count)
+                return LLDB_INVALID_ADDRESS;
+        }
+    }
+    // Otherwise it is the first ancestor we reach from its left subtree.
+    while (true)
+    {
+        lldb::addr_t parent = m_iterator_cache.ReadNodePointer(process, node_addr, m_parent_offset);
+        if (parent == LLDB_INVALID_ADDRESS || parent == 0)
+            return LLDB_INVALID_ADDRESS;
+        lldb::addr_t parent_left = m_iterator_cache.ReadNodePointer(process, parent, m_left_offset);
+        if (parent_left == LLDB_INVALID_ADDRESS)
+            return LLDB_INVALID_ADDRESS;
+        if (parent_left == node_addr)
+            return parent;
+        node_addr = parent;
+        if (++steps > m_count)
+            return LLDB_INVALID_ADDRESS;
+    }
 }
 
 lldb::ValueObjectSP
@@ -311,71 +154,26 @@ lldb_private::formatters::LibcxxStdMapSyntheticFrontEnd::GetChildAtIndex (size_t
     if (cached != m_children.end())
         return cached->second;
     
-    bool need_to_skip = (idx > 0);
-    MapIterator iterator(m_root_node, CalculateNumChildren());
-    ValueObjectSP iterated_sp(iterator.advance(idx));
-    if (iterated_sp.get() == NULL)
-    {
-        // this tree is garbage - stop
-        m_tree = NULL; // this will stop all future searches until an Update() happens
-        return iterated_sp;
-    }
-    if (GetDataType())
-    {
-        if (!need_to_skip)
-        {
-            Error error;
-            iterated_sp = iterated_sp->Dereference(error);
-            if (!iterated_sp || error.Fail())
-            {
-                m_tree = NULL;
-                return lldb::ValueObjectSP();
-            }
-            GetValueOffset(iterated_sp);
-            iterated_sp = iterated_sp->GetChildMemberWithName(ConstString("__value_"), true);
-            if (!iterated_sp)
-            {
-                m_tree = NULL;
-                return lldb::ValueObjectSP();
-            }
-        }
-        else
-        {
-            // because of the way our debug info is made, we need to read item 0 first
-            // so that we can cache information used to generate other elements
-            if (m_skip_size == UINT32_MAX)
-                GetChildAtIndex(0);
-            if (m_skip_size == UINT32_MAX)
-            {
-                m_tree = NULL;
-                return lldb::ValueObjectSP();
-            }
-            iterated_sp = iterated_sp->GetSyntheticChildAtOffset(m_skip_size, m_element_type, true);
-            if (!iterated_sp)
-            {
-                m_tree = NULL;
-                return lldb::ValueObjectSP();
-            }
-        }
-    }
-    else
+    ProcessSP process_sp(m_backend.GetProcessSP());
+    if (!process_sp || !GetDataType())
     {
         m_tree = NULL;
         return lldb::ValueObjectSP();
     }
-    // at this point we have a valid 
-    // we need to copy current_sp into a new object otherwise we will end up with all items named __value_
-    DataExtractor data;
-    Error error;
-    iterated_sp->GetData(data, error);
-    if (error.Fail())
+    
+    Process &process = *process_sp;
+    lldb::addr_t node_addr = m_iterator_cache.GetNodeAtIndex(idx,
+                                                             m_root_node->GetValueAsUnsigned(0),
+                                                             [this, &process] (lldb::addr_t addr) { return GetNextNode(process, addr); });
+    if (node_addr == LLDB_INVALID_ADDRESS)
     {
-        m_tree = NULL;
+        // this tree is garbage - stop
+        m_tree = NULL; // this will stop all future searches until an Update() happens
         return lldb::ValueObjectSP();
     }
     StreamString name;
     name.Printf("[%" PRIu64 "]", (uint64_t)idx);
-    return (m_children[idx] = ValueObject::CreateValueObjectFromData(name.GetData(), data, m_backend.GetExecutionContextRef(), m_element_type));
+    return (m_children[idx] = ValueObject::CreateValueObjectFromAddress(name.GetData(), node_addr + m_skip_size, m_backend.GetExecutionContextRef(), m_element_type));
 }
 
 bool
@@ -384,6 +182,7 @@ lldb_private::formatters::LibcxxStdMapSyntheticFrontEnd::Update()
     m_count = UINT32_MAX;
     m_tree = m_root_node = NULL;
     m_children.clear();
+    m_iterator_cache.Clear();
     m_tree = m_backend.GetChildMemberWithName(ConstString("__tree_"), true).get();
     if (!m_tree)
         return false;
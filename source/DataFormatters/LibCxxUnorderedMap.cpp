@@ -19,6 +19,7 @@
 #include "lldb/Host/Endian.h"
 #include "lldb/Symbol/ClangASTContext.h"
 #include "lldb/Target/ObjCLanguageRuntime.h"
+#include "lldb/Target/Process.h"
 #include "lldb/Target/Target.h"
 
 using namespace lldb;
@@ -29,9 +30,11 @@ lldb_private::formatters::LibcxxStdUnorderedMapSyntheticFrontEnd::LibcxxStdUnord
 SyntheticChildrenFrontEnd(*valobj_sp.get()),
 m_tree(NULL),
 m_num_elements(0),
-m_next_element(nullptr),
+m_element_type(),
+m_next_offset(0),
+m_value_offset(UINT32_MAX),
 m_children(),
-m_elements_cache()
+m_iterator_cache()
 {
     if (valobj_sp)
         Update();
@@ -45,6 +48,32 @@ lldb_private::formatters::LibcxxStdUnorderedMapSyntheticFrontEnd::CalculateNumCh
     return 0;
 }
 
+bool
+lldb_private::formatters::LibcxxStdUnorderedMapSyntheticFrontEnd::GetDataType ()
+{
+    if (m_value_offset != UINT32_MAX)
+        return true;
+    Error error;
+    ValueObjectSP node_sp = m_tree->Dereference(error);
+    if (!node_sp || error.Fail())
+        return false;
+    ValueObjectSP next_sp = node_sp->GetChildMemberWithName(ConstString("__next_"), true);
+    ValueObjectSP value_sp = node_sp->GetChildMemberWithName(ConstString("__value_"), true);
+    if (!next_sp || !value_sp)
+        return false;
+    const lldb::addr_t node_addr = node_sp->GetAddressOf();
+    const lldb::addr_t next_addr = next_sp->GetAddressOf();
+    const lldb::addr_t value_addr = value_sp->GetAddressOf();
+    if (node_addr == LLDB_INVALID_ADDRESS || next_addr == LLDB_INVALID_ADDRESS || value_addr == LLDB_INVALID_ADDRESS ||
+        next_addr < node_addr || value_addr < node_addr)
+        return false;
+    m_element_type = value_sp->GetClangType();
+    m_next_offset = next_addr - node_addr;
+    m_value_offset = value_addr - node_addr;
+    m_iterator_cache.SetNodeByteSize(m_value_offset + m_element_type.GetByteSize());
+    return true;
+}
+
 lldb::ValueObjectSP
 lldb_private::formatters::LibcxxStdUnorderedMapSyntheticFrontEnd::GetChildAtIndex (size_t idx)
 {
@@ -57,51 +86,29 @@ lldb_private::formatters::LibcxxStdUnorderedMapSyntheticFrontEnd::GetChildAtInde
     if (cached != m_children.end())
         return cached->second;
     
-    while (idx >= m_elements_cache.size())
-    {
-        if (m_next_element == nullptr)
-            return lldb::ValueObjectSP();
-        
-        Error error;
-        ValueObjectSP node_sp = m_next_element->Dereference(error);
-        if (!node_sp || error.Fail())
-            return lldb::ValueObjectSP();
-        
-        ValueObjectSP value_sp = node_sp->GetChildMemberWithName(ConstString("__value_"), true);
-        ValueObjectSP hash_sp = node_sp->GetChildMemberWithName(ConstString("__hash_"), true);
-        if (!hash_sp || !value_sp)
-            return lldb::ValueObjectSP();
-        m_elements_cache.push_back({value_sp.get(),hash_sp->GetValueAsUnsigned(0)});
-        m_next_element = node_sp->GetChildMemberWithName(ConstString("__next_"),true).get();
-        if (!m_next_element || m_next_element->GetValueAsUnsigned(0) == 0)
-            m_next_element = nullptr;
-    }
+    ProcessSP process_sp(m_backend.GetProcessSP());
+    if (!process_sp || !GetDataType())
+        return lldb::ValueObjectSP();
     
-    std::pair<ValueObject*, uint64_t> val_hash = m_elements_cache[idx];
-    if (!val_hash.first)
+    Process &process = *process_sp;
+    lldb::addr_t node_addr = m_iterator_cache.GetNodeAtIndex(idx,
+                                                             m_tree->GetValueAsUnsigned(0),
+                                                             [this, &process] (lldb::addr_t addr) { return m_iterator_cache.ReadNodePointer(process, addr, m_next_offset); });
+    if (node_addr == LLDB_INVALID_ADDRESS)
         return lldb::ValueObjectSP();
+    
     StreamString stream;
     stream.Printf("[%" PRIu64 "]", (uint64_t)idx);
-    DataExtractor data;
-    Error error;
-    val_hash.first->GetData(data, error);
-    if (error.Fail())
-        return lldb::ValueObjectSP();
-    const bool thread_and_frame_only_if_stopped = true;
-    ExecutionContext exe_ctx = val_hash.first->GetExecutionContextRef().Lock(thread_and_frame_only_if_stopped);
-    return val_hash.first->CreateValueObjectFromData(stream.GetData(),
-                                                     data,
-                                                     exe_ctx,
-                                                     val_hash.first->GetClangType());
+    return (m_children[idx] = ValueObject::CreateValueObjectFromAddress(stream.GetData(), node_addr + m_value_offset, m_backend.GetExecutionContextRef(), m_element_type));
 }
 
 bool
 lldb_private::formatters::LibcxxStdUnorderedMapSyntheticFrontEnd::Update()
 {
     m_num_elements = UINT32_MAX;
-    m_next_element = nullptr;
-    m_elements_cache.clear();
+    m_tree = NULL;
     m_children.clear();
+    m_iterator_cache.Clear();
     ValueObjectSP table_sp = m_backend.GetChildMemberWithName(ConstString("__table_"), true);
     if (!table_sp)
         return false;
@@ -110,8 +117,6 @@ lldb_private::formatters::LibcxxStdUnorderedMapSyntheticFrontEnd::Update()
         return false;
     m_num_elements = num_elements_sp->GetValueAsUnsigned(0);
     m_tree = table_sp->GetChildAtNamePath({ConstString("__p1_"),ConstString("__first_"),ConstString("__next_")}).get();
-    if (m_num_elements > 0)
-        m_next_element = table_sp->GetChildAtNamePath({ConstString("__p1_"),ConstString("__first_"),ConstString("__next_")}).get();
     return false;
 }
 
@@ -11,6 +11,8 @@
 
 // C Includes
 // C++ Includes
+#include <algorithm>
+
 // Other libraries and framework includes
 // Project includes
 #include "lldb/Core/Debugger.h"
@@ -21,6 +23,9 @@
 using namespace lldb;
 using namespace lldb_private;
 
+// How many children PrintChildren() creates and reads at once.
+static const size_t g_child_window_size = 64;
+
 ValueObjectPrinter::ValueObjectPrinter (ValueObject* valobj,
                                         Stream* s,
                                         const DumpValueObjectOptions& options)
@@ -524,10 +529,22 @@ ValueObjectPrinter::PrintChildren (uint32_t curr_ptr_depth)
     {
         PrintChildrenPreamble ();
         
-        for (size_t idx=0; idx<num_children; ++idx)
+        // Make the children a window at a time, so that only the ones that
+        // get printed are created and each window's memory is read at once.
+        // If the children's pointers are going to be followed, what they
+        // point to is read for the whole window too.  Children that weren't
+        // made before aren't cached in the parent, so each window is freed
+        // when the next one replaces it.
+        const uint32_t child_ptr_depth = (IsPtr() || IsRef()) && curr_ptr_depth >= 1 ? curr_ptr_depth - 1 : curr_ptr_depth;
+        const bool prefetch_pointees = child_ptr_depth > 0 && m_curr_depth + 1 < options.m_max_depth;
+        std::vector<ValueObjectSP> children;
+        for (size_t start_idx=0; start_idx<num_children; start_idx += children.size())
         {
-            ValueObjectSP child_sp(synth_m_valobj->GetChildAtIndex(idx, true));
-            PrintChild (child_sp, curr_ptr_depth);
+            const size_t window_size = std::min<size_t>(num_children - start_idx, g_child_window_size);
+            if (synth_m_valobj->GetChildrenAtIndexRange(start_idx, window_size, children, prefetch_pointees, false) == 0)
+                break;
+            for (const ValueObjectSP &child_sp : children)
+                PrintChild (child_sp, curr_ptr_depth);
         }
         
         PrintChildrenPostamble (print_dotdotdot);
@@ -560,9 +577,11 @@ ValueObjectPrinter::PrintChildrenOneLiner (bool hide_names)
     {
         m_stream->PutChar('(');
         
-        for (uint32_t idx=0; idx<num_children; ++idx)
+        std::vector<ValueObjectSP> children;
+        synth_m_valobj->GetChildrenAtIndexRange(0, num_children, children);
+        for (uint32_t idx=0; idx<children.size(); ++idx)
         {
-            lldb::ValueObjectSP child_sp(synth_m_valobj->GetChildAtIndex(idx, true));
+            lldb::ValueObjectSP child_sp(children[idx]);
             lldb::ValueObjectSP child_dyn_sp = child_sp.get() ? child_sp->GetDynamicValue(options.m_use_dynamic) : child_sp;
             if (child_dyn_sp)
                 child_sp = child_dyn_sp;
@@ -663,38 +663,55 @@ ClangASTSource::FindExternalVisibleDecls (NameSearchContext &context,
     }
     else
     {
-        const ModuleList &target_images = m_target->GetImages();
-        Mutex::Locker modules_locker (target_images.GetMutex());
+        ClangASTImporter::NamespaceMap found_namespaces;
 
-        for (size_t i = 0, e = target_images.GetSize(); i < e; ++i)
+        if (m_ast_importer->FindCachedNamespaceLookup(name, found_namespaces))
         {
-            lldb::ModuleSP image = target_images.GetModuleAtIndexUnlocked(i);
+            if (log)
+                log->Printf("  CAS::FEVD[%u] Found %d cached namespaces named %s",
+                            current_id,
+                            static_cast<int>(found_namespaces.size()),
+                            name.GetCString());
+        }
+        else
+        {
+            const ModuleList &target_images = m_target->GetImages();
+            Mutex::Locker modules_locker (target_images.GetMutex());
 
-            if (!image)
-                continue;
+            for (size_t i = 0, e = target_images.GetSize(); i < e; ++i)
+            {
+                lldb::ModuleSP image = target_images.GetModuleAtIndexUnlocked(i);
 
-            ClangNamespaceDecl found_namespace_decl;
+                if (!image)
+                    continue;
 
-            SymbolVendor *symbol_vendor = image->GetSymbolVendor();
+                ClangNamespaceDecl found_namespace_decl;
 
-            if (!symbol_vendor)
-                continue;
+                SymbolVendor *symbol_vendor = image->GetSymbolVendor();
 
-            SymbolContext null_sc;
+                if (!symbol_vendor)
+                    continue;
 
-            found_namespace_decl = symbol_vendor->FindNamespace(null_sc, name, &namespace_decl);
+                SymbolContext null_sc;
 
-            if (found_namespace_decl)
-            {
-                context.m_namespace_map->push_back(std::pair<lldb::ModuleSP, ClangNamespaceDecl>(image, found_namespace_decl));
+                found_namespace_decl = symbol_vendor->FindNamespace(null_sc, name, &namespace_decl);
 
-                if (log)
-                    log->Printf("  CAS::FEVD[%u] Found namespace %s in module %s",
-                                current_id,
-                                name.GetCString(),
-                                image->GetFileSpec().GetFilename().GetCString());
+                if (found_namespace_decl)
+                {
+                    found_namespaces.push_back(std::pair<lldb::ModuleSP, ClangNamespaceDecl>(image, found_namespace_decl));
+
+                    if (log)
+                        log->Printf("  CAS::FEVD[%u] Found namespace %s in module %s",
+                                    current_id,
+                                    name.GetCString(),
+                                    image->GetFileSpec().GetFilename().GetCString());
+                }
             }
+
+            m_ast_importer->CacheNamespaceLookup(name, found_namespaces);
         }
+
+        context.m_namespace_map->insert(context.m_namespace_map->end(), found_namespaces.begin(), found_namespaces.end());
     }
 
     do
@@ -704,9 +721,28 @@ ClangASTSource::FindExternalVisibleDecls (NameSearchContext &context,
         const bool exact_match = false;
 
         if (module_sp && namespace_decl)
+        {
             module_sp->FindTypesInNamespace(null_sc, name, &namespace_decl, 1, types);
+        }
         else
-            m_target->GetImages().FindTypes(null_sc, name, exact_match, 1, types);
+        {
+            lldb::TypeSP cached_type_sp;
+
+            if (m_ast_importer->FindCachedTypeLookup(name, cached_type_sp))
+            {
+                if (cached_type_sp)
+                    types.Insert(cached_type_sp);
+            }
+            else
+            {
+                m_target->GetImages().FindTypes(null_sc, name, exact_match, 1, types);
+
+                if (types.GetSize())
+                    cached_type_sp = types.GetTypeAtIndex(0);
+
+                m_ast_importer->CacheTypeLookup(name, cached_type_sp);
+            }
+        }
 
         if (types.GetSize())
         {
@@ -817,9 +817,29 @@ ClangExpressionDeclMap::FindGlobalVariable
     VariableList vars;
 
     if (module && namespace_decl)
+    {
         module->FindGlobalVariables (name, namespace_decl, true, -1, vars);
+    }
     else
-        target.GetImages().FindGlobalVariables(name, true, -1, vars);
+    {
+        ClangASTImporter *ast_importer = target.GetClangASTImporter();
+        std::vector<VariableSP> cached_vars;
+
+        if (ast_importer->FindCachedVariableLookup(name, cached_vars))
+        {
+            for (VariableSP &var_sp : cached_vars)
+                vars.AddVariable(var_sp);
+        }
+        else
+        {
+            target.GetImages().FindGlobalVariables(name, true, -1, vars);
+
+            for (size_t i = 0; i < vars.GetSize(); ++i)
+                cached_vars.push_back(vars.GetVariableAtIndex(i));
+
+            ast_importer->CacheVariableLookup(name, cached_vars);
+        }
+    }
 
     if (vars.GetSize())
     {
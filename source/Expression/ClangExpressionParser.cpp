@@ -11,6 +11,8 @@
 
 #include "lldb/Expression/ClangExpressionParser.h"
 
+#include <map>
+
 #include "lldb/Core/ArchSpec.h"
 #include "lldb/Core/DataBufferHeap.h"
 #include "lldb/Core/Debugger.h"
@@ -19,6 +21,7 @@
 #include "lldb/Core/Stream.h"
 #include "lldb/Core/StreamFile.h"
 #include "lldb/Core/StreamString.h"
+#include "lldb/Core/Timer.h"
 #include "lldb/Expression/ClangASTSource.h"
 #include "lldb/Expression/ClangExpression.h"
 #include "lldb/Expression/ClangExpressionDeclMap.h"
@@ -26,6 +29,7 @@
 #include "lldb/Expression/IRDynamicChecks.h"
 #include "lldb/Expression/IRInterpreter.h"
 #include "lldb/Host/File.h"
+#include "lldb/Host/Mutex.h"
 #include "lldb/Symbol/SymbolVendor.h"
 #include "lldb/Target/ExecutionContext.h"
 #include "lldb/Target/ObjCLanguageRuntime.h"
@@ -91,6 +95,74 @@ std::string GetBuiltinIncludePath(const char *Argv0) {
     return P.str();
 }
 
+//----------------------------------------------------------------------
+// Creating a TargetInfo parses the target's data layout and feature list
+// and is the same for every expression evaluated against a given
+// architecture and language, so each combination is created once and
+// shared by all the parsers that need it.  The options that go into the
+// key are the only ones the parser varies; TargetInfo::adjust() only
+// looks at language options that are fixed per language here.
+//
+// TargetInfo's reference count isn't atomic and parsers can be created
+// and destroyed on different threads, so the table and every retain and
+// release of a shared TargetInfo happen with this mutex held.  The table
+// keeps a reference to each TargetInfo for the life of the process, so a
+// parser can drop its own reference before the rest of its compiler goes
+// away.
+//----------------------------------------------------------------------
+static lldb_private::Mutex &
+GetSharedTargetInfoMutex ()
+{
+    static lldb_private::Mutex g_target_infos_mutex (lldb_private::Mutex::eMutexTypeNormal);
+    return g_target_infos_mutex;
+}
+
+static void
+InstallSharedTargetInfo (CompilerInstance &compiler,
+                         lldb::LanguageType language)
+{
+    typedef std::map<std::string, IntrusiveRefCntPtr<TargetInfo> > TargetInfoMap;
+    static TargetInfoMap g_target_infos;
+
+    const std::shared_ptr<TargetOptions> &target_opts = compiler.getInvocation().TargetOpts;
+
+    std::string key (target_opts->Triple);
+    key.append (1, '\0');
+    key.append (target_opts->ABI);
+    for (const std::string &feature : target_opts->Features)
+    {
+        key.append (1, '\0');
+        key.append (feature);
+    }
+    key.append (1, '\0');
+    key.append (std::to_string ((int)language));
+
+    lldb_private::Mutex::Locker locker (GetSharedTargetInfoMutex());
+
+    IntrusiveRefCntPtr<TargetInfo> &target_info = g_target_infos[key];
+    if (!target_info)
+    {
+        target_info = TargetInfo::CreateTargetInfo (compiler.getDiagnostics(), target_opts);
+        if (target_info)
+        {
+            // Inform the target of the language options
+            //
+            // FIXME: We shouldn't need to do this, the target should be immutable once
+            // created. This complexity should be lifted elsewhere.
+            target_info->adjust (compiler.getLangOpts());
+        }
+    }
+
+    compiler.setTarget (target_info.get());
+}
+
+static void
+ReleaseSharedTargetInfo (CompilerInstance &compiler)
+{
+    lldb_private::Mutex::Locker locker (GetSharedTargetInfoMutex());
+    compiler.setTarget (NULL);
+}
+
 //===----------------------------------------------------------------------===//
 // Implementation of ClangExpressionParser
 //===----------------------------------------------------------------------===//
@@ -102,6 +174,8 @@ ClangExpressionParser::ClangExpressionParser (ExecutionContextScope *exe_scope,
     m_compiler (),
     m_code_generator ()
 {
+    Timer scoped_timer (__PRETTY_FUNCTION__, __PRETTY_FUNCTION__);
+
     // Initialize targets first, so that --version shows registered targets.
     static struct InitializeLLVM {
         InitializeLLVM() {
@@ -153,12 +227,6 @@ ClangExpressionParser::ClangExpressionParser (ExecutionContextScope *exe_scope,
 
     m_compiler->createDiagnostics();
 
-    // Create the target instance.
-    m_compiler->setTarget(TargetInfo::CreateTargetInfo(
-        m_compiler->getDiagnostics(), m_compiler->getInvocation().TargetOpts));
-
-    assert (m_compiler->hasTarget());
-
     // 3. Set options.
 
     lldb::LanguageType language = expr.Language();
@@ -235,11 +303,11 @@ ClangExpressionParser::ClangExpressionParser (ExecutionContextScope *exe_scope,
     m_compiler->getDiagnostics().setSeverityForGroup(clang::diag::Flavor::WarningOrError,
         "odr", clang::diag::Severity::Ignored, SourceLocation());
 
-    // Inform the target of the language options
-    //
-    // FIXME: We shouldn't need to do this, the target should be immutable once
-    // created. This complexity should be lifted elsewhere.
-    m_compiler->getTarget().adjust(m_compiler->getLangOpts());
+    // Install the target instance, which has already been adjusted for the
+    // language options if another expression created it.
+    InstallSharedTargetInfo(*m_compiler, language);
+
+    assert (m_compiler->hasTarget());
 
     // 4. Set up the diagnostic buffer for reporting errors
 
@@ -291,11 +359,15 @@ ClangExpressionParser::ClangExpressionParser (ExecutionContextScope *exe_scope,
 
 ClangExpressionParser::~ClangExpressionParser()
 {
+    if (m_compiler)
+        ReleaseSharedTargetInfo(*m_compiler);
 }
 
 unsigned
 ClangExpressionParser::Parse (Stream &stream)
 {
+    Timer scoped_timer (__PRETTY_FUNCTION__, __PRETTY_FUNCTION__);
+
     TextDiagnosticBuffer *diag_buf = static_cast<TextDiagnosticBuffer*>(m_compiler->getDiagnostics().getClient());
 
     diag_buf->FlushDiagnostics (m_compiler->getDiagnostics());
@@ -477,6 +549,13 @@ ClangExpressionParser::PrepareForExecution (lldb::addr_t &func_addr,
 
         can_interpret = IRInterpreter::CanInterpret(*execution_unit_sp->GetModule(), *execution_unit_sp->GetFunction(), interpret_error);
 
+        // Counting these over a test run tells how many expressions avoid the JIT.
+        if (log)
+            log->Printf("Expression %s be interpreted%s%s",
+                        can_interpret ? "can" : "can't",
+                        can_interpret ? "" : ": ",
+                        can_interpret ? "" : interpret_error.AsCString("unknown reason"));
+
         Process *process = exe_ctx.GetProcessPtr();
 
         if (!ir_can_run)
@@ -485,6 +564,8 @@ ClangExpressionParser::PrepareForExecution (lldb::addr_t &func_addr,
             return err;
         }
 
+        m_expr.DidRewriteIR(*execution_unit_sp->GetFunction());
+
         if (!can_interpret && execution_policy == eExecutionPolicyNever)
         {
             err.SetErrorStringWithFormat("Can't run the expression locally: %s", interpret_error.AsCString());
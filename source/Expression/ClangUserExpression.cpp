@@ -8,6 +8,7 @@
 //===----------------------------------------------------------------------===//
 
 #include <stdio.h>
+#include <string.h>
 #if HAVE_SYS_TYPES_H
 #  include <sys/types.h>
 #endif
@@ -50,6 +51,13 @@
 #include "clang/AST/DeclCXX.h"
 #include "clang/AST/DeclObjC.h"
 
+#include "llvm/IR/DataLayout.h"
+#include "llvm/IR/Function.h"
+#include "llvm/IR/Instructions.h"
+#include "llvm/IR/IntrinsicInst.h"
+#include "llvm/IR/Module.h"
+#include "llvm/IR/Operator.h"
+
 using namespace lldb_private;
 
 ClangUserExpression::ClangUserExpression (const char *expr,
@@ -77,7 +85,9 @@ ClangUserExpression::ClangUserExpression (const char *expr,
     m_const_object (false),
     m_target (NULL),
     m_can_interpret (false),
-    m_materialized_address (LLDB_INVALID_ADDRESS)
+    m_materialized_address (LLDB_INVALID_ADDRESS),
+    m_for_injection (false),
+    m_injection_error ()
 {
     switch (m_language)
     {
@@ -601,6 +611,311 @@ ClangUserExpression::Parse (Stream &error_stream,
     }
 }
 
+//----------------------------------------------------------------------
+// Strip casts and constant offsets off a pointer, returning the value
+// it is based on or NULL if part of the offset isn't constant.
+//----------------------------------------------------------------------
+static llvm::Value *
+StripConstantOffsets (llvm::Value *value,
+                      const llvm::DataLayout &data_layout,
+                      uint64_t &offset)
+{
+    offset = 0;
+
+    while (true)
+    {
+        value = value->stripPointerCasts();
+
+        llvm::GEPOperator *gep = llvm::dyn_cast<llvm::GEPOperator>(value);
+
+        if (!gep)
+            return value;
+
+        llvm::APInt gep_offset(data_layout.getPointerSizeInBits(), 0);
+
+        if (!gep->accumulateConstantOffset(data_layout, gep_offset))
+            return NULL;
+
+        offset += gep_offset.getZExtValue();
+        value = gep->getPointerOperand();
+    }
+}
+
+//----------------------------------------------------------------------
+// Return true if the pointer was loaded from the argument struct at the
+// given offset.
+//----------------------------------------------------------------------
+static bool
+IsArgumentSlot (llvm::Value *value,
+                llvm::Argument *arg,
+                const llvm::DataLayout &data_layout,
+                uint64_t slot_offset)
+{
+    uint64_t offset;
+    llvm::Value *base = StripConstantOffsets(value, data_layout, offset);
+    llvm::LoadInst *load = llvm::dyn_cast_or_null<llvm::LoadInst>(base);
+
+    if (!load || offset != 0)
+        return false;
+
+    return StripConstantOffsets(load->getPointerOperand(), data_layout, offset) == arg && offset == slot_offset;
+}
+
+//----------------------------------------------------------------------
+// Return the number of bytes that can be accessed from the start of a
+// stack allocation, or zero if it isn't a constant.
+//----------------------------------------------------------------------
+static uint64_t
+GetAllocaByteSize (llvm::AllocaInst *alloca,
+                   const llvm::DataLayout &data_layout)
+{
+    llvm::ConstantInt *count = llvm::dyn_cast<llvm::ConstantInt>(alloca->getArraySize());
+
+    if (!count)
+        return 0;
+
+    return data_layout.getTypeAllocSize(alloca->getAllocatedType()) * count->getZExtValue();
+}
+
+//----------------------------------------------------------------------
+// Return true if the expression only reads from its own stack, from the
+// argument struct, from the variables the struct points to and from
+// constants, and only writes to its own stack and to its result, and
+// every access is at a constant offset within what it accesses.  Such
+// an expression can't change or crash the inferior.
+//----------------------------------------------------------------------
+static bool
+IsSideEffectFree (llvm::Function &function,
+                  Materializer &materializer,
+                  Error &err)
+{
+    const uint32_t result_offset = materializer.GetResultOffset();
+
+    llvm::Argument *arg = NULL;
+
+    for (llvm::Function::arg_iterator ai = function.arg_begin(), ae = function.arg_end();
+         ai != ae;
+         ++ai)
+    {
+        if (ai->getName().equals("$__lldb_arg"))
+            arg = ai;
+    }
+
+    if (!arg)
+    {
+        err.SetErrorString("the expression takes no argument struct");
+        return false;
+    }
+
+    if (result_offset == UINT32_MAX)
+    {
+        err.SetErrorString("the expression has no result");
+        return false;
+    }
+
+    llvm::DataLayout data_layout(function.getParent());
+
+    for (llvm::Function::iterator bbi = function.begin(), bbe = function.end();
+         bbi != bbe;
+         ++bbi)
+    {
+        for (llvm::BasicBlock::iterator ii = bbi->begin(), ie = bbi->end();
+             ii != ie;
+             ++ii)
+        {
+            llvm::Instruction &inst = *ii;
+
+            if (inst.getType()->isFloatingPointTy() || inst.getType()->isVectorTy())
+            {
+                err.SetErrorString("the expression uses floating point or vector values");
+                return false;
+            }
+
+            switch (inst.getOpcode())
+            {
+            default:
+                break;
+            case llvm::Instruction::UDiv:
+            case llvm::Instruction::SDiv:
+            case llvm::Instruction::URem:
+            case llvm::Instruction::SRem:
+                // Dividing by zero would crash the inferior.
+                if (!llvm::isa<llvm::ConstantInt>(inst.getOperand(1)) ||
+                    llvm::cast<llvm::ConstantInt>(inst.getOperand(1))->isZero())
+                {
+                    err.SetErrorString("the expression divides by a value that may be zero");
+                    return false;
+                }
+                break;
+            }
+
+            if (llvm::LoadInst *load = llvm::dyn_cast<llvm::LoadInst>(&inst))
+            {
+                llvm::Type *type = load->getType();
+
+                if (load->isVolatile() || !(type->isIntegerTy() || type->isPointerTy()))
+                {
+                    err.SetErrorString("the expression loads a value that isn't an integer or a pointer");
+                    return false;
+                }
+
+                uint64_t offset;
+                llvm::Value *base = StripConstantOffsets(load->getPointerOperand(), data_layout, offset);
+
+                if (!base)
+                {
+                    err.SetErrorString("the expression loads from a computed address");
+                    return false;
+                }
+
+                // How many bytes from the start of the base can be read,
+                // or zero if it can't be read at all.
+                uint64_t readable_size = 0;
+
+                if (llvm::AllocaInst *alloca = llvm::dyn_cast<llvm::AllocaInst>(base))
+                {
+                    readable_size = GetAllocaByteSize(alloca, data_layout);
+                }
+                else if (base == arg)
+                {
+                    readable_size = materializer.GetStructByteSize();
+                }
+                else if (llvm::LoadInst *base_load = llvm::dyn_cast<llvm::LoadInst>(base))
+                {
+                    uint64_t slot_offset;
+                    if (StripConstantOffsets(base_load->getPointerOperand(), data_layout, slot_offset) == arg)
+                        readable_size = materializer.GetPointeeByteSize(slot_offset);
+                }
+                else if (llvm::GlobalVariable *global = llvm::dyn_cast<llvm::GlobalVariable>(base))
+                {
+                    if (global->isConstant() && global->hasInitializer())
+                        readable_size = data_layout.getTypeAllocSize(global->getType()->getElementType());
+                }
+
+                if (readable_size == 0)
+                {
+                    err.SetErrorString("the expression loads through a pointer that isn't a variable");
+                    return false;
+                }
+
+                const uint64_t load_size = data_layout.getTypeStoreSize(type);
+
+                if (offset >= readable_size || load_size > readable_size - offset)
+                {
+                    err.SetErrorString("the expression loads from outside a variable");
+                    return false;
+                }
+            }
+            else if (llvm::StoreInst *store = llvm::dyn_cast<llvm::StoreInst>(&inst))
+            {
+                llvm::Type *type = store->getValueOperand()->getType();
+
+                if (store->isVolatile() || !(type->isIntegerTy() || type->isPointerTy()))
+                {
+                    err.SetErrorString("the expression stores a value that isn't an integer or a pointer");
+                    return false;
+                }
+
+                uint64_t offset;
+                llvm::Value *base = StripConstantOffsets(store->getPointerOperand(), data_layout, offset);
+
+                // The result slot holds the location of the result, which
+                // is the only memory outside the stack that may change.
+                uint64_t writable_size = 0;
+
+                if (!base)
+                    writable_size = 0;
+                else if (llvm::AllocaInst *alloca = llvm::dyn_cast<llvm::AllocaInst>(base))
+                    writable_size = GetAllocaByteSize(alloca, data_layout);
+                else if (IsArgumentSlot(store->getPointerOperand(), arg, data_layout, result_offset))
+                    writable_size = materializer.GetPointeeByteSize(result_offset);
+
+                if (writable_size == 0)
+                {
+                    err.SetErrorString("the expression stores to memory other than its result");
+                    return false;
+                }
+
+                const uint64_t store_size = data_layout.getTypeStoreSize(type);
+
+                if (offset >= writable_size || store_size > writable_size - offset)
+                {
+                    err.SetErrorString("the expression stores outside its result or its stack");
+                    return false;
+                }
+            }
+            else if (llvm::CallInst *call = llvm::dyn_cast<llvm::CallInst>(&inst))
+            {
+                llvm::IntrinsicInst *intrinsic = llvm::dyn_cast<llvm::IntrinsicInst>(call);
+
+                if (!intrinsic ||
+                    !(llvm::isa<llvm::DbgInfoIntrinsic>(intrinsic) ||
+                      intrinsic->getIntrinsicID() == llvm::Intrinsic::lifetime_start ||
+                      intrinsic->getIntrinsicID() == llvm::Intrinsic::lifetime_end))
+                {
+                    err.SetErrorString("the expression calls a function");
+                    return false;
+                }
+            }
+            else if (inst.mayReadOrWriteMemory())
+            {
+                err.SetErrorStringWithFormat("the expression contains a '%s' instruction", inst.getOpcodeName());
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+void
+ClangUserExpression::DidRewriteIR (llvm::Function &function)
+{
+    if (!m_for_injection)
+        return;
+
+    m_injection_error.Clear();
+
+    IsSideEffectFree(function, *m_materializer_ap, m_injection_error);
+}
+
+bool
+ClangUserExpression::ParseForInjection (Stream &error_stream,
+                                        ExecutionContext &exe_ctx)
+{
+    m_for_injection = true;
+    m_injection_error.SetErrorString("the expression wasn't compiled");
+
+    if (!Parse (error_stream, exe_ctx, eExecutionPolicyAlways, false, false))
+        return false;
+
+    if (m_cplusplus || m_objectivec)
+    {
+        error_stream.PutCString ("error: the expression needs an object pointer\n");
+        return false;
+    }
+
+    if (!m_materializer_ap->IsFrameIndependent())
+    {
+        error_stream.PutCString ("error: the expression uses locals, registers or persistent variables\n");
+        return false;
+    }
+
+    if (m_jit_start_addr == LLDB_INVALID_ADDRESS)
+    {
+        error_stream.PutCString ("error: the expression wasn't JIT compiled\n");
+        return false;
+    }
+
+    if (!m_injection_error.Success())
+    {
+        error_stream.Printf ("error: %s\n", m_injection_error.AsCString());
+        return false;
+    }
+
+    return true;
+}
+
 static lldb::addr_t
 GetObjectPointer (lldb::StackFrameSP frame_sp,
                   ConstString &object_name,
@@ -760,6 +1075,51 @@ ClangUserExpression::PrepareToExecuteJITExpression (Stream &error_stream,
     return true;
 }
 
+bool
+ClangUserExpression::PrepareForInjection (Stream &error_stream,
+                                          ExecutionContext &exe_ctx,
+                                          lldb::addr_t &function_address,
+                                          lldb::addr_t &struct_address,
+                                          size_t &struct_size,
+                                          uint32_t &result_ptr_offset)
+{
+    if (!m_for_injection || m_jit_start_addr == LLDB_INVALID_ADDRESS)
+    {
+        error_stream.Printf ("The expression wasn't parsed for injection\n");
+        return false;
+    }
+
+    const uint32_t result_offset = m_materializer_ap->GetResultOffset();
+
+    if (result_offset == UINT32_MAX)
+    {
+        error_stream.Printf ("The expression has no result\n");
+        return false;
+    }
+
+    // Each call copies the struct to a 16 byte aligned stack.
+    if (m_materializer_ap->GetStructAlignment() > 16)
+    {
+        error_stream.Printf ("The argument struct is too strictly aligned\n");
+        return false;
+    }
+
+    // The struct has to live in the inferior, which calls the function.
+    m_can_interpret = false;
+
+    lldb::addr_t object_ptr = 0;
+    lldb::addr_t cmd_ptr = 0;
+
+    if (!PrepareToExecuteJITExpression (error_stream, exe_ctx, struct_address, object_ptr, cmd_ptr))
+        return false;
+
+    function_address = m_jit_start_addr;
+    struct_size = m_materializer_ap->GetStructByteSize();
+    result_ptr_offset = result_offset;
+
+    return true;
+}
+
 bool
 ClangUserExpression::FinalizeJITExecution (Stream &error_stream,
                                            ExecutionContext &exe_ctx,
@@ -976,6 +1336,68 @@ ClangUserExpression::Execute (Stream &error_stream,
     }
 }
 
+//------------------------------------------------------------------
+// Make the key a compiled expression is cached under in the target.
+// Besides the expression and what it is parsed with, this includes the
+// innermost lexical scope of the frame, which decides what the names in
+// the expression refer to. Code and variable locations are looked up
+// again each time the expression is materialized, so any pc in that
+// scope will do. Returns false if the expression shouldn't be cached.
+//------------------------------------------------------------------
+static bool
+GetUserExpressionCacheKey (ExecutionContext &exe_ctx,
+                           const char *expr_cstr,
+                           const char *expr_prefix,
+                           lldb::LanguageType language,
+                           ClangExpression::ResultType desired_type,
+                           lldb_private::ExecutionPolicy execution_policy,
+                           bool generate_debug_info,
+                           std::string &key)
+{
+    // Expressions with debug info add their own module to the target,
+    // and persistent variables and types can be redefined between
+    // evaluations, so always compile those afresh.
+    if (generate_debug_info ||
+        ::strchr (expr_cstr, '$') ||
+        (expr_prefix && ::strchr (expr_prefix, '$')))
+        return false;
+
+    Process *process = exe_ctx.GetProcessPtr();
+    if (process == NULL)
+        return false;
+
+    const void *scope = NULL;
+    StackFrame *frame = exe_ctx.GetFramePtr();
+    if (frame)
+    {
+        const SymbolContext &sc = frame->GetSymbolContext (lldb::eSymbolContextModule   |
+                                                           lldb::eSymbolContextFunction |
+                                                           lldb::eSymbolContextBlock    |
+                                                           lldb::eSymbolContextSymbol);
+        if (sc.block)
+            scope = sc.block;
+        else if (sc.function)
+            scope = sc.function;
+        else if (sc.symbol)
+            scope = sc.symbol;
+        else
+            return false;
+    }
+
+    StreamString key_strm;
+    key_strm.Printf ("%u:%u:%u:%u:%p:%s",
+                     process->GetUniqueID(),
+                     (uint32_t)language,
+                     (uint32_t)desired_type,
+                     (uint32_t)execution_policy,
+                     scope,
+                     expr_prefix ? expr_prefix : "");
+    key = key_strm.GetString();
+    key.append (1, '\0');
+    key.append (expr_cstr);
+    return true;
+}
+
 lldb::ExpressionResults
 ClangUserExpression::Evaluate (ExecutionContext &exe_ctx,
                                const EvaluateExpressionOptions& options,
@@ -1009,28 +1431,60 @@ ClangUserExpression::Evaluate (ExecutionContext &exe_ctx,
     if (process == NULL || !process->CanJIT())
         execution_policy = eExecutionPolicyNever;
 
-    ClangUserExpressionSP user_expression_sp (new ClangUserExpression (expr_cstr, expr_prefix, language, desired_type));
-
     StreamString error_stream;
 
-    if (log)
-        log->Printf("== [ClangUserExpression::Evaluate] Parsing expression %s ==", expr_cstr);
-
     const bool keep_expression_in_memory = true;
     const bool generate_debug_info = options.GetGenerateDebugInfo();
 
+    Target *target = exe_ctx.GetTargetPtr();
+    std::string cache_key;
+    const bool use_cache = target && target->GetExpressionCacheSize() > 0 &&
+                           GetUserExpressionCacheKey (exe_ctx,
+                                                      expr_cstr,
+                                                      expr_prefix,
+                                                      language,
+                                                      desired_type,
+                                                      execution_policy,
+                                                      generate_debug_info,
+                                                      cache_key);
+
+    ClangUserExpressionSP user_expression_sp;
+    if (use_cache)
+        user_expression_sp = target->TakeCachedUserExpression (cache_key);
+
     if (options.InvokeCancelCallback (lldb::eExpressionEvaluationParse))
     {
+        if (user_expression_sp)
+            target->CacheUserExpression (cache_key, user_expression_sp);
         error.SetErrorString ("expression interrupted by callback before parse");
         result_valobj_sp = ValueObjectConstResult::Create (exe_ctx.GetBestExecutionContextScope(), error);
         return lldb::eExpressionInterrupted;
     }
 
-    if (!user_expression_sp->Parse (error_stream,
-                                    exe_ctx,
-                                    execution_policy,
-                                    keep_expression_in_memory,
-                                    generate_debug_info))
+    bool parsed = false;
+    if (user_expression_sp)
+    {
+        if (log)
+            log->Printf("== [ClangUserExpression::Evaluate] Reusing compiled expression %s ==", expr_cstr);
+
+        // It was compiled in the same scope, but maybe not at this pc.
+        user_expression_sp->InstallContext (exe_ctx);
+        parsed = true;
+    }
+    else
+    {
+        if (log)
+            log->Printf("== [ClangUserExpression::Evaluate] Parsing expression %s ==", expr_cstr);
+
+        user_expression_sp.reset (new ClangUserExpression (expr_cstr, expr_prefix, language, desired_type));
+        parsed = user_expression_sp->Parse (error_stream,
+                                            exe_ctx,
+                                            execution_policy,
+                                            keep_expression_in_memory,
+                                            generate_debug_info);
+    }
+
+    if (!parsed)
     {
         if (error_stream.GetString().empty())
             error.SetExpressionError (lldb::eExpressionParseError, "expression failed to parse, unknown error");
@@ -1102,6 +1556,11 @@ ClangUserExpression::Evaluate (ExecutionContext &exe_ctx,
 
                     error.SetError(ClangUserExpression::kNoResult, lldb::eErrorTypeGeneric);
                 }
+
+                // Only expressions that ran to completion are left in a state
+                // where they can run again.
+                if (use_cache)
+                    target->CacheUserExpression (cache_key, user_expression_sp);
             }
         }
     }
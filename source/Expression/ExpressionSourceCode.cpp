@@ -43,17 +43,30 @@ typedef __PTRDIFF_TYPE__ ptrdiff_t;
 typedef unsigned short unichar;
 )";
 
+//----------------------------------------------------------------------
+// The prefix every wrapped expression starts with only depends on how the
+// target spells BOOL, so both variants are put together once rather than
+// for every expression.
+//----------------------------------------------------------------------
+static const std::string &
+GetExpressionPrefix (bool bool_is_builtin)
+{
+    static const std::string g_signed_char_bool_prefix (std::string(ExpressionSourceCode::g_expression_prefix) + "typedef signed char BOOL;\n");
+    static const std::string g_builtin_bool_prefix (std::string(ExpressionSourceCode::g_expression_prefix) + "typedef bool BOOL;\n");
+
+    return bool_is_builtin ? g_builtin_bool_prefix : g_signed_char_bool_prefix;
+}
 
 bool ExpressionSourceCode::GetText (std::string &text, lldb::LanguageType wrapping_language, bool const_object, bool static_method, ExecutionContext &exe_ctx) const
 {
-    const char *target_specific_defines = "typedef signed char BOOL;\n";
+    bool bool_is_builtin = false;
     static ConstString g_platform_ios_simulator ("PlatformiOSSimulator");
     
     if (Target *target = exe_ctx.GetTargetPtr())
     {
         if (target->GetArchitecture().GetMachine() == llvm::Triple::aarch64)
         {
-            target_specific_defines = "typedef bool BOOL;\n";
+            bool_is_builtin = true;
         }
         if (target->GetArchitecture().GetMachine() == llvm::Triple::x86_64)
         {
@@ -61,12 +74,14 @@ bool ExpressionSourceCode::GetText (std::string &text, lldb::LanguageType wrappi
             {
                 if (platform_sp->GetPluginName() == g_platform_ios_simulator)
                 {
-                    target_specific_defines = "typedef bool BOOL;\n";
+                    bool_is_builtin = true;
                 }
             }
         }
     }
     
+    const char *expression_prefix = GetExpressionPrefix(bool_is_builtin).c_str();
+    
     if (m_wrap)
     {
         switch (wrapping_language) 
@@ -87,30 +102,26 @@ bool ExpressionSourceCode::GetText (std::string &text, lldb::LanguageType wrappi
             break;
         case lldb::eLanguageTypeC:
             wrap_stream.Printf("%s                             \n"
-                               "%s                             \n"
                                "%s                             \n"
                                "void                           \n"
                                "%s(void *$__lldb_arg)          \n"
                                "{                              \n"
                                "    %s;                        \n" 
                                "}                              \n",
-                               g_expression_prefix,
-                               target_specific_defines,
+                               expression_prefix,
                                m_prefix.c_str(),
                                m_name.c_str(),
                                m_body.c_str());
             break;
         case lldb::eLanguageTypeC_plus_plus:
             wrap_stream.Printf("%s                                     \n"
-                               "%s                                     \n"
                                "%s                                     \n"
                                "void                                   \n"
                                "$__lldb_class::%s(void *$__lldb_arg) %s\n"
                                "{                                      \n"
                                "    %s;                                \n" 
                                "}                                      \n",
-                               g_expression_prefix,
-                               target_specific_defines,
+                               expression_prefix,
                                m_prefix.c_str(),
                                m_name.c_str(),
                                (const_object ? "const" : ""),
@@ -120,7 +131,6 @@ bool ExpressionSourceCode::GetText (std::string &text, lldb::LanguageType wrappi
             if (static_method)
             {
                 wrap_stream.Printf("%s                                                      \n"
-                                   "%s                                                      \n"
                                    "%s                                                      \n"
                                    "@interface $__lldb_objc_class ($__lldb_category)        \n"
                                    "+(void)%s:(void *)$__lldb_arg;                          \n"
@@ -131,8 +141,7 @@ bool ExpressionSourceCode::GetText (std::string &text, lldb::LanguageType wrappi
                                    "    %s;                                                 \n"
                                    "}                                                       \n"
                                    "@end                                                    \n",
-                                   g_expression_prefix,
-                                   target_specific_defines,
+                                   expression_prefix,
                                    m_prefix.c_str(),
                                    m_name.c_str(),
                                    m_name.c_str(),
@@ -141,7 +150,6 @@ bool ExpressionSourceCode::GetText (std::string &text, lldb::LanguageType wrappi
             else
             {
                 wrap_stream.Printf("%s                                                     \n"
-                                   "%s                                                     \n"
                                    "%s                                                     \n"
                                    "@interface $__lldb_objc_class ($__lldb_category)       \n"
                                    "-(void)%s:(void *)$__lldb_arg;                         \n"
@@ -152,8 +160,7 @@ bool ExpressionSourceCode::GetText (std::string &text, lldb::LanguageType wrappi
                                    "    %s;                                                \n"
                                    "}                                                      \n"
                                    "@end                                                   \n",
-                                   g_expression_prefix,
-                                   target_specific_defines,
+                                   expression_prefix,
                                    m_prefix.c_str(),
                                    m_name.c_str(),
                                    m_name.c_str(),
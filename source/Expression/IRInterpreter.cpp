@@ -20,11 +20,15 @@
 #include "llvm/IR/DataLayout.h"
 #include "llvm/IR/Function.h"
 #include "llvm/IR/Instructions.h"
+#include "llvm/IR/IntrinsicInst.h"
 #include "llvm/IR/Intrinsics.h"
 #include "llvm/IR/Module.h"
 #include "llvm/Support/raw_ostream.h"
 
+#include <math.h>
+#include <string.h>
 #include <map>
+#include <vector>
 
 using namespace llvm;
 
@@ -82,6 +86,77 @@ CanIgnoreCall (const CallInst *call)
     return false;
 }
 
+static bool
+IsMemoryIntrinsic (const CallInst *call)
+{
+    const llvm::Function *called_function = call->getCalledFunction();
+
+    if (!called_function || !called_function->isIntrinsic())
+        return false;
+
+    switch (called_function->getIntrinsicID())
+    {
+    default:
+        return false;
+    case llvm::Intrinsic::memcpy:
+    case llvm::Intrinsic::memmove:
+    case llvm::Intrinsic::memset:
+        return true;
+    }
+}
+
+// Floating point values are computed on the host, so only the IEEE types
+// the host has too can be interpreted.
+static bool
+IsSupportedType (const Type *type)
+{
+    switch (type->getTypeID())
+    {
+    default:
+        return true;
+    case Type::VectorTyID:
+    case Type::HalfTyID:
+    case Type::X86_FP80TyID:
+    case Type::FP128TyID:
+    case Type::PPC_FP128TyID:
+    case Type::X86_MMXTyID:
+        return false;
+    }
+}
+
+// The raw data of a ConstantDataSequential is in host byte order, so it
+// can only be copied to the target as is if the target has the host's byte
+// order or the elements are single bytes.
+static bool
+CanResolveConstantData (const Constant *constant, bool host_byte_order)
+{
+    if (host_byte_order)
+        return true;
+
+    if (const ConstantDataSequential *constant_data = dyn_cast<ConstantDataSequential>(constant))
+        return constant_data->getElementByteSize() <= 1;
+
+    if (isa<ConstantStruct>(constant) || isa<ConstantArray>(constant))
+    {
+        for (unsigned oi = 0, oe = constant->getNumOperands(); oi != oe; ++oi)
+        {
+            if (!CanResolveConstantData(cast<Constant>(constant->getOperand(oi)), host_byte_order))
+                return false;
+        }
+    }
+
+    return true;
+}
+
+static int64_t
+SignExtend (uint64_t value, unsigned bit_width)
+{
+    if (bit_width == 0 || bit_width >= 64)
+        return (int64_t)value;
+    const unsigned shift = 64 - bit_width;
+    return ((int64_t)(value << shift)) >> shift;
+}
+
 class InterpreterStackFrame
 {
 public:
@@ -91,6 +166,7 @@ public:
     DataLayout                             &m_target_data;
     lldb_private::IRMemoryMap              &m_memory_map;
     const BasicBlock                       *m_bb;
+    const BasicBlock                       *m_prev_bb;    // The block we jumped to m_bb from, for PHI nodes
     BasicBlock::const_iterator              m_ii;
     BasicBlock::const_iterator              m_ie;
 
@@ -106,7 +182,9 @@ public:
                            lldb::addr_t stack_frame_bottom,
                            lldb::addr_t stack_frame_top) :
         m_target_data (target_data),
-        m_memory_map (memory_map)
+        m_memory_map (memory_map),
+        m_bb (NULL),
+        m_prev_bb (NULL)
     {
         m_byte_order = (target_data.isLittleEndian() ? lldb::eByteOrderLittle : lldb::eByteOrderBig);
         m_addr_byte_size = (target_data.getPointerSize(0));
@@ -122,6 +200,7 @@ public:
 
     void Jump (const BasicBlock *bb)
     {
+        m_prev_bb = m_bb;
         m_bb = bb;
         m_ii = m_bb->begin();
         m_ie = m_bb->end();
@@ -235,6 +314,114 @@ public:
         return write_error.Success();
     }
 
+    // Floating point values are handled as doubles, which represent every
+    // float exactly.  Rounding a float operation done in double back to float
+    // gives the same result as doing it in float.
+    bool EvaluateFloat (double &result, const Value *value, Module &module)
+    {
+        lldb_private::Scalar bits;
+
+        if (!EvaluateValue(bits, value, module))
+            return false;
+
+        const uint64_t raw_bits = bits.ULongLong();
+
+        if (value->getType()->isFloatTy())
+        {
+            const uint32_t float_bits = (uint32_t)raw_bits;
+            float float_value;
+            ::memcpy(&float_value, &float_bits, sizeof(float_value));
+            result = float_value;
+            return true;
+        }
+        else if (value->getType()->isDoubleTy())
+        {
+            ::memcpy(&result, &raw_bits, sizeof(result));
+            return true;
+        }
+
+        return false;
+    }
+
+    bool AssignFloat (const Value *value, double float_value, Module &module)
+    {
+        lldb_private::Scalar bits;
+
+        if (value->getType()->isFloatTy())
+        {
+            const float narrow_value = (float)float_value;
+            uint32_t float_bits;
+            ::memcpy(&float_bits, &narrow_value, sizeof(float_bits));
+            bits = float_bits;
+        }
+        else if (value->getType()->isDoubleTy())
+        {
+            uint64_t double_bits;
+            ::memcpy(&double_bits, &float_value, sizeof(double_bits));
+            bits = double_bits;
+        }
+        else
+        {
+            return false;
+        }
+
+        return AssignValue(value, bits, module);
+    }
+
+    // Copy the bytes of one value to another, of any type.
+    bool CopyValue (const Value *to, lldb::addr_t to_offset, const Value *from, lldb::addr_t from_offset, size_t size, Module &module)
+    {
+        lldb::addr_t to_address = ResolveValue(to, module);
+        lldb::addr_t from_address = ResolveValue(from, module);
+
+        if (to_address == LLDB_INVALID_ADDRESS || from_address == LLDB_INVALID_ADDRESS)
+            return false;
+
+        if (size == 0)
+            return true;
+
+        lldb_private::DataBufferHeap buffer(size, 0);
+        lldb_private::Error error;
+
+        m_memory_map.ReadMemory(buffer.GetBytes(), from_address + from_offset, size, error);
+
+        if (!error.Success())
+            return false;
+
+        m_memory_map.WriteMemory(to_address + to_offset, buffer.GetBytes(), size, error);
+
+        return error.Success();
+    }
+
+    // Find where the member selected by the indices of an extractvalue or
+    // insertvalue is in an aggregate of the given type.
+    bool GetAggregateOffset (Type *type, ArrayRef<unsigned> indices, uint64_t &offset)
+    {
+        offset = 0;
+
+        for (ArrayRef<unsigned>::iterator ii = indices.begin(), ie = indices.end();
+             ii != ie;
+             ++ii)
+        {
+            if (StructType *struct_type = dyn_cast<StructType>(type))
+            {
+                offset += m_target_data.getStructLayout(struct_type)->getElementOffset(*ii);
+                type = struct_type->getElementType(*ii);
+            }
+            else if (ArrayType *array_type = dyn_cast<ArrayType>(type))
+            {
+                type = array_type->getElementType();
+                offset += *ii * m_target_data.getTypeAllocSize(type);
+            }
+            else
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
     bool ResolveConstantValue (APInt &value, const Constant *constant)
     {
         switch (constant->getValueID())
@@ -341,6 +528,58 @@ public:
 
     bool ResolveConstant (lldb::addr_t process_address, const Constant *constant)
     {
+        if (isa<ConstantAggregateZero>(constant) || isa<UndefValue>(constant))
+        {
+            size_t constant_size = m_target_data.getTypeStoreSize(constant->getType());
+            lldb_private::DataBufferHeap zeroes(constant_size, 0);
+            lldb_private::Error write_error;
+
+            if (constant_size)
+                m_memory_map.WriteMemory(process_address, zeroes.GetBytes(), constant_size, write_error);
+
+            return write_error.Success();
+        }
+
+        if (const ConstantStruct *constant_struct = dyn_cast<ConstantStruct>(constant))
+        {
+            const StructLayout *struct_layout = m_target_data.getStructLayout(constant_struct->getType());
+
+            for (unsigned oi = 0, oe = constant_struct->getNumOperands(); oi != oe; ++oi)
+            {
+                if (!ResolveConstant(process_address + struct_layout->getElementOffset(oi), constant_struct->getOperand(oi)))
+                    return false;
+            }
+
+            return true;
+        }
+
+        if (const ConstantArray *constant_array = dyn_cast<ConstantArray>(constant))
+        {
+            const uint64_t element_size = m_target_data.getTypeAllocSize(constant_array->getType()->getElementType());
+
+            for (unsigned oi = 0, oe = constant_array->getNumOperands(); oi != oe; ++oi)
+            {
+                if (!ResolveConstant(process_address + oi * element_size, constant_array->getOperand(oi)))
+                    return false;
+            }
+
+            return true;
+        }
+
+        if (const ConstantDataSequential *constant_data = dyn_cast<ConstantDataSequential>(constant))
+        {
+            // The raw data is in host byte order
+            if (m_byte_order != lldb::endian::InlHostByteOrder() && constant_data->getElementByteSize() > 1)
+                return false;
+
+            StringRef raw_data = constant_data->getRawDataValues();
+            lldb_private::Error write_error;
+
+            m_memory_map.WriteMemory(process_address, (const uint8_t*)raw_data.data(), raw_data.size(), write_error);
+
+            return write_error.Success();
+        }
+
         APInt resolved_value;
 
         if (!ResolveConstantValue(resolved_value, constant))
@@ -450,6 +689,10 @@ static const char *memory_allocation_error          = "Interpreter couldn't allo
 static const char *memory_write_error               = "Interpreter couldn't write to memory";
 static const char *memory_read_error                = "Interpreter couldn't read from memory";
 static const char *infinite_loop_error              = "Interpreter ran for too many cycles";
+static const char *conversion_range_error           = "Interpreter can't convert a floating point value that doesn't fit in an integer";
+
+// Loops are interpreted too, but only for so long
+static const uint32_t max_interpreted_instructions  = 64 * 1024;
 //static const char *bad_result_error                 = "Result of expression is in bad memory";
 
 bool
@@ -459,6 +702,10 @@ IRInterpreter::CanInterpret (llvm::Module &module,
 {
     lldb_private::Log *log(lldb_private::GetLogIfAllCategoriesSet (LIBLLDB_LOG_EXPRESSIONS));
 
+    DataLayout target_data(&module);
+    const lldb::ByteOrder byte_order = (target_data.isLittleEndian() ? lldb::eByteOrderLittle : lldb::eByteOrderBig);
+    const bool host_byte_order = (byte_order == lldb::endian::InlHostByteOrder());
+
     bool saw_function_with_body = false;
 
     for (Module::iterator fi = module.begin(), fe = module.end();
@@ -507,7 +754,7 @@ IRInterpreter::CanInterpret (llvm::Module &module,
                         return false;
                     }
 
-                    if (!CanIgnoreCall(call_inst))
+                    if (!CanIgnoreCall(call_inst) && !IsMemoryIntrinsic(call_inst))
                     {
                         if (log)
                             log->Printf("Unsupported instruction: %s", PrintValue(ii).c_str());
@@ -575,9 +822,34 @@ IRInterpreter::CanInterpret (llvm::Module &module,
             case Instruction::URem:
             case Instruction::Xor:
             case Instruction::ZExt:
+            case Instruction::ExtractValue:
+            case Instruction::FAdd:
+            case Instruction::FCmp:
+            case Instruction::FDiv:
+            case Instruction::FMul:
+            case Instruction::FPExt:
+            case Instruction::FPToSI:
+            case Instruction::FPToUI:
+            case Instruction::FPTrunc:
+            case Instruction::FRem:
+            case Instruction::FSub:
+            case Instruction::InsertValue:
+            case Instruction::PHI:
+            case Instruction::Select:
+            case Instruction::SIToFP:
+            case Instruction::Switch:
+            case Instruction::UIToFP:
                 break;
             }
 
+            if (!IsSupportedType(ii->getType()))
+            {
+                if (log)
+                    log->Printf("Unsupported result type: %s", PrintType(ii->getType()).c_str());
+                error.SetErrorString(unsupported_operand_error);
+                return false;
+            }
+
             for (int oi = 0, oe = ii->getNumOperands();
                  oi != oe;
                  ++oi)
@@ -585,17 +857,22 @@ IRInterpreter::CanInterpret (llvm::Module &module,
                 Value *operand = ii->getOperand(oi);
                 Type *operand_type = operand->getType();
 
-                switch (operand_type->getTypeID())
+                if (!IsSupportedType(operand_type))
                 {
-                default:
-                    break;
-                case Type::VectorTyID:
-                    {
-                        if (log)
-                            log->Printf("Unsupported operand type: %s", PrintType(operand_type).c_str());
-                        error.SetErrorString(unsupported_operand_error);
-                        return false;
-                    }
+                    if (log)
+                        log->Printf("Unsupported operand type: %s", PrintType(operand_type).c_str());
+                    error.SetErrorString(unsupported_operand_error);
+                    return false;
+                }
+
+                const Constant *constant = dyn_cast<Constant>(operand);
+
+                if (constant && !CanResolveConstantData(constant, host_byte_order))
+                {
+                    if (log)
+                        log->Printf("Constant data in the wrong byte order: %s", PrintValue(constant).c_str());
+                    error.SetErrorString(unsupported_operand_error);
+                    return false;
                 }
             }
         }
@@ -657,7 +934,7 @@ IRInterpreter::Interpret (llvm::Module &module,
 
     frame.Jump(function.begin());
 
-    while (frame.m_ii != frame.m_ie && (++num_insts < 4096))
+    while (frame.m_ii != frame.m_ie && (++num_insts < max_interpreted_instructions))
     {
         const Instruction *inst = frame.m_ii;
 
@@ -681,7 +958,12 @@ IRInterpreter::Interpret (llvm::Module &module,
                     return false;
                 }
 
-                if (!CanIgnoreCall(call_inst))
+                if (CanIgnoreCall(call_inst))
+                    break;
+
+                const MemIntrinsic *mem_inst = dyn_cast<MemIntrinsic>(call_inst);
+
+                if (!mem_inst)
                 {
                     if (log)
                         log->Printf("The interpreter shouldn't have accepted %s", PrintValue(call_inst).c_str());
@@ -689,6 +971,90 @@ IRInterpreter::Interpret (llvm::Module &module,
                     error.SetErrorString(interpreter_internal_error);
                     return false;
                 }
+
+                // The semantics of memcpy, memmove and memset are:
+                //   Fill a buffer B of the given length from the source region, or with the value
+                //   Transfer B to the destination region
+
+                lldb_private::Scalar D;
+                lldb_private::Scalar L;
+
+                if (!frame.EvaluateValue(D, mem_inst->getRawDest(), module) ||
+                    !frame.EvaluateValue(L, mem_inst->getLength(), module))
+                {
+                    if (log)
+                        log->Printf("Couldn't evaluate the operands of %s", PrintValue(mem_inst).c_str());
+                    error.SetErrorToGenericError();
+                    error.SetErrorString(bad_value_error);
+                    return false;
+                }
+
+                const size_t length = L.ULongLong();
+
+                if (length == 0)
+                    break;
+
+                lldb_private::DataBufferHeap buffer(length, 0);
+
+                if (const MemTransferInst *transfer_inst = dyn_cast<MemTransferInst>(mem_inst))
+                {
+                    lldb_private::Scalar S;
+
+                    if (!frame.EvaluateValue(S, transfer_inst->getRawSource(), module))
+                    {
+                        if (log)
+                            log->Printf("Couldn't evaluate %s", PrintValue(transfer_inst->getRawSource()).c_str());
+                        error.SetErrorToGenericError();
+                        error.SetErrorString(bad_value_error);
+                        return false;
+                    }
+
+                    lldb_private::Error read_error;
+                    memory_map.ReadMemory(buffer.GetBytes(), S.ULongLong(), length, read_error);
+
+                    if (!read_error.Success())
+                    {
+                        if (log)
+                            log->Printf("Couldn't read from a region on behalf of %s", PrintValue(mem_inst).c_str());
+                        error.SetErrorToGenericError();
+                        error.SetErrorString(memory_read_error);
+                        return false;
+                    }
+                }
+                else if (const MemSetInst *set_inst = dyn_cast<MemSetInst>(mem_inst))
+                {
+                    lldb_private::Scalar V;
+
+                    if (!frame.EvaluateValue(V, set_inst->getValue(), module))
+                    {
+                        if (log)
+                            log->Printf("Couldn't evaluate %s", PrintValue(set_inst->getValue()).c_str());
+                        error.SetErrorToGenericError();
+                        error.SetErrorString(bad_value_error);
+                        return false;
+                    }
+
+                    ::memset(buffer.GetBytes(), (int)(V.ULongLong() & 0xff), length);
+                }
+
+                lldb_private::Error write_error;
+                memory_map.WriteMemory(D.ULongLong(), buffer.GetBytes(), length, write_error);
+
+                if (!write_error.Success())
+                {
+                    if (log)
+                        log->Printf("Couldn't write to a region on behalf of %s", PrintValue(mem_inst).c_str());
+                    error.SetErrorToGenericError();
+                    error.SetErrorString(memory_write_error);
+                    return false;
+                }
+
+                if (log)
+                {
+                    log->Printf("Interpreted a %s", PrintValue(mem_inst).c_str());
+                    log->Printf("  D : 0x%" PRIx64, (uint64_t)D.ULongLong());
+                    log->Printf("  L : %" PRIu64, (uint64_t)length);
+                }
             }
                 break;
             case Instruction::Add:
@@ -1376,6 +1742,506 @@ IRInterpreter::Interpret (llvm::Module &module,
                 }
             }
                 break;
+            case Instruction::FAdd:
+            case Instruction::FSub:
+            case Instruction::FMul:
+            case Instruction::FDiv:
+            case Instruction::FRem:
+            {
+                Value *lhs = inst->getOperand(0);
+                Value *rhs = inst->getOperand(1);
+
+                double L;
+                double R;
+
+                if (!frame.EvaluateFloat(L, lhs, module))
+                {
+                    if (log)
+                        log->Printf("Couldn't evaluate %s", PrintValue(lhs).c_str());
+                    error.SetErrorToGenericError();
+                    error.SetErrorString(bad_value_error);
+                    return false;
+                }
+
+                if (!frame.EvaluateFloat(R, rhs, module))
+                {
+                    if (log)
+                        log->Printf("Couldn't evaluate %s", PrintValue(rhs).c_str());
+                    error.SetErrorToGenericError();
+                    error.SetErrorString(bad_value_error);
+                    return false;
+                }
+
+                double result = 0;
+
+                switch (inst->getOpcode())
+                {
+                    default:
+                        break;
+                    case Instruction::FAdd:
+                        result = L + R;
+                        break;
+                    case Instruction::FSub:
+                        result = L - R;
+                        break;
+                    case Instruction::FMul:
+                        result = L * R;
+                        break;
+                    case Instruction::FDiv:
+                        result = L / R;
+                        break;
+                    case Instruction::FRem:
+                        result = ::fmod(L, R);
+                        break;
+                }
+
+                if (!frame.AssignFloat(inst, result, module))
+                {
+                    if (log)
+                        log->Printf("Couldn't assign the result of %s", PrintValue(inst).c_str());
+                    error.SetErrorToGenericError();
+                    error.SetErrorString(memory_write_error);
+                    return false;
+                }
+
+                if (log)
+                {
+                    log->Printf("Interpreted a %s", inst->getOpcodeName());
+                    log->Printf("  L : %s", frame.SummarizeValue(lhs).c_str());
+                    log->Printf("  R : %s", frame.SummarizeValue(rhs).c_str());
+                    log->Printf("  = : %s", frame.SummarizeValue(inst).c_str());
+                }
+            }
+                break;
+            case Instruction::FCmp:
+            {
+                const FCmpInst *fcmp_inst = dyn_cast<FCmpInst>(inst);
+
+                if (!fcmp_inst)
+                {
+                    if (log)
+                        log->Printf("getOpcode() returns FCmp, but instruction is not an FCmpInst");
+                    error.SetErrorToGenericError();
+                    error.SetErrorString(interpreter_internal_error);
+                    return false;
+                }
+
+                Value *lhs = inst->getOperand(0);
+                Value *rhs = inst->getOperand(1);
+
+                double L;
+                double R;
+
+                if (!frame.EvaluateFloat(L, lhs, module) || !frame.EvaluateFloat(R, rhs, module))
+                {
+                    if (log)
+                        log->Printf("Couldn't evaluate the operands of %s", PrintValue(inst).c_str());
+                    error.SetErrorToGenericError();
+                    error.SetErrorString(bad_value_error);
+                    return false;
+                }
+
+                const bool unordered = isnan(L) || isnan(R);
+                bool compare_result = false;
+
+                switch (fcmp_inst->getPredicate())
+                {
+                    default:
+                        error.SetErrorToGenericError();
+                        error.SetErrorString(unsupported_opcode_error);
+                        return false;
+                    case CmpInst::FCMP_FALSE:   compare_result = false;                  break;
+                    case CmpInst::FCMP_TRUE:    compare_result = true;                   break;
+                    case CmpInst::FCMP_ORD:     compare_result = !unordered;             break;
+                    case CmpInst::FCMP_UNO:     compare_result = unordered;              break;
+                    case CmpInst::FCMP_OEQ:     compare_result = !unordered && L == R;   break;
+                    case CmpInst::FCMP_OGT:     compare_result = !unordered && L > R;    break;
+                    case CmpInst::FCMP_OGE:     compare_result = !unordered && L >= R;   break;
+                    case CmpInst::FCMP_OLT:     compare_result = !unordered && L < R;    break;
+                    case CmpInst::FCMP_OLE:     compare_result = !unordered && L <= R;   break;
+                    case CmpInst::FCMP_ONE:     compare_result = !unordered && L != R;   break;
+                    case CmpInst::FCMP_UEQ:     compare_result = unordered || L == R;    break;
+                    case CmpInst::FCMP_UGT:     compare_result = unordered || L > R;     break;
+                    case CmpInst::FCMP_UGE:     compare_result = unordered || L >= R;    break;
+                    case CmpInst::FCMP_ULT:     compare_result = unordered || L < R;     break;
+                    case CmpInst::FCMP_ULE:     compare_result = unordered || L <= R;    break;
+                    case CmpInst::FCMP_UNE:     compare_result = unordered || L != R;    break;
+                }
+
+                lldb_private::Scalar result;
+                result = compare_result ? 1 : 0;
+
+                frame.AssignValue(inst, result, module);
+
+                if (log)
+                {
+                    log->Printf("Interpreted an FCmpInst");
+                    log->Printf("  L : %s", frame.SummarizeValue(lhs).c_str());
+                    log->Printf("  R : %s", frame.SummarizeValue(rhs).c_str());
+                    log->Printf("  = : %s", frame.SummarizeValue(inst).c_str());
+                }
+            }
+                break;
+            case Instruction::FPExt:
+            case Instruction::FPTrunc:
+            case Instruction::FPToSI:
+            case Instruction::FPToUI:
+            case Instruction::SIToFP:
+            case Instruction::UIToFP:
+            {
+                const CastInst *cast_inst = dyn_cast<CastInst>(inst);
+
+                if (!cast_inst)
+                {
+                    if (log)
+                        log->Printf("getOpcode() returns %s, but instruction is not a CastInst", inst->getOpcodeName());
+                    error.SetErrorToGenericError();
+                    error.SetErrorString(interpreter_internal_error);
+                    return false;
+                }
+
+                Value *source = cast_inst->getOperand(0);
+
+                bool evaluated = false;
+                bool assigned = false;
+
+                switch (inst->getOpcode())
+                {
+                    default:
+                        break;
+                    case Instruction::FPExt:
+                    case Instruction::FPTrunc:
+                    {
+                        double F;
+                        evaluated = frame.EvaluateFloat(F, source, module);
+                        if (evaluated)
+                            assigned = frame.AssignFloat(inst, F, module);
+                    }
+                        break;
+                    case Instruction::FPToSI:
+                    case Instruction::FPToUI:
+                    {
+                        double F;
+                        evaluated = frame.EvaluateFloat(F, source, module);
+                        if (evaluated)
+                        {
+                            // Converting a value that the integer can't hold is
+                            // undefined on the host as well as in the IR, so
+                            // refuse NaNs and values out of range.  Negative
+                            // values converted to unsigned go through int64_t
+                            // like FPToSI does.
+                            const double two_to_the_63 = 9223372036854775808.0;
+                            const bool is_unsigned = inst->getOpcode() == Instruction::FPToUI;
+                            lldb_private::Scalar I;
+                            if (F >= -two_to_the_63 && F < two_to_the_63)
+                                I = (uint64_t)(int64_t)F;
+                            else if (is_unsigned && F >= two_to_the_63 && F < 2 * two_to_the_63)
+                                I = (uint64_t)F;
+                            else
+                            {
+                                if (log)
+                                    log->Printf("%s doesn't fit in the result of %s", PrintValue(source).c_str(), PrintValue(inst).c_str());
+                                error.SetErrorToGenericError();
+                                error.SetErrorString(conversion_range_error);
+                                return false;
+                            }
+                            // Assigning truncates the result to the destination type
+                            assigned = frame.AssignValue(inst, I, module);
+                        }
+                    }
+                        break;
+                    case Instruction::SIToFP:
+                    case Instruction::UIToFP:
+                    {
+                        lldb_private::Scalar I;
+                        evaluated = frame.EvaluateValue(I, source, module);
+                        if (evaluated)
+                        {
+                            const unsigned bit_width = source->getType()->getPrimitiveSizeInBits();
+                            uint64_t raw_value = I.ULongLong();
+                            if (bit_width < 64)
+                                raw_value &= ((1ull << bit_width) - 1);
+                            if (inst->getOpcode() == Instruction::SIToFP)
+                                assigned = frame.AssignFloat(inst, (double)SignExtend(raw_value, bit_width), module);
+                            else
+                                assigned = frame.AssignFloat(inst, (double)raw_value, module);
+                        }
+                    }
+                        break;
+                }
+
+                if (!evaluated)
+                {
+                    if (log)
+                        log->Printf("Couldn't evaluate %s", PrintValue(source).c_str());
+                    error.SetErrorToGenericError();
+                    error.SetErrorString(bad_value_error);
+                    return false;
+                }
+
+                if (!assigned)
+                {
+                    if (log)
+                        log->Printf("Couldn't assign the result of %s", PrintValue(inst).c_str());
+                    error.SetErrorToGenericError();
+                    error.SetErrorString(memory_write_error);
+                    return false;
+                }
+
+                if (log)
+                {
+                    log->Printf("Interpreted a %s", inst->getOpcodeName());
+                    log->Printf("  Src : %s", frame.SummarizeValue(source).c_str());
+                    log->Printf("  =   : %s", frame.SummarizeValue(inst).c_str());
+                }
+            }
+                break;
+            case Instruction::PHI:
+            {
+                // All the PHI nodes at the top of a block take the values they have for
+                // the edge we came in on at the same time, so read all of them before
+                // assigning any.
+
+                typedef std::pair<const PHINode *, std::vector<uint8_t> > PHIValue;
+                std::vector<PHIValue> phi_values;
+
+                BasicBlock::const_iterator last_phi = frame.m_ii;
+
+                for (BasicBlock::const_iterator pi = frame.m_ii; pi != frame.m_ie; ++pi)
+                {
+                    const Instruction *phi_inst = pi;
+                    const PHINode *phi_node = dyn_cast<PHINode>(phi_inst);
+
+                    if (!phi_node)
+                        break;
+
+                    const int incoming_index = frame.m_prev_bb ? phi_node->getBasicBlockIndex(frame.m_prev_bb) : -1;
+
+                    if (incoming_index < 0)
+                    {
+                        if (log)
+                            log->Printf("%s has no value for the block we came from", PrintValue(phi_node).c_str());
+                        error.SetErrorToGenericError();
+                        error.SetErrorString(bad_value_error);
+                        return false;
+                    }
+
+                    const Value *incoming_value = phi_node->getIncomingValue(incoming_index);
+                    const size_t value_size = data_layout.getTypeStoreSize(phi_node->getType());
+                    lldb::addr_t incoming_address = frame.ResolveValue(incoming_value, module);
+
+                    phi_values.push_back(PHIValue(phi_node, std::vector<uint8_t>(value_size, 0)));
+
+                    lldb_private::Error read_error;
+
+                    if (incoming_address == LLDB_INVALID_ADDRESS)
+                        read_error.SetErrorToGenericError();
+                    else if (value_size)
+                        memory_map.ReadMemory(&phi_values.back().second[0], incoming_address, value_size, read_error);
+
+                    if (!read_error.Success())
+                    {
+                        if (log)
+                            log->Printf("Couldn't evaluate %s", PrintValue(incoming_value).c_str());
+                        error.SetErrorToGenericError();
+                        error.SetErrorString(bad_value_error);
+                        return false;
+                    }
+
+                    last_phi = pi;
+                }
+
+                for (std::vector<PHIValue>::iterator vi = phi_values.begin(), ve = phi_values.end(); vi != ve; ++vi)
+                {
+                    lldb::addr_t phi_address = frame.ResolveValue(vi->first, module);
+                    lldb_private::Error write_error;
+
+                    if (phi_address == LLDB_INVALID_ADDRESS)
+                        write_error.SetErrorToGenericError();
+                    else if (!vi->second.empty())
+                        memory_map.WriteMemory(phi_address, &vi->second[0], vi->second.size(), write_error);
+
+                    if (!write_error.Success())
+                    {
+                        if (log)
+                            log->Printf("Couldn't assign %s", PrintValue(vi->first).c_str());
+                        error.SetErrorToGenericError();
+                        error.SetErrorString(memory_write_error);
+                        return false;
+                    }
+
+                    if (log)
+                        log->Printf("Interpreted a PHINode: %s", frame.SummarizeValue(vi->first).c_str());
+                }
+
+                frame.m_ii = last_phi;
+            }
+                break;
+            case Instruction::Select:
+            {
+                const SelectInst *select_inst = dyn_cast<SelectInst>(inst);
+
+                if (!select_inst)
+                {
+                    if (log)
+                        log->Printf("getOpcode() returns Select, but instruction is not a SelectInst");
+                    error.SetErrorToGenericError();
+                    error.SetErrorString(interpreter_internal_error);
+                    return false;
+                }
+
+                const Value *condition = select_inst->getCondition();
+
+                lldb_private::Scalar C;
+
+                if (!frame.EvaluateValue(C, condition, module))
+                {
+                    if (log)
+                        log->Printf("Couldn't evaluate %s", PrintValue(condition).c_str());
+                    error.SetErrorToGenericError();
+                    error.SetErrorString(bad_value_error);
+                    return false;
+                }
+
+                const Value *chosen = C.ULongLong() ? select_inst->getTrueValue() : select_inst->getFalseValue();
+
+                if (!frame.CopyValue(inst, 0, chosen, 0, data_layout.getTypeStoreSize(inst->getType()), module))
+                {
+                    if (log)
+                        log->Printf("Couldn't evaluate %s", PrintValue(chosen).c_str());
+                    error.SetErrorToGenericError();
+                    error.SetErrorString(bad_value_error);
+                    return false;
+                }
+
+                if (log)
+                {
+                    log->Printf("Interpreted a SelectInst");
+                    log->Printf("  cond : %s", frame.SummarizeValue(condition).c_str());
+                    log->Printf("  =    : %s", frame.SummarizeValue(inst).c_str());
+                }
+            }
+                break;
+            case Instruction::Switch:
+            {
+                const SwitchInst *switch_inst = dyn_cast<SwitchInst>(inst);
+
+                if (!switch_inst)
+                {
+                    if (log)
+                        log->Printf("getOpcode() returns Switch, but instruction is not a SwitchInst");
+                    error.SetErrorToGenericError();
+                    error.SetErrorString(interpreter_internal_error);
+                    return false;
+                }
+
+                const Value *condition = switch_inst->getCondition();
+
+                lldb_private::Scalar C;
+
+                if (!frame.EvaluateValue(C, condition, module))
+                {
+                    if (log)
+                        log->Printf("Couldn't evaluate %s", PrintValue(condition).c_str());
+                    error.SetErrorToGenericError();
+                    error.SetErrorString(bad_value_error);
+                    return false;
+                }
+
+                const uint64_t condition_value = C.ULongLong();
+                const BasicBlock *destination = switch_inst->getDefaultDest();
+
+                for (SwitchInst::ConstCaseIt ci = switch_inst->case_begin(), ce = switch_inst->case_end();
+                     ci != ce;
+                     ++ci)
+                {
+                    if (ci.getCaseValue()->getZExtValue() == condition_value)
+                    {
+                        destination = ci.getCaseSuccessor();
+                        break;
+                    }
+                }
+
+                frame.Jump(destination);
+
+                if (log)
+                {
+                    log->Printf("Interpreted a SwitchInst");
+                    log->Printf("  cond : %s", frame.SummarizeValue(condition).c_str());
+                }
+            }
+                continue;
+            case Instruction::ExtractValue:
+            {
+                const ExtractValueInst *extract_inst = dyn_cast<ExtractValueInst>(inst);
+
+                if (!extract_inst)
+                {
+                    if (log)
+                        log->Printf("getOpcode() returns ExtractValue, but instruction is not an ExtractValueInst");
+                    error.SetErrorToGenericError();
+                    error.SetErrorString(interpreter_internal_error);
+                    return false;
+                }
+
+                const Value *aggregate = extract_inst->getAggregateOperand();
+                uint64_t offset;
+
+                if (!frame.GetAggregateOffset(aggregate->getType(), extract_inst->getIndices(), offset) ||
+                    !frame.CopyValue(inst, 0, aggregate, offset, data_layout.getTypeStoreSize(inst->getType()), module))
+                {
+                    if (log)
+                        log->Printf("Couldn't evaluate %s", PrintValue(inst).c_str());
+                    error.SetErrorToGenericError();
+                    error.SetErrorString(bad_value_error);
+                    return false;
+                }
+
+                if (log)
+                {
+                    log->Printf("Interpreted an ExtractValueInst");
+                    log->Printf("  Agg : %s", frame.SummarizeValue(aggregate).c_str());
+                    log->Printf("  =   : %s", frame.SummarizeValue(inst).c_str());
+                }
+            }
+                break;
+            case Instruction::InsertValue:
+            {
+                const InsertValueInst *insert_inst = dyn_cast<InsertValueInst>(inst);
+
+                if (!insert_inst)
+                {
+                    if (log)
+                        log->Printf("getOpcode() returns InsertValue, but instruction is not an InsertValueInst");
+                    error.SetErrorToGenericError();
+                    error.SetErrorString(interpreter_internal_error);
+                    return false;
+                }
+
+                // The result is the aggregate with one member replaced
+                const Value *aggregate = insert_inst->getAggregateOperand();
+                const Value *member = insert_inst->getInsertedValueOperand();
+                uint64_t offset;
+
+                if (!frame.GetAggregateOffset(aggregate->getType(), insert_inst->getIndices(), offset) ||
+                    !frame.CopyValue(inst, 0, aggregate, 0, data_layout.getTypeStoreSize(inst->getType()), module) ||
+                    !frame.CopyValue(inst, offset, member, 0, data_layout.getTypeStoreSize(member->getType()), module))
+                {
+                    if (log)
+                        log->Printf("Couldn't evaluate %s", PrintValue(inst).c_str());
+                    error.SetErrorToGenericError();
+                    error.SetErrorString(bad_value_error);
+                    return false;
+                }
+
+                if (log)
+                {
+                    log->Printf("Interpreted an InsertValueInst");
+                    log->Printf("  Agg : %s", frame.SummarizeValue(aggregate).c_str());
+                    log->Printf("  =   : %s", frame.SummarizeValue(inst).c_str());
+                }
+            }
+                break;
             case Instruction::Ret:
             {
                 return true;
@@ -1481,7 +2347,7 @@ IRInterpreter::Interpret (llvm::Module &module,
         ++frame.m_ii;
     }
 
-    if (num_insts >= 4096)
+    if (num_insts >= max_interpreted_instructions)
     {
         error.SetErrorToGenericError();
         error.SetErrorString(infinite_loop_error);
@@ -205,7 +205,10 @@ IRMemoryMap::Allocation::Allocation (lldb::addr_t process_alloc,
     m_permissions (permissions),
     m_alignment (alignment),
     m_policy (policy),
-    m_leak (false)
+    m_leak (false),
+    m_buffered (false),
+    m_dirty_start (0),
+    m_dirty_end (0)
 {
     switch (policy)
     {
@@ -469,6 +472,14 @@ IRMemoryMap::WriteMemory (lldb::addr_t process_address, const uint8_t *bytes, si
             return;
         }
         ::memcpy (allocation.m_data.GetBytes() + offset, bytes, size);
+        if (allocation.m_buffered)
+        {
+            if (allocation.m_dirty_start > offset)
+                allocation.m_dirty_start = offset;
+            if (allocation.m_dirty_end < offset + size)
+                allocation.m_dirty_end = offset + size;
+            break;
+        }
         process_sp = m_process_wp.lock();
         if (process_sp)
         {
@@ -607,7 +618,7 @@ IRMemoryMap::ReadMemory (uint8_t *bytes, lldb::addr_t process_address, size_t si
         break;
     case eAllocationPolicyMirror:
         process_sp = m_process_wp.lock();
-        if (process_sp)
+        if (process_sp && !allocation.m_buffered)
         {
             process_sp->ReadMemory(process_address, bytes, size, error);
             if (!error.Success())
@@ -621,6 +632,12 @@ IRMemoryMap::ReadMemory (uint8_t *bytes, lldb::addr_t process_address, size_t si
                 error.SetErrorString("Couldn't read: data buffer is empty");
                 return;
             }
+            if (allocation.m_data.GetByteSize() < offset + size)
+            {
+                error.SetErrorToGenericError();
+                error.SetErrorString("Couldn't read: not enough underlying data");
+                return;
+            }
             ::memcpy (bytes, allocation.m_data.GetBytes() + offset, size);
         }
         break;
@@ -737,7 +754,7 @@ IRMemoryMap::GetMemoryData (DataExtractor &extractor, lldb::addr_t process_addre
                     error.SetErrorString("Couldn't get memory data: data buffer is empty");
                     return;
                 }
-                if (process_sp)
+                if (process_sp && !allocation.m_buffered)
                 {
                     process_sp->ReadMemory(allocation.m_process_start, allocation.m_data.GetBytes(), allocation.m_data.GetByteSize(), error);
                     if (!error.Success())
@@ -766,3 +783,91 @@ IRMemoryMap::GetMemoryData (DataExtractor &extractor, lldb::addr_t process_addre
         return;
     }
 }
+
+void
+IRMemoryMap::BeginBuffering (lldb::addr_t process_address, bool fetch, Error &error)
+{
+    error.Clear();
+
+    AllocationMap::iterator iter = m_allocations.find(process_address);
+
+    if (iter == m_allocations.end())
+    {
+        error.SetErrorToGenericError();
+        error.SetErrorString("Couldn't buffer: allocation doesn't exist");
+        return;
+    }
+
+    Allocation &allocation = iter->second;
+
+    // Host-only allocations never reach the process, and process-only
+    // allocations have no host copy to buffer into.
+    if (allocation.m_policy != eAllocationPolicyMirror || !allocation.m_data.GetByteSize())
+        return;
+
+    if (fetch)
+    {
+        lldb::ProcessSP process_sp = m_process_wp.lock();
+
+        if (process_sp)
+        {
+            process_sp->ReadMemory(allocation.m_process_start, allocation.m_data.GetBytes(), allocation.m_data.GetByteSize(), error);
+            if (!error.Success())
+                return;
+        }
+    }
+
+    allocation.m_buffered = true;
+    allocation.m_dirty_start = allocation.m_data.GetByteSize();
+    allocation.m_dirty_end = 0;
+
+    if (lldb_private::Log *log = lldb_private::GetLogIfAllCategoriesSet (LIBLLDB_LOG_EXPRESSIONS))
+    {
+        log->Printf("IRMemoryMap::BeginBuffering (0x%" PRIx64 ", %s) buffering [0x%" PRIx64 "..0x%" PRIx64 ")",
+                    (uint64_t)process_address,
+                    fetch ? "fetch" : "no fetch",
+                    (uint64_t)allocation.m_process_start,
+                    (uint64_t)allocation.m_process_start + (uint64_t)allocation.m_size);
+    }
+}
+
+void
+IRMemoryMap::EndBuffering (lldb::addr_t process_address, Error &error)
+{
+    error.Clear();
+
+    AllocationMap::iterator iter = m_allocations.find(process_address);
+
+    if (iter == m_allocations.end())
+    {
+        error.SetErrorToGenericError();
+        error.SetErrorString("Couldn't stop buffering: allocation doesn't exist");
+        return;
+    }
+
+    Allocation &allocation = iter->second;
+
+    if (!allocation.m_buffered)
+        return;
+
+    allocation.m_buffered = false;
+
+    if (allocation.m_dirty_end <= allocation.m_dirty_start)
+        return;
+
+    const size_t dirty_size = allocation.m_dirty_end - allocation.m_dirty_start;
+
+    lldb::ProcessSP process_sp = m_process_wp.lock();
+
+    if (process_sp)
+        process_sp->WriteMemory(allocation.m_process_start + allocation.m_dirty_start, allocation.m_data.GetBytes() + allocation.m_dirty_start, dirty_size, error);
+
+    if (lldb_private::Log *log = lldb_private::GetLogIfAllCategoriesSet (LIBLLDB_LOG_EXPRESSIONS))
+    {
+        log->Printf("IRMemoryMap::EndBuffering (0x%" PRIx64 ") wrote [0x%" PRIx64 "..0x%" PRIx64 ")%s",
+                    (uint64_t)process_address,
+                    (uint64_t)(allocation.m_process_start + allocation.m_dirty_start),
+                    (uint64_t)(allocation.m_process_start + allocation.m_dirty_end),
+                    error.Success() ? "" : " (failed)");
+    }
+}
@@ -46,6 +46,17 @@ Materializer::AddStructMember (Entity &entity)
     return ret;
 }
 
+uint64_t
+Materializer::GetPointeeByteSize (uint32_t offset)
+{
+    for (EntityUP &entity_up : m_entities)
+    {
+        if (entity_up->GetOffset() == offset)
+            return entity_up->GetPointeeByteSize();
+    }
+    return 0;
+}
+
 void
 Materializer::Entity::SetSizeAndAlignmentFromType (ClangASTType &type)
 {
@@ -399,6 +410,7 @@ Materializer::AddPersistentVariable (lldb::ClangExpressionVariableSP &persistent
     iter->reset (new EntityPersistentVariable (persistent_variable_sp));
     uint32_t ret = AddStructMember(**iter);
     (*iter)->SetOffset(ret);
+    m_frame_independent = false;
     return ret;
 }
 
@@ -418,6 +430,15 @@ public:
         m_is_reference = m_variable_sp->GetType()->GetClangForwardType().IsReferenceType();
     }
     
+    uint64_t GetPointeeByteSize ()
+    {
+        // The slot of a reference holds what it refers to, whose size
+        // isn't the variable's.
+        if (m_is_reference)
+            return 0;
+        return m_variable_sp->GetType()->GetByteSize();
+    }
+    
     void Materialize (lldb::StackFrameSP &frame_sp, IRMemoryMap &map, lldb::addr_t process_address, Error &err)
     {
         Log *log(lldb_private::GetLogIfAllCategoriesSet (LIBLLDB_LOG_EXPRESSIONS));
@@ -749,6 +770,15 @@ Materializer::AddVariable (lldb::VariableSP &variable_sp, Error &err)
     iter->reset (new EntityVariable (variable_sp));
     uint32_t ret = AddStructMember(**iter);
     (*iter)->SetOffset(ret);
+    switch (variable_sp->GetScope())
+    {
+    case lldb::eValueTypeVariableGlobal:
+    case lldb::eValueTypeVariableStatic:
+        break;
+    default:
+        m_frame_independent = false;
+        break;
+    }
     return ret;
 }
 
@@ -768,6 +798,13 @@ public:
         m_alignment = 8;
     }
     
+    uint64_t GetPointeeByteSize ()
+    {
+        if (m_is_program_reference)
+            return 0;
+        return m_type.GetByteSize();
+    }
+    
     void Materialize (lldb::StackFrameSP &frame_sp, IRMemoryMap &map, lldb::addr_t process_address, Error &err)
     {
         if (!m_is_program_reference)
@@ -1329,6 +1366,7 @@ Materializer::AddRegister (const RegisterInfo &register_info, Error &err)
     iter->reset (new EntityRegister (register_info));
     uint32_t ret = AddStructMember(**iter);
     (*iter)->SetOffset(ret);
+    m_frame_independent = false;
     return ret;
 }
 
@@ -1336,7 +1374,8 @@ Materializer::Materializer () :
     m_dematerializer_wp(),
     m_result_entity(NULL),
     m_current_offset(0),
-    m_struct_alignment(8)
+    m_struct_alignment(8),
+    m_frame_independent(true)
 {
 }
 
@@ -1372,12 +1411,34 @@ Materializer::Materialize (lldb::StackFrameSP &frame_sp, IRMemoryMap &map, lldb:
         error.SetErrorString("Couldn't materialize: target doesn't exist");
     }
 
+    // Lay the struct out in the host copy of its allocation and send it to
+    // the process in one write, rather than one write per entity.  None of
+    // the entities read the struct back while materializing, so there is no
+    // need to fetch it first.
+    Error buffer_error;
+    map.BeginBuffering(process_address, false, buffer_error);
+    const bool buffered = buffer_error.Success();
+
     for (EntityUP &entity_up : m_entities)
     {
         entity_up->Materialize(frame_sp, map, process_address, error);
 
         if (!error.Success())
+        {
+            if (buffered)
+                map.EndBuffering(process_address, buffer_error);
             return DematerializerSP();
+        }
+    }
+
+    if (buffered)
+        map.EndBuffering(process_address, buffer_error);
+
+    if (buffered && !buffer_error.Success())
+    {
+        error.SetErrorToGenericError();
+        error.SetErrorStringWithFormat("Couldn't materialize: couldn't write the struct: %s", buffer_error.AsCString());
+        return DematerializerSP();
     }
 
     if (Log *log = lldb_private::GetLogIfAllCategoriesSet (LIBLLDB_LOG_EXPRESSIONS))
@@ -1417,6 +1478,12 @@ Materializer::Dematerializer::Dematerialize (Error &error, lldb::ClangExpression
     }
     else
     {
+        // Read the whole struct back once; the entities then pick their
+        // results out of the host copy.
+        Error buffer_error;
+        m_map->BeginBuffering(m_process_address, true, buffer_error);
+        const bool buffered = buffer_error.Success();
+
         if (Log *log =lldb_private::GetLogIfAllCategoriesSet (LIBLLDB_LOG_EXPRESSIONS))
         {
             log->Printf("Materializer::Dematerialize (frame_sp = %p, process_address = 0x%" PRIx64 ") about to dematerialize:",
@@ -1439,6 +1506,9 @@ Materializer::Dematerializer::Dematerialize (Error &error, lldb::ClangExpression
             if (!error.Success())
                 break;
         }
+
+        if (buffered)
+            m_map->EndBuffering(m_process_address, buffer_error);
     }
 
     Wipe();
@@ -128,6 +128,174 @@ NativeBreakpointList::DecRef (lldb::addr_t addr)
     return error;
 }
 
+size_t
+NativeBreakpointList::AddRefs (const std::vector<lldb::addr_t> &addrs, size_t size_hint, bool hardware, CreateBreakpointsFunc create_func, std::vector<Error> &errors)
+{
+    Log *log (GetLogIfAnyCategoriesSet (LIBLLDB_LOG_BREAKPOINTS));
+    if (log)
+        log->Printf ("NativeBreakpointList::%s %" PRIu64 " addresses, size_hint = %lu, hardware = %s", __FUNCTION__, static_cast<uint64_t> (addrs.size ()), size_hint, hardware ? "true" : "false");
+
+    errors.clear ();
+    errors.resize (addrs.size ());
+
+    Mutex::Locker locker (m_mutex);
+
+    // Bump the ref count of the breakpoints we already have and collect the
+    // addresses that need a new breakpoint.  The same address can show up
+    // more than once, only the first one creates the breakpoint.
+    std::vector<lldb::addr_t> new_addrs;
+    std::vector<size_t> new_addr_indexes;
+    std::map<lldb::addr_t, size_t> new_addr_map;
+    std::vector<size_t> duplicate_indexes;
+    for (size_t i = 0; i < addrs.size (); ++i)
+    {
+        const lldb::addr_t addr = addrs[i];
+        auto iter = m_breakpoints.find (addr);
+        if (iter != m_breakpoints.end ())
+        {
+            iter->second->AddRef ();
+            continue;
+        }
+
+        if (new_addr_map.find (addr) != new_addr_map.end ())
+        {
+            duplicate_indexes.push_back (i);
+            continue;
+        }
+
+        new_addr_map[addr] = new_addrs.size ();
+        new_addrs.push_back (addr);
+        new_addr_indexes.push_back (i);
+    }
+
+    size_t num_failed = 0;
+    if (!new_addrs.empty ())
+    {
+        if (log)
+            log->Printf ("NativeBreakpointList::%s creating %" PRIu64 " new breakpoints", __FUNCTION__, static_cast<uint64_t> (new_addrs.size ()));
+
+        std::vector<NativeBreakpointSP> breakpoint_sps;
+        std::vector<Error> create_errors;
+        create_func (new_addrs, size_hint, hardware, breakpoint_sps, create_errors);
+        assert (breakpoint_sps.size () == new_addrs.size () && create_errors.size () == new_addrs.size () && "NativeBreakpoint create function returned the wrong number of results");
+
+        for (size_t i = 0; i < new_addrs.size (); ++i)
+        {
+            errors[new_addr_indexes[i]] = create_errors[i];
+            if (create_errors[i].Fail ())
+            {
+                ++num_failed;
+                if (log)
+                    log->Printf ("NativeBreakpointList::%s creating breakpoint for addr = 0x%" PRIx64 " -- FAILED: %s", __FUNCTION__, new_addrs[i], create_errors[i].AsCString ());
+                continue;
+            }
+
+            // Remember the breakpoint.
+            assert (breakpoint_sps[i] && "NativeBreakpoint create function succeeded but returned NULL breakpoint");
+            m_breakpoints.insert (BreakpointMap::value_type (new_addrs[i], breakpoint_sps[i]));
+        }
+    }
+
+    // Duplicates get the result of the first occurrence and a reference if
+    // that one worked.
+    for (size_t idx : duplicate_indexes)
+    {
+        auto iter = m_breakpoints.find (addrs[idx]);
+        if (iter != m_breakpoints.end ())
+            iter->second->AddRef ();
+        else
+        {
+            errors[idx] = errors[new_addr_indexes[new_addr_map[addrs[idx]]]];
+            ++num_failed;
+        }
+    }
+
+    return num_failed;
+}
+
+size_t
+NativeBreakpointList::DecRefs (const std::vector<lldb::addr_t> &addrs, DisableBreakpointsFunc disable_func, std::vector<Error> &errors)
+{
+    Log *log (GetLogIfAnyCategoriesSet (LIBLLDB_LOG_BREAKPOINTS));
+    if (log)
+        log->Printf ("NativeBreakpointList::%s %" PRIu64 " addresses", __FUNCTION__, static_cast<uint64_t> (addrs.size ()));
+
+    errors.clear ();
+    errors.resize (addrs.size ());
+
+    Mutex::Locker locker (m_mutex);
+
+    size_t num_failed = 0;
+    std::vector<NativeBreakpointSP> software_breakpoint_sps;
+    std::vector<size_t> software_indexes;
+    for (size_t i = 0; i < addrs.size (); ++i)
+    {
+        const lldb::addr_t addr = addrs[i];
+        auto iter = m_breakpoints.find (addr);
+        if (iter == m_breakpoints.end ())
+        {
+            // Not found!
+            if (log)
+                log->Printf ("NativeBreakpointList::%s addr = 0x%" PRIx64 " -- NOT FOUND", __FUNCTION__, addr);
+            errors[i].SetErrorString ("breakpoint not found");
+            ++num_failed;
+            continue;
+        }
+
+        // Decrement ref count.
+        const int32_t new_ref_count = iter->second->DecRef ();
+        assert (new_ref_count >= 0 && "NativeBreakpoint ref count went negative");
+        if (new_ref_count > 0)
+            continue;
+
+        NativeBreakpointSP breakpoint_sp (iter->second);
+        m_breakpoints.erase (iter);
+
+        if (!breakpoint_sp->IsEnabled ())
+            continue;
+
+        // Software breakpoints get restored together, anything else is
+        // disabled on its own.
+        if (breakpoint_sp->IsSoftwareBreakpoint ())
+        {
+            software_breakpoint_sps.push_back (breakpoint_sp);
+            software_indexes.push_back (i);
+        }
+        else
+        {
+            errors[i] = breakpoint_sp->Disable ();
+            if (errors[i].Fail ())
+                ++num_failed;
+        }
+    }
+
+    if (!software_breakpoint_sps.empty ())
+    {
+        if (log)
+            log->Printf ("NativeBreakpointList::%s disabling %" PRIu64 " software breakpoints", __FUNCTION__, static_cast<uint64_t> (software_breakpoint_sps.size ()));
+
+        std::vector<Error> disable_errors;
+        disable_func (software_breakpoint_sps, disable_errors);
+        assert (disable_errors.size () == software_breakpoint_sps.size () && "NativeBreakpoint disable function returned the wrong number of results");
+
+        for (size_t i = 0; i < software_breakpoint_sps.size (); ++i)
+        {
+            errors[software_indexes[i]] = disable_errors[i];
+            if (disable_errors[i].Success ())
+                software_breakpoint_sps[i]->m_enabled = false;
+            else
+            {
+                // The breakpoint stays out of the list, same as DecRef ().
+                ++num_failed;
+                if (log)
+                    log->Printf ("NativeBreakpointList::%s addr = 0x%" PRIx64 " -- removal FAILED: %s", __FUNCTION__, software_breakpoint_sps[i]->GetAddress (), disable_errors[i].AsCString ());
+            }
+        }
+    }
+
+    return num_failed;
+}
+
 Error
 NativeBreakpointList::EnableBreakpoint (lldb::addr_t addr)
 {
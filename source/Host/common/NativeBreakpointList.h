@@ -17,6 +17,7 @@
 
 #include <functional>
 #include <map>
+#include <vector>
 
 namespace lldb_private
 {
@@ -25,6 +26,11 @@ namespace lldb_private
     public:
         typedef std::function<Error (lldb::addr_t addr, size_t size_hint, bool hardware, NativeBreakpointSP &breakpoint_sp)> CreateBreakpointFunc;
 
+        // Batched variants.  The breakpoint and error vectors are filled in
+        // with one entry per input address, in the same order.
+        typedef std::function<void (const std::vector<lldb::addr_t> &addrs, size_t size_hint, bool hardware, std::vector<NativeBreakpointSP> &breakpoint_sps, std::vector<Error> &errors)> CreateBreakpointsFunc;
+        typedef std::function<void (const std::vector<NativeBreakpointSP> &breakpoint_sps, std::vector<Error> &errors)> DisableBreakpointsFunc;
+
         NativeBreakpointList ();
 
         Error
@@ -33,6 +39,35 @@ namespace lldb_private
         Error
         DecRef (lldb::addr_t addr);
 
+        //------------------------------------------------------------------
+        /// Add a reference to the breakpoint at each address in \a addrs,
+        /// creating all of the breakpoints that don't exist yet with a
+        /// single call to \a create_func so they can be written to the
+        /// inferior together.
+        ///
+        /// @param[out] errors
+        ///     Filled in with the result for each address in \a addrs.
+        ///
+        /// @return
+        ///     The number of addresses that failed.
+        //------------------------------------------------------------------
+        size_t
+        AddRefs (const std::vector<lldb::addr_t> &addrs, size_t size_hint, bool hardware, CreateBreakpointsFunc create_func, std::vector<Error> &errors);
+
+        //------------------------------------------------------------------
+        /// Drop a reference to the breakpoint at each address in \a addrs.
+        /// All enabled software breakpoints that lose their last reference
+        /// are disabled with a single call to \a disable_func.
+        ///
+        /// @param[out] errors
+        ///     Filled in with the result for each address in \a addrs.
+        ///
+        /// @return
+        ///     The number of addresses that failed.
+        //------------------------------------------------------------------
+        size_t
+        DecRefs (const std::vector<lldb::addr_t> &addrs, DisableBreakpointsFunc disable_func, std::vector<Error> &errors);
+
         Error
         EnableBreakpoint (lldb::addr_t addr);
 
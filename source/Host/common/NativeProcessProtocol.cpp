@@ -50,6 +50,14 @@ NativeProcessProtocol::GetMemoryRegionInfo (lldb::addr_t load_addr, MemoryRegion
     return Error ("not implemented");
 }
 
+Error
+NativeProcessProtocol::GetMemoryRegions (std::vector<MemoryRegionInfo> &regions)
+{
+    // Default: not implemented.
+    regions.clear ();
+    return Error ("not implemented");
+}
+
 bool
 NativeProcessProtocol::GetExitStatus (ExitType *exit_type, int *status, std::string &exit_description)
 {
@@ -337,12 +345,66 @@ NativeProcessProtocol::SetSoftwareBreakpoint (lldb::addr_t addr, uint32_t size_h
             { return SoftwareBreakpoint::CreateSoftwareBreakpoint (*this, addr, size_hint, breakpoint_sp); });
 }
 
+Error
+NativeProcessProtocol::SetSoftwareBreakpoints (const std::vector<lldb::addr_t> &addrs, uint32_t size_hint, std::vector<Error> &errors)
+{
+    Log *log (GetLogIfAnyCategoriesSet (LIBLLDB_LOG_BREAKPOINTS));
+    if (log)
+        log->Printf ("NativeProcessProtocol::%s %" PRIu64 " addresses", __FUNCTION__, static_cast<uint64_t> (addrs.size ()));
+
+    const size_t num_failed = m_breakpoint_list.AddRefs (addrs, size_hint, false,
+            [this] (const std::vector<lldb::addr_t> &new_addrs, size_t size_hint, bool /* hardware */, std::vector<NativeBreakpointSP> &breakpoint_sps, std::vector<Error> &create_errors)
+            { SoftwareBreakpoint::CreateSoftwareBreakpoints (*this, new_addrs, size_hint, breakpoint_sps, create_errors); },
+            errors);
+
+    Error error;
+    if (num_failed > 0)
+        error.SetErrorStringWithFormat ("failed to set %" PRIu64 " of %" PRIu64 " breakpoints", static_cast<uint64_t> (num_failed), static_cast<uint64_t> (addrs.size ()));
+    return error;
+}
+
+Error
+NativeProcessProtocol::SetBreakpoints (const std::vector<lldb::addr_t> &addrs, uint32_t size, bool hardware, std::vector<Error> &errors)
+{
+    if (!hardware)
+        return SetSoftwareBreakpoints (addrs, size, errors);
+
+    // Hardware breakpoints don't touch memory so there is nothing to batch.
+    errors.clear ();
+    size_t num_failed = 0;
+    for (lldb::addr_t addr : addrs)
+    {
+        errors.push_back (SetBreakpoint (addr, size, hardware));
+        if (errors.back ().Fail ())
+            ++num_failed;
+    }
+
+    Error error;
+    if (num_failed > 0)
+        error.SetErrorStringWithFormat ("failed to set %" PRIu64 " of %" PRIu64 " breakpoints", static_cast<uint64_t> (num_failed), static_cast<uint64_t> (addrs.size ()));
+    return error;
+}
+
 Error
 NativeProcessProtocol::RemoveBreakpoint (lldb::addr_t addr)
 {
     return m_breakpoint_list.DecRef (addr);
 }
 
+Error
+NativeProcessProtocol::RemoveBreakpoints (const std::vector<lldb::addr_t> &addrs, std::vector<Error> &errors)
+{
+    const size_t num_failed = m_breakpoint_list.DecRefs (addrs,
+            [this] (const std::vector<NativeBreakpointSP> &breakpoint_sps, std::vector<Error> &disable_errors)
+            { SoftwareBreakpoint::DisableSoftwareBreakpoints (*this, breakpoint_sps, disable_errors); },
+            errors);
+
+    Error error;
+    if (num_failed > 0)
+        error.SetErrorStringWithFormat ("failed to remove %" PRIu64 " of %" PRIu64 " breakpoints", static_cast<uint64_t> (num_failed), static_cast<uint64_t> (addrs.size ()));
+    return error;
+}
+
 Error
 NativeProcessProtocol::EnableBreakpoint (lldb::addr_t addr)
 {
@@ -80,6 +80,13 @@ namespace lldb_private
         virtual Error
         GetMemoryRegionInfo (lldb::addr_t load_addr, MemoryRegionInfo &range_info);
 
+        //----------------------------------------------------------------------
+        /// Get every mapped region of the process, sorted by address.
+        /// Unmapped gaps between the regions are not included.
+        //----------------------------------------------------------------------
+        virtual Error
+        GetMemoryRegions (std::vector<MemoryRegionInfo> &regions);
+
         virtual Error
         ReadMemory (lldb::addr_t addr, void *buf, lldb::addr_t size, lldb::addr_t &bytes_read) = 0;
 
@@ -119,6 +126,27 @@ namespace lldb_private
         virtual Error
         DisableBreakpoint (lldb::addr_t addr);
 
+        //----------------------------------------------------------------------
+        /// Set a breakpoint at every address in \a addrs.  Software
+        /// breakpoints that land in the same page are inserted with one
+        /// read and one write of the inferior's memory.
+        ///
+        /// @param[out] errors
+        ///     Filled in with the result for each address in \a addrs.
+        ///
+        /// @return
+        ///     An error if any of the breakpoints couldn't be set.
+        //----------------------------------------------------------------------
+        virtual Error
+        SetBreakpoints (const std::vector<lldb::addr_t> &addrs, uint32_t size, bool hardware, std::vector<Error> &errors);
+
+        //----------------------------------------------------------------------
+        /// Remove the breakpoints at every address in \a addrs, batching the
+        /// memory writes the same way as SetBreakpoints().
+        //----------------------------------------------------------------------
+        virtual Error
+        RemoveBreakpoints (const std::vector<lldb::addr_t> &addrs, std::vector<Error> &errors);
+
         //----------------------------------------------------------------------
         // Watchpoint functions
         //----------------------------------------------------------------------
@@ -308,6 +336,9 @@ namespace lldb_private
         Error
         SetSoftwareBreakpoint (lldb::addr_t addr, uint32_t size_hint);
 
+        Error
+        SetSoftwareBreakpoints (const std::vector<lldb::addr_t> &addrs, uint32_t size_hint, std::vector<Error> &errors);
+
         virtual Error
         GetSoftwareBreakpointTrapOpcode (size_t trap_opcode_size_hint, size_t &actual_opcode_size, const uint8_t *&trap_opcode_bytes) = 0;
 
@@ -9,6 +9,8 @@
 
 #include "SoftwareBreakpoint.h"
 
+#include <algorithm>
+
 #include "lldb/Core/Error.h"
 #include "lldb/Core/Log.h"
 #include "lldb/Host/Debug.h"
@@ -37,6 +39,173 @@ SoftwareBreakpoint::CreateSoftwareBreakpoint (NativeProcessProtocol &process, ll
     // trap for the breakpoint site.
     size_t bp_opcode_size = 0;
     const uint8_t *bp_opcode_bytes = NULL;
+    Error error = GetTrapOpcode (process, size_hint, bp_opcode_size, bp_opcode_bytes);
+    if (error.Fail ())
+        return error;
+
+    // Enable the breakpoint.
+    uint8_t saved_opcode_bytes [MAX_TRAP_OPCODE_SIZE];
+    error = EnableSoftwareBreakpoint (process, addr, bp_opcode_size, bp_opcode_bytes, saved_opcode_bytes);
+    if (error.Fail ())
+    {
+        if (log)
+            log->Printf ("SoftwareBreakpoint::%s: failed to enable new breakpoint at 0x%" PRIx64 ": %s", __FUNCTION__, addr, error.AsCString ());
+        return error;
+    }
+
+    if (log)
+        log->Printf ("SoftwareBreakpoint::%s addr = 0x%" PRIx64 " -- SUCCESS", __FUNCTION__, addr);
+
+    // Set the breakpoint and verified it was written properly.  Now
+    // create a breakpoint remover that understands how to undo this
+    // breakpoint.
+    breakpoint_sp.reset (new SoftwareBreakpoint (process, addr, saved_opcode_bytes, bp_opcode_bytes, bp_opcode_size));
+    return Error ();
+}
+
+void
+SoftwareBreakpoint::CreateSoftwareBreakpoints (NativeProcessProtocol &process, const std::vector<lldb::addr_t> &addrs, size_t size_hint, std::vector<NativeBreakpointSP> &breakpoint_sps, std::vector<Error> &errors)
+{
+    Log *log (GetLogIfAnyCategoriesSet (LIBLLDB_LOG_BREAKPOINTS));
+    if (log)
+        log->Printf ("SoftwareBreakpoint::%s %" PRIu64 " addresses", __FUNCTION__, static_cast<uint64_t> (addrs.size ()));
+
+    breakpoint_sps.clear ();
+    breakpoint_sps.resize (addrs.size ());
+    errors.clear ();
+    errors.resize (addrs.size ());
+
+    size_t bp_opcode_size = 0;
+    const uint8_t *bp_opcode_bytes = NULL;
+    Error error = GetTrapOpcode (process, size_hint, bp_opcode_size, bp_opcode_bytes);
+    if (error.Fail ())
+    {
+        std::fill (errors.begin (), errors.end (), error);
+        return;
+    }
+
+    // Visit the addresses in ascending order so the ones that share a
+    // page are next to each other.
+    std::vector<size_t> order;
+    order.reserve (addrs.size ());
+    for (size_t i = 0; i < addrs.size (); ++i)
+    {
+        if (addrs[i] == LLDB_INVALID_ADDRESS)
+            errors[i].SetErrorStringWithFormat ("SoftwareBreakpoint::%s invalid load address specified.", __FUNCTION__);
+        else
+            order.push_back (i);
+    }
+    std::sort (order.begin (), order.end (), [&addrs] (size_t lhs, size_t rhs) { return addrs[lhs] < addrs[rhs]; });
+
+    size_t group_start = 0;
+    while (group_start < order.size ())
+    {
+        // Grow the group while the next address is in the same page and
+        // doesn't overlap the trap of the previous one.
+        const lldb::addr_t page = addrs[order[group_start]] / BATCH_PAGE_SIZE;
+        size_t group_end = group_start + 1;
+        while (group_end < order.size () &&
+               addrs[order[group_end]] / BATCH_PAGE_SIZE == page &&
+               addrs[order[group_end]] >= addrs[order[group_end - 1]] + bp_opcode_size)
+            ++group_end;
+
+        if (group_end - group_start > 1)
+        {
+            std::vector<lldb::addr_t> page_addrs;
+            for (size_t i = group_start; i < group_end; ++i)
+                page_addrs.push_back (addrs[order[i]]);
+
+            std::vector<NativeBreakpointSP> page_breakpoint_sps;
+            std::vector<Error> page_errors;
+            error = EnableSoftwareBreakpointsInPage (process, page_addrs, bp_opcode_size, bp_opcode_bytes, page_breakpoint_sps, page_errors);
+            if (error.Success ())
+            {
+                for (size_t i = group_start; i < group_end; ++i)
+                {
+                    breakpoint_sps[order[i]] = page_breakpoint_sps[i - group_start];
+                    errors[order[i]] = page_errors[i - group_start];
+                }
+                group_start = group_end;
+                continue;
+            }
+
+            if (log)
+                log->Printf ("SoftwareBreakpoint::%s batched insert of %" PRIu64 " breakpoints at 0x%" PRIx64 " failed, setting them one at a time: %s", __FUNCTION__, static_cast<uint64_t> (page_addrs.size ()), page_addrs.front (), error.AsCString ());
+        }
+
+        // Either a single breakpoint in this page or the batched insert
+        // failed, so fall back to one breakpoint at a time.
+        for (size_t i = group_start; i < group_end; ++i)
+            errors[order[i]] = CreateSoftwareBreakpoint (process, addrs[order[i]], size_hint, breakpoint_sps[order[i]]);
+        group_start = group_end;
+    }
+}
+
+void
+SoftwareBreakpoint::DisableSoftwareBreakpoints (NativeProcessProtocol &process, const std::vector<NativeBreakpointSP> &breakpoint_sps, std::vector<Error> &errors)
+{
+    Log *log (GetLogIfAnyCategoriesSet (LIBLLDB_LOG_BREAKPOINTS));
+    if (log)
+        log->Printf ("SoftwareBreakpoint::%s %" PRIu64 " breakpoints", __FUNCTION__, static_cast<uint64_t> (breakpoint_sps.size ()));
+
+    errors.clear ();
+    errors.resize (breakpoint_sps.size ());
+
+    std::vector<size_t> order;
+    order.reserve (breakpoint_sps.size ());
+    for (size_t i = 0; i < breakpoint_sps.size (); ++i)
+    {
+        assert (breakpoint_sps[i] && breakpoint_sps[i]->IsSoftwareBreakpoint () && "only software breakpoints can be disabled in a batch");
+        order.push_back (i);
+    }
+    std::sort (order.begin (), order.end (), [&breakpoint_sps] (size_t lhs, size_t rhs) { return breakpoint_sps[lhs]->GetAddress () < breakpoint_sps[rhs]->GetAddress (); });
+
+    size_t group_start = 0;
+    while (group_start < order.size ())
+    {
+        SoftwareBreakpoint *first_bp = static_cast<SoftwareBreakpoint *> (breakpoint_sps[order[group_start]].get ());
+        const lldb::addr_t page = first_bp->GetAddress () / BATCH_PAGE_SIZE;
+        std::vector<SoftwareBreakpoint *> page_breakpoints (1, first_bp);
+        size_t group_end = group_start + 1;
+        while (group_end < order.size ())
+        {
+            SoftwareBreakpoint *bp = static_cast<SoftwareBreakpoint *> (breakpoint_sps[order[group_end]].get ());
+            const SoftwareBreakpoint *prev_bp = page_breakpoints.back ();
+            if (bp->GetAddress () / BATCH_PAGE_SIZE != page || bp->GetAddress () < prev_bp->GetAddress () + prev_bp->m_opcode_size)
+                break;
+            page_breakpoints.push_back (bp);
+            ++group_end;
+        }
+
+        if (page_breakpoints.size () > 1)
+        {
+            std::vector<Error> page_errors;
+            Error error = DisableSoftwareBreakpointsInPage (process, page_breakpoints, page_errors);
+            if (error.Success ())
+            {
+                for (size_t i = group_start; i < group_end; ++i)
+                    errors[order[i]] = page_errors[i - group_start];
+                group_start = group_end;
+                continue;
+            }
+
+            if (log)
+                log->Printf ("SoftwareBreakpoint::%s batched removal of %" PRIu64 " breakpoints at 0x%" PRIx64 " failed, removing them one at a time: %s", __FUNCTION__, static_cast<uint64_t> (page_breakpoints.size ()), first_bp->GetAddress (), error.AsCString ());
+        }
+
+        for (size_t i = group_start; i < group_end; ++i)
+            errors[order[i]] = page_breakpoints[i - group_start]->DoDisable ();
+        group_start = group_end;
+    }
+}
+
+Error
+SoftwareBreakpoint::GetTrapOpcode (NativeProcessProtocol &process, size_t size_hint, size_t &bp_opcode_size, const uint8_t *&bp_opcode_bytes)
+{
+    Log *log (GetLogIfAnyCategoriesSet (LIBLLDB_LOG_BREAKPOINTS));
+
+    // Ask the NativeProcessProtocol subclass to fill in the correct software breakpoint
+    // trap for the breakpoint site.
     Error error = process.GetSoftwareBreakpointTrapOpcode (size_hint, bp_opcode_size, bp_opcode_bytes);
 
     if (error.Fail ())
@@ -51,7 +220,7 @@ SoftwareBreakpoint::CreateSoftwareBreakpoint (NativeProcessProtocol &process, ll
     {
         if (log)
             log->Printf ("SoftwareBreakpoint::%s failed to retrieve any trap opcodes", __FUNCTION__);
-        return Error ("SoftwareBreakpoint::GetSoftwareBreakpointTrapOpcode() returned zero, unable to get breakpoint trap for address 0x%" PRIx64, addr);
+        return Error ("SoftwareBreakpoint::GetSoftwareBreakpointTrapOpcode() returned zero, unable to get breakpoint trap");
     }
 
     if (bp_opcode_size > MAX_TRAP_OPCODE_SIZE)
@@ -66,27 +235,10 @@ SoftwareBreakpoint::CreateSoftwareBreakpoint (NativeProcessProtocol &process, ll
     {
         if (log)
             log->Printf ("SoftwareBreakpoint::%s failed to retrieve trap opcode bytes", __FUNCTION__);
-        return Error ("SoftwareBreakpoint::GetSoftwareBreakpointTrapOpcode() returned NULL trap opcode bytes, unable to get breakpoint trap for address 0x%" PRIx64, addr);
+        return Error ("SoftwareBreakpoint::GetSoftwareBreakpointTrapOpcode() returned NULL trap opcode bytes, unable to get breakpoint trap");
     }
 
-    // Enable the breakpoint.
-    uint8_t saved_opcode_bytes [MAX_TRAP_OPCODE_SIZE];
-    error = EnableSoftwareBreakpoint (process, addr, bp_opcode_size, bp_opcode_bytes, saved_opcode_bytes);
-    if (error.Fail ())
-    {
-        if (log)
-            log->Printf ("SoftwareBreakpoint::%s: failed to enable new breakpoint at 0x%" PRIx64 ": %s", __FUNCTION__, addr, error.AsCString ());
-        return error;
-    }
-
-    if (log)
-        log->Printf ("SoftwareBreakpoint::%s addr = 0x%" PRIx64 " -- SUCCESS", __FUNCTION__, addr);
-
-    // Set the breakpoint and verified it was written properly.  Now
-    // create a breakpoint remover that understands how to undo this
-    // breakpoint.
-    breakpoint_sp.reset (new SoftwareBreakpoint (process, addr, saved_opcode_bytes, bp_opcode_bytes, bp_opcode_size));
-    return Error ();
+    return error;
 }
 
 Error
@@ -169,6 +321,151 @@ SoftwareBreakpoint::EnableSoftwareBreakpoint (NativeProcessProtocol &process, ll
     return Error ();
 }
 
+Error
+SoftwareBreakpoint::EnableSoftwareBreakpointsInPage (NativeProcessProtocol &process, const std::vector<lldb::addr_t> &addrs, size_t bp_opcode_size, const uint8_t *bp_opcode_bytes, std::vector<NativeBreakpointSP> &breakpoint_sps, std::vector<Error> &errors)
+{
+    assert (!addrs.empty () && "no breakpoint addresses");
+
+    Log *log (GetLogIfAnyCategoriesSet (LIBLLDB_LOG_BREAKPOINTS));
+
+    // The addresses are sorted and don't overlap, so one read covers all of
+    // their original opcodes.
+    const lldb::addr_t start_addr = addrs.front ();
+    const lldb::addr_t span_size = addrs.back () + bp_opcode_size - start_addr;
+    if (log)
+        log->Printf ("SoftwareBreakpoint::%s %" PRIu64 " breakpoints in [0x%" PRIx64 ", 0x%" PRIx64 ")", __FUNCTION__, static_cast<uint64_t> (addrs.size ()), start_addr, start_addr + span_size);
+
+    std::vector<uint8_t> original_bytes (span_size);
+    lldb::addr_t bytes_read = 0;
+    Error error = process.ReadMemory (start_addr, &original_bytes[0], span_size, bytes_read);
+    if (error.Fail ())
+        return error;
+    if (bytes_read != span_size)
+        return Error ("SoftwareBreakpoint::%s attempted to read %" PRIu64 " bytes but only read %" PRIu64, __FUNCTION__, span_size, bytes_read);
+
+    // Patch the traps into a copy and write the whole span back at once.
+    std::vector<uint8_t> trap_bytes (original_bytes);
+    for (lldb::addr_t addr : addrs)
+        ::memcpy (&trap_bytes[addr - start_addr], bp_opcode_bytes, bp_opcode_size);
+
+    lldb::addr_t bytes_written = 0;
+    error = process.WriteMemory (start_addr, &trap_bytes[0], span_size, bytes_written);
+    if (error.Fail () || bytes_written != span_size)
+    {
+        // Put back whatever made it out so nothing is left half patched.
+        if (bytes_written > 0)
+        {
+            lldb::addr_t restored = 0;
+            process.WriteMemory (start_addr, &original_bytes[0], bytes_written, restored);
+        }
+        if (error.Success ())
+            error.SetErrorStringWithFormat ("SoftwareBreakpoint::%s attempted to write %" PRIu64 " bytes but only wrote %" PRIu64, __FUNCTION__, span_size, bytes_written);
+        return error;
+    }
+
+    // Verify with one more read, then create a breakpoint for every trap
+    // that made it.
+    std::vector<uint8_t> verify_bytes (span_size);
+    lldb::addr_t verify_bytes_read = 0;
+    error = process.ReadMemory (start_addr, &verify_bytes[0], span_size, verify_bytes_read);
+    if (error.Fail () || verify_bytes_read != span_size)
+    {
+        lldb::addr_t restored = 0;
+        process.WriteMemory (start_addr, &original_bytes[0], span_size, restored);
+        if (error.Success ())
+            error.SetErrorStringWithFormat ("SoftwareBreakpoint::%s attempted to read %" PRIu64 " verification bytes but only read %" PRIu64, __FUNCTION__, span_size, verify_bytes_read);
+        return error;
+    }
+
+    breakpoint_sps.clear ();
+    breakpoint_sps.resize (addrs.size ());
+    errors.clear ();
+    errors.resize (addrs.size ());
+    for (size_t i = 0; i < addrs.size (); ++i)
+    {
+        const lldb::addr_t offset = addrs[i] - start_addr;
+        if (::memcmp (&verify_bytes[offset], bp_opcode_bytes, bp_opcode_size) != 0)
+        {
+            errors[i].SetErrorStringWithFormat ("SoftwareBreakpoint::%s: verification of software breakpoint writing failed - trap opcodes not successfully read back after writing when setting breakpoint at 0x%" PRIx64, __FUNCTION__, addrs[i]);
+            continue;
+        }
+        breakpoint_sps[i].reset (new SoftwareBreakpoint (process, addrs[i], &original_bytes[offset], bp_opcode_bytes, bp_opcode_size));
+    }
+
+    if (log)
+        log->Printf ("SoftwareBreakpoint::%s [0x%" PRIx64 ", 0x%" PRIx64 ") -- SUCCESS", __FUNCTION__, start_addr, start_addr + span_size);
+    return Error ();
+}
+
+Error
+SoftwareBreakpoint::DisableSoftwareBreakpointsInPage (NativeProcessProtocol &process, const std::vector<SoftwareBreakpoint *> &breakpoints, std::vector<Error> &errors)
+{
+    assert (!breakpoints.empty () && "no breakpoints");
+
+    Log *log (GetLogIfAnyCategoriesSet (LIBLLDB_LOG_BREAKPOINTS));
+
+    const lldb::addr_t start_addr = breakpoints.front ()->GetAddress ();
+    const lldb::addr_t span_size = breakpoints.back ()->GetAddress () + breakpoints.back ()->m_opcode_size - start_addr;
+    if (log)
+        log->Printf ("SoftwareBreakpoint::%s %" PRIu64 " breakpoints in [0x%" PRIx64 ", 0x%" PRIx64 ")", __FUNCTION__, static_cast<uint64_t> (breakpoints.size ()), start_addr, start_addr + span_size);
+
+    std::vector<uint8_t> current_bytes (span_size);
+    lldb::addr_t bytes_read = 0;
+    Error error = process.ReadMemory (start_addr, &current_bytes[0], span_size, bytes_read);
+    if (error.Fail ())
+        return error;
+    if (bytes_read != span_size)
+        return Error ("SoftwareBreakpoint::%s attempted to read %" PRIu64 " bytes but only read %" PRIu64, __FUNCTION__, span_size, bytes_read);
+
+    // Only restore the opcodes where our trap is still in memory, the same
+    // as DoDisable ().
+    std::vector<uint8_t> restored_bytes (current_bytes);
+    std::vector<bool> break_op_found (breakpoints.size (), false);
+    for (size_t i = 0; i < breakpoints.size (); ++i)
+    {
+        const SoftwareBreakpoint *bp = breakpoints[i];
+        const lldb::addr_t offset = bp->GetAddress () - start_addr;
+        if (::memcmp (&current_bytes[offset], bp->m_trap_opcodes, bp->m_opcode_size) == 0)
+        {
+            ::memcpy (&restored_bytes[offset], bp->m_saved_opcodes, bp->m_opcode_size);
+            break_op_found[i] = true;
+        }
+    }
+
+    lldb::addr_t bytes_written = 0;
+    error = process.WriteMemory (start_addr, &restored_bytes[0], span_size, bytes_written);
+    if (error.Fail ())
+        return error;
+    if (bytes_written != span_size)
+        return Error ("SoftwareBreakpoint::%s attempted to write %" PRIu64 " bytes but only wrote %" PRIu64, __FUNCTION__, span_size, bytes_written);
+
+    std::vector<uint8_t> verify_bytes (span_size);
+    lldb::addr_t verify_bytes_read = 0;
+    error = process.ReadMemory (start_addr, &verify_bytes[0], span_size, verify_bytes_read);
+    if (error.Fail ())
+        return error;
+    if (verify_bytes_read != span_size)
+        return Error ("SoftwareBreakpoint::%s attempted to read %" PRIu64 " verification bytes but only read %" PRIu64, __FUNCTION__, span_size, verify_bytes_read);
+
+    errors.clear ();
+    errors.resize (breakpoints.size ());
+    for (size_t i = 0; i < breakpoints.size (); ++i)
+    {
+        const SoftwareBreakpoint *bp = breakpoints[i];
+        const lldb::addr_t offset = bp->GetAddress () - start_addr;
+        if (::memcmp (&verify_bytes[offset], bp->m_saved_opcodes, bp->m_opcode_size) == 0)
+            continue;
+        if (break_op_found[i])
+            errors[i].SetErrorString ("Failed to restore original opcode.");
+        else
+            errors[i].SetErrorString ("Original breakpoint trap is no longer in memory.");
+    }
+
+    if (log)
+        log->Printf ("SoftwareBreakpoint::%s [0x%" PRIx64 ", 0x%" PRIx64 ") -- SUCCESS", __FUNCTION__, start_addr, start_addr + span_size);
+    return Error ();
+}
+
 // -------------------------------------------------------------------
 // instance-level members
 // -------------------------------------------------------------------
@@ -10,6 +10,8 @@
 #ifndef liblldb_SoftwareBreakpoint_h_
 #define liblldb_SoftwareBreakpoint_h_
 
+#include <vector>
+
 #include "lldb/lldb-private-forward.h"
 #include "NativeBreakpoint.h"
 
@@ -21,6 +23,30 @@ namespace lldb_private
         static Error
         CreateSoftwareBreakpoint (NativeProcessProtocol &process, lldb::addr_t addr, size_t size_hint, NativeBreakpointSP &breakpoint_spn);
 
+        //------------------------------------------------------------------
+        /// Create software breakpoints at all of \a addrs.
+        ///
+        /// Breakpoints that fall in the same page are set with one read of
+        /// the original opcodes, one write of the trap opcodes and one
+        /// verification read, instead of three transfers per breakpoint.
+        ///
+        /// @param[out] breakpoint_sps
+        /// @param[out] errors
+        ///     Filled in with one entry per address in \a addrs.
+        //------------------------------------------------------------------
+        static void
+        CreateSoftwareBreakpoints (NativeProcessProtocol &process, const std::vector<lldb::addr_t> &addrs, size_t size_hint, std::vector<NativeBreakpointSP> &breakpoint_sps, std::vector<Error> &errors);
+
+        //------------------------------------------------------------------
+        /// Restore the original opcodes of all of the software breakpoints
+        /// in \a breakpoint_sps, one page at a time.
+        ///
+        /// @param[out] errors
+        ///     Filled in with one entry per breakpoint.
+        //------------------------------------------------------------------
+        static void
+        DisableSoftwareBreakpoints (NativeProcessProtocol &process, const std::vector<NativeBreakpointSP> &breakpoint_sps, std::vector<Error> &errors);
+
         SoftwareBreakpoint (NativeProcessProtocol &process, lldb::addr_t addr, const uint8_t *saved_opcodes, const uint8_t *trap_opcodes, size_t opcode_size);
 
     protected:
@@ -42,9 +68,21 @@ namespace lldb_private
         uint8_t m_trap_opcodes [MAX_TRAP_OPCODE_SIZE];
         const size_t m_opcode_size;
 
+        /// Breakpoints are batched by pages of this size.
+        static const lldb::addr_t BATCH_PAGE_SIZE = 4096;
+
         static Error
         EnableSoftwareBreakpoint (NativeProcessProtocol &process, lldb::addr_t addr, size_t bp_opcode_size, const uint8_t *bp_opcode_bytes, uint8_t *saved_opcode_bytes);
 
+        static Error
+        GetTrapOpcode (NativeProcessProtocol &process, size_t size_hint, size_t &bp_opcode_size, const uint8_t *&bp_opcode_bytes);
+
+        static Error
+        EnableSoftwareBreakpointsInPage (NativeProcessProtocol &process, const std::vector<lldb::addr_t> &addrs, size_t bp_opcode_size, const uint8_t *bp_opcode_bytes, std::vector<NativeBreakpointSP> &breakpoint_sps, std::vector<Error> &errors);
+
+        static Error
+        DisableSoftwareBreakpointsInPage (NativeProcessProtocol &process, const std::vector<SoftwareBreakpoint *> &breakpoints, std::vector<Error> &errors);
+
     };
 }
 
@@ -11,6 +11,7 @@
 
 #include "lldb/Core/ConstString.h"
 #include "lldb/Core/DataExtractor.h"
+#include "lldb/Core/Disassembler.h"
 #include "lldb/Core/Error.h"
 #include "lldb/Core/Log.h"
 #include "lldb/Core/Module.h"
@@ -1123,6 +1124,276 @@ ABISysV_x86_64::RegisterIsVolatile (const RegisterInfo *reg_info)
     return !RegisterIsCalleeSaved (reg_info);
 }
 
+static void
+AppendCode (std::vector<uint8_t> &code, const uint8_t *bytes, size_t size)
+{
+    code.insert (code.end(), bytes, bytes + size);
+}
+
+static void
+AppendAddress (std::vector<uint8_t> &code, uint64_t addr)
+{
+    for (size_t i = 0; i < sizeof(addr); ++i)
+        code.push_back ((uint8_t)(addr >> (8 * i)));
+}
+
+static void
+AppendUInt32 (std::vector<uint8_t> &code, uint32_t value)
+{
+    for (size_t i = 0; i < sizeof(value); ++i)
+        code.push_back ((uint8_t)(value >> (8 * i)));
+}
+
+//------------------------------------------------------------------
+// Decode just enough of the instruction in "bytes" to tell whether it
+// does the same thing when it runs from another address: it can't be a
+// relative branch or call and can't address memory relative to rip.
+// Anything that isn't understood is treated as position dependent.
+//------------------------------------------------------------------
+static bool
+InstructionIsPositionIndependent (const uint8_t *bytes, size_t size)
+{
+    size_t i = 0;
+
+    // Legacy prefixes, then at most one REX prefix.
+    while (i < size)
+    {
+        const uint8_t prefix = bytes[i];
+        if (prefix == 0x66 || prefix == 0x67 || prefix == 0xf0 || prefix == 0xf2 || prefix == 0xf3 ||
+            prefix == 0x2e || prefix == 0x36 || prefix == 0x3e || prefix == 0x26 || prefix == 0x64 || prefix == 0x65)
+            ++i;
+        else
+            break;
+    }
+    if (i < size && (bytes[i] & 0xf0) == 0x40)
+        ++i;
+    if (i >= size)
+        return false;
+
+    const uint8_t opcode = bytes[i++];
+    bool has_modrm = false;
+    if (opcode == 0x0f)
+    {
+        if (i >= size)
+            return false;
+        const uint8_t opcode2 = bytes[i++];
+        if ((opcode2 & 0xf0) == 0x80)                   // jcc rel32
+            return false;
+        if (opcode2 == 0x0f)                            // 3DNow!
+            return false;
+        if (opcode2 == 0x38 || opcode2 == 0x3a)
+        {
+            if (i >= size)
+                return false;
+            ++i;
+            has_modrm = true;
+        }
+        else
+        {
+            has_modrm = !((opcode2 >= 0x05 && opcode2 <= 0x09) ||
+                          opcode2 == 0x0b || opcode2 == 0x0e ||
+                          (opcode2 >= 0x30 && opcode2 <= 0x37) ||
+                          opcode2 == 0x77 ||
+                          (opcode2 >= 0xa0 && opcode2 <= 0xa2) ||
+                          (opcode2 >= 0xa8 && opcode2 <= 0xaa) ||
+                          (opcode2 >= 0xc8 && opcode2 <= 0xcf));
+        }
+    }
+    else
+    {
+        if ((opcode >= 0x70 && opcode <= 0x7f) ||       // jcc rel8
+            (opcode >= 0xe0 && opcode <= 0xe3) ||       // loop, jrcxz
+            opcode == 0xe8 || opcode == 0xe9 || opcode == 0xeb)
+            return false;
+        if (opcode == 0x62 || opcode == 0xc4 || opcode == 0xc5)  // EVEX, VEX
+            return false;
+        has_modrm = (opcode < 0x40 && (opcode & 0x07) < 4) ||
+                    opcode == 0x63 || opcode == 0x69 || opcode == 0x6b ||
+                    (opcode >= 0x80 && opcode <= 0x8f) ||
+                    opcode == 0xc0 || opcode == 0xc1 || opcode == 0xc6 || opcode == 0xc7 ||
+                    (opcode >= 0xd0 && opcode <= 0xd3) ||
+                    (opcode >= 0xd8 && opcode <= 0xdf) ||
+                    opcode == 0xf6 || opcode == 0xf7 || opcode == 0xfe || opcode == 0xff;
+    }
+
+    if (!has_modrm)
+        return true;
+    if (i >= size)
+        return false;
+    const uint8_t modrm = bytes[i];
+    const uint8_t mod = modrm >> 6;
+    const uint8_t reg = (modrm >> 3) & 0x07;
+    const uint8_t rm = modrm & 0x07;
+    if (opcode == 0xff && reg >= 2 && reg <= 5)         // indirect call and jmp
+        return false;
+    // mod 00 with r/m 101 is [rip + disp32] in 64 bit mode.
+    return !(mod == 0 && rm == 5);
+}
+
+size_t
+ABISysV_x86_64::GetJumpOpcode (addr_t from_addr,
+                               addr_t to_addr,
+                               uint8_t *opcode,
+                               size_t opcode_max_size)
+{
+    // jmp rel32, relative to the end of the five byte instruction.
+    const size_t jump_size = 5;
+    const int64_t displacement = (int64_t)(to_addr - (from_addr + jump_size));
+    if (opcode_max_size < jump_size || displacement < INT32_MIN || displacement > INT32_MAX)
+        return 0;
+
+    const uint32_t rel32 = (uint32_t)(int32_t)displacement;
+    opcode[0] = 0xe9;
+    for (size_t i = 0; i < 4; ++i)
+        opcode[1 + i] = (uint8_t)(rel32 >> (8 * i));
+    return jump_size;
+}
+
+bool
+ABISysV_x86_64::CreateConditionTrampoline (Instruction &insn,
+                                           addr_t insn_addr,
+                                           addr_t code_addr,
+                                           addr_t function_addr,
+                                           addr_t arg_addr,
+                                           size_t arg_size,
+                                           uint32_t result_ptr_offset,
+                                           size_t result_size,
+                                           addr_t hit_count_addr,
+                                           std::vector<uint8_t> &code,
+                                           addr_t &trap_addr)
+{
+    // Every call gets its own copy of the arguments on the stack with its
+    // own result slot after them, so threads that hit the site at the same
+    // time can't see each other's results.  Keep that frame small.
+    static const size_t g_max_arg_size = 4096;
+    if (arg_size == 0 || arg_size > g_max_arg_size || result_ptr_offset + 8 > arg_size)
+        return false;
+    const uint32_t result_slot_offset = (arg_size + 15) & ~(size_t)15;
+    const uint32_t frame_size = result_slot_offset + 16;
+
+    // The displaced instruction runs from the trampoline, so it can't
+    // depend on where it is.
+    if (insn.DoesBranch())
+        return false;
+    DataExtractor insn_data;
+    if (insn.GetOpcode().GetData (insn_data) == 0)
+        return false;
+    if (!InstructionIsPositionIndependent (insn_data.GetDataStart(), insn_data.GetByteSize()))
+        return false;
+
+    // Reads the result slot into eax or rax.
+    static const uint8_t g_load_result_1[] = { 0x0f, 0xb6, 0x84, 0x24 };   // movzx  eax, byte ptr [rsp + disp32]
+    static const uint8_t g_load_result_2[] = { 0x0f, 0xb7, 0x84, 0x24 };   // movzx  eax, word ptr [rsp + disp32]
+    static const uint8_t g_load_result_4[] = { 0x8b, 0x84, 0x24 };         // mov    eax, dword ptr [rsp + disp32]
+    static const uint8_t g_load_result_8[] = { 0x48, 0x8b, 0x84, 0x24 };   // mov    rax, qword ptr [rsp + disp32]
+    const uint8_t *load_result = NULL;
+    size_t load_result_size = 0;
+    switch (result_size)
+    {
+    case 1: load_result = g_load_result_1; load_result_size = sizeof(g_load_result_1); break;
+    case 2: load_result = g_load_result_2; load_result_size = sizeof(g_load_result_2); break;
+    case 4: load_result = g_load_result_4; load_result_size = sizeof(g_load_result_4); break;
+    case 8: load_result = g_load_result_8; load_result_size = sizeof(g_load_result_8); break;
+    default:
+        return false;
+    }
+
+    // Step over the red zone, save the flags and the registers the call can
+    // change and align the stack.  The condition is only injected if it
+    // doesn't use floating point or vector values, so the SSE registers are
+    // left alone.
+    static const uint8_t g_save[] =
+    {
+        0x48, 0x8d, 0x64, 0x24, 0x80,                   // lea    rsp, [rsp - 128]
+        0x9c,                                           // pushfq
+        0xfc,                                           // cld
+        0x50, 0x51, 0x52, 0x56, 0x57,                   // push   rax, rcx, rdx, rsi, rdi
+        0x41, 0x50, 0x41, 0x51, 0x41, 0x52, 0x41, 0x53, // push   r8, r9, r10, r11
+        0x55,                                           // push   rbp
+        0x48, 0x89, 0xe5,                               // mov    rbp, rsp
+        0x48, 0x83, 0xe4, 0xf0                          // and    rsp, -16
+    };
+    static const uint8_t g_sub_rsp[] = { 0x48, 0x81, 0xec };               // sub    rsp, imm32
+    static const uint8_t g_mov_rsi[] = { 0x48, 0xbe };                     // movabs rsi, imm64
+    static const uint8_t g_mov_rdi_rsp[] = { 0x48, 0x89, 0xe7 };           // mov    rdi, rsp
+    static const uint8_t g_mov_ecx[] = { 0xb9 };                           // mov    ecx, imm32
+    static const uint8_t g_rep_movsb[] = { 0xf3, 0xa4 };                   // rep movsb
+    static const uint8_t g_lea_rax_rsp[] = { 0x48, 0x8d, 0x84, 0x24 };     // lea    rax, [rsp + disp32]
+    static const uint8_t g_store_rax_rsp[] = { 0x48, 0x89, 0x84, 0x24 };   // mov    qword ptr [rsp + disp32], rax
+    static const uint8_t g_mov_rax[] = { 0x48, 0xb8 };                     // movabs rax, imm64
+    static const uint8_t g_call_rax[] = { 0xff, 0xd0 };                    // call   rax
+    static const uint8_t g_test_result[] = { 0x48, 0x85, 0xc0 };           // test   rax, rax
+
+    // Nothing from here on changes the flags until popfq, so the registers
+    // can be restored before branching on the result.
+    static const uint8_t g_restore[] =
+    {
+        0x48, 0x89, 0xec,                               // mov    rsp, rbp
+        0x5d,                                           // pop    rbp
+        0x41, 0x5b, 0x41, 0x5a, 0x41, 0x59, 0x41, 0x58, // pop    r11, r10, r9, r8
+        0x5f, 0x5e, 0x5a, 0x59, 0x58                    // pop    rdi, rsi, rdx, rcx, rax
+    };
+    static const uint8_t g_restore_flags[] =
+    {
+        0x9d,                                           // popfq
+        0x48, 0x8d, 0xa4, 0x24, 0x80, 0x00, 0x00, 0x00  // lea    rsp, [rsp + 128]
+    };
+    // Counts a hit that didn't stop.  The flags it changes are restored by
+    // the popfq that follows.
+    static const uint8_t g_count_hit[] = { 0x50, 0x48, 0xb8 };                       // push rax; movabs rax, imm64
+    static const uint8_t g_count_hit_end[] = { 0xf0, 0x48, 0xff, 0x00, 0x58 };      // lock inc qword ptr [rax]; pop rax
+    static const uint8_t g_jump_absolute[] = { 0xff, 0x25, 0x00, 0x00, 0x00, 0x00 }; // jmp qword ptr [rip]
+    static const uint8_t g_trap[] = { 0xcc };                                       // int3
+
+    code.clear();
+    AppendCode (code, g_save, sizeof(g_save));
+
+    // Copy the arguments to the stack, which stays 16 byte aligned, and
+    // point the copy's result pointer at the slot after them.
+    AppendCode (code, g_sub_rsp, sizeof(g_sub_rsp));
+    AppendUInt32 (code, frame_size);
+    AppendCode (code, g_mov_rsi, sizeof(g_mov_rsi));
+    AppendAddress (code, arg_addr);
+    AppendCode (code, g_mov_rdi_rsp, sizeof(g_mov_rdi_rsp));
+    AppendCode (code, g_mov_ecx, sizeof(g_mov_ecx));
+    AppendUInt32 (code, arg_size);
+    AppendCode (code, g_rep_movsb, sizeof(g_rep_movsb));
+    AppendCode (code, g_lea_rax_rsp, sizeof(g_lea_rax_rsp));
+    AppendUInt32 (code, result_slot_offset);
+    AppendCode (code, g_store_rax_rsp, sizeof(g_store_rax_rsp));
+    AppendUInt32 (code, result_ptr_offset);
+
+    AppendCode (code, g_mov_rdi_rsp, sizeof(g_mov_rdi_rsp));
+    AppendCode (code, g_mov_rax, sizeof(g_mov_rax));
+    AppendAddress (code, function_addr);
+    AppendCode (code, g_call_rax, sizeof(g_call_rax));
+    AppendCode (code, load_result, load_result_size);
+    AppendUInt32 (code, result_slot_offset);
+    AppendCode (code, g_test_result, sizeof(g_test_result));
+    AppendCode (code, g_restore, sizeof(g_restore));
+
+    // jnz over the path that resumes the program.
+    const size_t resume_path_size = sizeof(g_count_hit) + sizeof(uint64_t) + sizeof(g_count_hit_end) +
+                                    sizeof(g_restore_flags) + insn_data.GetByteSize() + sizeof(g_jump_absolute) + sizeof(uint64_t);
+    if (resume_path_size > INT8_MAX)
+        return false;
+    code.push_back (0x75);
+    code.push_back ((uint8_t)resume_path_size);
+
+    AppendCode (code, g_count_hit, sizeof(g_count_hit));
+    AppendAddress (code, hit_count_addr);
+    AppendCode (code, g_count_hit_end, sizeof(g_count_hit_end));
+    AppendCode (code, g_restore_flags, sizeof(g_restore_flags));
+    AppendCode (code, insn_data.GetDataStart(), insn_data.GetByteSize());
+    AppendCode (code, g_jump_absolute, sizeof(g_jump_absolute));
+    AppendAddress (code, insn_addr + insn_data.GetByteSize());
+
+    AppendCode (code, g_restore_flags, sizeof(g_restore_flags));
+    trap_addr = code_addr + code.size();
+    AppendCode (code, g_trap, sizeof(g_trap));
+    return true;
+}
+
 
 
 // See "Register Usage" in the 
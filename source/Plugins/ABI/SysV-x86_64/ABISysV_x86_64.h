@@ -105,6 +105,26 @@ public:
 
     virtual const lldb_private::RegisterInfo *
     GetRegisterInfoArray (uint32_t &count);
+
+    virtual size_t
+    GetJumpOpcode (lldb::addr_t from_addr,
+                   lldb::addr_t to_addr,
+                   uint8_t *opcode,
+                   size_t opcode_max_size);
+
+    virtual bool
+    CreateConditionTrampoline (lldb_private::Instruction &insn,
+                               lldb::addr_t insn_addr,
+                               lldb::addr_t code_addr,
+                               lldb::addr_t function_addr,
+                               lldb::addr_t arg_addr,
+                               size_t arg_size,
+                               uint32_t result_ptr_offset,
+                               size_t result_size,
+                               lldb::addr_t hit_count_addr,
+                               std::vector<uint8_t> &code,
+                               lldb::addr_t &trap_addr);
+
     //------------------------------------------------------------------
     // Static Functions
     //------------------------------------------------------------------
@@ -125,17 +125,29 @@ AppleObjCRuntime::GetObjectDescription (Stream &strm, Value &value, ExecutionCon
         }
     }
     
-    // Now we're ready to call the function:
-    ClangFunction func (*exe_ctx.GetBestExecutionContextScope(),
-                        return_clang_type, 
-                        *function_address, 
-                        arg_value_list,
-                        "objc-object-description");
-
+    // Now we're ready to call the function.  The wrapper is the same for
+    // every object, so the process compiles it once and we only write new
+    // arguments each time.
     StreamString error_stream;
     
+    ClangFunction *func = process->GetCallerFunction(*function_address,
+                                                     return_clang_type,
+                                                     arg_value_list,
+                                                     "objc-object-description",
+                                                     exe_ctx,
+                                                     error_stream);
+    if (!func)
+    {
+        strm.Printf("Couldn't compile the Print Object function: %s\n", error_stream.GetData());
+        return false;
+    }
+    
     lldb::addr_t wrapper_struct_addr = LLDB_INVALID_ADDRESS;
-    func.InsertFunction(exe_ctx, wrapper_struct_addr, error_stream);
+    if (!func->WriteFunctionArguments(exe_ctx, wrapper_struct_addr, *function_address, arg_value_list, error_stream))
+    {
+        strm.Printf("Couldn't write the Print Object function's arguments: %s\n", error_stream.GetData());
+        return false;
+    }
 
     EvaluateExpressionOptions options;
     options.SetUnwindOnError(true);
@@ -144,11 +156,12 @@ AppleObjCRuntime::GetObjectDescription (Stream &strm, Value &value, ExecutionCon
     options.SetIgnoreBreakpoints(true);
     options.SetTimeoutUsec(PO_FUNCTION_TIMEOUT_USEC);
     
-    ExpressionResults results = func.ExecuteFunction (exe_ctx, 
-                                                     &wrapper_struct_addr,
-                                                     options,
-                                                     error_stream, 
-                                                     ret);
+    ExpressionResults results = func->ExecuteFunction (exe_ctx, 
+                                                      &wrapper_struct_addr,
+                                                      options,
+                                                      error_stream, 
+                                                      ret);
+    func->DeallocateFunctionResults (exe_ctx, wrapper_struct_addr);
     if (results != eExpressionCompleted)
     {
         strm.Printf("Error evaluating Print Object function: %d.\n", results);
@@ -334,12 +334,12 @@ ExtractRuntimeGlobalSymbol (Process* process,
 AppleObjCRuntimeV2::AppleObjCRuntimeV2 (Process *process,
                                         const ModuleSP &objc_module_sp) :
     AppleObjCRuntime (process),
-    m_get_class_info_function(),
-    m_get_class_info_code(),
+    m_get_class_info_function(NULL),
+    m_get_class_info_code(NULL),
     m_get_class_info_args (LLDB_INVALID_ADDRESS),
     m_get_class_info_args_mutex (Mutex::eMutexTypeNormal),
-    m_get_shared_cache_class_info_function(),
-    m_get_shared_cache_class_info_code(),
+    m_get_shared_cache_class_info_function(NULL),
+    m_get_shared_cache_class_info_code(NULL),
     m_get_shared_cache_class_info_args (LLDB_INVALID_ADDRESS),
     m_get_shared_cache_class_info_args_mutex (Mutex::eMutexTypeNormal),
     m_type_vendor_ap (),
@@ -1733,74 +1733,54 @@ AppleObjCRuntimeV2::UpdateISAToDescriptorMapDynamic(RemoteNXMapTable &hash_table
     ClangASTType clang_uint32_t_type = ast->GetBuiltinTypeForEncodingAndBitSize(eEncodingUint, 32);
     ClangASTType clang_void_pointer_type = ast->GetBasicType(eBasicTypeVoid).GetPointerType();
     
-    if (!m_get_class_info_code.get())
+    // The process compiles the helper and its caller once and keeps them
+    // for as long as the JITted code stays in the inferior.
+    if (!m_get_class_info_code)
     {
-        m_get_class_info_code.reset (new ClangUtilityFunction (g_get_dynamic_class_info_body,
-                                                               g_get_dynamic_class_info_name));
-        
         errors.Clear();
         
-        if (!m_get_class_info_code->Install(errors, exe_ctx))
+        m_get_class_info_code = process->GetUtilityFunction (g_get_dynamic_class_info_body,
+                                                             g_get_dynamic_class_info_name,
+                                                             exe_ctx,
+                                                             errors);
+        if (!m_get_class_info_code)
         {
             if (log)
                 log->Printf ("Failed to install implementation lookup: %s.", errors.GetData());
-            m_get_class_info_code.reset();
+            return false;
         }
     }
     
-    if (m_get_class_info_code.get())
-        function_address.SetOffset(m_get_class_info_code->StartAddress());
-    else
-        return false;
+    function_address.SetOffset(m_get_class_info_code->StartAddress());
     
     ValueList arguments;
+    Value value;
+    value.SetValueType (Value::eValueTypeScalar);
+    value.SetClangType (clang_void_pointer_type);
+    arguments.PushValue (value);
+    arguments.PushValue (value);
+    
+    value.SetValueType (Value::eValueTypeScalar);
+    value.SetClangType (clang_uint32_t_type);
+    arguments.PushValue (value);
     
-    // Next make the runner function for our implementation utility function.
-    if (!m_get_class_info_function.get())
+    // Next get the runner function for our implementation utility function.
+    if (!m_get_class_info_function)
     {
-        Value value;
-        value.SetValueType (Value::eValueTypeScalar);
-//        value.SetContext (Value::eContextTypeClangType, clang_void_pointer_type);
-        value.SetClangType (clang_void_pointer_type);
-        arguments.PushValue (value);
-        arguments.PushValue (value);
-        
-        value.SetValueType (Value::eValueTypeScalar);
-//        value.SetContext (Value::eContextTypeClangType, clang_uint32_t_type);
-        value.SetClangType (clang_uint32_t_type);
-        arguments.PushValue (value);
-        
-        m_get_class_info_function.reset(new ClangFunction (*m_process,
-                                                           clang_uint32_t_type,
-                                                           function_address,
-                                                           arguments,
-                                                           "objc-v2-isa-to-descriptor"));
-        
-        if (m_get_class_info_function.get() == NULL)
-            return false;
-        
         errors.Clear();
         
-        unsigned num_errors = m_get_class_info_function->CompileFunction(errors);
-        if (num_errors)
+        m_get_class_info_function = process->GetCallerFunction (function_address,
+                                                                clang_uint32_t_type,
+                                                                arguments,
+                                                                "objc-v2-isa-to-descriptor",
+                                                                exe_ctx,
+                                                                errors);
+        if (!m_get_class_info_function)
         {
             if (log)
                 log->Printf ("Error compiling function: \"%s\".", errors.GetData());
             return false;
         }
-        
-        errors.Clear();
-        
-        if (!m_get_class_info_function->WriteFunctionWrapper(exe_ctx, errors))
-        {
-            if (log)
-                log->Printf ("Error Inserting function: \"%s\".", errors.GetData());
-            return false;
-        }
-    }
-    else
-    {
-        arguments = m_get_class_info_function->GetArgumentValues ();
     }
     
     const uint32_t class_info_byte_size = addr_size + 4;
@@ -1983,74 +1963,54 @@ AppleObjCRuntimeV2::UpdateISAToDescriptorMapSharedCache()
     ClangASTType clang_uint32_t_type = ast->GetBuiltinTypeForEncodingAndBitSize(eEncodingUint, 32);
     ClangASTType clang_void_pointer_type = ast->GetBasicType(eBasicTypeVoid).GetPointerType();
     
-    if (!m_get_shared_cache_class_info_code.get())
+    // The process compiles the helper and its caller once and keeps them
+    // for as long as the JITted code stays in the inferior.
+    if (!m_get_shared_cache_class_info_code)
     {
-        m_get_shared_cache_class_info_code.reset (new ClangUtilityFunction (g_get_shared_cache_class_info_body,
-                                                                            g_get_shared_cache_class_info_name));
-        
         errors.Clear();
         
-        if (!m_get_shared_cache_class_info_code->Install(errors, exe_ctx))
+        m_get_shared_cache_class_info_code = process->GetUtilityFunction (g_get_shared_cache_class_info_body,
+                                                                          g_get_shared_cache_class_info_name,
+                                                                          exe_ctx,
+                                                                          errors);
+        if (!m_get_shared_cache_class_info_code)
         {
             if (log)
                 log->Printf ("Failed to install implementation lookup: %s.", errors.GetData());
-            m_get_shared_cache_class_info_code.reset();
+            return false;
         }
     }
     
-    if (m_get_shared_cache_class_info_code.get())
-        function_address.SetOffset(m_get_shared_cache_class_info_code->StartAddress());
-    else
-        return false;
+    function_address.SetOffset(m_get_shared_cache_class_info_code->StartAddress());
     
     ValueList arguments;
+    Value value;
+    value.SetValueType (Value::eValueTypeScalar);
+    value.SetClangType (clang_void_pointer_type);
+    arguments.PushValue (value);
+    arguments.PushValue (value);
+    
+    value.SetValueType (Value::eValueTypeScalar);
+    value.SetClangType (clang_uint32_t_type);
+    arguments.PushValue (value);
     
-    // Next make the runner function for our implementation utility function.
-    if (!m_get_shared_cache_class_info_function.get())
+    // Next get the runner function for our implementation utility function.
+    if (!m_get_shared_cache_class_info_function)
     {
-        Value value;
-        value.SetValueType (Value::eValueTypeScalar);
-        //value.SetContext (Value::eContextTypeClangType, clang_void_pointer_type);
-        value.SetClangType (clang_void_pointer_type);
-        arguments.PushValue (value);
-        arguments.PushValue (value);
-        
-        value.SetValueType (Value::eValueTypeScalar);
-        //value.SetContext (Value::eContextTypeClangType, clang_uint32_t_type);
-        value.SetClangType (clang_uint32_t_type);
-        arguments.PushValue (value);
-        
-        m_get_shared_cache_class_info_function.reset(new ClangFunction (*m_process,
-                                                                        clang_uint32_t_type,
-                                                                        function_address,
-                                                                        arguments,
-                                                                        "objc-isa-to-descriptor-shared-cache"));
-        
-        if (m_get_shared_cache_class_info_function.get() == NULL)
-            return false;
-        
         errors.Clear();
         
-        unsigned num_errors = m_get_shared_cache_class_info_function->CompileFunction(errors);
-        if (num_errors)
+        m_get_shared_cache_class_info_function = process->GetCallerFunction (function_address,
+                                                                             clang_uint32_t_type,
+                                                                             arguments,
+                                                                             "objc-isa-to-descriptor-shared-cache",
+                                                                             exe_ctx,
+                                                                             errors);
+        if (!m_get_shared_cache_class_info_function)
         {
             if (log)
                 log->Printf ("Error compiling function: \"%s\".", errors.GetData());
             return false;
         }
-        
-        errors.Clear();
-        
-        if (!m_get_shared_cache_class_info_function->WriteFunctionWrapper(exe_ctx, errors))
-        {
-            if (log)
-                log->Printf ("Error Inserting function: \"%s\".", errors.GetData());
-            return false;
-        }
-    }
-    else
-    {
-        arguments = m_get_shared_cache_class_info_function->GetArgumentValues ();
     }
     
     const uint32_t class_info_byte_size = addr_size + 4;
@@ -260,13 +260,15 @@ private:
     lldb::addr_t
     GetSharedCacheReadOnlyAddress();
     
-    std::unique_ptr<ClangFunction>            m_get_class_info_function;
-    std::unique_ptr<ClangUtilityFunction>     m_get_class_info_code;
+    // The functions are owned by the process, which keeps them as long as
+    // this runtime.
+    ClangFunction                          *m_get_class_info_function;
+    ClangUtilityFunction                   *m_get_class_info_code;
     lldb::addr_t                            m_get_class_info_args;
     Mutex                                   m_get_class_info_args_mutex;
 
-    std::unique_ptr<ClangFunction>            m_get_shared_cache_class_info_function;
-    std::unique_ptr<ClangUtilityFunction>     m_get_shared_cache_class_info_code;
+    ClangFunction                          *m_get_shared_cache_class_info_function;
+    ClangUtilityFunction                   *m_get_shared_cache_class_info_code;
     lldb::addr_t                            m_get_shared_cache_class_info_args;
     Mutex                                   m_get_shared_cache_class_info_args_mutex;
 
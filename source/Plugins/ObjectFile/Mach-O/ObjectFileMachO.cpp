@@ -5220,12 +5220,11 @@ ObjectFileMachO::SaveCore (const lldb::ProcessSP &process_sp,
             if (make_core)
             {
                 std::vector<segment_command_64> segment_load_commands;
-//                uint32_t range_info_idx = 0;
-                MemoryRegionInfo range_info;
-                Error range_error = process_sp->GetMemoryRegionInfo(0, range_info);
+                std::vector<MemoryRegionInfo> regions;
+                Error range_error = process_sp->GetMemoryRegions(regions);
                 if (range_error.Success())
                 {
-                    while (range_info.GetRange().GetRangeBase() != LLDB_INVALID_ADDRESS)
+                    for (const MemoryRegionInfo &range_info : regions)
                     {
                         const addr_t addr = range_info.GetRange().GetRangeBase();
                         const addr_t size = range_info.GetRange().GetByteSize();
@@ -5242,14 +5241,6 @@ ObjectFileMachO::SaveCore (const lldb::ProcessSP &process_sp,
                         if (range_info.GetExecutable() == MemoryRegionInfo::eYes)
                             prot |= VM_PROT_EXECUTE;
 
-//                        printf ("[%3u] [0x%16.16" PRIx64 " - 0x%16.16" PRIx64 ") %c%c%c\n",
-//                                range_info_idx,
-//                                addr,
-//                                size,
-//                                (prot & VM_PROT_READ   ) ? 'r' : '-',
-//                                (prot & VM_PROT_WRITE  ) ? 'w' : '-',
-//                                (prot & VM_PROT_EXECUTE) ? 'x' : '-');
-
                         if (prot != 0)
                         {
                             segment_command_64 segment = {
@@ -5266,18 +5257,6 @@ ObjectFileMachO::SaveCore (const lldb::ProcessSP &process_sp,
                                 0 };                // uint32_t flags;
                             segment_load_commands.push_back(segment);
                         }
-                        else
-                        {
-                            // No protections and a size of 1 used to be returned from old
-                            // debugservers when we asked about a region that was past the
-                            // last memory region and it indicates the end...
-                            if (size == 1)
-                                break;
-                        }
-                        
-                        range_error = process_sp->GetMemoryRegionInfo(range_info.GetRange().GetRangeEnd(), range_info);
-                        if (range_error.Fail())
-                            break;
                     }
                     
                     const uint32_t addr_byte_size = target_arch.GetAddressByteSize();
@@ -13,6 +13,7 @@
 
 // C Includes
 #include <errno.h>
+#include <fcntl.h>
 #include <poll.h>
 #include <string.h>
 #include <stdint.h>
@@ -22,10 +23,12 @@
 #include <sys/socket.h>
 #include <sys/syscall.h>
 #include <sys/types.h>
+#include <sys/uio.h>
 #include <sys/user.h>
 #include <sys/wait.h>
 
 // C++ Includes
+#include <algorithm>
 #include <fstream>
 #include <string>
 
@@ -306,6 +309,56 @@ namespace
     }
 #endif
 
+    //------------------------------------------------------------------------------
+    // Bulk memory access helpers.  Transfers larger than a ptrace word go
+    // through process_vm_readv() and /proc/<pid>/mem so that, for example,
+    // patching every breakpoint in a page costs a couple of syscalls rather
+    // than one ptrace call per word.  Both return the number of bytes
+    // transferred; callers finish whatever is left with ptrace.
+
+    static lldb::addr_t
+    DoReadMemoryBulk (lldb::pid_t pid, lldb::addr_t vm_addr, void *buf, lldb::addr_t size)
+    {
+        lldb::addr_t bytes_read = 0;
+        while (bytes_read < size)
+        {
+            struct iovec local_iov;
+            struct iovec remote_iov;
+            local_iov.iov_base = static_cast<uint8_t *>(buf) + bytes_read;
+            local_iov.iov_len = size - bytes_read;
+            remote_iov.iov_base = reinterpret_cast<void *>(vm_addr + bytes_read);
+            remote_iov.iov_len = size - bytes_read;
+            const ssize_t result = process_vm_readv (static_cast< ::pid_t>(pid), &local_iov, 1, &remote_iov, 1, 0);
+            if (result <= 0)
+                break;
+            bytes_read += result;
+        }
+        return bytes_read;
+    }
+
+    static lldb::addr_t
+    DoWriteMemoryBulk (lldb::pid_t pid, lldb::addr_t vm_addr, const void *buf, lldb::addr_t size)
+    {
+        // process_vm_writev() honors page protections, /proc/<pid>/mem writes
+        // from a tracer do not, which is what we need for patching code.
+        char mem_path[64];
+        ::snprintf (mem_path, sizeof (mem_path), "/proc/%" PRIu64 "/mem", pid);
+        const int fd = ::open (mem_path, O_RDWR | O_CLOEXEC);
+        if (fd < 0)
+            return 0;
+
+        lldb::addr_t bytes_written = 0;
+        while (bytes_written < size)
+        {
+            const ssize_t result = ::pwrite64 (fd, static_cast<const uint8_t *>(buf) + bytes_written, size - bytes_written, vm_addr + bytes_written);
+            if (result <= 0)
+                break;
+            bytes_written += result;
+        }
+        ::close (fd);
+        return bytes_written;
+    }
+
     //------------------------------------------------------------------------------
     // Static implementations of NativeProcessLinux::ReadMemory and
     // NativeProcessLinux::WriteMemory.  This enables mutual recursion between these
@@ -334,7 +387,18 @@ namespace
                     pid, word_size, (void*)vm_addr, buf, size);
 
         assert(sizeof(data) >= word_size);
-        for (bytes_read = 0; bytes_read < size; bytes_read += remainder)
+        bytes_read = 0;
+        if (size > word_size)
+        {
+            bytes_read = DoReadMemoryBulk (pid, vm_addr, buf, size);
+            if (log && ProcessPOSIXLog::AtTopNestLevel() && log->GetMask().Test(POSIX_LOG_MEMORY))
+                log->Printf ("NativeProcessLinux::%s() bulk read %" PRIu64 " of %" PRIu64 " bytes", __FUNCTION__,
+                        bytes_read, size);
+            vm_addr += bytes_read;
+            dst += bytes_read;
+        }
+
+        for (; bytes_read < size; bytes_read += remainder)
         {
             errno = 0;
             data = PTRACE(PTRACE_PEEKDATA, pid, (void*)vm_addr, NULL, 0);
@@ -396,7 +460,17 @@ namespace
             log->Printf ("NativeProcessLinux::%s(%" PRIu64 ", %u, %p, %p, %" PRIu64 ")", __FUNCTION__,
                     pid, word_size, (void*)vm_addr, buf, size);
 
-        for (bytes_written = 0; bytes_written < size; bytes_written += remainder)
+        if (size > word_size)
+        {
+            bytes_written = DoWriteMemoryBulk (pid, vm_addr, buf, size);
+            if (log && ProcessPOSIXLog::AtTopNestLevel() && log->GetMask().Test(POSIX_LOG_MEMORY))
+                log->Printf ("NativeProcessLinux::%s() bulk wrote %" PRIu64 " of %" PRIu64 " bytes", __FUNCTION__,
+                        bytes_written, size);
+            vm_addr += bytes_written;
+            src += bytes_written;
+        }
+
+        for (; bytes_written < size; bytes_written += remainder)
         {
             remainder = size - bytes_written;
             remainder = remainder > word_size ? word_size : remainder;
@@ -1957,6 +2031,9 @@ NativeProcessLinux::MonitorSIGTRAP(const siginfo_t *info, lldb::pid_t pid)
         if (log)
             log->Printf ("NativeProcessLinux::%s() pid %" PRIu64 " received thread creation event for tid %" PRIu64, __FUNCTION__, pid, tid);
 
+        // The new thread's stack was just mapped.
+        InvalidateMemoryRegionCache ();
+
         // If we don't track the thread yet: create it, mark as stopped.
         // If we do track it, this is the wait we needed.  Now resume the new thread.
         // In all cases, resume the current (i.e. main process) thread.
@@ -1989,6 +2066,8 @@ NativeProcessLinux::MonitorSIGTRAP(const siginfo_t *info, lldb::pid_t pid)
     case (SIGTRAP | (PTRACE_EVENT_EXEC << 8)):
         if (log)
             log->Printf ("NativeProcessLinux::%s() received exec event, code = %d", __FUNCTION__, info->si_code ^ SIGTRAP);
+        // The old address space is gone.
+        InvalidateMemoryRegionCache ();
         // FIXME stop all threads, mark thread stop reason as ThreadStopInfo.reason = eStopReasonExec;
         break;
 
@@ -2313,6 +2392,9 @@ NativeProcessLinux::Resume (const ResumeActionList &resume_actions)
     if (log)
         log->Printf ("NativeProcessLinux::%s called: pid %" PRIu64, __FUNCTION__, GetID ());
 
+    // The inferior is free to map and unmap memory once it runs.
+    InvalidateMemoryRegionCache ();
+
     int run_thread_count = 0;
     int stop_thread_count = 0;
     int step_thread_count = 0;
@@ -2586,16 +2668,9 @@ ParseMemoryRegionInfoFromProcMapsLine (const std::string &maps_line, MemoryRegio
 }
 
 Error
-NativeProcessLinux::GetMemoryRegionInfo (lldb::addr_t load_addr, MemoryRegionInfo &range_info)
+NativeProcessLinux::PopulateMemoryRegionCache ()
 {
-    // FIXME review that the final memory region returned extends to the end of the virtual address space,
-    // with no perms if it is not mapped.
-
-    // Use an approach that reads memory regions from /proc/{pid}/maps.
-    // Assume proc maps entries are in ascending order.
-    // FIXME assert if we find differently.
-    Mutex::Locker locker (m_mem_region_cache_mutex);
-
+    // Callers must hold m_mem_region_cache_mutex.
     Log *log (GetLogIfAllCategoriesSet (LIBLLDB_LOG_PROCESS));
     Error error;
 
@@ -2606,88 +2681,118 @@ NativeProcessLinux::GetMemoryRegionInfo (lldb::addr_t load_addr, MemoryRegionInf
         return error;
     }
 
-    // If our cache is empty, pull the latest.  There should always be at least one memory region
-    // if memory region handling is supported.
-    if (m_mem_region_cache.empty ())
+    // If our cache is populated, reuse it.  It is thrown away whenever the
+    // inferior runs or does something that is likely to change its mappings.
+    if (!m_mem_region_cache.empty ())
     {
-        error = ProcFileReader::ProcessLineByLine (GetID (), "maps",
-             [&] (const std::string &line) -> bool
-             {
-                 MemoryRegionInfo info;
-                 const Error parse_error = ParseMemoryRegionInfoFromProcMapsLine (line, info);
-                 if (parse_error.Success ())
-                 {
-                     m_mem_region_cache.push_back (info);
-                     return true;
-                 }
-                 else
-                 {
-                     if (log)
-                         log->Printf ("NativeProcessLinux::%s failed to parse proc maps line '%s': %s", __FUNCTION__, line.c_str (), error.AsCString ());
-                     return false;
-                 }
-             });
-
-        // If we had an error, we'll mark unsupported.
-        if (error.Fail ())
-        {
-            m_supports_mem_region = LazyBool::eLazyBoolNo;
-            return error;
-        }
-        else if (m_mem_region_cache.empty ())
-        {
-            // No entries after attempting to read them.  This shouldn't happen if /proc/{pid}/maps
-            // is supported.  Assume we don't support map entries via procfs.
-            if (log)
-                log->Printf ("NativeProcessLinux::%s failed to find any procfs maps entries, assuming no support for memory region metadata retrieval", __FUNCTION__);
-            m_supports_mem_region = LazyBool::eLazyBoolNo;
-            error.SetErrorString ("not supported");
-            return error;
-        }
-
         if (log)
-            log->Printf ("NativeProcessLinux::%s read %" PRIu64 " memory region entries from /proc/%" PRIu64 "/maps", __FUNCTION__, static_cast<uint64_t> (m_mem_region_cache.size ()), GetID ());
+            log->Printf ("NativeProcessLinux::%s reusing %" PRIu64 " cached memory region entries", __FUNCTION__, static_cast<uint64_t> (m_mem_region_cache.size ()));
+        return error;
+    }
+
+    // There should always be at least one memory region if memory region
+    // handling is supported.
+    error = ProcFileReader::ProcessLineByLine (GetID (), "maps",
+         [&] (const std::string &line) -> bool
+         {
+             MemoryRegionInfo info;
+             const Error parse_error = ParseMemoryRegionInfoFromProcMapsLine (line, info);
+             if (parse_error.Success ())
+             {
+                 m_mem_region_cache.push_back (info);
+                 return true;
+             }
+             else
+             {
+                 if (log)
+                     log->Printf ("NativeProcessLinux::%s failed to parse proc maps line '%s': %s", __FUNCTION__, line.c_str (), parse_error.AsCString ());
+                 return false;
+             }
+         });
 
-        // We support memory retrieval, remember that.
-        m_supports_mem_region = LazyBool::eLazyBoolYes;
+    // If we had an error, we'll mark unsupported.
+    if (error.Fail ())
+    {
+        m_supports_mem_region = LazyBool::eLazyBoolNo;
+        m_mem_region_cache.clear ();
+        return error;
     }
-    else
+    else if (m_mem_region_cache.empty ())
     {
+        // No entries after attempting to read them.  This shouldn't happen if /proc/{pid}/maps
+        // is supported.  Assume we don't support map entries via procfs.
         if (log)
-            log->Printf ("NativeProcessLinux::%s reusing %" PRIu64 " cached memory region entries", __FUNCTION__, static_cast<uint64_t> (m_mem_region_cache.size ()));
+            log->Printf ("NativeProcessLinux::%s failed to find any procfs maps entries, assuming no support for memory region metadata retrieval", __FUNCTION__);
+        m_supports_mem_region = LazyBool::eLazyBoolNo;
+        error.SetErrorString ("not supported");
+        return error;
     }
 
-    lldb::addr_t prev_base_address = 0;
+    // The lookups below binary search the cache, so make sure the kernel
+    // handed us the entries in ascending order.
+    std::sort (m_mem_region_cache.begin (), m_mem_region_cache.end (),
+               [] (const MemoryRegionInfo &lhs, const MemoryRegionInfo &rhs)
+               { return lhs.GetRange ().GetRangeBase () < rhs.GetRange ().GetRangeBase (); });
 
-    // FIXME start by finding the last region that is <= target address using binary search.  Data is sorted.
-    // There can be a ton of regions on pthreads apps with lots of threads.
-    for (auto it = m_mem_region_cache.begin(); it != m_mem_region_cache.end (); ++it)
-    {
-        MemoryRegionInfo &proc_entry_info = *it;
+    if (log)
+        log->Printf ("NativeProcessLinux::%s read %" PRIu64 " memory region entries from /proc/%" PRIu64 "/maps", __FUNCTION__, static_cast<uint64_t> (m_mem_region_cache.size ()), GetID ());
 
-        // Sanity check assumption that /proc/{pid}/maps entries are ascending.
-        assert ((proc_entry_info.GetRange ().GetRangeBase () >= prev_base_address) && "descending /proc/pid/maps entries detected, unexpected");
-        prev_base_address = proc_entry_info.GetRange ().GetRangeBase ();
+    // We support memory retrieval, remember that.
+    m_supports_mem_region = LazyBool::eLazyBoolYes;
+    return error;
+}
 
-        // If the target address comes before this entry, indicate distance to next region.
-        if (load_addr < proc_entry_info.GetRange ().GetRangeBase ())
-        {
-            range_info.GetRange ().SetRangeBase (load_addr);
-            range_info.GetRange ().SetByteSize (proc_entry_info.GetRange ().GetRangeBase () - load_addr);
-            range_info.SetReadable (MemoryRegionInfo::OptionalBool::eNo);
-            range_info.SetWritable (MemoryRegionInfo::OptionalBool::eNo);
-            range_info.SetExecutable (MemoryRegionInfo::OptionalBool::eNo);
+void
+NativeProcessLinux::InvalidateMemoryRegionCache ()
+{
+    Log *log (GetLogIfAllCategoriesSet (LIBLLDB_LOG_PROCESS));
 
-            return error;
-        }
-        else if (proc_entry_info.GetRange ().Contains (load_addr))
+    Mutex::Locker locker (m_mem_region_cache_mutex);
+    if (log && !m_mem_region_cache.empty ())
+        log->Printf ("NativeProcessLinux::%s clearing %" PRIu64 " entries from the cache", __FUNCTION__, static_cast<uint64_t> (m_mem_region_cache.size ()));
+    m_mem_region_cache.clear ();
+}
+
+Error
+NativeProcessLinux::GetMemoryRegionInfo (lldb::addr_t load_addr, MemoryRegionInfo &range_info)
+{
+    // FIXME review that the final memory region returned extends to the end of the virtual address space,
+    // with no perms if it is not mapped.
+
+    // Use an approach that reads memory regions from /proc/{pid}/maps.
+    Mutex::Locker locker (m_mem_region_cache_mutex);
+
+    Log *log (GetLogIfAllCategoriesSet (LIBLLDB_LOG_PROCESS));
+    Error error = PopulateMemoryRegionCache ();
+    if (error.Fail ())
+        return error;
+
+    // Find the first region that starts after the target address.  The one
+    // before it, if any, is the only one that can contain the address.
+    auto it = std::upper_bound (m_mem_region_cache.begin (), m_mem_region_cache.end (), load_addr,
+                                [] (lldb::addr_t addr, const MemoryRegionInfo &info)
+                                { return addr < info.GetRange ().GetRangeBase (); });
+
+    if (it != m_mem_region_cache.begin ())
+    {
+        const MemoryRegionInfo &proc_entry_info = *(it - 1);
+        if (proc_entry_info.GetRange ().Contains (load_addr))
         {
             // The target address is within the memory region we're processing here.
             range_info = proc_entry_info;
             return error;
         }
+    }
 
-        // The target memory address comes somewhere after the region we just parsed.
+    if (it != m_mem_region_cache.end ())
+    {
+        // The target address comes before this entry, indicate distance to next region.
+        range_info.GetRange ().SetRangeBase (load_addr);
+        range_info.GetRange ().SetByteSize (it->GetRange ().GetRangeBase () - load_addr);
+        range_info.SetReadable (MemoryRegionInfo::OptionalBool::eNo);
+        range_info.SetWritable (MemoryRegionInfo::OptionalBool::eNo);
+        range_info.SetExecutable (MemoryRegionInfo::OptionalBool::eNo);
+        return error;
     }
 
     // If we made it here, we didn't find an entry that contained the given address.
@@ -2699,6 +2804,18 @@ NativeProcessLinux::GetMemoryRegionInfo (lldb::addr_t load_addr, MemoryRegionInf
     return error;
 }
 
+Error
+NativeProcessLinux::GetMemoryRegions (std::vector<MemoryRegionInfo> &regions)
+{
+    regions.clear ();
+
+    Mutex::Locker locker (m_mem_region_cache_mutex);
+    Error error = PopulateMemoryRegionCache ();
+    if (error.Success ())
+        regions = m_mem_region_cache;
+    return error;
+}
+
 void
 NativeProcessLinux::DoStopIDBumped (uint32_t newBumpId)
 {
@@ -2706,12 +2823,7 @@ NativeProcessLinux::DoStopIDBumped (uint32_t newBumpId)
     if (log)
         log->Printf ("NativeProcessLinux::%s(newBumpId=%" PRIu32 ") called", __FUNCTION__, newBumpId);
 
-    {
-        Mutex::Locker locker (m_mem_region_cache_mutex);
-        if (log)
-            log->Printf ("NativeProcessLinux::%s clearing %" PRIu64 " entries from the cache", __FUNCTION__, static_cast<uint64_t> (m_mem_region_cache.size ()));
-        m_mem_region_cache.clear ();
-    }
+    InvalidateMemoryRegionCache ();
 }
 
 Error
@@ -86,6 +86,9 @@ namespace lldb_private
         Error
         GetMemoryRegionInfo (lldb::addr_t load_addr, MemoryRegionInfo &range_info) override;
 
+        Error
+        GetMemoryRegions (std::vector<MemoryRegionInfo> &regions) override;
+
         Error
         ReadMemory (lldb::addr_t addr, void *buf, lldb::addr_t size, lldb::addr_t &bytes_read) override;
 
@@ -329,6 +332,15 @@ namespace lldb_private
         void
         StopMonitor();
 
+        /// Reads /proc/{pid}/maps into m_mem_region_cache if it is empty.
+        /// The caller must hold m_mem_region_cache_mutex.
+        Error
+        PopulateMemoryRegionCache ();
+
+        /// Drops the cached memory regions so the next query re-reads them.
+        void
+        InvalidateMemoryRegionCache ();
+
         bool
         HasThreadNoLock (lldb::tid_t thread_id);
 
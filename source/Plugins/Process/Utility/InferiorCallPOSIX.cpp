@@ -48,97 +48,79 @@ lldb_private::InferiorCallMmap (Process *process,
     if (thread == NULL)
         return false;
 
-    const bool append = true;
-    const bool include_symbols = true;
-    const bool include_inlines = false;
-    SymbolContextList sc_list;
-    const uint32_t count
-      = process->GetTarget().GetImages().FindFunctions (ConstString ("mmap"), 
-                                                        eFunctionNameTypeFull,
-                                                        include_symbols,
-                                                        include_inlines,
-                                                        append, 
-                                                        sc_list);
-    if (count > 0)
-    {
-        SymbolContext sc;
-        if (sc_list.GetContextAtIndex(0, sc))
-        {
-            const uint32_t range_scope = eSymbolContextFunction | eSymbolContextSymbol;
-            const bool use_inline_block_range = false;
-            EvaluateExpressionOptions options;
-            options.SetStopOthers(true);
-            options.SetUnwindOnError(true);
-            options.SetIgnoreBreakpoints(true);
-            options.SetTryAllThreads(true);
-            options.SetDebug (false);
-            options.SetTimeoutUsec(500000);
+    // The process remembers where mmap is, so we don't search all the
+    // images for it every time we allocate memory.
+    Address mmap_addr;
+    if (!process->GetHelperFunctionAddress (ConstString ("mmap"), mmap_addr))
+        return false;
 
-            addr_t prot_arg, flags_arg = 0;
-            if (prot == eMmapProtNone)
-              prot_arg = PROT_NONE;
-            else {
-              prot_arg = 0;
-              if (prot & eMmapProtExec)
-                prot_arg |= PROT_EXEC;
-              if (prot & eMmapProtRead)
-                prot_arg |= PROT_READ;
-              if (prot & eMmapProtWrite)
-                prot_arg |= PROT_WRITE;
-            }
+    EvaluateExpressionOptions options;
+    options.SetStopOthers(true);
+    options.SetUnwindOnError(true);
+    options.SetIgnoreBreakpoints(true);
+    options.SetTryAllThreads(true);
+    options.SetDebug (false);
+    options.SetTimeoutUsec(500000);
+
+    addr_t prot_arg, flags_arg = 0;
+    if (prot == eMmapProtNone)
+      prot_arg = PROT_NONE;
+    else {
+      prot_arg = 0;
+      if (prot & eMmapProtExec)
+        prot_arg |= PROT_EXEC;
+      if (prot & eMmapProtRead)
+        prot_arg |= PROT_READ;
+      if (prot & eMmapProtWrite)
+        prot_arg |= PROT_WRITE;
+    }
 
-            if (flags & eMmapFlagsPrivate)
-              flags_arg |= MAP_PRIVATE;
-            if (flags & eMmapFlagsAnon)
-              flags_arg |= MAP_ANON;
+    if (flags & eMmapFlagsPrivate)
+      flags_arg |= MAP_PRIVATE;
+    if (flags & eMmapFlagsAnon)
+      flags_arg |= MAP_ANON;
 
-            AddressRange mmap_range;
-            if (sc.GetAddressRange(range_scope, 0, use_inline_block_range, mmap_range))
+    ClangASTContext *clang_ast_context = process->GetTarget().GetScratchClangASTContext();
+    ClangASTType clang_void_ptr_type = clang_ast_context->GetBasicType(eBasicTypeVoid).GetPointerType();
+    lldb::addr_t args[] = { addr, length, prot_arg, flags_arg, fd, offset };
+    ThreadPlanCallFunction *call_function_thread_plan
+      = new ThreadPlanCallFunction (*thread,
+                                    mmap_addr,
+                                    clang_void_ptr_type,
+                                    args,
+                                    options);
+    lldb::ThreadPlanSP call_plan_sp (call_function_thread_plan);
+    if (call_plan_sp)
+    {
+        StreamFile error_strm;
+        // This plan is a utility plan, so set it to discard itself when done.
+        call_plan_sp->SetIsMasterPlan (true);
+        call_plan_sp->SetOkayToDiscard(true);
+
+        StackFrame *frame = thread->GetStackFrameAtIndex (0).get();
+        if (frame)
+        {
+            ExecutionContext exe_ctx;
+            frame->CalculateExecutionContext (exe_ctx);
+            ExpressionResults result = process->RunThreadPlan (exe_ctx,
+                                                              call_plan_sp,
+                                                              options,
+                                                              error_strm);
+            if (result == eExpressionCompleted)
             {
-                ClangASTContext *clang_ast_context = process->GetTarget().GetScratchClangASTContext();
-                ClangASTType clang_void_ptr_type = clang_ast_context->GetBasicType(eBasicTypeVoid).GetPointerType();
-                lldb::addr_t args[] = { addr, length, prot_arg, flags_arg, fd, offset };
-                ThreadPlanCallFunction *call_function_thread_plan
-                  = new ThreadPlanCallFunction (*thread,
-                                                mmap_range.GetBaseAddress(),
-                                                clang_void_ptr_type,
-                                                args,
-                                                options);
-                lldb::ThreadPlanSP call_plan_sp (call_function_thread_plan);
-                if (call_plan_sp)
+
+                allocated_addr = call_plan_sp->GetReturnValueObject()->GetValueAsUnsigned(LLDB_INVALID_ADDRESS);
+                if (process->GetAddressByteSize() == 4)
+                {
+                    if (allocated_addr == UINT32_MAX)
+                        return false;
+                }
+                else if (process->GetAddressByteSize() == 8)
                 {
-                    StreamFile error_strm;
-                    // This plan is a utility plan, so set it to discard itself when done.
-                    call_plan_sp->SetIsMasterPlan (true);
-                    call_plan_sp->SetOkayToDiscard(true);
-                    
-                    StackFrame *frame = thread->GetStackFrameAtIndex (0).get();
-                    if (frame)
-                    {
-                        ExecutionContext exe_ctx;
-                        frame->CalculateExecutionContext (exe_ctx);
-                        ExpressionResults result = process->RunThreadPlan (exe_ctx,
-                                                                          call_plan_sp,
-                                                                          options,
-                                                                          error_strm);
-                        if (result == eExpressionCompleted)
-                        {
-                            
-                            allocated_addr = call_plan_sp->GetReturnValueObject()->GetValueAsUnsigned(LLDB_INVALID_ADDRESS);
-                            if (process->GetAddressByteSize() == 4)
-                            {
-                                if (allocated_addr == UINT32_MAX)
-                                    return false;
-                            }
-                            else if (process->GetAddressByteSize() == 8)
-                            {
-                                if (allocated_addr == UINT64_MAX)
-                                    return false;
-                            }
-                            return true;
-                        }
-                    }
+                    if (allocated_addr == UINT64_MAX)
+                        return false;
                 }
+                return true;
             }
         }
     }
@@ -151,67 +133,47 @@ lldb_private::InferiorCallMunmap (Process *process,
                                   addr_t addr,
                                   addr_t length)
 {
-   Thread *thread = process->GetThreadList().GetSelectedThread().get();
-   if (thread == NULL)
-       return false;
-   
-   const bool append = true;
-   const bool include_symbols = true;
-   const bool include_inlines = false;
-   SymbolContextList sc_list;
-   const uint32_t count
-     = process->GetTarget().GetImages().FindFunctions (ConstString ("munmap"), 
-                                                       eFunctionNameTypeFull,
-                                                       include_symbols, 
-                                                       include_inlines,
-                                                       append, 
-                                                       sc_list);
-   if (count > 0)
-   {
-       SymbolContext sc;
-       if (sc_list.GetContextAtIndex(0, sc))
-       {
-            const uint32_t range_scope = eSymbolContextFunction | eSymbolContextSymbol;
-            const bool use_inline_block_range = false;
-            EvaluateExpressionOptions options;
-            options.SetStopOthers(true);
-            options.SetUnwindOnError(true);
-            options.SetIgnoreBreakpoints(true);
-            options.SetTryAllThreads(true);
-            options.SetDebug (false);
-            options.SetTimeoutUsec(500000);
-           
-            AddressRange munmap_range;
-            if (sc.GetAddressRange(range_scope, 0, use_inline_block_range, munmap_range))
+    Thread *thread = process->GetThreadList().GetSelectedThread().get();
+    if (thread == NULL)
+        return false;
+
+    Address munmap_addr;
+    if (!process->GetHelperFunctionAddress (ConstString ("munmap"), munmap_addr))
+        return false;
+
+    EvaluateExpressionOptions options;
+    options.SetStopOthers(true);
+    options.SetUnwindOnError(true);
+    options.SetIgnoreBreakpoints(true);
+    options.SetTryAllThreads(true);
+    options.SetDebug (false);
+    options.SetTimeoutUsec(500000);
+
+    lldb::addr_t args[] = { addr, length };
+    lldb::ThreadPlanSP call_plan_sp (new ThreadPlanCallFunction (*thread,
+                                                                munmap_addr,
+                                                                ClangASTType(),
+                                                                args,
+                                                                options));
+    if (call_plan_sp)
+    {
+        StreamFile error_strm;
+        // This plan is a utility plan, so set it to discard itself when done.
+        call_plan_sp->SetIsMasterPlan (true);
+        call_plan_sp->SetOkayToDiscard(true);
+
+        StackFrame *frame = thread->GetStackFrameAtIndex (0).get();
+        if (frame)
+        {
+            ExecutionContext exe_ctx;
+            frame->CalculateExecutionContext (exe_ctx);
+            ExpressionResults result = process->RunThreadPlan (exe_ctx,
+                                                              call_plan_sp,
+                                                              options,
+                                                              error_strm);
+            if (result == eExpressionCompleted)
             {
-                lldb::addr_t args[] = { addr, length };
-                lldb::ThreadPlanSP call_plan_sp (new ThreadPlanCallFunction (*thread,
-                                                                            munmap_range.GetBaseAddress(),
-                                                                            ClangASTType(),
-                                                                            args,
-                                                                            options));
-                if (call_plan_sp)
-                {
-                    StreamFile error_strm;
-                    // This plan is a utility plan, so set it to discard itself when done.
-                    call_plan_sp->SetIsMasterPlan (true);
-                    call_plan_sp->SetOkayToDiscard(true);
-                   
-                    StackFrame *frame = thread->GetStackFrameAtIndex (0).get();
-                    if (frame)
-                    {
-                        ExecutionContext exe_ctx;
-                        frame->CalculateExecutionContext (exe_ctx);
-                        ExpressionResults result = process->RunThreadPlan (exe_ctx,
-                                                                          call_plan_sp,
-                                                                          options,
-                                                                          error_strm);
-                        if (result == eExpressionCompleted)
-                        {
-                            return true;
-                        }
-                    }
-                }
+                return true;
             }
         }
     }
@@ -414,6 +414,10 @@ RegisterContextLLDB::InitializeNonZerothFrame()
         return;
     }
 
+    // The unwind row cache is keyed by the file address of the pc as we
+    // read it, before it is possibly backed up by one below.
+    const addr_t pc_file_addr = m_current_pc.GetFileAddress();
+
     bool resolve_tail_call_address = true; // m_current_pc can be one past the address range of the function...
                                            // This will handle the case where the saved pc does not point to 
                                            // a function/symbol because it is beyond the bounds of the correct
@@ -508,42 +512,98 @@ RegisterContextLLDB::InitializeNonZerothFrame()
         }
     }
 
-    // We've set m_frame_type and m_sym_ctx before this call.
-    m_fast_unwind_plan_sp = GetFastUnwindPlanForFrame ();
-
     UnwindPlan::RowSP active_row;
     int cfa_offset = 0;
     RegisterKind row_register_kind = eRegisterKindGeneric;
 
-    // Try to get by with just the fast UnwindPlan if possible - the full UnwindPlan may be expensive to get
-    // (e.g. if we have to parse the entire eh_frame section of an ObjectFile for the first time.)
+    // A frame above an ordinary function call picks the same UnwindPlans and
+    // row every time we unwind through the same return address, so reuse what
+    // an earlier unwind found.  Frames above a trap handler or the debugger
+    // behave like frame zero and are always worked out from scratch.
+    UnwindTable *unwind_table = NULL;
+    if (m_frame_type == eNormalFrame
+        && GetNextFrame()->m_frame_type != eTrapHandlerFrame
+        && GetNextFrame()->m_frame_type != eDebuggerFrame
+        && pc_module_sp->GetObjectFile())
+    {
+        unwind_table = &pc_module_sp->GetObjectFile()->GetUnwindTable();
+    }
 
-    if (m_fast_unwind_plan_sp && m_fast_unwind_plan_sp->PlanValidAtAddress (m_current_pc))
+    UnwindTable::UnwindRowCacheEntry cached_row;
+    if (unwind_table && unwind_table->LookupUnwindRow (pc_file_addr, cached_row))
     {
-        active_row = m_fast_unwind_plan_sp->GetRowForFunctionOffset (m_current_offset);
-        row_register_kind = m_fast_unwind_plan_sp->GetRegisterKind ();
-        if (active_row.get() && log)
+        m_fast_unwind_plan_sp = cached_row.fast_unwind_plan_sp;
+        if (cached_row.source == UnwindTable::eUnwindRowFromFastPlan)
         {
-            StreamString active_row_strm;
-            active_row->Dump(active_row_strm, m_fast_unwind_plan_sp.get(), &m_thread, m_start_pc.GetLoadAddress(exe_ctx.GetTargetPtr()));
-            UnwindLogMsg ("active row: %s", active_row_strm.GetString().c_str());
+            row_register_kind = m_fast_unwind_plan_sp->GetRegisterKind ();
+        }
+        else
+        {
+            m_full_unwind_plan_sp = cached_row.full_unwind_plan_sp;
+            row_register_kind = m_full_unwind_plan_sp->GetRegisterKind ();
+        }
+        if (cached_row.fallback_unwind_plan_sp)
+            m_fallback_unwind_plan_sp = cached_row.fallback_unwind_plan_sp;
+        active_row = cached_row.active_row;
+
+        if (log)
+        {
+            uint32_t hits = 0, misses = 0;
+            unwind_table->GetUnwindRowCacheStatistics (hits, misses);
+            UnwindLogMsg ("using cached unwind row from the %s UnwindPlan (%s), %s unwind row cache hits %u, misses %u",
+                          cached_row.source == UnwindTable::eUnwindRowFromFastPlan ? "fast" : "full",
+                          cached_row.source == UnwindTable::eUnwindRowFromFastPlan ? m_fast_unwind_plan_sp->GetSourceName().AsCString("") : m_full_unwind_plan_sp->GetSourceName().AsCString(""),
+                          pc_module_sp->GetFileSpec().GetFilename().AsCString("<unknown>"),
+                          hits, misses);
         }
     }
     else
     {
-        m_full_unwind_plan_sp = GetFullUnwindPlanForFrame ();
-        int valid_offset = -1;
-        if (IsUnwindPlanValidForCurrentPC(m_full_unwind_plan_sp, valid_offset))
+        // We've set m_frame_type and m_sym_ctx before this call.
+        m_fast_unwind_plan_sp = GetFastUnwindPlanForFrame ();
+
+        // Try to get by with just the fast UnwindPlan if possible - the full UnwindPlan may be expensive to get
+        // (e.g. if we have to parse the entire eh_frame section of an ObjectFile for the first time.)
+
+        if (m_fast_unwind_plan_sp && m_fast_unwind_plan_sp->PlanValidAtAddress (m_current_pc))
         {
-            active_row = m_full_unwind_plan_sp->GetRowForFunctionOffset (valid_offset);
-            row_register_kind = m_full_unwind_plan_sp->GetRegisterKind ();
+            active_row = m_fast_unwind_plan_sp->GetRowForFunctionOffset (m_current_offset);
+            row_register_kind = m_fast_unwind_plan_sp->GetRegisterKind ();
+            cached_row.source = UnwindTable::eUnwindRowFromFastPlan;
             if (active_row.get() && log)
             {
                 StreamString active_row_strm;
-                active_row->Dump(active_row_strm, m_full_unwind_plan_sp.get(), &m_thread, m_start_pc.GetLoadAddress(exe_ctx.GetTargetPtr()));
+                active_row->Dump(active_row_strm, m_fast_unwind_plan_sp.get(), &m_thread, m_start_pc.GetLoadAddress(exe_ctx.GetTargetPtr()));
                 UnwindLogMsg ("active row: %s", active_row_strm.GetString().c_str());
             }
         }
+        else
+        {
+            m_full_unwind_plan_sp = GetFullUnwindPlanForFrame ();
+            cached_row.source = UnwindTable::eUnwindRowFromFullPlan;
+            int valid_offset = -1;
+            if (IsUnwindPlanValidForCurrentPC(m_full_unwind_plan_sp, valid_offset))
+            {
+                active_row = m_full_unwind_plan_sp->GetRowForFunctionOffset (valid_offset);
+                row_register_kind = m_full_unwind_plan_sp->GetRegisterKind ();
+                if (active_row.get() && log)
+                {
+                    StreamString active_row_strm;
+                    active_row->Dump(active_row_strm, m_full_unwind_plan_sp.get(), &m_thread, m_start_pc.GetLoadAddress(exe_ctx.GetTargetPtr()));
+                    UnwindLogMsg ("active row: %s", active_row_strm.GetString().c_str());
+                }
+            }
+        }
+
+        // Finding the plans may have shown this isn't an ordinary frame after all
+        if (unwind_table && active_row.get() && m_frame_type == eNormalFrame)
+        {
+            cached_row.fast_unwind_plan_sp = m_fast_unwind_plan_sp;
+            cached_row.full_unwind_plan_sp = m_full_unwind_plan_sp;
+            cached_row.fallback_unwind_plan_sp = m_fallback_unwind_plan_sp;
+            cached_row.active_row = active_row;
+            unwind_table->AddUnwindRow (pc_file_addr, cached_row);
+        }
     }
 
     if (!active_row.get())
@@ -484,6 +484,8 @@ StopInfoMachException::CreateStopReasonWithMachException
                     lldb::BreakpointSiteSP bp_site_sp;
                     if (process_sp)
                         bp_site_sp = process_sp->GetBreakpointSiteList().FindByAddress(pc);
+                    if (process_sp && !bp_site_sp)
+                        bp_site_sp = process_sp->ResolveInjectedConditionTrap (thread, pc);
                     if (bp_site_sp && bp_site_sp->IsEnabled())
                     {
                         // Update the PC if we were asked to do so, but only do
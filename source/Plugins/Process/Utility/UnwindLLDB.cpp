@@ -12,6 +12,7 @@
 #include "lldb/Symbol/FuncUnwinders.h"
 #include "lldb/Symbol/Function.h"
 #include "lldb/Symbol/UnwindPlan.h"
+#include "lldb/Target/MemoryRegionInfo.h"
 #include "lldb/Target/Thread.h"
 #include "lldb/Target/Target.h"
 #include "lldb/Target/Process.h"
@@ -27,7 +28,12 @@ UnwindLLDB::UnwindLLDB (Thread &thread) :
     Unwind (thread),
     m_frames(),
     m_unwind_complete(false),
-    m_user_supplied_trap_handler_functions()
+    m_user_supplied_trap_handler_functions(),
+    m_stack_prefetch_size(0),
+    m_stack_prefetch_start(LLDB_INVALID_ADDRESS),
+    m_stack_prefetch_end(LLDB_INVALID_ADDRESS),
+    m_stack_region_start(LLDB_INVALID_ADDRESS),
+    m_stack_region_end(LLDB_INVALID_ADDRESS)
 {
     ProcessSP process_sp(thread.GetProcess());
     if (process_sp)
@@ -97,6 +103,15 @@ UnwindLLDB::AddFirstFrame ()
     if (!reg_ctx_sp->IsValid())
         goto unwind_done;
 
+    // Read the top of the stack in one go, the frames we are about to
+    // add will read their saved registers from it a word at a time.
+    {
+        ProcessSP process_sp (m_thread.GetProcess());
+        if (process_sp)
+            m_stack_prefetch_size = process_sp->GetUnwindStackPrefetchSize();
+        PrefetchStackMemory (reg_ctx_sp->GetSP (LLDB_INVALID_ADDRESS));
+    }
+
     if (!reg_ctx_sp->GetCFA (first_cursor_sp->cfa))
         goto unwind_done;
 
@@ -135,6 +150,12 @@ UnwindLLDB::AddOneMoreFrame (ABI *abi)
         return false;
 
     uint32_t cur_idx = m_frames.size ();
+
+    // This frame's registers are saved in the stack just below and
+    // above the caller's CFA, extend the prefetch when we get close to
+    // the end of it.
+    PrefetchStackMemory (m_frames[cur_idx - 1]->cfa);
+
     RegisterContextLLDBSP reg_ctx_sp(new RegisterContextLLDB (m_thread, 
                                                               m_frames[cur_idx - 1]->reg_ctx_lldb_sp, 
                                                               cursor_sp->sctx, 
@@ -275,6 +296,70 @@ unwind_done:
     return false;
 }
 
+void
+UnwindLLDB::PrefetchStackMemory (addr_t addr)
+{
+    if (m_stack_prefetch_size == 0 || addr == LLDB_INVALID_ADDRESS)
+        return;
+
+    // Nothing to do while addr and a good part of what is above it have
+    // been prefetched, or when we've prefetched up to the end of the stack.
+    const bool in_prefetch = m_stack_prefetch_start != LLDB_INVALID_ADDRESS &&
+                             addr >= m_stack_prefetch_start && addr < m_stack_prefetch_end;
+    if (in_prefetch && (m_stack_prefetch_end - addr > m_stack_prefetch_size / 4 || m_stack_prefetch_end >= m_stack_region_end))
+        return;
+
+    ProcessSP process_sp (m_thread.GetProcess());
+    if (!process_sp)
+        return;
+
+    // Don't read past the end of the memory region the stack is in. A
+    // frame may be on another stack (like a signal stack), so look the
+    // region up again whenever we leave the one we know about.
+    if (m_stack_region_start == LLDB_INVALID_ADDRESS || addr < m_stack_region_start || addr >= m_stack_region_end)
+    {
+        MemoryRegionInfo region_info;
+        Error region_error (process_sp->GetMemoryRegionInfo (addr, region_info));
+        if (region_error.Success() && region_info.GetRange().Contains (addr))
+        {
+            if (region_info.GetReadable() == MemoryRegionInfo::eNo)
+                return;
+            m_stack_region_start = region_info.GetRange().GetRangeBase();
+            m_stack_region_end = region_info.GetRange().GetRangeEnd();
+        }
+        else
+        {
+            m_stack_region_start = addr;
+            m_stack_region_end = LLDB_INVALID_ADDRESS;
+        }
+    }
+
+    addr_t start_addr = addr;
+    if (in_prefetch)
+        start_addr = m_stack_prefetch_end;
+    else
+        m_stack_prefetch_start = addr;
+
+    addr_t end_addr = start_addr + m_stack_prefetch_size;
+    if (end_addr < start_addr || end_addr > m_stack_region_end)
+        end_addr = m_stack_region_end;
+    if (end_addr <= start_addr)
+        return;
+
+    Error error;
+    const size_t bytes_prefetched = process_sp->PrefetchMemory (start_addr, end_addr - start_addr, error);
+    m_stack_prefetch_end = start_addr + bytes_prefetched;
+
+    Log *log(GetLogIfAllCategoriesSet (LIBLLDB_LOG_UNWIND));
+    if (log)
+        log->Printf ("th%d prefetched %" PRIu64 " bytes of stack at 0x%" PRIx64,
+                     m_thread.GetIndexID(), (uint64_t)bytes_prefetched, start_addr);
+
+    // Don't keep trying if the process won't give us any of it
+    if (bytes_prefetched == 0)
+        m_stack_prefetch_size = 0;
+}
+
 bool
 UnwindLLDB::DoGetFrameInfoAtIndex (uint32_t idx, addr_t& cfa, addr_t& pc)
 {
@@ -65,6 +65,11 @@ protected:
     {
         m_frames.clear();
         m_unwind_complete = false;
+        m_stack_prefetch_size = 0;
+        m_stack_prefetch_start = LLDB_INVALID_ADDRESS;
+        m_stack_prefetch_end = LLDB_INVALID_ADDRESS;
+        m_stack_region_start = LLDB_INVALID_ADDRESS;
+        m_stack_region_end = LLDB_INVALID_ADDRESS;
     }
 
     virtual uint32_t
@@ -131,9 +136,21 @@ private:
  
     std::vector<ConstString> m_user_supplied_trap_handler_functions;
 
+    // The stack memory that has been read into the process memory cache
+    // for this unwind, and the memory region it lies in.
+    uint64_t m_stack_prefetch_size;
+    lldb::addr_t m_stack_prefetch_start;
+    lldb::addr_t m_stack_prefetch_end;
+    lldb::addr_t m_stack_region_start;
+    lldb::addr_t m_stack_region_end;
+
     bool AddOneMoreFrame (ABI *abi);
     bool AddFirstFrame ();
 
+    // Make sure the stack memory at addr, and some of what is above it,
+    // is in the process memory cache before registers are read from it.
+    void PrefetchStackMemory (lldb::addr_t addr);
+
     //------------------------------------------------------------------
     // For UnwindLLDB only
     //------------------------------------------------------------------
@@ -10,6 +10,10 @@
 // C Includes
 #include <stdlib.h>
 
+// C++ Includes
+#include <algorithm>
+#include <set>
+
 // Other libraries and framework includes
 #include "lldb/Core/PluginManager.h"
 #include "lldb/Core/Module.h"
@@ -18,8 +22,11 @@
 #include "lldb/Core/State.h"
 #include "lldb/Core/DataBufferHeap.h"
 #include "lldb/Core/Log.h"
+#include "lldb/Host/Host.h"
+#include "lldb/Host/Mutex.h"
 #include "lldb/Target/Target.h"
 #include "lldb/Target/DynamicLoader.h"
+#include "lldb/Target/Platform.h"
 
 #include "llvm/Support/ELF.h"
 
@@ -33,6 +40,12 @@
 
 using namespace lldb_private;
 
+// For reads at least this big the host is told to start reading the
+// pages in ahead of time, and for even bigger ones, which are usually
+// scans of the core file, that they will be read in order
+static const size_t k_large_read_size = 1024 * 1024;
+static const size_t k_sequential_read_size = 16 * 1024 * 1024;
+
 ConstString
 ProcessElfCore::GetPluginNameStatic()
 {
@@ -111,7 +124,10 @@ ProcessElfCore::ProcessElfCore(Target& target, Listener &listener,
     m_signals_sp (),
     m_thread_data_valid(false),
     m_thread_data(),
-    m_core_aranges ()
+    m_nt_file_entries(),
+    m_core_aranges (),
+    m_core_data_sp (),
+    m_core_data_offset (0)
 {
 }
 
@@ -167,6 +183,92 @@ ProcessElfCore::AddAddressRangeFromLoadSegment(const elf::ELFProgramHeader *head
     return addr;
 }
 
+void
+ProcessElfCore::MapLoadSegments ()
+{
+    m_core_data_sp.reset();
+    m_core_data_offset = 0;
+
+    lldb::addr_t file_start = LLDB_INVALID_ADDRESS;
+    lldb::addr_t file_end = 0;
+    const size_t num_ranges = m_core_aranges.GetSize();
+    for (size_t i = 0; i < num_ranges; ++i)
+    {
+        const VMRangeToFileOffset::Entry *entry = m_core_aranges.GetEntryAtIndex(i);
+        if (entry->data.GetByteSize() == 0)
+            continue;
+        file_start = std::min<lldb::addr_t>(file_start, entry->data.GetRangeBase());
+        file_end = std::max<lldb::addr_t>(file_end, entry->data.GetRangeEnd());
+    }
+
+    if (file_start >= file_end || file_end - file_start > SIZE_MAX)
+        return;
+
+    // If the core file can't be mapped (or is truncated) we can still
+    // read it through the core object file, just not as fast.
+    std::shared_ptr<DataBufferMemoryMap> data_sp (new DataBufferMemoryMap());
+    if (data_sp->MemoryMapFromFileSpec (&m_core_file, file_start, file_end - file_start, false) == 0)
+    {
+        Log *log (GetLogIfAllCategoriesSet(LIBLLDB_LOG_PROCESS));
+        if (log)
+            log->Printf("ProcessElfCore::%s failed to map core file range [0x%" PRIx64 "-0x%" PRIx64 ")",
+                        __FUNCTION__, file_start, file_end);
+        return;
+    }
+
+    m_core_data_sp = data_sp;
+    m_core_data_offset = file_start;
+}
+
+bool
+ProcessElfCore::GetCoreFileOffset (lldb::addr_t addr,
+                                   lldb::addr_t &file_offset,
+                                   lldb::addr_t &file_bytes_left,
+                                   Error &error)
+{
+    // Get the address range
+    const VMRangeToFileOffset::Entry *address_range = m_core_aranges.FindEntryThatContains (addr);
+    if (address_range == NULL || address_range->GetRangeEnd() < addr)
+    {
+        error.SetErrorStringWithFormat ("core file does not contain 0x%" PRIx64, addr);
+        return false;
+    }
+
+    // Convert the address into core file offset
+    const lldb::addr_t offset = addr - address_range->GetRangeBase();
+    const lldb::addr_t file_start = address_range->data.GetRangeBase();
+    const lldb::addr_t file_end = address_range->data.GetRangeEnd();
+
+    file_offset = file_start + offset;
+
+    // Figure out how many on-disk bytes remain in this segment
+    // starting at the given offset
+    file_bytes_left = 0;
+    if (file_end > file_offset)
+        file_bytes_left = file_end - file_offset;
+    return true;
+}
+
+const uint8_t *
+ProcessElfCore::GetMappedCoreBytes (lldb::addr_t file_offset, size_t size, size_t &bytes_mapped)
+{
+    bytes_mapped = 0;
+    if (!m_core_data_sp || file_offset < m_core_data_offset)
+        return NULL;
+
+    const lldb::offset_t data_offset = file_offset - m_core_data_offset;
+    const lldb::offset_t data_size = m_core_data_sp->GetByteSize();
+    if (data_offset >= data_size)
+        return NULL;
+
+    bytes_mapped = std::min<lldb::offset_t>(size, data_size - data_offset);
+    if (bytes_mapped >= k_sequential_read_size)
+        m_core_data_sp->Advise (data_offset, bytes_mapped, DataBufferMemoryMap::eAccessHintSequential);
+    if (bytes_mapped >= k_large_read_size)
+        m_core_data_sp->Advise (data_offset, bytes_mapped, DataBufferMemoryMap::eAccessHintWillNeed);
+    return m_core_data_sp->GetBytes() + data_offset;
+}
+
 //----------------------------------------------------------------------
 // Process Control
 //----------------------------------------------------------------------
@@ -227,6 +329,8 @@ ProcessElfCore::DoLoadCore ()
     if (!ranges_are_sorted)
         m_core_aranges.Sort();
 
+    MapLoadSegments();
+
     // Even if the architecture is set in the target, we need to override
     // it to match the core file which is always single arch.
     ArchSpec arch (m_core_module_sp->GetArchitecture());
@@ -242,6 +346,8 @@ ProcessElfCore::DoLoadCore ()
             break;
     }
 
+    LoadModulesFromNTFile();
+
     return error;
 }
 
@@ -309,27 +415,14 @@ ProcessElfCore::DoReadMemory (lldb::addr_t addr, void *buf, size_t size, Error &
     if (core_objfile == NULL)
         return 0;
 
-    // Get the address range
-    const VMRangeToFileOffset::Entry *address_range = m_core_aranges.FindEntryThatContains (addr);
-    if (address_range == NULL || address_range->GetRangeEnd() < addr)
-    {
-        error.SetErrorStringWithFormat ("core file does not contain 0x%" PRIx64, addr);
+    lldb::addr_t file_offset = 0;
+    lldb::addr_t bytes_left = 0; // Number of bytes available in the core file from the given address
+    if (!GetCoreFileOffset (addr, file_offset, bytes_left, error))
         return 0;
-    }
 
-    // Convert the address into core file offset
-    const lldb::addr_t offset = addr - address_range->GetRangeBase();
-    const lldb::addr_t file_start = address_range->data.GetRangeBase();
-    const lldb::addr_t file_end = address_range->data.GetRangeEnd();
     size_t bytes_to_read = size; // Number of bytes to read from the core file
     size_t bytes_copied = 0;     // Number of bytes actually read from the core file
     size_t zero_fill_size = 0;   // Padding
-    lldb::addr_t bytes_left = 0; // Number of bytes available in the core file from the given address
-
-    // Figure out how many on-disk bytes remain in this segment
-    // starting at the given offset
-    if (file_end > file_start + offset)
-        bytes_left = file_end - (file_start + offset);
 
     // Figure out how many bytes we need to zero-fill if we are
     // reading more bytes than available in the on-disk segment
@@ -339,9 +432,20 @@ ProcessElfCore::DoReadMemory (lldb::addr_t addr, void *buf, size_t size, Error &
         bytes_to_read = bytes_left;
     }
 
-    // If there is data available on the core file read it
+    // If there is data available on the core file read it, straight out
+    // of our mapping if we have one
     if (bytes_to_read)
-        bytes_copied = core_objfile->CopyData(offset + file_start, bytes_to_read, buf);
+    {
+        size_t bytes_mapped = 0;
+        const uint8_t *src = GetMappedCoreBytes (file_offset, bytes_to_read, bytes_mapped);
+        if (src && bytes_mapped == bytes_to_read)
+        {
+            ::memcpy (buf, src, bytes_to_read);
+            bytes_copied = bytes_to_read;
+        }
+        else
+            bytes_copied = core_objfile->CopyData(file_offset, bytes_to_read, buf);
+    }
 
     assert(zero_fill_size <= size);
     // Pad remaining bytes
@@ -351,12 +455,39 @@ ProcessElfCore::DoReadMemory (lldb::addr_t addr, void *buf, size_t size, Error &
     return bytes_copied + zero_fill_size;
 }
 
+size_t
+ProcessElfCore::GetMemoryView (lldb::addr_t addr, size_t size, DataExtractor &data, Error &error)
+{
+    // Share the mapped core file bytes if they are all on disk, anything
+    // that needs to be zero filled has to be copied.
+    lldb::addr_t file_offset = 0;
+    lldb::addr_t bytes_left = 0;
+    Error lookup_error;
+    if (size > 0 &&
+        GetCoreFileOffset (addr, file_offset, bytes_left, lookup_error) &&
+        size <= bytes_left)
+    {
+        size_t bytes_mapped = 0;
+        const uint8_t *src = GetMappedCoreBytes (file_offset, size, bytes_mapped);
+        if (src && bytes_mapped == size)
+        {
+            error.Clear();
+            data.SetByteOrder (GetByteOrder());
+            data.SetAddressByteSize (GetAddressByteSize());
+            return data.SetData (lldb::DataBufferSP (m_core_data_sp), file_offset - m_core_data_offset, size);
+        }
+    }
+    return Process::GetMemoryView (addr, size, data, error);
+}
+
 void
 ProcessElfCore::Clear()
 {
     m_thread_list.Clear();
     m_os = llvm::Triple::UnknownOS;
     m_signals_sp.reset();
+    m_core_data_sp.reset();
+    m_core_data_offset = 0;
 }
 
 void
@@ -390,7 +521,8 @@ enum {
     NT_PRPSINFO,
     NT_TASKSTRUCT,
     NT_PLATFORM,
-    NT_AUXV
+    NT_AUXV,
+    NT_FILE         = 0x46494c45
 };
 
 enum {
@@ -548,6 +680,9 @@ ProcessElfCore::ParseThreadContextsFromNoteSegment(const elf::ELFProgramHeader *
                 case NT_AUXV:
                     m_auxv = DataExtractor(note_data);
                     break;
+                case NT_FILE:
+                    ParseNTFile(note_data, arch);
+                    break;
                 default:
                     break;
             }
@@ -562,6 +697,201 @@ ProcessElfCore::ParseThreadContextsFromNoteSegment(const elf::ELFProgramHeader *
     }
 }
 
+// Parse a NT_FILE note. It starts with the number of mappings and the
+// page size, followed by a start, end and file offset in pages for each
+// mapping, and then the path of each mapping as a NULL terminated string.
+// All numbers are the size of an address.
+void
+ProcessElfCore::ParseNTFile (const DataExtractor &note_data, const ArchSpec &arch)
+{
+    m_nt_file_entries.clear();
+
+    lldb::offset_t offset = 0;
+    const uint32_t addr_size = arch.GetAddressByteSize();
+    if (addr_size == 0)
+        return;
+
+    const uint64_t count = note_data.GetMaxU64(&offset, addr_size);
+    const uint64_t page_size = note_data.GetMaxU64(&offset, addr_size);
+    if (count == 0 || count > note_data.GetByteSize() / (3 * addr_size))
+        return;
+
+    m_nt_file_entries.resize(count);
+    for (uint64_t i = 0; i < count; ++i)
+    {
+        NT_FILE_Entry &entry = m_nt_file_entries[i];
+        entry.start = note_data.GetMaxU64(&offset, addr_size);
+        entry.end = note_data.GetMaxU64(&offset, addr_size);
+        entry.file_ofs = note_data.GetMaxU64(&offset, addr_size) * page_size;
+    }
+
+    for (uint64_t i = 0; i < count; ++i)
+    {
+        const char *path = note_data.GetCStr(&offset);
+        if (path == NULL)
+        {
+            // Truncated note, keep the entries we have a path for
+            m_nt_file_entries.resize(i);
+            break;
+        }
+        m_nt_file_entries[i].path.SetCString(path);
+    }
+}
+
+namespace {
+    // Modules to be created from the NT_FILE note by a pool of threads
+    struct ModuleLoadQueue
+    {
+        std::vector<ModuleSpec> specs;
+        std::vector<lldb::ModuleSP> modules;
+        FileSpecList *search_paths;
+        Mutex mutex;
+        size_t next_index;
+    };
+}
+
+static lldb::thread_result_t
+CreateModulesThread (lldb::thread_arg_t arg)
+{
+    ModuleLoadQueue *queue = (ModuleLoadQueue *)arg;
+    while (true)
+    {
+        size_t index;
+        {
+            Mutex::Locker locker (queue->mutex);
+            if (queue->next_index >= queue->specs.size())
+                break;
+            index = queue->next_index++;
+        }
+
+        // Create the module in the global module list and parse its
+        // object file and sections, which is where the time goes. The
+        // target picks the module up from the global list afterwards.
+        lldb::ModuleSP module_sp;
+        ModuleList::GetSharedModule (queue->specs[index], module_sp, queue->search_paths, NULL, NULL);
+        if (module_sp && module_sp->GetObjectFile())
+            module_sp->GetSectionList();
+        queue->modules[index] = module_sp;
+    }
+    return NULL;
+}
+
+// Returns the load bias of an ELF module whose first page was found
+// mapped at mapping_start.
+static lldb::addr_t
+GetModuleLoadBias (const lldb::ModuleSP &module_sp, lldb::addr_t mapping_start)
+{
+    ObjectFile *objfile = module_sp->GetObjectFile();
+    if (objfile == NULL || objfile->GetPluginName() != ObjectFileELF::GetPluginNameStatic())
+        return LLDB_INVALID_ADDRESS;
+
+    ObjectFileELF *elf_objfile = (ObjectFileELF *)objfile;
+    const size_t num_segments = elf_objfile->GetProgramHeaderCount();
+    for (size_t i = 1; i <= num_segments; ++i)
+    {
+        const elf::ELFProgramHeader *header = elf_objfile->GetProgramHeaderByIndex(i);
+        if (header && header->p_type == llvm::ELF::PT_LOAD && header->p_vaddr >= header->p_offset)
+            return mapping_start - (header->p_vaddr - header->p_offset);
+    }
+    return LLDB_INVALID_ADDRESS;
+}
+
+void
+ProcessElfCore::LoadModulesFromNTFile ()
+{
+    if (m_nt_file_entries.empty())
+        return;
+
+    Log *log (GetLogIfAnyCategoriesSet(LIBLLDB_LOG_DYNAMIC_LOADER));
+    Target &target = GetTarget();
+    const ArchSpec &arch = target.GetArchitecture();
+
+    // The mapping of the first page of a file is where its image was
+    // loaded, other mappings of the same file are its other segments.
+    std::vector<const NT_FILE_Entry *> images;
+    std::set<const char *> seen_paths;
+    for (const NT_FILE_Entry &entry : m_nt_file_entries)
+    {
+        if (entry.file_ofs == 0 && entry.path && seen_paths.insert(entry.path.GetCString()).second)
+            images.push_back(&entry);
+    }
+
+    if (images.empty())
+        return;
+
+    // When the modules come from the host, create them in parallel first.
+    // Remote platforms may have to fetch the files, so leave those alone.
+    PlatformSP platform_sp (target.GetPlatform());
+    if (platform_sp && platform_sp->IsHost() && images.size() > 1)
+    {
+        ModuleLoadQueue queue;
+        for (const NT_FILE_Entry *entry : images)
+            queue.specs.push_back(ModuleSpec(FileSpec(entry->path.GetCString(), false), arch));
+        queue.modules.resize(images.size());
+        queue.search_paths = &target.GetExecutableSearchPaths();
+        queue.next_index = 0;
+
+        const uint32_t num_threads = std::min<uint32_t>(std::max<uint32_t>(Host::GetNumberCPUS(), 1), images.size());
+        std::vector<lldb::thread_t> threads;
+        for (uint32_t i = 0; i < num_threads; ++i)
+        {
+            lldb::thread_t thread = Host::ThreadCreate ("<lldb.process.elf-core.load-modules>", CreateModulesThread, &queue, NULL);
+            if (IS_VALID_LLDB_HOST_THREAD(thread))
+                threads.push_back(thread);
+        }
+
+        // Whatever the threads didn't get to is done here
+        CreateModulesThread (&queue);
+        for (lldb::thread_t thread : threads)
+            Host::ThreadJoin (thread, NULL, NULL);
+    }
+
+    // Modules the target already has, like the executable, are reused.  New
+    // ones are added quietly so that everybody hears about all of them once,
+    // after their load addresses are set.
+    ModuleList loaded_modules;
+    for (const NT_FILE_Entry *entry : images)
+    {
+        ModuleSpec module_spec (FileSpec(entry->path.GetCString(), false), arch);
+        lldb::ModuleSP module_sp (target.GetImages().FindFirstModule(module_spec));
+        bool added = false;
+        if (!module_sp)
+        {
+            const bool notify = false;
+            module_sp = target.GetSharedModule(module_spec, NULL, notify);
+            added = (bool)module_sp;
+        }
+        if (!module_sp)
+        {
+            if (log)
+                log->Printf("ProcessElfCore::%s failed to load module %s at 0x%" PRIx64,
+                            __FUNCTION__, entry->path.GetCString(), entry->start);
+            continue;
+        }
+
+        const lldb::addr_t load_bias = GetModuleLoadBias (module_sp, entry->start);
+        if (load_bias == LLDB_INVALID_ADDRESS)
+        {
+            // It still has to be announced if it was added.
+            if (added)
+                loaded_modules.AppendIfNeeded (module_sp);
+            continue;
+        }
+
+        bool changed = false;
+        const bool value_is_offset = true;
+        module_sp->SetLoadAddress (target, load_bias, value_is_offset, changed);
+        loaded_modules.AppendIfNeeded (module_sp);
+    }
+
+    if (log)
+        log->Printf("ProcessElfCore::%s found %" PRIu64 " of %" PRIu64 " images from the NT_FILE note",
+                    __FUNCTION__, (uint64_t)loaded_modules.GetSize(), (uint64_t)images.size());
+
+    if (loaded_modules.GetSize() > 0)
+        target.ModulesDidLoad (loaded_modules);
+}
+
 uint32_t
 ProcessElfCore::GetNumThreadContexts ()
 {
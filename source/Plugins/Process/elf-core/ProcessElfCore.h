@@ -23,6 +23,7 @@
 
 // Other libraries and framework includes
 #include "lldb/Core/ConstString.h"
+#include "lldb/Core/DataBufferMemoryMap.h"
 #include "lldb/Core/Error.h"
 #include "lldb/Target/Process.h"
 
@@ -124,6 +125,9 @@ public:
     virtual size_t
     DoReadMemory (lldb::addr_t addr, void *buf, size_t size, lldb_private::Error &error);
 
+    virtual size_t
+    GetMemoryView (lldb::addr_t addr, size_t size, lldb_private::DataExtractor &data, lldb_private::Error &error);
+
     virtual lldb::addr_t
     GetImageInfoAddress ();
 
@@ -149,6 +153,15 @@ private:
     typedef lldb_private::Range<lldb::addr_t, lldb::addr_t> FileRange;
     typedef lldb_private::RangeDataArray<lldb::addr_t, lldb::addr_t, FileRange, 1> VMRangeToFileOffset;
 
+    // A file mapping described by the NT_FILE note
+    struct NT_FILE_Entry
+    {
+        lldb::addr_t start;
+        lldb::addr_t end;
+        lldb::addr_t file_ofs;  // In bytes
+        lldb_private::ConstString path;
+    };
+
     lldb::ModuleSP m_core_module_sp;
     lldb_private::FileSpec m_core_file;
     std::string  m_dyld_plugin_name;
@@ -166,14 +179,30 @@ private:
     // AUXV structure found from the NOTE segment
     lldb_private::DataExtractor m_auxv;
 
+    // File mappings found in the NT_FILE note
+    std::vector<NT_FILE_Entry> m_nt_file_entries;
+
     // Address ranges found in the core
     VMRangeToFileOffset m_core_aranges;
 
+    // Read only memory map of the part of the core file that contains
+    // the PT_LOAD segments, and the file offset it starts at
+    std::shared_ptr<lldb_private::DataBufferMemoryMap> m_core_data_sp;
+    lldb::offset_t m_core_data_offset;
+
     // Parse thread(s) data structures(prstatus, prpsinfo) from given NOTE segment
     void
     ParseThreadContextsFromNoteSegment (const elf::ELFProgramHeader *segment_header,
                                         lldb_private::DataExtractor segment_data);
 
+    // Parse the file mappings of a NT_FILE note
+    void
+    ParseNTFile (const lldb_private::DataExtractor &note_data, const lldb_private::ArchSpec &arch);
+
+    // Load every image found in the NT_FILE note at its recorded address
+    void
+    LoadModulesFromNTFile ();
+
     // Returns number of thread contexts stored in the core file
     uint32_t
     GetNumThreadContexts();
@@ -181,6 +210,23 @@ private:
     // Parse a contiguous address range of the process from LOAD segment
     lldb::addr_t
     AddAddressRangeFromLoadSegment(const elf::ELFProgramHeader *header);
+
+    // Memory map the file contents of all LOAD segments
+    void
+    MapLoadSegments ();
+
+    // Find the core file offset of a process address, and the number of
+    // bytes its LOAD segment has on disk from there on
+    bool
+    GetCoreFileOffset (lldb::addr_t addr,
+                       lldb::addr_t &file_offset,
+                       lldb::addr_t &file_bytes_left,
+                       lldb_private::Error &error);
+
+    // Return a pointer to the mapped bytes at a core file offset and the
+    // number of bytes, up to size, that are mapped from there on
+    const uint8_t *
+    GetMappedCoreBytes (lldb::addr_t file_offset, size_t size, size_t &bytes_mapped);
 };
 
 #endif  // liblldb_ProcessElffCore_h_
@@ -18,6 +18,7 @@
 // C++ Includes
 // Other libraries and framework includes
 #include "lldb/Core/ConnectionFileDescriptor.h"
+#include "lldb/Core/ConnectionSharedMemory.h"
 #include "lldb/Core/Log.h"
 #include "lldb/Core/StreamFile.h"
 #include "lldb/Core/StreamString.h"
@@ -653,11 +654,12 @@ Error
 GDBRemoteCommunication::StartDebugserverProcess (const char *hostname,
                                                  uint16_t in_port,
                                                  lldb_private::ProcessLaunchInfo &launch_info,
-                                                 uint16_t &out_port)
+                                                 uint16_t &out_port,
+                                                 bool use_shared_memory)
 {
     Log *log (ProcessGDBRemoteLog::GetLogIfAllCategoriesSet (GDBR_LOG_PROCESS));
     if (log)
-        log->Printf ("GDBRemoteCommunication::%s(hostname=%s, in_port=%" PRIu16 ", out_port=%" PRIu16, __FUNCTION__, hostname ? hostname : "<empty>", in_port, out_port);
+        log->Printf ("GDBRemoteCommunication::%s(hostname=%s, in_port=%" PRIu16 ", out_port=%" PRIu16 ", use_shared_memory=%i", __FUNCTION__, hostname ? hostname : "<empty>", in_port, out_port, use_shared_memory);
 
     out_port = in_port;
     Error error;
@@ -777,6 +779,23 @@ GDBRemoteCommunication::StartDebugserverProcess (const char *hostname,
                 listen = true;
             }
         }
+        else if (use_shared_memory)
+        {
+            // No host and port given and the debugserver is on this host, so
+            // create a shared memory region and have the debugserver attach
+            // to it. Packets will then never go through the kernel.
+            std::string shm_name (ConnectionSharedMemory::GetUniqueName());
+            std::unique_ptr<ConnectionSharedMemory> shm_conn_ap (new ConnectionSharedMemory());
+            if (shm_conn_ap->Open (true, shm_name.c_str(), ConnectionSharedMemory::k_default_size, &error) != eConnectionStatusSuccess)
+            {
+                if (error.Success())
+                    error.SetErrorStringWithFormat ("failed to create shared memory connection '%s'", shm_name.c_str());
+                return error;
+            }
+            SetConnection (shm_conn_ap.release());
+            debugserver_args.AppendArgument("--shared-memory");
+            debugserver_args.AppendArgument(shm_name.c_str());
+        }
         else
         {
             // No host and port given, so lets listen on our end and make the debugserver
@@ -848,6 +867,13 @@ GDBRemoteCommunication::StartDebugserverProcess (const char *hostname,
             else if (listen)
             {
                 
+            }
+            else if (use_shared_memory)
+            {
+                // Make sure the debugserver actually attached to our shared memory...
+                ConnectionSharedMemory *connection = (ConnectionSharedMemory *)GetConnection ();
+                if (connection == NULL || !connection->WaitForPeer (10 * TimeValue::MicroSecPerSec))
+                    error.SetErrorString ("debugserver failed to attach to the shared memory connection");
             }
             else
             {
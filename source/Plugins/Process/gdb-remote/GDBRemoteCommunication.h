@@ -125,7 +125,8 @@ public:
     StartDebugserverProcess (const char *hostname,
                              uint16_t in_port, // If set to zero, then out_port will contain the bound port on exit
                              lldb_private::ProcessLaunchInfo &launch_info,
-                             uint16_t &out_port);
+                             uint16_t &out_port,
+                             bool use_shared_memory = false); // Connect to a local debugserver through a shared memory ring buffer instead of a socket
 
     void
     DumpHistory(lldb_private::Stream &strm);
@@ -23,6 +23,7 @@
 #include "lldb/Core/ConnectionFileDescriptor.h"
 #include "lldb/Core/Log.h"
 #include "lldb/Core/State.h"
+#include "lldb/Core/StreamFile.h"
 #include "lldb/Core/StreamGDBRemote.h"
 #include "lldb/Core/StreamString.h"
 #include "lldb/Host/Endian.h"
@@ -63,6 +64,7 @@ GDBRemoteCommunicationClient::GDBRemoteCommunicationClient(bool is_platform) :
     m_qGDBServerVersion_is_valid (eLazyBoolCalculate),
     m_supports_alloc_dealloc_memory (eLazyBoolCalculate),
     m_supports_memory_region_info  (eLazyBoolCalculate),
+    m_supports_memory_regions (eLazyBoolCalculate),
     m_supports_watchpoint_support_info  (eLazyBoolCalculate),
     m_supports_detach_stay_stopped (eLazyBoolCalculate),
     m_watchpoints_trigger_after_instruction(eLazyBoolCalculate),
@@ -76,6 +78,7 @@ GDBRemoteCommunicationClient::GDBRemoteCommunicationClient(bool is_platform) :
     m_supports_qXfer_libraries_read (eLazyBoolCalculate),
     m_supports_qXfer_libraries_svr4_read (eLazyBoolCalculate),
     m_supports_augmented_libraries_svr4_read (eLazyBoolCalculate),
+    m_supports_QSetBreakpoints (eLazyBoolCalculate),
     m_supports_jThreadExtendedInfo (eLazyBoolCalculate),
     m_supports_qProcessInfoPID (true),
     m_supports_qfProcessInfo (true),
@@ -151,7 +154,8 @@ GDBRemoteCommunicationClient::HandshakeWithServer (Error *error_ptr)
 #if 0
             // Set above line to "#if 1" to test packet speed if remote GDB server
             // supports the qSpeedTest packet...
-            TestPacketSpeed(10000);
+            StreamFile strm (stdout, false);
+            TestPacketSpeed(10000, strm);
 #endif
             return true;
         }
@@ -209,6 +213,16 @@ GDBRemoteCommunicationClient::GetQXferAuxvReadSupported ()
     return (m_supports_qXfer_auxv_read == eLazyBoolYes);
 }
 
+bool
+GDBRemoteCommunicationClient::GetQSetBreakpointsSupported ()
+{
+    if (m_supports_QSetBreakpoints == eLazyBoolCalculate)
+    {
+        GetRemoteQSupported();
+    }
+    return (m_supports_QSetBreakpoints == eLazyBoolYes);
+}
+
 uint64_t
 GDBRemoteCommunicationClient::GetRemoteMaxPacketSize()
 {
@@ -327,6 +341,7 @@ GDBRemoteCommunicationClient::ResetDiscoverableSettings()
     m_qGDBServerVersion_is_valid = eLazyBoolCalculate;
     m_supports_alloc_dealloc_memory = eLazyBoolCalculate;
     m_supports_memory_region_info = eLazyBoolCalculate;
+    m_supports_memory_regions = eLazyBoolCalculate;
     m_prepare_for_reg_writing_reply = eLazyBoolCalculate;
     m_attach_or_wait_reply = eLazyBoolCalculate;
     m_avoid_g_packets = eLazyBoolCalculate;
@@ -334,6 +349,7 @@ GDBRemoteCommunicationClient::ResetDiscoverableSettings()
     m_supports_qXfer_libraries_read = eLazyBoolCalculate;
     m_supports_qXfer_libraries_svr4_read = eLazyBoolCalculate;
     m_supports_augmented_libraries_svr4_read = eLazyBoolCalculate;
+    m_supports_QSetBreakpoints = eLazyBoolCalculate;
 
     m_supports_qProcessInfoPID = true;
     m_supports_qfProcessInfo = true;
@@ -371,6 +387,7 @@ GDBRemoteCommunicationClient::GetRemoteQSupported ()
     m_supports_qXfer_libraries_read = eLazyBoolNo;
     m_supports_qXfer_libraries_svr4_read = eLazyBoolNo;
     m_supports_augmented_libraries_svr4_read = eLazyBoolNo;
+    m_supports_QSetBreakpoints = eLazyBoolNo;
     m_max_packet_size = UINT64_MAX;  // It's supposed to always be there, but if not, we assume no limit
 
     StringExtractorGDBRemote response;
@@ -390,6 +407,8 @@ GDBRemoteCommunicationClient::GetRemoteQSupported ()
         }
         if (::strstr (response_cstr, "qXfer:libraries:read+"))
             m_supports_qXfer_libraries_read = eLazyBoolYes;
+        if (::strstr (response_cstr, "QSetBreakpoints+"))
+            m_supports_QSetBreakpoints = eLazyBoolYes;
 
         const char *packet_size_str = ::strstr (response_cstr, "PacketSize=");
         if (packet_size_str)
@@ -2076,6 +2095,92 @@ GDBRemoteCommunicationClient::GetMemoryRegionInfo (lldb::addr_t addr,
 
 }
 
+Error
+GDBRemoteCommunicationClient::GetMemoryRegions (std::vector<lldb_private::MemoryRegionInfo> &regions)
+{
+    Error error;
+    regions.clear();
+
+    if (m_supports_memory_regions == eLazyBoolNo)
+    {
+        error.SetErrorString("qMemoryRegions is not supported");
+        return error;
+    }
+
+    // The stub returns as many regions as fit in one reply and tells us
+    // where to continue with a "next" key.
+    addr_t next_addr = 0;
+    bool more = true;
+    while (more)
+    {
+        char packet[64];
+        const int packet_len = ::snprintf(packet, sizeof(packet), "qMemoryRegions:%" PRIx64, (uint64_t)next_addr);
+        assert (packet_len < (int)sizeof(packet));
+        StringExtractorGDBRemote response;
+        if (SendPacketAndWaitForResponse (packet, packet_len, response, false) != PacketResult::Success ||
+            response.IsUnsupportedResponse())
+        {
+            m_supports_memory_regions = eLazyBoolNo;
+            regions.clear();
+            error.SetErrorString("qMemoryRegions is not supported");
+            return error;
+        }
+        if (response.IsErrorResponse())
+        {
+            regions.clear();
+            error.SetErrorStringWithFormat("qMemoryRegions failed with error 0x%2.2x", response.GetError());
+            return error;
+        }
+        m_supports_memory_regions = eLazyBoolYes;
+
+        more = false;
+        if (response.IsOKResponse())
+            break;
+
+        std::string name;
+        std::string value;
+        bool success = true;
+        while (success && response.GetNameColonValue(name, value))
+        {
+            if (name.compare ("start") == 0)
+            {
+                // Every region starts with its "start" key.
+                regions.push_back (MemoryRegionInfo());
+                regions.back().GetRange().SetRangeBase (Args::StringToUInt64(value.c_str(), LLDB_INVALID_ADDRESS, 16, &success));
+            }
+            else if (name.compare ("size") == 0 && !regions.empty())
+            {
+                regions.back().GetRange().SetByteSize (Args::StringToUInt64(value.c_str(), 0, 16, &success));
+            }
+            else if (name.compare ("permissions") == 0 && !regions.empty())
+            {
+                MemoryRegionInfo &region_info = regions.back();
+                region_info.SetReadable (value.find('r') != std::string::npos ? MemoryRegionInfo::eYes : MemoryRegionInfo::eNo);
+                region_info.SetWritable (value.find('w') != std::string::npos ? MemoryRegionInfo::eYes : MemoryRegionInfo::eNo);
+                region_info.SetExecutable (value.find('x') != std::string::npos ? MemoryRegionInfo::eYes : MemoryRegionInfo::eNo);
+            }
+            else if (name.compare ("next") == 0)
+            {
+                const addr_t addr = Args::StringToUInt64(value.c_str(), 0, 16, &success);
+                // Make sure we are always making progress.
+                if (success && addr > next_addr)
+                {
+                    next_addr = addr;
+                    more = true;
+                }
+            }
+        }
+
+        if (!success)
+        {
+            regions.clear();
+            error.SetErrorString("malformed qMemoryRegions response");
+            return error;
+        }
+    }
+    return error;
+}
+
 Error
 GDBRemoteCommunicationClient::GetWatchpointSupportInfo (uint32_t &num)
 {
@@ -2660,7 +2765,7 @@ GDBRemoteCommunicationClient::GetGroupName (uint32_t gid, std::string &name)
 }
 
 void
-GDBRemoteCommunicationClient::TestPacketSpeed (const uint32_t num_packets)
+GDBRemoteCommunicationClient::TestPacketSpeed (const uint32_t num_packets, Stream &strm)
 {
     uint32_t i;
     TimeValue start_time, end_time;
@@ -2719,7 +2824,7 @@ GDBRemoteCommunicationClient::TestPacketSpeed (const uint32_t num_packets)
                 if (recv_size == 0)
                 {
                     float packets_per_second = (((float)num_packets)/(float)total_time_nsec) * (float)TimeValue::NanoSecPerSec;
-                    printf ("%u qSpeedTest(send=%-7u, recv=%-7u) in %" PRIu64 ".%9.9" PRIu64 " sec for %f packets/sec.\n",
+                    strm.Printf ("%u qSpeedTest(send=%-7u, recv=%-7u) in %" PRIu64 ".%9.9" PRIu64 " sec for %f packets/sec.\n",
                             num_packets, 
                             send_size,
                             recv_size,
@@ -2730,7 +2835,7 @@ GDBRemoteCommunicationClient::TestPacketSpeed (const uint32_t num_packets)
                 else
                 {
                     float mb_second = ((((float)k_recv_amount)/(float)total_time_nsec) * (float)TimeValue::NanoSecPerSec) / (1024.0*1024.0);
-                    printf ("%u qSpeedTest(send=%-7u, recv=%-7u) sent 4MB in %" PRIu64 ".%9.9" PRIu64 " sec for %f MB/sec.\n",
+                    strm.Printf ("%u qSpeedTest(send=%-7u, recv=%-7u) sent 4MB in %" PRIu64 ".%9.9" PRIu64 " sec for %f MB/sec.\n",
                             num_packets,
                             send_size,
                             recv_size,
@@ -2959,6 +3064,92 @@ GDBRemoteCommunicationClient::SendGDBStoppointTypePacket (GDBStoppointType type,
     return UINT8_MAX;
 }
 
+bool
+GDBRemoteCommunicationClient::SendGDBStoppointTypePackets (GDBStoppointType type,
+                                                           bool insert,
+                                                           const std::vector<addr_t> &addrs,
+                                                           uint32_t length,
+                                                           std::vector<uint8_t> &results)
+{
+    if (!SupportsGDBStoppointPacket(type) || !GetQSetBreakpointsSupported())
+        return false;
+
+    results.assign (addrs.size(), UINT8_MAX);
+
+    // Leave room for the packet framing and checksum, and don't let a
+    // single packet get silly large even if the stub would accept it.
+    const char *packet_prefix = insert ? "QSetBreakpoints:" : "QRemoveBreakpoints:";
+    size_t max_packet_size = std::min<uint64_t> (GetRemoteMaxPacketSize(), 16 * 1024);
+    if (max_packet_size > 16)
+        max_packet_size -= 16;
+
+    size_t start_idx = 0;
+    while (start_idx < addrs.size())
+    {
+        StreamString packet;
+        packet.PutCString (packet_prefix);
+        size_t end_idx = start_idx;
+        while (end_idx < addrs.size())
+        {
+            char entry[64];
+            const int entry_len = ::snprintf (entry,
+                                              sizeof(entry),
+                                              "%s%i,%" PRIx64 ",%x",
+                                              end_idx > start_idx ? ";" : "",
+                                              type,
+                                              addrs[end_idx],
+                                              length);
+            assert (entry_len + 1 < (int)sizeof(entry));
+            // Always send at least one entry per packet.
+            if (end_idx > start_idx && packet.GetSize() + entry_len > max_packet_size)
+                break;
+            packet.Write (entry, entry_len);
+            ++end_idx;
+        }
+
+        StringExtractorGDBRemote response;
+        if (SendPacketAndWaitForResponse(packet.GetData(), packet.GetSize(), response, true) != PacketResult::Success)
+            return true;
+
+        if (response.IsUnsupportedResponse())
+        {
+            // Only the first packet can be unsupported, so nothing has
+            // been sent yet.
+            m_supports_QSetBreakpoints = eLazyBoolNo;
+            return start_idx > 0;
+        }
+
+        if (response.IsOKResponse())
+        {
+            for (size_t i = start_idx; i < end_idx; ++i)
+                results[i] = 0;
+        }
+        else if (response.IsErrorResponse())
+        {
+            // The whole packet was rejected.
+            const uint8_t error_code = response.GetError();
+            for (size_t i = start_idx; i < end_idx; ++i)
+                results[i] = error_code;
+        }
+        else
+        {
+            // One "OK" or "Exx" per entry, separated by semicolons.
+            for (size_t i = start_idx; i < end_idx && response.GetBytesLeft() > 0; ++i)
+            {
+                if (response.GetChar() == 'O' && response.GetChar() == 'K')
+                    results[i] = 0;
+                else
+                    results[i] = response.GetHexU8 (UINT8_MAX);
+                if (response.GetBytesLeft() > 0 && response.GetChar() != ';')
+                    break;
+            }
+        }
+
+        start_idx = end_idx;
+    }
+    return true;
+}
+
 size_t
 GDBRemoteCommunicationClient::GetCurrentThreadIDs (std::vector<lldb::tid_t> &thread_ids, 
                                                    bool &sequence_mutex_unavailable)
@@ -267,6 +267,13 @@ public:
     GetMemoryRegionInfo (lldb::addr_t addr, 
                         lldb_private::MemoryRegionInfo &range_info); 
 
+    //------------------------------------------------------------------
+    /// Get every mapped region of the process with qMemoryRegions
+    /// packets. Returns an error if the stub doesn't support them.
+    //------------------------------------------------------------------
+    lldb_private::Error
+    GetMemoryRegions (std::vector<lldb_private::MemoryRegionInfo> &regions);
+
     lldb_private::Error
     GetWatchpointSupportInfo (uint32_t &num); 
 
@@ -384,8 +391,29 @@ public:
                                 lldb::addr_t addr,        // Address of breakpoint or watchpoint
                                 uint32_t length);         // Byte Size of breakpoint or watchpoint
 
+    //------------------------------------------------------------------
+    /// Insert or remove a breakpoint at each address in \a addrs using
+    /// QSetBreakpoints/QRemoveBreakpoints packets, split up so that each
+    /// one fits in the remote's maximum packet size.
+    ///
+    /// @param[out] results
+    ///     Filled in with one entry per address: zero on success, the
+    ///     stub's error code, or UINT8_MAX if no reply was received.
+    ///
+    /// @return
+    ///     \b false if the stub doesn't support batched breakpoint
+    ///     packets, in which case nothing was sent and the caller should
+    ///     use SendGDBStoppointTypePacket() for each address instead.
+    //------------------------------------------------------------------
+    bool
+    SendGDBStoppointTypePackets (GDBStoppointType type,
+                                 bool insert,
+                                 const std::vector<lldb::addr_t> &addrs,
+                                 uint32_t length,
+                                 std::vector<uint8_t> &results);
+
     void
-    TestPacketSpeed (const uint32_t num_packets);
+    TestPacketSpeed (const uint32_t num_packets, lldb_private::Stream &strm);
 
     // This packet is for testing the speed of the interface only. Both
     // the client and server need to support it, but this allows us to
@@ -405,6 +433,9 @@ public:
     bool
     GetQXferAuxvReadSupported ();
 
+    bool
+    GetQSetBreakpointsSupported ();
+
     bool
     GetQXferLibrariesReadSupported ();
 
@@ -557,6 +588,7 @@ protected:
     lldb_private::LazyBool m_qGDBServerVersion_is_valid;
     lldb_private::LazyBool m_supports_alloc_dealloc_memory;
     lldb_private::LazyBool m_supports_memory_region_info;
+    lldb_private::LazyBool m_supports_memory_regions;
     lldb_private::LazyBool m_supports_watchpoint_support_info;
     lldb_private::LazyBool m_supports_detach_stay_stopped;
     lldb_private::LazyBool m_watchpoints_trigger_after_instruction;
@@ -570,6 +602,7 @@ protected:
     lldb_private::LazyBool m_supports_qXfer_libraries_read;
     lldb_private::LazyBool m_supports_qXfer_libraries_svr4_read;
     lldb_private::LazyBool m_supports_augmented_libraries_svr4_read;
+    lldb_private::LazyBool m_supports_QSetBreakpoints;
     lldb_private::LazyBool m_supports_jThreadExtendedInfo;
 
     bool
@@ -377,6 +377,10 @@ GDBRemoteCommunicationServer::GetPacketAndSendResponse (uint32_t timeout_usec,
             packet_result = Handle_qMemoryRegionInfo (packet);
             break;
 
+        case StringExtractorGDBRemote::eServerPacketType_qMemoryRegions:
+            packet_result = Handle_qMemoryRegions (packet);
+            break;
+
         case StringExtractorGDBRemote::eServerPacketType_interrupt:
             if (IsGdbServer ())
                 packet_result = Handle_interrupt (packet);
@@ -395,6 +399,14 @@ GDBRemoteCommunicationServer::GetPacketAndSendResponse (uint32_t timeout_usec,
             packet_result = Handle_z (packet);
             break;
 
+        case StringExtractorGDBRemote::eServerPacketType_QSetBreakpoints:
+            packet_result = Handle_QSetBreakpoints (packet);
+            break;
+
+        case StringExtractorGDBRemote::eServerPacketType_QRemoveBreakpoints:
+            packet_result = Handle_QRemoveBreakpoints (packet);
+            break;
+
         case StringExtractorGDBRemote::eServerPacketType_s:
             packet_result = Handle_s (packet);
             break;
@@ -3656,6 +3668,69 @@ GDBRemoteCommunicationServer::Handle_qMemoryRegionInfo (StringExtractorGDBRemote
     return SendPacketNoLock(response.GetData(), response.GetSize());
 }
 
+GDBRemoteCommunicationServer::PacketResult
+GDBRemoteCommunicationServer::Handle_qMemoryRegions (StringExtractorGDBRemote &packet)
+{
+    Log *log (GetLogIfAnyCategoriesSet(LIBLLDB_LOG_PROCESS));
+
+    // We don't support if we're not llgs.
+    if (!IsGdbServer())
+        return SendUnimplementedResponse ("");
+
+    // Ensure we have a process.
+    if (!m_debugged_process_sp || (m_debugged_process_sp->GetID () == LLDB_INVALID_PROCESS_ID))
+    {
+        if (log)
+            log->Printf ("GDBRemoteCommunicationServer::%s failed, no process available", __FUNCTION__);
+        return SendErrorResponse (0x15);
+    }
+
+    // Parse out the address to start listing from.
+    packet.SetFilePos (strlen("qMemoryRegions:"));
+    if (packet.GetBytesLeft() < 1)
+        return SendIllFormedResponse(packet, "Too short qMemoryRegions: packet");
+    const lldb::addr_t start_addr = packet.GetHexMaxU64(false, 0);
+
+    std::vector<MemoryRegionInfo> regions;
+    const Error error = m_debugged_process_sp->GetMemoryRegions (regions);
+    if (error.Fail ())
+    {
+        if (log)
+            log->Printf ("GDBRemoteCommunicationServer::%s failed to get memory regions: %s", __FUNCTION__, error.AsCString ());
+        return SendUnimplementedResponse ("");
+    }
+
+    // Stay well under the packet size we advertise in qSupported, and tell
+    // the client where to pick up if we run out of room.
+    const size_t max_response_size = 64 * 1024;
+
+    StreamGDBRemote response;
+    for (const MemoryRegionInfo &region_info : regions)
+    {
+        if (region_info.GetRange ().GetRangeEnd () <= start_addr)
+            continue;
+
+        if (response.GetSize () >= max_response_size)
+        {
+            response.Printf ("next:%" PRIx64 ";", region_info.GetRange ().GetRangeBase ());
+            break;
+        }
+
+        response.Printf ("start:%" PRIx64 ";size:%" PRIx64 ";permissions:", region_info.GetRange ().GetRangeBase (), region_info.GetRange ().GetByteSize ());
+        if (region_info.GetReadable ())
+            response.PutChar ('r');
+        if (region_info.GetWritable ())
+            response.PutChar('w');
+        if (region_info.GetExecutable())
+            response.PutChar ('x');
+        response.PutChar (';');
+    }
+
+    if (response.GetSize () == 0)
+        return SendOKResponse ();
+    return SendPacketNoLock(response.GetData(), response.GetSize());
+}
+
 GDBRemoteCommunicationServer::PacketResult
 GDBRemoteCommunicationServer::Handle_Z (StringExtractorGDBRemote &packet)
 {
@@ -3805,6 +3880,138 @@ GDBRemoteCommunicationServer::Handle_z (StringExtractorGDBRemote &packet)
     return SendUnimplementedResponse ("");
 }
 
+GDBRemoteCommunicationServer::PacketResult
+GDBRemoteCommunicationServer::Handle_QSetBreakpoints (StringExtractorGDBRemote &packet)
+{
+    return HandleBreakpointBatch (packet, true);
+}
+
+GDBRemoteCommunicationServer::PacketResult
+GDBRemoteCommunicationServer::Handle_QRemoveBreakpoints (StringExtractorGDBRemote &packet)
+{
+    return HandleBreakpointBatch (packet, false);
+}
+
+GDBRemoteCommunicationServer::PacketResult
+GDBRemoteCommunicationServer::HandleBreakpointBatch (StringExtractorGDBRemote &packet, bool set)
+{
+    Log *log (GetLogIfAnyCategoriesSet(LIBLLDB_LOG_BREAKPOINTS));
+
+    // We don't support if we're not llgs.
+    if (!IsGdbServer())
+        return SendUnimplementedResponse ("");
+
+    // Ensure we have a process.
+    if (!m_debugged_process_sp || (m_debugged_process_sp->GetID () == LLDB_INVALID_PROCESS_ID))
+    {
+        if (log)
+            log->Printf ("GDBRemoteCommunicationServer::%s failed, no process available", __FUNCTION__);
+        return SendErrorResponse (0x15);
+    }
+
+    // Parse out the "<type>,<addr>,<kind>" entries, which are separated by
+    // semicolons.
+    packet.SetFilePos (strlen (set ? "QSetBreakpoints:" : "QRemoveBreakpoints:"));
+
+    std::vector<lldb::addr_t> addrs;
+    std::vector<bool> hardware;
+    std::vector<uint32_t> kinds;
+    while (packet.GetBytesLeft () > 0)
+    {
+        bool want_hardware = false;
+        switch (packet.GetChar ())
+        {
+            case '0': want_hardware = false; break;
+            case '1': want_hardware = true;  break;
+            case '2':
+            case '3':
+                return SendUnimplementedResponse ("watchpoint support not yet implemented");
+            default:
+                return SendIllFormedResponse (packet, "breakpoint batch had invalid software/hardware specifier");
+        }
+
+        if ((packet.GetBytesLeft() < 1) || packet.GetChar () != ',')
+            return SendIllFormedResponse (packet, "Malformed breakpoint batch, expecting comma after breakpoint type");
+
+        if (packet.GetBytesLeft() < 1)
+            return SendIllFormedResponse (packet, "Too short breakpoint batch, missing address");
+        const lldb::addr_t breakpoint_addr = packet.GetHexMaxU64 (false, 0);
+
+        if ((packet.GetBytesLeft() < 1) || packet.GetChar () != ',')
+            return SendIllFormedResponse (packet, "Malformed breakpoint batch, expecting comma after address");
+
+        const uint32_t kind = packet.GetHexMaxU32 (false, std::numeric_limits<uint32_t>::max ());
+        if (kind == std::numeric_limits<uint32_t>::max ())
+            return SendIllFormedResponse (packet, "Malformed breakpoint batch, failed to parse kind argument");
+
+        addrs.push_back (breakpoint_addr);
+        hardware.push_back (want_hardware);
+        kinds.push_back (kind);
+
+        if (packet.GetBytesLeft () > 0 && packet.GetChar () != ';')
+            return SendIllFormedResponse (packet, "Malformed breakpoint batch, expecting semicolon between entries");
+    }
+
+    if (addrs.empty ())
+        return SendIllFormedResponse (packet, "breakpoint batch had no entries");
+
+    // Hand each group of entries that share a type and kind to the process
+    // in one call so it can batch the memory writes.
+    std::vector<Error> errors (addrs.size ());
+    std::vector<bool> handled (addrs.size (), false);
+    for (size_t i = 0; i < addrs.size (); ++i)
+    {
+        if (handled[i])
+            continue;
+
+        std::vector<size_t> group;
+        for (size_t j = i; j < addrs.size (); ++j)
+        {
+            if (!handled[j] && hardware[j] == hardware[i] && kinds[j] == kinds[i])
+            {
+                group.push_back (j);
+                handled[j] = true;
+            }
+        }
+
+        std::vector<lldb::addr_t> group_addrs;
+        for (size_t idx : group)
+            group_addrs.push_back (addrs[idx]);
+
+        std::vector<Error> group_errors;
+        if (set)
+            m_debugged_process_sp->SetBreakpoints (group_addrs, kinds[i], hardware[i], group_errors);
+        else
+            m_debugged_process_sp->RemoveBreakpoints (group_addrs, group_errors);
+
+        for (size_t k = 0; k < group.size () && k < group_errors.size (); ++k)
+            errors[group[k]] = group_errors[k];
+    }
+
+    // Reply with a plain OK when everything worked, otherwise with one
+    // result per entry in the order they were sent.
+    bool all_succeeded = true;
+    StreamGDBRemote response;
+    for (size_t i = 0; i < errors.size (); ++i)
+    {
+        if (i > 0)
+            response.PutChar (';');
+        if (errors[i].Success ())
+            response.PutCString ("OK");
+        else
+        {
+            all_succeeded = false;
+            response.PutCString ("E09");
+            if (log)
+                log->Printf ("GDBRemoteCommunicationServer::%s pid %" PRIu64 " failed to %s breakpoint at 0x%" PRIx64 ": %s", __FUNCTION__, m_debugged_process_sp->GetID (), set ? "set" : "remove", addrs[i], errors[i].AsCString ());
+        }
+    }
+
+    if (all_succeeded)
+        return SendOKResponse ();
+    return SendPacketNoLock (response.GetData (), response.GetSize ());
+}
+
 GDBRemoteCommunicationServer::PacketResult
 GDBRemoteCommunicationServer::Handle_s (StringExtractorGDBRemote &packet)
 {
@@ -3873,6 +4080,9 @@ GDBRemoteCommunicationServer::Handle_qSupported (StringExtractorGDBRemote &packe
     response.PutCString (";qXfer:auxv:read+");
 #endif
 
+    if (IsGdbServer ())
+        response.PutCString (";QSetBreakpoints+");
+
     return SendPacketNoLock(response.GetData(), response.GetSize());
 }
 
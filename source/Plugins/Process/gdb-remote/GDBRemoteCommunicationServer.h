@@ -430,12 +430,24 @@ protected:
     PacketResult
     Handle_qMemoryRegionInfo (StringExtractorGDBRemote &packet);
 
+    PacketResult
+    Handle_qMemoryRegions (StringExtractorGDBRemote &packet);
+
     PacketResult
     Handle_Z (StringExtractorGDBRemote &packet);
 
     PacketResult
     Handle_z (StringExtractorGDBRemote &packet);
 
+    PacketResult
+    Handle_QSetBreakpoints (StringExtractorGDBRemote &packet);
+
+    PacketResult
+    Handle_QRemoveBreakpoints (StringExtractorGDBRemote &packet);
+
+    PacketResult
+    HandleBreakpointBatch (StringExtractorGDBRemote &packet, bool set);
+
     PacketResult
     Handle_s (StringExtractorGDBRemote &packet);
 
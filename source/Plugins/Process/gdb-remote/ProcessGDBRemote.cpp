@@ -103,13 +103,15 @@ namespace {
     {
         { "packet-timeout" , OptionValue::eTypeUInt64 , true , 1, NULL, NULL, "Specify the default packet timeout in seconds." },
         { "target-definition-file" , OptionValue::eTypeFileSpec , true, 0 , NULL, NULL, "The file that provides the description for remote target registers." },
+        { "use-shared-memory" , OptionValue::eTypeBoolean , true, false, NULL, NULL, "If true, talk to a locally launched lldb-gdbserver through a shared memory ring buffer instead of a loopback socket." },
         {  NULL            , OptionValue::eTypeInvalid, false, 0, NULL, NULL, NULL  }
     };
     
     enum
     {
         ePropertyPacketTimeout,
-        ePropertyTargetDefinitionFile
+        ePropertyTargetDefinitionFile,
+        ePropertyUseSharedMemory
     };
     
     class PluginProperties : public Properties
@@ -154,6 +156,13 @@ namespace {
             const uint32_t idx = ePropertyTargetDefinitionFile;
             return m_collection_sp->GetPropertyAtIndexAsFileSpec (NULL, idx);
         }
+
+        bool
+        GetUseSharedMemory () const
+        {
+            const uint32_t idx = ePropertyUseSharedMemory;
+            return m_collection_sp->GetPropertyAtIndexAsBoolean (NULL, idx, g_properties[idx].default_uint_value != 0);
+        }
     };
     
     typedef std::shared_ptr<PluginProperties> ProcessKDPPropertiesSP;
@@ -1758,6 +1767,8 @@ ProcessGDBRemote::SetThreadStopInfo (StringExtractor& stop_packet)
                         {
                             addr_t pc = thread_sp->GetRegisterContext()->GetPC();
                             lldb::BreakpointSiteSP bp_site_sp = thread_sp->GetProcess()->GetBreakpointSiteList().FindByAddress(pc);
+                            if (!bp_site_sp)
+                                bp_site_sp = ResolveInjectedConditionTrap (*thread_sp, pc);
                             if (bp_site_sp)
                             {
                                 // If the breakpoint is for this thread, then we'll report the hit, but if it is for another thread,
@@ -1808,6 +1819,8 @@ ProcessGDBRemote::SetThreadStopInfo (StringExtractor& stop_packet)
                             handled = true;
                             addr_t pc = thread_sp->GetRegisterContext()->GetPC() + m_breakpoint_pc_offset;
                             lldb::BreakpointSiteSP bp_site_sp = thread_sp->GetProcess()->GetBreakpointSiteList().FindByAddress(pc);
+                            if (!bp_site_sp)
+                                bp_site_sp = ResolveInjectedConditionTrap (*thread_sp, pc);
 
                             if (bp_site_sp)
                             {
@@ -2283,6 +2296,19 @@ ProcessGDBRemote::DoWriteMemory (addr_t addr, const void *buf, size_t size, Erro
     return 0;
 }
 
+static unsigned
+GetMmapProtection (uint32_t permissions)
+{
+    unsigned prot = 0;
+    if (permissions & lldb::ePermissionsReadable)
+        prot |= eMmapProtRead;
+    if (permissions & lldb::ePermissionsWritable)
+        prot |= eMmapProtWrite;
+    if (permissions & lldb::ePermissionsExecutable)
+        prot |= eMmapProtExec;
+    return prot;
+}
+
 lldb::addr_t
 ProcessGDBRemote::DoAllocateMemory (size_t size, uint32_t permissions, Error &error)
 {
@@ -2300,15 +2326,7 @@ ProcessGDBRemote::DoAllocateMemory (size_t size, uint32_t permissions, Error &er
 
         case eLazyBoolNo:
             // Call mmap() to create memory in the inferior..
-            unsigned prot = 0;
-            if (permissions & lldb::ePermissionsReadable)
-                prot |= eMmapProtRead;
-            if (permissions & lldb::ePermissionsWritable)
-                prot |= eMmapProtWrite;
-            if (permissions & lldb::ePermissionsExecutable)
-                prot |= eMmapProtExec;
-
-            if (InferiorCallMmap(this, allocated_addr, 0, size, prot,
+            if (InferiorCallMmap(this, allocated_addr, 0, size, GetMmapProtection(permissions),
                                  eMmapFlagsAnon | eMmapFlagsPrivate, -1, 0))
                 m_addr_to_mmap_size[allocated_addr] = size;
             else
@@ -2327,6 +2345,26 @@ ProcessGDBRemote::DoAllocateMemory (size_t size, uint32_t permissions, Error &er
     return allocated_addr;
 }
 
+addr_t
+ProcessGDBRemote::DoAllocateMemoryNear (addr_t hint_addr, size_t size, uint32_t permissions, Error &error)
+{
+    // Only mmap() takes a hint, so use it even if the stub can allocate
+    // memory itself.
+    addr_t allocated_addr = LLDB_INVALID_ADDRESS;
+    if (InferiorCallMmap(this, allocated_addr, hint_addr, size, GetMmapProtection(permissions),
+                         eMmapFlagsAnon | eMmapFlagsPrivate, -1, 0))
+    {
+        m_addr_to_mmap_size[allocated_addr] = size;
+        error.Clear();
+    }
+    else
+    {
+        allocated_addr = LLDB_INVALID_ADDRESS;
+        error.SetErrorStringWithFormat("unable to allocate %" PRIu64 " bytes of memory near 0x%" PRIx64 " with permissions %s", (uint64_t)size, hint_addr, GetPermissionsAsCString (permissions));
+    }
+    return allocated_addr;
+}
+
 Error
 ProcessGDBRemote::GetMemoryRegionInfo (addr_t load_addr, 
                                        MemoryRegionInfo &region_info)
@@ -2336,6 +2374,17 @@ ProcessGDBRemote::GetMemoryRegionInfo (addr_t load_addr,
     return error;
 }
 
+Error
+ProcessGDBRemote::GetMemoryRegions (std::vector<MemoryRegionInfo> &regions)
+{
+    // Fall back to one qMemoryRegionInfo per region if the stub can't list
+    // them all at once.
+    Error error (m_gdb_comm.GetMemoryRegions (regions));
+    if (error.Fail())
+        error = Process::GetMemoryRegions (regions);
+    return error;
+}
+
 Error
 ProcessGDBRemote::GetWatchpointSupportInfo (uint32_t &num)
 {
@@ -2357,6 +2406,11 @@ ProcessGDBRemote::DoDeallocateMemory (lldb::addr_t addr)
     Error error; 
     LazyBool supported = m_gdb_comm.SupportsAllocDeallocMemory();
 
+    // Memory from DoAllocateMemoryNear() came from mmap() even if the stub
+    // can allocate memory.
+    if (m_addr_to_mmap_size.find(addr) != m_addr_to_mmap_size.end())
+        supported = eLazyBoolNo;
+
     switch (supported)
     {
         case eLazyBoolCalculate:
@@ -2426,6 +2480,11 @@ ProcessGDBRemote::EnableBreakpointSite (BreakpointSite *bp_site)
         return error;
     }
 
+    // The jump to an injected condition can only be put in place by writing
+    // it to memory ourselves.
+    if (bp_site->IsConditionInjected())
+        return EnableSoftwareBreakpoint(bp_site);
+
     // Get the software breakpoint trap opcode size
     const size_t bp_op_size = GetSoftwareBreakpointTrapOpcode(bp_site);
 
@@ -2562,6 +2621,121 @@ ProcessGDBRemote::DisableBreakpointSite (BreakpointSite *bp_site)
     return error;
 }
 
+Error
+ProcessGDBRemote::EnableBreakpointSites (const std::vector<BreakpointSite *> &bp_sites, std::vector<Error> &errors)
+{
+    Log *log(ProcessGDBRemoteLog::GetLogIfAllCategoriesSet(GDBR_LOG_BREAKPOINTS));
+
+    // Send all of the software breakpoints that share a trap opcode size in
+    // as few packets as possible. Anything the stub didn't set, or that
+    // needs a hardware breakpoint, goes through EnableBreakpointSite() so
+    // it gets the usual fallbacks.
+    std::map<size_t, std::vector<BreakpointSite *> > sites_by_size;
+    if (bp_sites.size() > 1 && m_gdb_comm.SupportsGDBStoppointPacket(eBreakpointSoftware))
+    {
+        for (BreakpointSite *bp_site : bp_sites)
+        {
+            if (!bp_site->IsEnabled() && !bp_site->HardwareRequired() && !bp_site->IsConditionInjected())
+                sites_by_size[GetSoftwareBreakpointTrapOpcode(bp_site)].push_back (bp_site);
+        }
+    }
+
+    for (auto &pos : sites_by_size)
+    {
+        std::vector<addr_t> addrs;
+        for (BreakpointSite *bp_site : pos.second)
+            addrs.push_back (bp_site->GetLoadAddress());
+
+        std::vector<uint8_t> results;
+        if (!m_gdb_comm.SendGDBStoppointTypePackets(eBreakpointSoftware, true, addrs, pos.first, results))
+            break;
+
+        size_t num_set = 0;
+        for (size_t i = 0; i < pos.second.size(); ++i)
+        {
+            if (results[i] == 0)
+            {
+                pos.second[i]->SetEnabled(true);
+                pos.second[i]->SetType(BreakpointSite::eExternal);
+                ++num_set;
+            }
+        }
+        if (log)
+            log->Printf ("ProcessGDBRemote::EnableBreakpointSites set %" PRIu64 " of %" PRIu64 " breakpoints in a batch", (uint64_t)num_set, (uint64_t)addrs.size());
+    }
+
+    size_t num_failed = 0;
+    errors.clear();
+    for (BreakpointSite *bp_site : bp_sites)
+    {
+        // EnableBreakpointSite() returns right away for sites set above.
+        errors.push_back (EnableBreakpointSite(bp_site));
+        if (errors.back().Fail())
+            ++num_failed;
+    }
+
+    Error error;
+    if (num_failed > 0)
+        error.SetErrorStringWithFormat ("failed to enable %" PRIu64 " of %" PRIu64 " breakpoint sites", (uint64_t)num_failed, (uint64_t)bp_sites.size());
+    return error;
+}
+
+Error
+ProcessGDBRemote::DisableBreakpointSites (const std::vector<BreakpointSite *> &bp_sites, std::vector<Error> &errors)
+{
+    Log *log(ProcessGDBRemoteLog::GetLogIfAllCategoriesSet(GDBR_LOG_BREAKPOINTS));
+
+    // Only breakpoints the stub inserted for us with "Z0" can be removed in
+    // a batch, everything else goes through DisableBreakpointSite().
+    std::map<size_t, std::vector<BreakpointSite *> > sites_by_size;
+    if (bp_sites.size() > 1)
+    {
+        for (BreakpointSite *bp_site : bp_sites)
+        {
+            if (bp_site->IsEnabled() && bp_site->GetType() == BreakpointSite::eExternal && !bp_site->IsHardware())
+                sites_by_size[GetSoftwareBreakpointTrapOpcode(bp_site)].push_back (bp_site);
+        }
+    }
+
+    for (auto &pos : sites_by_size)
+    {
+        std::vector<addr_t> addrs;
+        for (BreakpointSite *bp_site : pos.second)
+            addrs.push_back (bp_site->GetLoadAddress());
+
+        std::vector<uint8_t> results;
+        if (!m_gdb_comm.SendGDBStoppointTypePackets(eBreakpointSoftware, false, addrs, pos.first, results))
+            break;
+
+        size_t num_removed = 0;
+        for (size_t i = 0; i < pos.second.size(); ++i)
+        {
+            if (results[i] == 0)
+            {
+                pos.second[i]->SetEnabled(false);
+                ++num_removed;
+            }
+        }
+        if (log)
+            log->Printf ("ProcessGDBRemote::DisableBreakpointSites removed %" PRIu64 " of %" PRIu64 " breakpoints in a batch", (uint64_t)num_removed, (uint64_t)addrs.size());
+    }
+
+    size_t num_failed = 0;
+    errors.clear();
+    for (BreakpointSite *bp_site : bp_sites)
+    {
+        // DisableBreakpointSite() returns right away for sites removed above.
+        errors.push_back (DisableBreakpointSite(bp_site));
+        if (errors.back().Fail())
+            ++num_failed;
+    }
+
+    Error error;
+    if (num_failed > 0)
+        error.SetErrorStringWithFormat ("failed to disable %" PRIu64 " of %" PRIu64 " breakpoint sites", (uint64_t)num_failed, (uint64_t)bp_sites.size());
+    return error;
+}
+
 // Pre-requisite: wp != NULL.
 static GDBStoppointType
 GetGDBStoppointType (Watchpoint *wp)
@@ -2716,11 +2890,15 @@ ProcessGDBRemote::LaunchAndConnectToDebugserver (const ProcessInfo &process_info
         const char *hostname = NULL;
         uint16_t port = 0;
 #endif
+        // Only the reverse connect case launches a debugserver that can
+        // attach to a shared memory connection in this process
+        const bool use_shared_memory = hostname == NULL && GetGlobalPluginProperties()->GetUseSharedMemory();
 
         error = m_gdb_comm.StartDebugserverProcess (hostname,
                                                     port,
                                                     debugserver_launch_info,
-                                                    port);
+                                                    port,
+                                                    use_shared_memory);
 
         if (error.Success ())
             m_debugserver_pid = debugserver_launch_info.GetProcessID();
@@ -3411,6 +3589,66 @@ public:
 };
 
 
+class CommandObjectProcessGDBRemotePacketSpeedTest : public CommandObjectParsed
+{
+private:
+    
+public:
+    CommandObjectProcessGDBRemotePacketSpeedTest(CommandInterpreter &interpreter) :
+    CommandObjectParsed (interpreter,
+                         "process plugin packet speed-test",
+                         "Send qSpeedTest packets with varying send and receive sizes and report the packets/sec and MB/sec the connection achieves. "
+                         "Takes an optional argument that specifies how many packets to send for each size (default is 1000).",
+                         NULL)
+    {
+    }
+    
+    ~CommandObjectProcessGDBRemotePacketSpeedTest ()
+    {
+    }
+    
+    bool
+    DoExecute (Args& command, CommandReturnObject &result)
+    {
+        const size_t argc = command.GetArgumentCount();
+        uint32_t num_packets = 1000;
+        if (argc > 1)
+        {
+            result.AppendErrorWithFormat ("'%s' takes at most one argument", m_cmd_name.c_str());
+            result.SetStatus (eReturnStatusFailed);
+            return false;
+        }
+        if (argc == 1)
+        {
+            bool success = false;
+            num_packets = Args::StringToUInt32 (command.GetArgumentAtIndex(0), 0, 0, &success);
+            if (!success || num_packets == 0)
+            {
+                result.AppendErrorWithFormat ("invalid packet count '%s'", command.GetArgumentAtIndex(0));
+                result.SetStatus (eReturnStatusFailed);
+                return false;
+            }
+        }
+
+        ProcessGDBRemote *process = (ProcessGDBRemote *)m_interpreter.GetExecutionContext().GetProcessPtr();
+        if (process)
+        {
+            if (!process->GetGDBRemote().SendSpeedTestPacket (0, 0))
+            {
+                result.AppendError ("the remote GDB server doesn't support the qSpeedTest packet");
+                result.SetStatus (eReturnStatusFailed);
+                return false;
+            }
+            process->GetGDBRemote().TestPacketSpeed (num_packets, result.GetOutputStream());
+            result.SetStatus (eReturnStatusSuccessFinishResult);
+            return true;
+        }
+        result.AppendError ("no process");
+        result.SetStatus (eReturnStatusFailed);
+        return false;
+    }
+};
+
 class CommandObjectProcessGDBRemotePacketSend : public CommandObjectParsed
 {
 private:
@@ -3537,6 +3775,7 @@ public:
         LoadSubCommand ("send", CommandObjectSP (new CommandObjectProcessGDBRemotePacketSend (interpreter)));
         LoadSubCommand ("monitor", CommandObjectSP (new CommandObjectProcessGDBRemotePacketMonitor (interpreter)));
         LoadSubCommand ("xfer-size", CommandObjectSP (new CommandObjectProcessGDBRemotePacketXferSize (interpreter)));
+        LoadSubCommand ("speed-test", CommandObjectSP (new CommandObjectProcessGDBRemotePacketSpeedTest (interpreter)));
     }
     
     ~CommandObjectProcessGDBRemotePacket ()
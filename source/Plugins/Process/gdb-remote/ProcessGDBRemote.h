@@ -176,9 +176,15 @@ public:
     virtual lldb::addr_t
     DoAllocateMemory (size_t size, uint32_t permissions, lldb_private::Error &error);
 
+    virtual lldb::addr_t
+    DoAllocateMemoryNear (lldb::addr_t hint_addr, size_t size, uint32_t permissions, lldb_private::Error &error);
+
     virtual lldb_private::Error
     GetMemoryRegionInfo (lldb::addr_t load_addr, 
                          lldb_private::MemoryRegionInfo &region_info);
+
+    virtual lldb_private::Error
+    GetMemoryRegions (std::vector<lldb_private::MemoryRegionInfo> &regions);
     
     virtual lldb_private::Error
     DoDeallocateMemory (lldb::addr_t ptr);
@@ -198,6 +204,12 @@ public:
     virtual lldb_private::Error
     DisableBreakpointSite (lldb_private::BreakpointSite *bp_site);
 
+    virtual lldb_private::Error
+    EnableBreakpointSites (const std::vector<lldb_private::BreakpointSite *> &bp_sites, std::vector<lldb_private::Error> &errors);
+
+    virtual lldb_private::Error
+    DisableBreakpointSites (const std::vector<lldb_private::BreakpointSite *> &bp_sites, std::vector<lldb_private::Error> &errors);
+
     //----------------------------------------------------------------------
     // Process Watchpoints
     //----------------------------------------------------------------------
@@ -37,8 +37,9 @@
 // space (item_buffer_size in size) which must be mach_vm_deallocate'd by
 // lldb.  
 //
-// The AppleGetItemInfoHandler object should persist so that the ClangUtilityFunction
-// can be reused multiple times.
+// The ClangUtilityFunction and the ClangFunction that calls it are kept by
+// the process (see Process::GetUtilityFunction), so they are only compiled
+// once per process.
 
 namespace lldb_private
 {
@@ -104,8 +105,8 @@ private:
     static const char *g_get_item_info_function_code;
 
     lldb_private::Process *m_process;
-    std::unique_ptr<ClangFunction> m_get_item_info_function;
-    std::unique_ptr<ClangUtilityFunction> m_get_item_info_impl_code;
+    ClangFunction *m_get_item_info_function;          // Owned by the process
+    ClangUtilityFunction *m_get_item_info_impl_code;   // Owned by the process
     Mutex m_get_item_info_function_mutex;
 
     lldb::addr_t m_get_item_info_return_buffer_addr;
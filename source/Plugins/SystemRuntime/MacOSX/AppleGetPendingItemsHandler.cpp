@@ -105,8 +105,8 @@ extern \"C\"
 
 AppleGetPendingItemsHandler::AppleGetPendingItemsHandler (Process *process) :
     m_process (process),
-    m_get_pending_items_function (),
-    m_get_pending_items_impl_code (),
+    m_get_pending_items_function (NULL),
+    m_get_pending_items_impl_code (NULL),
     m_get_pending_items_function_mutex(),
     m_get_pending_items_return_buffer_addr (LLDB_INVALID_ADDRESS),
     m_get_pending_items_retbuffer_mutex()
@@ -181,17 +181,18 @@ AppleGetPendingItemsHandler::SetupGetPendingItemsFunction (Thread &thread, Value
                 return args_addr;
             }
         }
-        else if (!m_get_pending_items_impl_code.get())
+        else if (!m_get_pending_items_impl_code)
         {
             if (g_get_pending_items_function_code != NULL)
             {
-                m_get_pending_items_impl_code.reset (new ClangUtilityFunction (g_get_pending_items_function_code,
-                                                             g_get_pending_items_function_name));
-                if (!m_get_pending_items_impl_code->Install(errors, exe_ctx))
+                m_get_pending_items_impl_code = thread.GetProcess()->GetUtilityFunction (g_get_pending_items_function_code,
+                                                                                         g_get_pending_items_function_name,
+                                                                                         exe_ctx,
+                                                                                         errors);
+                if (!m_get_pending_items_impl_code)
                 {
                     if (log)
                         log->Printf ("Failed to install pending-items introspection: %s.", errors.GetData());
-                    m_get_pending_items_impl_code.reset();
                     return args_addr;
                 }
             }
@@ -212,31 +213,23 @@ AppleGetPendingItemsHandler::SetupGetPendingItemsFunction (Thread &thread, Value
             impl_code_address.SetOffset(m_get_pending_items_impl_code->StartAddress());
         }
 
-        // Next make the runner function for our implementation utility function.
-        if (!m_get_pending_items_function.get())
+        // Next get the runner function for our implementation utility function.  The
+        // process compiles it and the utility function once and keeps them.
+        if (!m_get_pending_items_function)
         {
             ClangASTContext *clang_ast_context = thread.GetProcess()->GetTarget().GetScratchClangASTContext();
             ClangASTType get_pending_items_return_type = clang_ast_context->GetBasicType(eBasicTypeVoid).GetPointerType();
-            m_get_pending_items_function.reset(new ClangFunction (thread,
-                                                     get_pending_items_return_type,
-                                                     impl_code_address,
-                                                     get_pending_items_arglist,
-                                                     "queue-pending-items"));
-            
-            errors.Clear();        
-            unsigned num_errors = m_get_pending_items_function->CompileFunction(errors);
-            if (num_errors)
-            {
-                if (log)
-                    log->Printf ("Error compiling pending-items function: \"%s\".", errors.GetData());
-                return args_addr;
-            }
-            
             errors.Clear();
-            if (!m_get_pending_items_function->WriteFunctionWrapper(exe_ctx, errors))
+            m_get_pending_items_function = thread.GetProcess()->GetCallerFunction (impl_code_address,
+                                                                                   get_pending_items_return_type,
+                                                                                   get_pending_items_arglist,
+                                                                                   "queue-pending-items",
+                                                                                   exe_ctx,
+                                                                                   errors);
+            if (!m_get_pending_items_function)
             {
                 if (log)
-                    log->Printf ("Error Inserting pending-items function: \"%s\".", errors.GetData());
+                    log->Printf ("Error compiling pending-items function: \"%s\".", errors.GetData());
                 return args_addr;
             }
         }
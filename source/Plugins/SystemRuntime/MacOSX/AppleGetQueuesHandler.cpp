@@ -101,8 +101,8 @@ extern \"C\"
 
 AppleGetQueuesHandler::AppleGetQueuesHandler (Process *process) :
     m_process (process),
-    m_get_queues_function (),
-    m_get_queues_impl_code (),
+    m_get_queues_function (NULL),
+    m_get_queues_impl_code (NULL),
     m_get_queues_function_mutex(),
     m_get_queues_return_buffer_addr (LLDB_INVALID_ADDRESS),
     m_get_queues_retbuffer_mutex()
@@ -189,17 +189,18 @@ AppleGetQueuesHandler::SetupGetQueuesFunction (Thread &thread, ValueList &get_qu
                 return args_addr;
             }
         }
-        else if (!m_get_queues_impl_code.get())
+        else if (!m_get_queues_impl_code)
         {
             if (g_get_current_queues_function_code != NULL)
             {
-                m_get_queues_impl_code.reset (new ClangUtilityFunction (g_get_current_queues_function_code,
-                                                             g_get_current_queues_function_name));
-                if (!m_get_queues_impl_code->Install(errors, exe_ctx))
+                m_get_queues_impl_code = thread.GetProcess()->GetUtilityFunction (g_get_current_queues_function_code,
+                                                                                  g_get_current_queues_function_name,
+                                                                                  exe_ctx,
+                                                                                  errors);
+                if (!m_get_queues_impl_code)
                 {
                     if (log)
                         log->Printf ("Failed to install queues introspection: %s.", errors.GetData());
-                    m_get_queues_impl_code.reset();
                     return args_addr;
                 }
             }
@@ -220,31 +221,23 @@ AppleGetQueuesHandler::SetupGetQueuesFunction (Thread &thread, ValueList &get_qu
             impl_code_address.SetOffset(m_get_queues_impl_code->StartAddress());
         }
 
-        // Next make the runner function for our implementation utility function.
-        if (!m_get_queues_function.get())
+        // Next get the runner function for our implementation utility function.  The
+        // process compiles it and the utility function once and keeps them.
+        if (!m_get_queues_function)
         {
             ClangASTContext *clang_ast_context = thread.GetProcess()->GetTarget().GetScratchClangASTContext();
             ClangASTType get_queues_return_type = clang_ast_context->GetBasicType(eBasicTypeVoid).GetPointerType();
-            m_get_queues_function.reset(new ClangFunction (thread,
-                                                     get_queues_return_type,
-                                                     impl_code_address,
-                                                     get_queues_arglist,
-                                                     "queue-fetch-queues"));
-            
-            errors.Clear();        
-            unsigned num_errors = m_get_queues_function->CompileFunction(errors);
-            if (num_errors)
-            {
-                if (log)
-                    log->Printf ("Error compiling get-queues function: \"%s\".", errors.GetData());
-                return args_addr;
-            }
-            
             errors.Clear();
-            if (!m_get_queues_function->WriteFunctionWrapper(exe_ctx, errors))
+            m_get_queues_function = thread.GetProcess()->GetCallerFunction (impl_code_address,
+                                                                            get_queues_return_type,
+                                                                            get_queues_arglist,
+                                                                            "queue-fetch-queues",
+                                                                            exe_ctx,
+                                                                            errors);
+            if (!m_get_queues_function)
             {
                 if (log)
-                    log->Printf ("Error Inserting get-queues function: \"%s\".", errors.GetData());
+                    log->Printf ("Error compiling get-queues function: \"%s\".", errors.GetData());
                 return args_addr;
             }
         }
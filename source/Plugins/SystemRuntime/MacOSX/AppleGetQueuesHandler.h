@@ -38,8 +38,9 @@
 // space (queues_buffer_size in size) which must be mach_vm_deallocate'd by
 // lldb.  count is the number of queues that were stored in the buffer.
 //
-// The AppleGetQueuesHandler object should persist so that the ClangUtilityFunction
-// can be reused multiple times.
+// The ClangUtilityFunction and the ClangFunction that calls it are kept by
+// the process (see Process::GetUtilityFunction), so they are only compiled
+// once per process.
 
 namespace lldb_private
 {
@@ -104,8 +105,8 @@ private:
     static const char *g_get_current_queues_function_code;
 
     lldb_private::Process *m_process;
-    std::unique_ptr<ClangFunction> m_get_queues_function;
-    std::unique_ptr<ClangUtilityFunction> m_get_queues_impl_code;
+    ClangFunction *m_get_queues_function;          // Owned by the process
+    ClangUtilityFunction *m_get_queues_impl_code;   // Owned by the process
     Mutex m_get_queues_function_mutex;
 
     lldb::addr_t m_get_queues_return_buffer_addr;
@@ -105,8 +105,8 @@ extern \"C\"
 
 AppleGetThreadItemInfoHandler::AppleGetThreadItemInfoHandler (Process *process) :
     m_process (process),
-    m_get_thread_item_info_function (),
-    m_get_thread_item_info_impl_code (),
+    m_get_thread_item_info_function (NULL),
+    m_get_thread_item_info_impl_code (NULL),
     m_get_thread_item_info_function_mutex(),
     m_get_thread_item_info_return_buffer_addr (LLDB_INVALID_ADDRESS),
     m_get_thread_item_info_retbuffer_mutex()
@@ -181,17 +181,18 @@ AppleGetThreadItemInfoHandler::SetupGetThreadItemInfoFunction (Thread &thread, V
                 return args_addr;
             }
         }
-        else if (!m_get_thread_item_info_impl_code.get())
+        else if (!m_get_thread_item_info_impl_code)
         {
             if (g_get_thread_item_info_function_code != NULL)
             {
-                m_get_thread_item_info_impl_code.reset (new ClangUtilityFunction (g_get_thread_item_info_function_code,
-                                                             g_get_thread_item_info_function_name));
-                if (!m_get_thread_item_info_impl_code->Install(errors, exe_ctx))
+                m_get_thread_item_info_impl_code = thread.GetProcess()->GetUtilityFunction (g_get_thread_item_info_function_code,
+                                                                                            g_get_thread_item_info_function_name,
+                                                                                            exe_ctx,
+                                                                                            errors);
+                if (!m_get_thread_item_info_impl_code)
                 {
                     if (log)
                         log->Printf ("Failed to install get-thread-item-info introspection: %s.", errors.GetData());
-                    m_get_thread_item_info_impl_code.reset();
                     return args_addr;
                 }
             }
@@ -212,31 +213,23 @@ AppleGetThreadItemInfoHandler::SetupGetThreadItemInfoFunction (Thread &thread, V
             impl_code_address.SetOffset(m_get_thread_item_info_impl_code->StartAddress());
         }
 
-        // Next make the runner function for our implementation utility function.
-        if (!m_get_thread_item_info_function.get())
+        // Next get the runner function for our implementation utility function.  The
+        // process compiles it and the utility function once and keeps them.
+        if (!m_get_thread_item_info_function)
         {
             ClangASTContext *clang_ast_context = thread.GetProcess()->GetTarget().GetScratchClangASTContext();
             ClangASTType get_thread_item_info_return_type = clang_ast_context->GetBasicType(eBasicTypeVoid).GetPointerType();
-            m_get_thread_item_info_function.reset(new ClangFunction (thread,
-                                                                     get_thread_item_info_return_type,
-                                                                     impl_code_address,
-                                                                     get_thread_item_info_arglist,
-                                                                     "queue-thread-item-info"));
-            
-            errors.Clear();        
-            unsigned num_errors = m_get_thread_item_info_function->CompileFunction(errors);
-            if (num_errors)
-            {
-                if (log)
-                    log->Printf ("Error compiling get-thread-item-info function: \"%s\".", errors.GetData());
-                return args_addr;
-            }
-            
             errors.Clear();
-            if (!m_get_thread_item_info_function->WriteFunctionWrapper(exe_ctx, errors))
+            m_get_thread_item_info_function = thread.GetProcess()->GetCallerFunction (impl_code_address,
+                                                                                      get_thread_item_info_return_type,
+                                                                                      get_thread_item_info_arglist,
+                                                                                      "queue-thread-item-info",
+                                                                                      exe_ctx,
+                                                                                      errors);
+            if (!m_get_thread_item_info_function)
             {
                 if (log)
-                    log->Printf ("Error Inserting get-thread-item-info function: \"%s\".", errors.GetData());
+                    log->Printf ("Error compiling get-thread-item-info function: \"%s\".", errors.GetData());
                 return args_addr;
             }
         }
@@ -9,6 +9,9 @@
 
 #include "UnwindAssembly-x86.h"
 
+#include <algorithm>
+#include <vector>
+
 #include "llvm-c/Disassembler.h"
 #include "llvm/Support/TargetSelect.h"
 
@@ -16,6 +19,7 @@
 #include "lldb/Core/Error.h"
 #include "lldb/Core/ArchSpec.h"
 #include "lldb/Core/PluginManager.h"
+#include "lldb/Host/Mutex.h"
 #include "lldb/Symbol/UnwindPlan.h"
 #include "lldb/Target/ExecutionContext.h"
 #include "lldb/Target/Process.h"
@@ -114,10 +118,73 @@ static int x86_64_register_map_initialized = 0;
 //  AssemblyParse_x86 local-file class definition & implementation functions
 //-----------------------------------------------------------------------------------------------
 
+//-----------------------------------------------------------------------------------------------
+//  The instructions the prologue scanner recognizes
+//-----------------------------------------------------------------------------------------------
+
+enum insn_kind {
+    k_insn_other,
+    k_insn_push_reg,            // pushq %reg                       [0x50+reg]
+    k_insn_push_0,              // pushq $0                         [0x6a 0x00]
+    k_insn_mov_rsp_rbp,         // movq %rsp, %rbp                  [0x89 0xe5] or [0x8b 0xec]
+    k_insn_sub_rsp_imm8,        // subq $imm8, %rsp                 [0x83 0xec imm8]
+    k_insn_sub_rsp_imm32,       // subq $imm32, %rsp                [0x81 0xec imm32]
+    k_insn_lea_rsp_disp8,       // leaq disp8(%rsp), %rsp           [0x8d 0x64 0x24 disp8]
+    k_insn_lea_rsp_disp32,      // leaq disp32(%rsp), %rsp          [0x8d 0xa4 0x24 disp32]
+    k_insn_mov_reg_rbp_disp8,   // movq %reg, disp8(%rbp)           [REX.W 0x89 01rrr101 disp8]
+    k_insn_mov_reg_rbp_disp32,  // movq %reg, disp32(%rbp)          [REX.W 0x89 10rrr101 disp32]
+    k_insn_ret                  // leave, ret, ret imm16, lret imm16 [0xc9], [0xc3], [0xc2 imm16], [0xca imm16]
+};
+
+// An instruction matches a pattern when its opcode byte (after any REX
+// prefix) masked with opcode_mask is opcode and, if modrm_mask is not
+// zero, the byte after the opcode masked with modrm_mask is modrm.  The
+// first matching pattern wins.
+struct insn_pattern {
+    uint8_t opcode_mask;
+    uint8_t opcode;
+    uint8_t modrm_mask;
+    uint8_t modrm;
+    insn_kind kind;
+};
+
+static const struct insn_pattern g_insn_patterns[] = {
+    { 0xf8, 0x50, 0x00, 0x00, k_insn_push_reg },
+    { 0xff, 0x6a, 0xff, 0x00, k_insn_push_0 },
+    { 0xff, 0x89, 0xff, 0xe5, k_insn_mov_rsp_rbp },
+    { 0xff, 0x8b, 0xff, 0xec, k_insn_mov_rsp_rbp },
+    { 0xff, 0x83, 0xff, 0xec, k_insn_sub_rsp_imm8 },
+    { 0xff, 0x81, 0xff, 0xec, k_insn_sub_rsp_imm32 },
+    { 0xff, 0x8d, 0xff, 0x64, k_insn_lea_rsp_disp8 },
+    { 0xff, 0x8d, 0xff, 0xa4, k_insn_lea_rsp_disp32 },
+    { 0xff, 0x89, 0xc7, 0x45, k_insn_mov_reg_rbp_disp8 },
+    { 0xff, 0x89, 0xc7, 0x85, k_insn_mov_reg_rbp_disp32 },
+    { 0xff, 0xc9, 0x00, 0x00, k_insn_ret },
+    { 0xff, 0xc3, 0x00, 0x00, k_insn_ret },
+    { 0xff, 0xc2, 0x00, 0x00, k_insn_ret },
+    { 0xff, 0xca, 0x00, 0x00, k_insn_ret }
+};
+
+const int size_of_insn_patterns = sizeof (g_insn_patterns) / sizeof (struct insn_pattern);
+
+// A decoded instruction: what kind it is, the machine register number
+// it pushes or stores (k_insn_push_reg, k_insn_mov_reg_rbp_*) and its
+// immediate or displacement operand.
+struct decoded_insn {
+    insn_kind kind;
+    int regno;
+    int operand;
+};
+
+//-----------------------------------------------------------------------------------------------
+//  AssemblyParse_x86 local-file class definition & implementation functions
+//-----------------------------------------------------------------------------------------------
+
 class AssemblyParse_x86 {
 public:
 
-    AssemblyParse_x86 (const ExecutionContext &exe_ctx, int cpu, ArchSpec &arch, AddressRange func);
+    AssemblyParse_x86 (const ExecutionContext &exe_ctx, int cpu, ArchSpec &arch, AddressRange func,
+                       ::LLVMDisasmContextRef disasm_context);
 
     ~AssemblyParse_x86 ();
 
@@ -128,26 +195,26 @@ public:
     bool find_first_non_prologue_insn (Address &address);
 
 private:
-    enum { kMaxInstructionByteSize = 32 };
+    // Prologues are much shorter than this, only this much of a function
+    // is read for scanning.
+    enum { kMaxScanByteSize = 4096 };
 
     bool nonvolatile_reg_p (int machine_regno);
-    bool push_rbp_pattern_p ();
-    bool push_0_pattern_p ();
-    bool mov_rsp_rbp_pattern_p ();
-    bool sub_rsp_pattern_p (int& amount);
-    bool push_reg_p (int& regno);
-    bool mov_reg_to_local_stack_frame_p (int& regno, int& fp_offset);
-    bool ret_pattern_p ();
-    uint32_t extract_4 (uint8_t *b);
+    bool read_function_bytes ();
+    bool read_function_tail (uint8_t *buf, size_t size);
+    bool decode_insn (uint32_t offset, int &length, decoded_insn &insn);
+    bool prologue_insn_p (const decoded_insn &insn);
+    uint32_t extract_4 (const uint8_t *b);
     bool machine_regno_to_lldb_regno (int machine_regno, uint32_t& lldb_regno);
-    bool instruction_length (Address addr, int &length);
 
     const ExecutionContext m_exe_ctx;
 
     AddressRange m_func_bounds;
 
     Address m_cur_insn;
-    uint8_t m_cur_insn_bytes[kMaxInstructionByteSize];
+
+    // The start of the function, read with a single memory read
+    std::vector<uint8_t> m_func_bytes;
 
     int m_machine_ip_regnum;
     int m_machine_sp_regnum;
@@ -165,10 +232,12 @@ private:
     DISALLOW_COPY_AND_ASSIGN (AssemblyParse_x86);
 };
 
-AssemblyParse_x86::AssemblyParse_x86 (const ExecutionContext &exe_ctx, int cpu, ArchSpec &arch, AddressRange func) :
+AssemblyParse_x86::AssemblyParse_x86 (const ExecutionContext &exe_ctx, int cpu, ArchSpec &arch, AddressRange func,
+                                      ::LLVMDisasmContextRef disasm_context) :
     m_exe_ctx (exe_ctx), 
     m_func_bounds(func), 
     m_cur_insn (),
+    m_func_bytes (),
     m_machine_ip_regnum (LLDB_INVALID_REGNUM),
     m_machine_sp_regnum (LLDB_INVALID_REGNUM),
     m_machine_fp_regnum (LLDB_INVALID_REGNUM),
@@ -177,7 +246,8 @@ AssemblyParse_x86::AssemblyParse_x86 (const ExecutionContext &exe_ctx, int cpu,
     m_lldb_fp_regnum (LLDB_INVALID_REGNUM),
     m_wordsize (-1), 
     m_cpu(cpu),
-    m_arch(arch)
+    m_arch(arch),
+    m_disasm_context (disasm_context)
 {
     int *initialized_flag = NULL;
     if (cpu == k_i386)
@@ -241,17 +311,10 @@ AssemblyParse_x86::AssemblyParse_x86 (const ExecutionContext &exe_ctx, int cpu,
        if (machine_regno_to_lldb_regno (m_machine_ip_regnum, lldb_regno))
            m_lldb_ip_regnum = lldb_regno;
    }
-
-   m_disasm_context = ::LLVMCreateDisasm(m_arch.GetTriple().getTriple().c_str(), 
-                                          (void*)this, 
-                                          /*TagType=*/1,
-                                          NULL,
-                                          NULL);
 }
 
 AssemblyParse_x86::~AssemblyParse_x86 ()
 {
-    ::LLVMDisasmDispose(m_disasm_context);
 }
 
 // This function expects an x86 native register number (i.e. the bits stripped out of the 
@@ -292,152 +355,209 @@ AssemblyParse_x86::nonvolatile_reg_p (int machine_regno)
 }
 
 
-// Macro to detect if this is a REX mode prefix byte. 
-#define REX_W_PREFIX_P(opcode) (((opcode) & (~0x5)) == 0x48)
+// Read the start of the function, up to kMaxScanByteSize bytes, for the
+// scanner to decode.  Everything is decoded from this buffer instead of
+// reading each instruction from the target on its own.
+bool
+AssemblyParse_x86::read_function_bytes ()
+{
+    if (!m_func_bytes.empty())
+        return true;
 
-// The high bit which should be added to the source register number (the "R" bit)
-#define REX_W_SRCREG(opcode) (((opcode) & 0x4) >> 2)
+    Target *target = m_exe_ctx.GetTargetPtr();
+    if (target == NULL || !m_func_bounds.GetBaseAddress().IsValid())
+        return false;
 
-// The high bit which should be added to the destination register number (the "B" bit)
-#define REX_W_DSTREG(opcode) ((opcode) & 0x1)
+    const size_t size = std::min<addr_t> (m_func_bounds.GetByteSize(), kMaxScanByteSize);
+    m_func_bytes.resize (size);
 
-// pushq %rbp [0x55]
-bool AssemblyParse_x86::push_rbp_pattern_p () {
-    uint8_t *p = m_cur_insn_bytes;
-    if (*p == 0x55)
-      return true;
-    return false;
+    const bool prefer_file_cache = true;
+    Error error;
+    const size_t bytes_read = target->ReadMemory (m_func_bounds.GetBaseAddress(), prefer_file_cache,
+                                                  m_func_bytes.data(), size, error);
+    if (bytes_read == 0 || bytes_read == static_cast<size_t>(-1))
+    {
+        m_func_bytes.clear();
+        return false;
+    }
+    m_func_bytes.resize (bytes_read);
+    return true;
 }
 
-// pushq $0 ; the first instruction in start() [0x6a 0x00]
-bool AssemblyParse_x86::push_0_pattern_p ()
+// Read the last size bytes of the function, out of the buffer if the
+// whole function is in it.
+bool
+AssemblyParse_x86::read_function_tail (uint8_t *buf, size_t size)
 {
-    uint8_t *p = m_cur_insn_bytes;
-    if (*p == 0x6a && *(p + 1) == 0x0)
-        return true;
-    return false;
-}
-
-// movq %rsp, %rbp [0x48 0x8b 0xec] or [0x48 0x89 0xe5]
-// movl %esp, %ebp [0x8b 0xec] or [0x89 0xe5]
-bool AssemblyParse_x86::mov_rsp_rbp_pattern_p () {
-    uint8_t *p = m_cur_insn_bytes;
-    if (m_wordsize == 8 && *p == 0x48)
-      p++;
-    if (*(p) == 0x8b && *(p + 1) == 0xec)
-        return true;
-    if (*(p) == 0x89 && *(p + 1) == 0xe5)
-        return true;
-    return false;
-}
+    const addr_t func_size = m_func_bounds.GetByteSize();
+    if (func_size < size)
+        return false;
 
-// subq $0x20, %rsp 
-bool AssemblyParse_x86::sub_rsp_pattern_p (int& amount) {
-    uint8_t *p = m_cur_insn_bytes;
-    if (m_wordsize == 8 && *p == 0x48)
-      p++;
-    // 8-bit immediate operand
-    if (*p == 0x83 && *(p + 1) == 0xec) {
-        amount = (int8_t) *(p + 2);
-        return true;
-    }
-    // 32-bit immediate operand
-    if (*p == 0x81 && *(p + 1) == 0xec) {
-        amount = (int32_t) extract_4 (p + 2);
+    if (m_func_bytes.size() == func_size)
+    {
+        memcpy (buf, m_func_bytes.data() + func_size - size, size);
         return true;
     }
-    // Not handled:  [0x83 0xc4] for imm8 with neg values
-    // [0x81 0xc4] for imm32 with neg values
-    return false;
+
+    Target *target = m_exe_ctx.GetTargetPtr();
+    if (target == NULL)
+        return false;
+    Address tail_addr (m_func_bounds.GetBaseAddress());
+    tail_addr.SetOffset (tail_addr.GetOffset() + func_size - size);
+    const bool prefer_file_cache = true;
+    Error error;
+    const size_t bytes_read = target->ReadMemory (tail_addr, prefer_file_cache, buf, size, error);
+    return bytes_read == size;
 }
 
-// pushq %rbx
-// pushl $ebx
-bool AssemblyParse_x86::push_reg_p (int& regno) {
-    uint8_t *p = m_cur_insn_bytes;
-    int regno_prefix_bit = 0;
-    // If we have a rex prefix byte, check to see if a B bit is set
-    if (m_wordsize == 8 && *p == 0x41) {
-        regno_prefix_bit = 1 << 3;
-        p++;
-    }
-    if (*p >= 0x50 && *p <= 0x57) {
-        regno = (*p - 0x50) | regno_prefix_bit;
+// Decode the instruction at offset bytes into the function.  Returns false
+// if it is past what was read or isn't a valid instruction, otherwise sets
+// length to its size and fills in insn; insn.kind is k_insn_other for all
+// the instructions that aren't in g_insn_patterns.
+bool
+AssemblyParse_x86::decode_insn (uint32_t offset, int &length, decoded_insn &insn)
+{
+    if (offset >= m_func_bytes.size())
+        return false;
+
+    uint8_t *bytes = m_func_bytes.data() + offset;
+    char out_string[512];
+    length = ::LLVMDisasmInstruction (m_disasm_context,
+                                      bytes,
+                                      m_func_bytes.size() - offset,
+                                      m_func_bounds.GetBaseAddress().GetFileAddress() + offset, // PC value
+                                      out_string,
+                                      sizeof(out_string));
+    if (length <= 0)
+        return false;
+
+    insn.kind = k_insn_other;
+    insn.regno = -1;
+    insn.operand = 0;
+
+    const uint8_t *p = bytes;
+    const uint8_t *end = bytes + length;
+
+    // A REX prefix byte, only in 64-bit mode: 0100WRXB.  R extends the
+    // register in the ModR/M reg field, B the one in the r/m field or
+    // in the opcode.
+    uint8_t rex = 0;
+    if (m_wordsize == 8 && (*p & 0xf0) == 0x40)
+        rex = *p++;
+    if (p >= end)
         return true;
+    const int rex_r = (rex >> 2) & 1;
+    const int rex_b = rex & 1;
+
+    const uint8_t opcode = p[0];
+    const uint8_t modrm = p + 1 < end ? p[1] : 0;
+    for (int i = 0; i < size_of_insn_patterns; i++)
+    {
+        const struct insn_pattern &pattern = g_insn_patterns[i];
+        if ((opcode & pattern.opcode_mask) != pattern.opcode)
+            continue;
+        if (pattern.modrm_mask != 0 && (p + 1 >= end || (modrm & pattern.modrm_mask) != pattern.modrm))
+            continue;
+        insn.kind = pattern.kind;
+        break;
     }
-    return false;
-}
 
-// Look for an instruction sequence storing a nonvolatile register
-// on to the stack frame.
+    switch (insn.kind)
+    {
+        case k_insn_push_reg:
+            insn.regno = (opcode & 0x7) | (rex_b << 3);
+            break;
 
-//  movq %rax, -0x10(%rbp) [0x48 0x89 0x45 0xf0]
-//  movl %eax, -0xc(%ebp)  [0x89 0x45 0xf4]
+        case k_insn_push_0:
+        case k_insn_ret:
+            if (rex != 0)
+                insn.kind = k_insn_other;
+            break;
 
-// The offset value returned in rbp_offset will be positive -- 
-// but it must be subtraced from the frame base register to get
-// the actual location.  The positive value returned for the offset
-// is a convention used elsewhere for CFA offsets et al.
+        // Only %rsp and %rbp are operands, so none of R, X or B can be set
+        case k_insn_mov_rsp_rbp:
+            if ((rex & 0x7) != 0)
+                insn.kind = k_insn_other;
+            break;
 
-bool AssemblyParse_x86::mov_reg_to_local_stack_frame_p (int& regno, int& rbp_offset) {
-    uint8_t *p = m_cur_insn_bytes;
-    int src_reg_prefix_bit = 0;
-    int target_reg_prefix_bit = 0;
+        case k_insn_sub_rsp_imm8:
+            if ((rex & 0x7) != 0 || p + 3 > end)
+                insn.kind = k_insn_other;
+            else
+                insn.operand = (int8_t) p[2];
+            break;
 
-    if (m_wordsize == 8 && REX_W_PREFIX_P (*p)) {
-        src_reg_prefix_bit = REX_W_SRCREG (*p) << 3;
-        target_reg_prefix_bit = REX_W_DSTREG (*p) << 3;
-        if (target_reg_prefix_bit == 1) {
-            // rbp/ebp don't need a prefix bit - we know this isn't the
-            // reg we care about.
-            return false;
+        case k_insn_sub_rsp_imm32:
+            if ((rex & 0x7) != 0 || p + 6 > end)
+                insn.kind = k_insn_other;
+            else
+                insn.operand = (int32_t) extract_4 (p + 2);
+            break;
+
+        // The SIB byte must be 0x24, %rsp as the base with no index.  The
+        // operand is how far the stack pointer moves down, like for sub.
+        case k_insn_lea_rsp_disp8:
+            if ((rex & 0x7) != 0 || p + 4 > end || p[2] != 0x24)
+                insn.kind = k_insn_other;
+            else
+                insn.operand = -(int8_t) p[3];
+            break;
+
+        case k_insn_lea_rsp_disp32:
+            if ((rex & 0x7) != 0 || p + 7 > end || p[2] != 0x24)
+                insn.kind = k_insn_other;
+            else
+                insn.operand = -(int32_t) extract_4 (p + 3);
+            break;
+
+        // With REX.B set the base register is %r13, not %rbp.  In 64-bit
+        // mode REX.W is required, without it (movl) only the low half of
+        // the register is stored.
+        case k_insn_mov_reg_rbp_disp8:
+        case k_insn_mov_reg_rbp_disp32:
+        {
+            const int disp_size = insn.kind == k_insn_mov_reg_rbp_disp8 ? 1 : 4;
+            if ((m_wordsize == 8 && (rex & 0x8) == 0) || rex_b || p + 2 + disp_size > end)
+            {
+                insn.kind = k_insn_other;
+                break;
+            }
+            insn.regno = ((modrm >> 3) & 0x7) | (rex_r << 3);
+            insn.operand = disp_size == 1 ? (int8_t) p[2] : (int32_t) extract_4 (p + 2);
+            // Only stores below the frame pointer are into the stack frame
+            if (insn.operand > 0)
+                insn.kind = k_insn_other;
+            break;
         }
-        p++;
-    }
 
-    if (*p == 0x89) {
-        /* Mask off the 3-5 bits which indicate the destination register
-           if this is a ModR/M byte.  */
-        int opcode_destreg_masked_out = *(p + 1) & (~0x38);
-
-        /* Is this a ModR/M byte with Mod bits 01 and R/M bits 101 
-           and three bits between them, e.g. 01nnn101
-           We're looking for a destination of ebp-disp8 or ebp-disp32.   */
-        int immsize;
-        if (opcode_destreg_masked_out == 0x45)
-          immsize = 2;
-        else if (opcode_destreg_masked_out == 0x85)
-          immsize = 4;
-        else
-          return false;
-
-        int offset = 0;
-        if (immsize == 2)
-          offset = (int8_t) *(p + 2);
-        if (immsize == 4)
-             offset = (uint32_t) extract_4 (p + 2);
-        if (offset > 0)
-          return false;
-
-        regno = ((*(p + 1) >> 3) & 0x7) | src_reg_prefix_bit;
-        rbp_offset = offset > 0 ? offset : -offset;
-        return true;
+        case k_insn_other:
+            break;
     }
-    return false;
+    return true;
 }
 
-// ret [0xc9] or [0xc2 imm8] or [0xca imm8]
-bool 
-AssemblyParse_x86::ret_pattern_p () 
+// The instructions that set up a stack frame and save registers in it
+bool
+AssemblyParse_x86::prologue_insn_p (const decoded_insn &insn)
 {
-    uint8_t *p = m_cur_insn_bytes;
-    if (*p == 0xc9 || *p == 0xc2 || *p == 0xca || *p == 0xc3)
-        return true;
-    return false;
+    switch (insn.kind)
+    {
+        case k_insn_push_reg:
+        case k_insn_mov_rsp_rbp:
+        case k_insn_sub_rsp_imm8:
+        case k_insn_sub_rsp_imm32:
+        case k_insn_lea_rsp_disp8:
+        case k_insn_lea_rsp_disp32:
+        case k_insn_mov_reg_rbp_disp8:
+        case k_insn_mov_reg_rbp_disp32:
+            return true;
+        default:
+            return false;
+    }
 }
 
 uint32_t
-AssemblyParse_x86::extract_4 (uint8_t *b)
+AssemblyParse_x86::extract_4 (const uint8_t *b)
 {
     uint32_t v = 0;
     for (int i = 3; i >= 0; i--)
@@ -472,39 +592,6 @@ AssemblyParse_x86::machine_regno_to_lldb_regno (int machine_regno, uint32_t &lld
     return false;
 }
 
-bool
-AssemblyParse_x86::instruction_length (Address addr, int &length)
-{
-    const uint32_t max_op_byte_size = m_arch.GetMaximumOpcodeByteSize();
-    llvm::SmallVector <uint8_t, 32> opcode_data;
-    opcode_data.resize (max_op_byte_size);
-
-    if (!addr.IsValid())
-        return false;
-
-    const bool prefer_file_cache = true;
-    Error error;
-    Target *target = m_exe_ctx.GetTargetPtr();
-    if (target->ReadMemory (addr, prefer_file_cache, opcode_data.data(),
-                            max_op_byte_size, error) == static_cast<size_t>(-1))
-    {
-        return false;
-    }
-   
-    char out_string[512];
-    const addr_t pc = addr.GetFileAddress();
-    const size_t inst_size = ::LLVMDisasmInstruction (m_disasm_context,
-                                                      opcode_data.data(),
-                                                      max_op_byte_size,
-                                                      pc, // PC value
-                                                      out_string,
-                                                      sizeof(out_string));
-
-    length = inst_size;
-    return true;
-}
-
-
 bool 
 AssemblyParse_x86::get_non_call_site_unwind_plan (UnwindPlan &unwind_plan)
 {
@@ -514,9 +601,8 @@ AssemblyParse_x86::get_non_call_site_unwind_plan (UnwindPlan &unwind_plan)
     int current_func_text_offset = 0;
     int current_sp_bytes_offset_from_cfa = 0;
     UnwindPlan::Row::RegisterLocation initial_regloc;
-    Error error;
 
-    if (!m_cur_insn.IsValid())
+    if (!m_cur_insn.IsValid() || !read_function_bytes ())
     {
         return false;
     }
@@ -545,28 +631,19 @@ AssemblyParse_x86::get_non_call_site_unwind_plan (UnwindPlan &unwind_plan)
     *newrow = *row.get();
     row.reset(newrow);
 
-    const bool prefer_file_cache = true;
-
-    Target *target = m_exe_ctx.GetTargetPtr();
     while (m_func_bounds.ContainsFileAddress (m_cur_insn) && non_prologue_insn_count < 10)
     {
-        int stack_offset, insn_len;
-        int machine_regno;          // register numbers masked directly out of instructions
+        int insn_len;
+        decoded_insn insn;
         uint32_t lldb_regno;        // register numbers in lldb's eRegisterKindLLDB numbering scheme
 
-        if (!instruction_length (m_cur_insn, insn_len) || insn_len == 0 || insn_len > kMaxInstructionByteSize)
+        if (!decode_insn (current_func_text_offset, insn_len, insn))
         {
-            // An unrecognized/junk instruction
+            // An unrecognized/junk instruction, or the end of what was read
             break;
         }
-        if (target->ReadMemory (m_cur_insn, prefer_file_cache, m_cur_insn_bytes,
-                                insn_len, error) == static_cast<size_t>(-1))
-        {
-           // Error reading the instruction out of the file, stop scanning
-           break;
-        }
 
-        if (push_rbp_pattern_p ())
+        if (insn.kind == k_insn_push_reg && insn.regno == m_machine_fp_regnum)
         {
             row->SetOffset (current_func_text_offset + insn_len);
             current_sp_bytes_offset_from_cfa += m_wordsize;
@@ -582,7 +659,7 @@ AssemblyParse_x86::get_non_call_site_unwind_plan (UnwindPlan &unwind_plan)
             goto loopnext;
         }
 
-        if (mov_rsp_rbp_pattern_p ())
+        if (insn.kind == k_insn_mov_rsp_rbp)
         {
             row->SetOffset (current_func_text_offset + insn_len);
             row->SetCFARegister (m_lldb_fp_regnum);
@@ -597,12 +674,12 @@ AssemblyParse_x86::get_non_call_site_unwind_plan (UnwindPlan &unwind_plan)
         // This is the start() function (or a pthread equivalent), it starts with a pushl $0x0 which puts the
         // saved pc value of 0 on the stack.  In this case we want to pretend we didn't see a stack movement at all --
         // normally the saved pc value is already on the stack by the time the function starts executing.
-        if (push_0_pattern_p ())
+        if (insn.kind == k_insn_push_0)
         {
             goto loopnext;
         }
 
-        if (push_reg_p (machine_regno))
+        if (insn.kind == k_insn_push_reg)
         {
             current_sp_bytes_offset_from_cfa += m_wordsize;
             bool need_to_push_row = false;
@@ -614,7 +691,7 @@ AssemblyParse_x86::get_non_call_site_unwind_plan (UnwindPlan &unwind_plan)
                 row->SetCFAOffset (current_sp_bytes_offset_from_cfa);
             }
             // record where non-volatile (callee-saved, spilled) registers are saved on the stack
-            if (nonvolatile_reg_p (machine_regno) && machine_regno_to_lldb_regno (machine_regno, lldb_regno))
+            if (nonvolatile_reg_p (insn.regno) && machine_regno_to_lldb_regno (insn.regno, lldb_regno))
             {
                 need_to_push_row = true;
                 UnwindPlan::Row::RegisterLocation regloc;
@@ -633,18 +710,19 @@ AssemblyParse_x86::get_non_call_site_unwind_plan (UnwindPlan &unwind_plan)
             goto loopnext;
         }
 
-        if (mov_reg_to_local_stack_frame_p (machine_regno, stack_offset) && nonvolatile_reg_p (machine_regno))
+        if ((insn.kind == k_insn_mov_reg_rbp_disp8 || insn.kind == k_insn_mov_reg_rbp_disp32)
+            && nonvolatile_reg_p (insn.regno))
         {
-            if (machine_regno_to_lldb_regno (machine_regno, lldb_regno))
+            if (machine_regno_to_lldb_regno (insn.regno, lldb_regno))
             {
                 row->SetOffset (current_func_text_offset + insn_len);
                 UnwindPlan::Row::RegisterLocation regloc;
 
-                // stack_offset for 'movq %r15, -80(%rbp)' will be 80.
+                // The operand for 'movq %r15, -80(%rbp)' will be -80.
                 // In the Row, we want to express this as the offset from the CFA.  If the frame base
                 // is rbp (like the above instruction), the CFA offset for rbp is probably 16.  So we
                 // want to say that the value is stored at the CFA address - 96.
-                regloc.SetAtCFAPlusOffset (-(stack_offset + row->GetCFAOffset()));
+                regloc.SetAtCFAPlusOffset (insn.operand - row->GetCFAOffset());
 
                 row->SetRegisterInfo (lldb_regno, regloc);
                 unwind_plan.AppendRow (row);
@@ -656,9 +734,10 @@ AssemblyParse_x86::get_non_call_site_unwind_plan (UnwindPlan &unwind_plan)
             }
         }
 
-        if (sub_rsp_pattern_p (stack_offset))
+        if (insn.kind == k_insn_sub_rsp_imm8 || insn.kind == k_insn_sub_rsp_imm32
+            || insn.kind == k_insn_lea_rsp_disp8 || insn.kind == k_insn_lea_rsp_disp32)
         {
-            current_sp_bytes_offset_from_cfa += stack_offset;
+            current_sp_bytes_offset_from_cfa += insn.operand;
             if (row->GetCFARegister() == static_cast<uint32_t>(m_lldb_sp_regnum))
             {
                 row->SetOffset (current_func_text_offset + insn_len);
@@ -672,7 +751,7 @@ AssemblyParse_x86::get_non_call_site_unwind_plan (UnwindPlan &unwind_plan)
             goto loopnext;
         }
 
-        if (ret_pattern_p ())
+        if (insn.kind == k_insn_ret)
         {
             // we know where the end of the function is; set the limit on the PlanValidAddressRange
             // in case our initial "high pc" value was overly large
@@ -716,16 +795,11 @@ loopnext:
     // (or the 'jmp' instruction in the second case)
 
     uint64_t ret_insn_offset = LLDB_INVALID_ADDRESS;
-    Address end_of_fun(m_func_bounds.GetBaseAddress());
-    end_of_fun.SetOffset (end_of_fun.GetOffset() + m_func_bounds.GetByteSize());
 
     if (m_func_bounds.GetByteSize() > 7)
     {
         uint8_t bytebuf[7];
-        Address last_seven_bytes(end_of_fun);
-        last_seven_bytes.SetOffset (last_seven_bytes.GetOffset() - 7);
-        if (target->ReadMemory (last_seven_bytes, prefer_file_cache, bytebuf, 7,
-                                error) != static_cast<size_t>(-1))
+        if (read_function_tail (bytebuf, sizeof (bytebuf)))
         {
             if (bytebuf[5] == 0x5d && bytebuf[6] == 0xc3)  // mov & ret
             {
@@ -746,10 +820,7 @@ loopnext:
     else if (m_func_bounds.GetByteSize() > 2)
     {
         uint8_t bytebuf[2];
-        Address last_two_bytes(end_of_fun);
-        last_two_bytes.SetOffset (last_two_bytes.GetOffset() - 2);
-        if (target->ReadMemory (last_two_bytes, prefer_file_cache, bytebuf, 2,
-                                error) != static_cast<size_t>(-1))
+        if (read_function_tail (bytebuf, sizeof (bytebuf)))
         {
             if (bytebuf[0] == 0x5d && bytebuf[1] == 0xc3) // mov & ret
             {
@@ -883,33 +954,29 @@ AssemblyParse_x86::find_first_non_prologue_insn (Address &address)
         return false;
     }
 
-    const bool prefer_file_cache = true;
-    Target *target = m_exe_ctx.GetTargetPtr();
-    while (m_func_bounds.ContainsFileAddress (m_cur_insn))
+    uint32_t offset = 0;
+    if (read_function_bytes ())
     {
-        Error error;
-        int insn_len, offset, regno;
-        if (!instruction_length (m_cur_insn, insn_len) || insn_len > kMaxInstructionByteSize || insn_len == 0)
+        while (m_func_bounds.ContainsFileAddress (m_cur_insn))
         {
-            // An error parsing the instruction, i.e. probably data/garbage - stop scanning
-            break;
-        }
-        if (target->ReadMemory (m_cur_insn, prefer_file_cache, m_cur_insn_bytes,
-                                insn_len, error) == static_cast<size_t>(-1))
-        {
-           // Error reading the instruction out of the file, stop scanning
-           break;
-        }
+            int insn_len;
+            decoded_insn insn;
+            if (!decode_insn (offset, insn_len, insn))
+            {
+                // An error parsing the instruction, i.e. probably data/garbage - stop scanning
+                break;
+            }
 
-        if (push_rbp_pattern_p () || mov_rsp_rbp_pattern_p () || sub_rsp_pattern_p (offset)
-            || push_reg_p (regno) || mov_reg_to_local_stack_frame_p (regno, offset))
-        {
-            m_cur_insn.SetOffset (m_cur_insn.GetOffset() + insn_len);
-            continue;
-        }
+            if (prologue_insn_p (insn))
+            {
+                m_cur_insn.SetOffset (m_cur_insn.GetOffset() + insn_len);
+                offset += insn_len;
+                continue;
+            }
 
-        // Unknown non-prologue instruction - stop scanning
-        break;
+            // Unknown non-prologue instruction - stop scanning
+            break;
+        }
     }
 
     address = m_cur_insn;
@@ -928,35 +995,57 @@ AssemblyParse_x86::find_first_non_prologue_insn (Address &address)
 UnwindAssembly_x86::UnwindAssembly_x86 (const ArchSpec &arch, int cpu) : 
     lldb_private::UnwindAssembly(arch), 
     m_cpu(cpu),
-    m_arch(arch)
+    m_arch(arch),
+    m_mutex (Mutex::eMutexTypeNormal),
+    m_disasm_context (NULL)
 {
 }
 
 
 UnwindAssembly_x86::~UnwindAssembly_x86 ()
 {
+    if (m_disasm_context)
+        ::LLVMDisasmDispose(m_disasm_context);
+}
+
+// Making a disassembler is far more work than profiling a function, so
+// one is made on first use and shared by every function this profiler
+// looks at.  It isn't thread safe, m_mutex must be held to use it.
+::LLVMDisasmContextRef
+UnwindAssembly_x86::GetDisassembler ()
+{
+    if (m_disasm_context == NULL)
+        m_disasm_context = ::LLVMCreateDisasm(m_arch.GetTriple().getTriple().c_str(), 
+                                              NULL, 
+                                              /*TagType=*/1,
+                                              NULL,
+                                              NULL);
+    return m_disasm_context;
 }
 
 bool
 UnwindAssembly_x86::GetNonCallSiteUnwindPlanFromAssembly (AddressRange& func, Thread& thread, UnwindPlan& unwind_plan)
 {
     ExecutionContext exe_ctx (thread.shared_from_this());
-    AssemblyParse_x86 asm_parse(exe_ctx, m_cpu, m_arch, func);
+    Mutex::Locker locker (m_mutex);
+    AssemblyParse_x86 asm_parse(exe_ctx, m_cpu, m_arch, func, GetDisassembler());
     return asm_parse.get_non_call_site_unwind_plan (unwind_plan);
 }
 
 bool
 UnwindAssembly_x86::GetFastUnwindPlan (AddressRange& func, Thread& thread, UnwindPlan &unwind_plan)
 {
+    // Only the first few bytes are compared, nothing is disassembled
     ExecutionContext exe_ctx (thread.shared_from_this());
-    AssemblyParse_x86 asm_parse(exe_ctx, m_cpu, m_arch, func);
+    AssemblyParse_x86 asm_parse(exe_ctx, m_cpu, m_arch, func, NULL);
     return asm_parse.get_fast_unwind_plan (func, unwind_plan);
 }
 
 bool
 UnwindAssembly_x86::FirstNonPrologueInsn (AddressRange& func, const ExecutionContext &exe_ctx, Address& first_non_prologue_insn)
 {
-    AssemblyParse_x86 asm_parse(exe_ctx, m_cpu, m_arch, func);
+    Mutex::Locker locker (m_mutex);
+    AssemblyParse_x86 asm_parse(exe_ctx, m_cpu, m_arch, func, GetDisassembler());
     return asm_parse.find_first_non_prologue_insn (first_non_prologue_insn);
 }
 
@@ -13,6 +13,7 @@
 #include "llvm-c/Disassembler.h"
 
 #include "lldb/lldb-private.h"
+#include "lldb/Host/Mutex.h"
 #include "lldb/Target/UnwindAssembly.h"
 
 class UnwindAssembly_x86 : public lldb_private::UnwindAssembly
@@ -65,8 +66,13 @@ public:
 private:
     UnwindAssembly_x86 (const lldb_private::ArchSpec &arch, int cpu);
 
+    ::LLVMDisasmContextRef
+    GetDisassembler ();
+
     int m_cpu;
     lldb_private::ArchSpec m_arch;
+    lldb_private::Mutex m_mutex;
+    ::LLVMDisasmContextRef m_disasm_context;
 };
 
 
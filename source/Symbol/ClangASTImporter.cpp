@@ -21,8 +21,8 @@
 using namespace lldb_private;
 using namespace clang;
 
-ClangASTMetrics::Counters ClangASTMetrics::global_counters = { 0, 0, 0, 0, 0, 0 };
-ClangASTMetrics::Counters ClangASTMetrics::local_counters = { 0, 0, 0, 0, 0, 0 };
+ClangASTMetrics::Counters ClangASTMetrics::global_counters = { 0, 0, 0, 0, 0, 0, 0, 0 };
+ClangASTMetrics::Counters ClangASTMetrics::local_counters = { 0, 0, 0, 0, 0, 0, 0, 0 };
 
 void ClangASTMetrics::DumpCounters (Log *log, ClangASTMetrics::Counters &counters)
 {
@@ -32,6 +32,8 @@ void ClangASTMetrics::DumpCounters (Log *log, ClangASTMetrics::Counters &counter
     log->Printf("  Number of imports conducted by Clang       : %" PRIu64, counters.m_clang_import_count);
     log->Printf("  Number of Decls completed                  : %" PRIu64, counters.m_decls_completed_count);
     log->Printf("  Number of records laid out                 : %" PRIu64, counters.m_record_layout_count);
+    log->Printf("  Number of module lookups avoided           : %" PRIu64, counters.m_lookups_avoided_count);
+    log->Printf("  Number of module lookups performed         : %" PRIu64, counters.m_lookups_performed_count);
 }
 
 void ClangASTMetrics::DumpCounters (Log *log)
@@ -46,6 +48,94 @@ void ClangASTMetrics::DumpCounters (Log *log)
     DumpCounters (log, local_counters);
 }
 
+bool
+ClangASTImporter::FindCachedTypeLookup (const ConstString &name, lldb::TypeSP &type_sp)
+{
+    Mutex::Locker locker (m_lookup_mutex);
+
+    TypeLookupMap::iterator pos = m_type_lookups.find (name.GetCString());
+
+    if (pos == m_type_lookups.end())
+    {
+        ClangASTMetrics::RegisterLookupPerformed();
+        return false;
+    }
+
+    ClangASTMetrics::RegisterLookupAvoided();
+    type_sp = pos->second;
+    return true;
+}
+
+void
+ClangASTImporter::CacheTypeLookup (const ConstString &name, const lldb::TypeSP &type_sp)
+{
+    Mutex::Locker locker (m_lookup_mutex);
+
+    m_type_lookups[name.GetCString()] = type_sp;
+}
+
+bool
+ClangASTImporter::FindCachedNamespaceLookup (const ConstString &name, NamespaceMap &namespace_map)
+{
+    Mutex::Locker locker (m_lookup_mutex);
+
+    NamespaceLookupMap::iterator pos = m_namespace_lookups.find (name.GetCString());
+
+    if (pos == m_namespace_lookups.end())
+    {
+        ClangASTMetrics::RegisterLookupPerformed();
+        return false;
+    }
+
+    ClangASTMetrics::RegisterLookupAvoided();
+    namespace_map = pos->second;
+    return true;
+}
+
+void
+ClangASTImporter::CacheNamespaceLookup (const ConstString &name, const NamespaceMap &namespace_map)
+{
+    Mutex::Locker locker (m_lookup_mutex);
+
+    m_namespace_lookups[name.GetCString()] = namespace_map;
+}
+
+bool
+ClangASTImporter::FindCachedVariableLookup (const ConstString &name, std::vector<lldb::VariableSP> &variables)
+{
+    Mutex::Locker locker (m_lookup_mutex);
+
+    VariableLookupMap::iterator pos = m_variable_lookups.find (name.GetCString());
+
+    if (pos == m_variable_lookups.end())
+    {
+        ClangASTMetrics::RegisterLookupPerformed();
+        return false;
+    }
+
+    ClangASTMetrics::RegisterLookupAvoided();
+    variables = pos->second;
+    return true;
+}
+
+void
+ClangASTImporter::CacheVariableLookup (const ConstString &name, const std::vector<lldb::VariableSP> &variables)
+{
+    Mutex::Locker locker (m_lookup_mutex);
+
+    m_variable_lookups[name.GetCString()] = variables;
+}
+
+void
+ClangASTImporter::ClearLookupCache ()
+{
+    Mutex::Locker locker (m_lookup_mutex);
+
+    m_type_lookups.clear();
+    m_namespace_lookups.clear();
+    m_variable_lookups.clear();
+}
+
 clang::QualType
 ClangASTImporter::CopyType (clang::ASTContext *dst_ast,
                             clang::ASTContext *src_ast,
@@ -38,7 +38,14 @@ DWARFCallFrameInfo::DWARFCallFrameInfo(ObjectFile& objfile, SectionSP& section_s
     m_cfi_data_initialized (false),
     m_fde_index (),
     m_fde_index_initialized (false),
-    m_is_eh_frame (is_eh_frame)
+    m_is_eh_frame (is_eh_frame),
+    m_eh_frame_hdr_data (),
+    m_eh_frame_hdr_addr (LLDB_INVALID_ADDRESS),
+    m_fde_table_offset (0),
+    m_fde_table_count (0),
+    m_fde_table_entry_size (0),
+    m_fde_table_encoding (DW_EH_PE_omit),
+    m_eh_frame_hdr_initialized (false)
 {
 }
 
@@ -73,14 +80,11 @@ DWARFCallFrameInfo::GetAddressRange (Address addr, AddressRange &range)
     if (module_sp.get() == nullptr || module_sp->GetObjectFile() == nullptr || module_sp->GetObjectFile() != &m_objfile)
         return false;
 
-    if (m_section_sp.get() == nullptr || m_section_sp->IsEncrypted())
-        return false;
-    GetFDEIndex();
-    FDEEntryMap::Entry *fde_entry = m_fde_index.FindEntryThatContains (addr.GetFileAddress());
-    if (!fde_entry)
+    FDEEntryMap::Entry fde_entry;
+    if (GetFDEEntryByFileAddress (addr.GetFileAddress(), fde_entry) == false)
         return false;
 
-    range = AddressRange(fde_entry->base, fde_entry->size, m_objfile.GetSectionList());
+    range = AddressRange(fde_entry.base, fde_entry.size, m_objfile.GetSectionList());
     return true;
 }
 
@@ -90,6 +94,15 @@ DWARFCallFrameInfo::GetFDEEntryByFileAddress (addr_t file_addr, FDEEntryMap::Ent
     if (m_section_sp.get() == nullptr || m_section_sp->IsEncrypted())
         return false;
 
+    // Unless all FDEs have been indexed already, go straight to the FDE
+    // using the search table in .eh_frame_hdr, if there is one.
+    if (m_fde_index_initialized == false)
+    {
+        GetEHFrameHdr();
+        if (m_fde_table_count > 0)
+            return GetFDEEntryFromEHFrameHdr (file_addr, fde_entry);
+    }
+
     GetFDEIndex();
 
     if (m_fde_index.IsEmpty())
@@ -375,6 +388,182 @@ DWARFCallFrameInfo::GetFDEIndex ()
     m_fde_index_initialized = true;
 }
 
+// The .eh_frame_hdr section that the linker creates next to .eh_frame
+// contains a table of (initial location, FDE address) pairs sorted by
+// initial location, which lets us find the FDE for an address with a
+// binary search instead of scanning all of .eh_frame first.
+void
+DWARFCallFrameInfo::GetEHFrameHdr ()
+{
+    if (m_eh_frame_hdr_initialized)
+        return;
+
+    Mutex::Locker locker(m_fde_index_mutex);
+
+    if (m_eh_frame_hdr_initialized) // if two threads hit the locker
+        return;
+    m_eh_frame_hdr_initialized = true;
+
+    if (!m_is_eh_frame)
+        return;
+
+    SectionList *section_list = m_objfile.GetSectionList();
+    if (section_list == nullptr)
+        return;
+
+    static ConstString g_eh_frame_hdr_name (".eh_frame_hdr");
+    SectionSP hdr_section_sp (section_list->FindSectionByName (g_eh_frame_hdr_name));
+    if (hdr_section_sp.get() == nullptr || hdr_section_sp->IsEncrypted())
+        return;
+
+    DataExtractor hdr_data;
+    if (m_objfile.ReadSectionData (hdr_section_sp.get(), hdr_data) < 4)
+        return;
+
+    lldb::offset_t offset = 0;
+    const uint8_t version = hdr_data.GetU8 (&offset);
+    const uint8_t eh_frame_ptr_enc = hdr_data.GetU8 (&offset);
+    const uint8_t fde_count_enc = hdr_data.GetU8 (&offset);
+    const uint8_t table_enc = hdr_data.GetU8 (&offset);
+    if (version != 1 ||
+        eh_frame_ptr_enc == DW_EH_PE_omit || (eh_frame_ptr_enc & DW_EH_PE_indirect) ||
+        fde_count_enc == DW_EH_PE_omit || (fde_count_enc & DW_EH_PE_indirect) ||
+        table_enc == DW_EH_PE_omit || (table_enc & DW_EH_PE_indirect))
+        return;
+
+    // Only fixed size fields relative to nothing, the table itself or
+    // .eh_frame_hdr can be binary searched.
+    uint32_t entry_size = 0;
+    switch (table_enc & DW_EH_PE_MASK_ENCODING)
+    {
+        case DW_EH_PE_absptr:   entry_size = hdr_data.GetAddressByteSize(); break;
+        case DW_EH_PE_udata2:
+        case DW_EH_PE_sdata2:   entry_size = 2; break;
+        case DW_EH_PE_udata4:
+        case DW_EH_PE_sdata4:   entry_size = 4; break;
+        case DW_EH_PE_udata8:
+        case DW_EH_PE_sdata8:   entry_size = 8; break;
+        default:
+            return;
+    }
+    switch (table_enc & 0x70)
+    {
+        case DW_EH_PE_absptr:
+        case DW_EH_PE_pcrel:
+        case DW_EH_PE_datarel:
+            break;
+        default:
+            return;
+    }
+
+    const lldb::addr_t hdr_addr = hdr_section_sp->GetFileAddress();
+    const lldb::addr_t eh_frame_addr = hdr_data.GetGNUEHPointer (&offset, eh_frame_ptr_enc, hdr_addr, LLDB_INVALID_ADDRESS, hdr_addr);
+    const uint64_t fde_count = hdr_data.GetGNUEHPointer (&offset, fde_count_enc, hdr_addr, LLDB_INVALID_ADDRESS, hdr_addr);
+
+    // Make sure the table describes our .eh_frame
+    if (eh_frame_addr != m_section_sp->GetFileAddress())
+        return;
+
+    if (entry_size == 0 || fde_count == 0 || fde_count > UINT32_MAX ||
+        !hdr_data.ValidOffsetForDataOfSize (offset, fde_count * 2 * entry_size))
+        return;
+
+    m_eh_frame_hdr_data = hdr_data;
+    m_eh_frame_hdr_addr = hdr_addr;
+    m_fde_table_offset = offset;
+    m_fde_table_entry_size = entry_size;
+    m_fde_table_encoding = table_enc;
+    m_fde_table_count = (uint32_t)fde_count;
+
+    Log *log(GetLogIfAllCategoriesSet (LIBLLDB_LOG_UNWIND));
+    if (log)
+        m_objfile.GetModule()->LogMessage(log, "Using .eh_frame_hdr search table with %u entries", m_fde_table_count);
+}
+
+bool
+DWARFCallFrameInfo::GetFDEEntryFromEHFrameHdr (addr_t file_addr, FDEEntryMap::Entry &fde_entry)
+{
+    // Reading the FDE may parse and cache its CIE
+    Mutex::Locker locker(m_fde_index_mutex);
+
+    auto get_table_field = [this](uint32_t index, uint32_t field) -> addr_t
+    {
+        lldb::offset_t offset = m_fde_table_offset + (2 * (lldb::offset_t)index + field) * m_fde_table_entry_size;
+        return m_eh_frame_hdr_data.GetGNUEHPointer (&offset, m_fde_table_encoding, m_eh_frame_hdr_addr, LLDB_INVALID_ADDRESS, m_eh_frame_hdr_addr);
+    };
+
+    // Find the last entry whose initial location is at or before file_addr
+    uint32_t low = 0;
+    uint32_t high = m_fde_table_count;
+    while (low < high)
+    {
+        const uint32_t mid = low + (high - low) / 2;
+        if (get_table_field (mid, 0) <= file_addr)
+            low = mid + 1;
+        else
+            high = mid;
+    }
+    if (low == 0)
+        return false;
+
+    const addr_t fde_addr = get_table_field (low - 1, 1);
+    const addr_t eh_frame_addr = m_section_sp->GetFileAddress();
+    if (fde_addr < eh_frame_addr || fde_addr - eh_frame_addr >= m_section_sp->GetByteSize())
+        return false;
+
+    FDEEntryMap::Entry fde;
+    if (!ParseFDEAddressRange (fde_addr - eh_frame_addr, fde) || !fde.Contains (file_addr))
+        return false;
+
+    fde_entry = fde;
+    return true;
+}
+
+// Read the address range covered by the .eh_frame FDE at fde_offset.
+bool
+DWARFCallFrameInfo::ParseFDEAddressRange (dw_offset_t fde_offset, FDEEntryMap::Entry &fde_entry)
+{
+    if (m_cfi_data_initialized == false)
+        GetCFIData();
+
+    lldb::offset_t offset = fde_offset;
+    if (!m_cfi_data.ValidOffsetForDataOfSize (offset, 8))
+        return false;
+
+    const uint32_t len = m_cfi_data.GetU32 (&offset);
+    const dw_offset_t cie_id = m_cfi_data.GetU32 (&offset);
+    if (len == 0 || cie_id == 0 || cie_id == UINT32_MAX || cie_id > fde_offset + 4)
+        return false;
+
+    // We haven't scanned .eh_frame, so make sure there really is a CIE
+    // where the FDE says before it gets parsed and cached.
+    const dw_offset_t cie_offset = fde_offset + 4 - cie_id;
+    if (m_cie_map.find (cie_offset) == m_cie_map.end())
+    {
+        lldb::offset_t cie_header_offset = cie_offset;
+        if (!m_cfi_data.ValidOffsetForDataOfSize (cie_header_offset, 8))
+            return false;
+        const uint32_t cie_len = m_cfi_data.GetU32 (&cie_header_offset);
+        const dw_offset_t cie_cie_id = m_cfi_data.GetU32 (&cie_header_offset);
+        if (cie_len == 0 || cie_cie_id != 0)
+            return false;
+        m_cie_map[cie_offset] = CIESP();
+    }
+
+    const CIE *cie = GetCIE (cie_offset);
+    if (cie == nullptr)
+        return false;
+
+    const lldb::addr_t pc_rel_addr = m_section_sp->GetFileAddress();
+    const lldb::addr_t text_addr = LLDB_INVALID_ADDRESS;
+    const lldb::addr_t data_addr = LLDB_INVALID_ADDRESS;
+
+    lldb::addr_t addr = m_cfi_data.GetGNUEHPointer(&offset, cie->ptr_encoding, pc_rel_addr, text_addr, data_addr);
+    lldb::addr_t length = m_cfi_data.GetGNUEHPointer(&offset, cie->ptr_encoding & DW_EH_PE_MASK_ENCODING, pc_rel_addr, text_addr, data_addr);
+    fde_entry = FDEEntryMap::Entry (addr, length, fde_offset);
+    return true;
+}
+
 bool
 DWARFCallFrameInfo::FDEToUnwindPlan (dw_offset_t dwarf_offset, Address startaddr, UnwindPlan& unwind_plan)
 {
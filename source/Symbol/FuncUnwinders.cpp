@@ -111,13 +111,9 @@ FuncUnwinders::GetUnwindPlanAtNonCallSite (Thread& thread)
     Mutex::Locker locker (m_mutex);
     if (m_tried_unwind_at_non_call_site == false && m_unwind_plan_non_call_site_sp.get() == nullptr)
     {
-        UnwindAssemblySP assembly_profiler_sp (GetUnwindAssemblyProfiler());
-        if (assembly_profiler_sp)
-        {
-            m_unwind_plan_non_call_site_sp.reset (new UnwindPlan (lldb::eRegisterKindGeneric));
-            if (!assembly_profiler_sp->GetNonCallSiteUnwindPlanFromAssembly (m_range, thread, *m_unwind_plan_non_call_site_sp))
-                m_unwind_plan_non_call_site_sp.reset();
-        }
+        m_tried_unwind_at_non_call_site = true;
+        const bool fast = false;
+        m_unwind_plan_non_call_site_sp = m_unwind_table.GetAssemblyUnwindPlan (m_range, thread, fast);
     }
     return m_unwind_plan_non_call_site_sp;
 }
@@ -141,13 +137,8 @@ FuncUnwinders::GetUnwindPlanFastUnwind (Thread& thread)
     if (m_tried_unwind_fast == false && m_unwind_plan_fast_sp.get() == nullptr)
     {
         m_tried_unwind_fast = true;
-        UnwindAssemblySP assembly_profiler_sp (GetUnwindAssemblyProfiler());
-        if (assembly_profiler_sp)
-        {
-            m_unwind_plan_fast_sp.reset (new UnwindPlan (lldb::eRegisterKindGeneric));
-            if (!assembly_profiler_sp->GetFastUnwindPlan (m_range, thread, *m_unwind_plan_fast_sp))
-                m_unwind_plan_fast_sp.reset();
-        }
+        const bool fast = true;
+        m_unwind_plan_fast_sp = m_unwind_table.GetAssemblyUnwindPlan (m_range, thread, fast);
     }
     return m_unwind_plan_fast_sp;
 }
@@ -257,11 +248,5 @@ FuncUnwinders::InvalidateNonCallSiteUnwindPlan (lldb_private::Thread& thread)
 lldb::UnwindAssemblySP
 FuncUnwinders::GetUnwindAssemblyProfiler ()
 {
-    UnwindAssemblySP assembly_profiler_sp;
-    ArchSpec arch;
-    if (m_unwind_table.GetArchitecture (arch))
-    {
-        assembly_profiler_sp = UnwindAssembly::FindPlugin (arch);
-    }
-    return assembly_profiler_sp;
+    return m_unwind_table.GetUnwindAssemblyProfiler ();
 }
@@ -11,12 +11,17 @@
 
 #include <stdio.h>
 
+#include <algorithm>
+
 #include "lldb/Core/Module.h"
 #include "lldb/Core/Section.h"
 #include "lldb/Symbol/ObjectFile.h"
 #include "lldb/Symbol/FuncUnwinders.h"
+#include "lldb/Symbol/Symbol.h"
 #include "lldb/Symbol/SymbolContext.h"
+#include "lldb/Symbol/Symtab.h"
 #include "lldb/Symbol/DWARFCallFrameInfo.h"
+#include "lldb/Target/UnwindAssembly.h"
 
 // There is one UnwindTable object per ObjectFile.
 // It contains a list of Unwind objects -- one per function, populated lazily -- for the ObjectFile.
@@ -28,9 +33,19 @@ using namespace lldb_private;
 UnwindTable::UnwindTable (ObjectFile& objfile) : 
     m_object_file (objfile), 
     m_unwinds (),
+    m_function_ranges (),
+    m_indexed_unwinders (),
     m_initialized (false),
     m_mutex (),
-    m_eh_frame (nullptr)
+    m_eh_frame (nullptr),
+    m_unwind_row_cache (),
+    m_unwind_row_cache_hits (0),
+    m_unwind_row_cache_misses (0),
+    m_assembly_mutex (),
+    m_assembly_profiler_sp (),
+    m_tried_assembly_profiler (false),
+    m_assembly_unwind_plans (),
+    m_fast_assembly_unwind_plans ()
 {
 }
 
@@ -57,10 +72,107 @@ UnwindTable::Initialize ()
             m_eh_frame = new DWARFCallFrameInfo(m_object_file, sect, eRegisterKindGCC, true);
         }
     }
+
+    BuildFunctionRangeIndex ();
     
     m_initialized = true;
 }
 
+void
+UnwindTable::BuildFunctionRangeIndex ()
+{
+    FunctionRanges ranges;
+
+    // Code symbols with a size give the bounds of nearly every function
+    Symtab *symtab = m_object_file.GetSymtab();
+    if (symtab)
+    {
+        Mutex::Locker symtab_locker (symtab->GetMutex());
+        const size_t num_symbols = symtab->GetNumSymbols();
+        for (size_t idx = 0; idx < num_symbols; ++idx)
+        {
+            Symbol *symbol = symtab->SymbolAtIndex (idx);
+            if (symbol == NULL || symbol->GetType() != eSymbolTypeCode || !symbol->ValueIsAddress())
+                continue;
+            const addr_t size = symbol->GetByteSize();
+            const addr_t start = symbol->GetAddress().GetFileAddress();
+            if (size == 0 || start == LLDB_INVALID_ADDRESS)
+                continue;
+            FunctionRange range = { start, start + size };
+            ranges.push_back (range);
+        }
+    }
+
+    // A stripped object file has no useful symbols, use the FDEs then. We
+    // don't want to parse all of the eh_frame for the other object files,
+    // it's looked up through its search table where needed.
+    if (ranges.empty() && m_eh_frame)
+    {
+        DWARFCallFrameInfo::FunctionAddressAndSizeVector fdes;
+        m_eh_frame->GetFunctionAddressAndSizeVector (fdes);
+        const size_t num_fdes = fdes.GetSize();
+        for (size_t idx = 0; idx < num_fdes; ++idx)
+        {
+            const DWARFCallFrameInfo::FunctionAddressAndSizeVector::Entry *fde = fdes.GetEntryAtIndex (idx);
+            if (fde->GetByteSize() == 0)
+                continue;
+            FunctionRange range = { fde->GetRangeBase(), fde->GetRangeEnd() };
+            ranges.push_back (range);
+        }
+    }
+
+    // Aliases share a start address and some symbols overlap the
+    // function after them or are nested inside another symbol's range.
+    // Keep the smallest range at an address and end a range where the
+    // next one starts, so an address maps to the innermost function.
+    // Addresses that are left out go through the symbol context lookup.
+    std::sort (ranges.begin(), ranges.end(), [] (const FunctionRange &lhs, const FunctionRange &rhs) {
+        if (lhs.start != rhs.start)
+            return lhs.start < rhs.start;
+        return lhs.end < rhs.end;
+    });
+    m_function_ranges.clear();
+    m_function_ranges.reserve (ranges.size());
+    for (const FunctionRange &range : ranges)
+    {
+        if (!m_function_ranges.empty())
+        {
+            FunctionRange &prev_range = m_function_ranges.back();
+            if (range.start == prev_range.start)
+                continue;
+            if (range.start < prev_range.end)
+                prev_range.end = range.start;
+        }
+        m_function_ranges.push_back (range);
+    }
+    m_indexed_unwinders.reset (new IndexedUnwinders[m_function_ranges.size()]);
+}
+
+FuncUnwindersSP
+UnwindTable::GetIndexedFuncUnwinders (addr_t file_addr)
+{
+    FunctionRanges::iterator pos = std::upper_bound (m_function_ranges.begin(), m_function_ranges.end(), file_addr,
+                                                     [] (addr_t addr, const FunctionRange &range) { return addr < range.start; });
+    if (pos == m_function_ranges.begin())
+        return FuncUnwindersSP();
+    --pos;
+    if (file_addr >= pos->end)
+        return FuncUnwindersSP();
+
+    IndexedUnwinders &slot = m_indexed_unwinders[pos - m_function_ranges.begin()];
+    if (slot.ready.load (std::memory_order_acquire))
+        return slot.unwinders;
+
+    Mutex::Locker locker(m_mutex);
+    if (!slot.ready.load (std::memory_order_relaxed))
+    {
+        AddressRange range (pos->start, pos->end - pos->start, m_object_file.GetSectionList());
+        slot.unwinders.reset (new FuncUnwinders(*this, range));
+        slot.ready.store (true, std::memory_order_release);
+    }
+    return slot.unwinders;
+}
+
 UnwindTable::~UnwindTable ()
 {
     if (m_eh_frame)
@@ -74,10 +186,15 @@ UnwindTable::GetFuncUnwindersContainingAddress (const Address& addr, SymbolConte
 
     Initialize();
 
-    Mutex::Locker locker(m_mutex);
-
     // There is an UnwindTable per object file, so we can safely use file handles
     addr_t file_addr = addr.GetFileAddress();
+
+    FuncUnwindersSP indexed_func_unwinder_sp (GetIndexedFuncUnwinders (file_addr));
+    if (indexed_func_unwinder_sp)
+        return indexed_func_unwinder_sp;
+
+    Mutex::Locker locker(m_mutex);
+
     iterator end = m_unwinds.end ();
     iterator insert_pos = end;
     if (!m_unwinds.empty())
@@ -137,7 +254,8 @@ void
 UnwindTable::Dump (Stream &s)
 {
     Mutex::Locker locker(m_mutex);
-    s.Printf("UnwindTable for '%s':\n", m_object_file.GetFileSpec().GetPath().c_str());
+    s.Printf("UnwindTable for '%s' (%" PRIu64 " indexed functions):\n",
+             m_object_file.GetFileSpec().GetPath().c_str(), (uint64_t)m_function_ranges.size());
     const_iterator begin = m_unwinds.begin();
     const_iterator end = m_unwinds.end();
     for (const_iterator pos = begin; pos != end; ++pos)
@@ -159,3 +277,86 @@ UnwindTable::GetArchitecture (lldb_private::ArchSpec &arch)
 {
     return m_object_file.GetArchitecture (arch);
 }
+
+UnwindAssemblySP
+UnwindTable::GetUnwindAssemblyProfiler ()
+{
+    Mutex::Locker locker(m_assembly_mutex);
+    if (!m_tried_assembly_profiler)
+    {
+        m_tried_assembly_profiler = true;
+        ArchSpec arch;
+        if (GetArchitecture (arch))
+            m_assembly_profiler_sp = UnwindAssembly::FindPlugin (arch);
+    }
+    return m_assembly_profiler_sp;
+}
+
+UnwindPlanSP
+UnwindTable::GetAssemblyUnwindPlan (const AddressRange &range, Thread &thread, bool fast)
+{
+    AssemblyUnwindPlans &plans = fast ? m_fast_assembly_unwind_plans : m_assembly_unwind_plans;
+    const AssemblyUnwindPlans::key_type key (range.GetBaseAddress().GetFileAddress(), range.GetByteSize());
+    {
+        Mutex::Locker locker(m_assembly_mutex);
+        AssemblyUnwindPlans::const_iterator pos = plans.find (key);
+        if (pos != plans.end())
+            return pos->second;
+    }
+
+    UnwindPlanSP unwind_plan_sp;
+    UnwindAssemblySP assembly_profiler_sp (GetUnwindAssemblyProfiler());
+    if (assembly_profiler_sp)
+    {
+        // Functions are profiled without the lock held, if two threads
+        // profile the same one the first plan to be added is kept.
+        AddressRange func_range (range);
+        unwind_plan_sp.reset (new UnwindPlan (lldb::eRegisterKindGeneric));
+        const bool success = fast ? assembly_profiler_sp->GetFastUnwindPlan (func_range, thread, *unwind_plan_sp)
+                                  : assembly_profiler_sp->GetNonCallSiteUnwindPlanFromAssembly (func_range, thread, *unwind_plan_sp);
+        if (!success)
+            unwind_plan_sp.reset();
+    }
+
+    Mutex::Locker locker(m_assembly_mutex);
+    return plans.insert (std::make_pair (key, unwind_plan_sp)).first->second;
+}
+
+bool
+UnwindTable::LookupUnwindRow (lldb::addr_t file_addr, UnwindRowCacheEntry &entry)
+{
+    Mutex::Locker locker(m_mutex);
+    UnwindRowCache::const_iterator pos = m_unwind_row_cache.find (file_addr);
+    if (pos == m_unwind_row_cache.end())
+    {
+        ++m_unwind_row_cache_misses;
+        return false;
+    }
+    ++m_unwind_row_cache_hits;
+    entry = pos->second;
+    return true;
+}
+
+void
+UnwindTable::AddUnwindRow (lldb::addr_t file_addr, const UnwindRowCacheEntry &entry)
+{
+    Mutex::Locker locker(m_mutex);
+    m_unwind_row_cache[file_addr] = entry;
+}
+
+void
+UnwindTable::ClearUnwindRowCache ()
+{
+    Mutex::Locker locker(m_mutex);
+    m_unwind_row_cache.clear();
+    m_unwind_row_cache_hits = 0;
+    m_unwind_row_cache_misses = 0;
+}
+
+void
+UnwindTable::GetUnwindRowCacheStatistics (uint32_t &hits, uint32_t &misses)
+{
+    Mutex::Locker locker(m_mutex);
+    hits = m_unwind_row_cache_hits;
+    misses = m_unwind_row_cache_misses;
+}
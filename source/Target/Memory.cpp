@@ -29,7 +29,8 @@ MemoryCache::MemoryCache(Process &process) :
     m_cache_line_byte_size (512),
     m_mutex (Mutex::eMutexTypeRecursive),
     m_cache (),
-    m_invalid_ranges ()
+    m_invalid_ranges (),
+    m_flush_generation (0)
 {
 }
 
@@ -44,6 +45,7 @@ void
 MemoryCache::Clear(bool clear_invalid_ranges)
 {
     Mutex::Locker locker (m_mutex);
+    ++m_flush_generation;
     m_cache.clear();
     if (clear_invalid_ranges)
         m_invalid_ranges.Clear();
@@ -56,6 +58,9 @@ MemoryCache::Flush (addr_t addr, size_t size)
         return;
 
     Mutex::Locker locker (m_mutex);
+    // Even with nothing cached a read may be under way that started before
+    // the memory changed.
+    ++m_flush_generation;
     if (m_cache.empty())
         return;
 
@@ -112,6 +117,71 @@ MemoryCache::RemoveInvalidRange (lldb::addr_t base_addr, lldb::addr_t byte_size)
 }
 
 
+size_t
+MemoryCache::Prefetch (addr_t addr, size_t size, Error &error)
+{
+    if (size == 0)
+        return 0;
+
+    const uint32_t cache_line_byte_size = m_cache_line_byte_size;
+    const addr_t first_line_addr = addr - (addr % cache_line_byte_size);
+    addr_t end_addr = addr + size;
+    if (end_addr < addr)
+        end_addr = LLDB_INVALID_ADDRESS - (LLDB_INVALID_ADDRESS % cache_line_byte_size);
+    else if (end_addr % cache_line_byte_size)
+        end_addr += cache_line_byte_size - (end_addr % cache_line_byte_size);
+
+    Mutex::Locker locker (m_mutex);
+
+    // Skip the lines at the start that we already have, and stop before
+    // the first line we know we can't read.
+    addr_t read_addr = first_line_addr;
+    while (read_addr < end_addr)
+    {
+        BlockMap::const_iterator pos = m_cache.find (read_addr);
+        if (pos == m_cache.end())
+            break;
+        if (pos->second->GetByteSize() != cache_line_byte_size)
+        {
+            // Readable memory ends in this line
+            const addr_t cached_end = read_addr + pos->second->GetByteSize();
+            return cached_end > addr ? cached_end - addr : 0;
+        }
+        read_addr += cache_line_byte_size;
+    }
+
+    addr_t read_end = read_addr;
+    while (read_end < end_addr && m_invalid_ranges.FindEntryThatContains(read_end) == NULL)
+        read_end += cache_line_byte_size;
+
+    if (read_end > read_addr)
+    {
+        const size_t read_size = read_end - read_addr;
+        DataBufferHeap data (read_size, 0);
+        const uint32_t flush_generation = m_flush_generation;
+        locker.Unlock();
+        const size_t bytes_read = m_process.ReadMemoryFromInferior (read_addr, data.GetBytes(), read_size, error);
+        locker.Lock (m_mutex);
+
+        // If the cache was flushed while we read, the data may predate a
+        // write, so drop it.  The lines we found cached may be gone too.
+        if (flush_generation != m_flush_generation)
+            return 0;
+
+        // Only keep whole lines, a short read may just mean the process
+        // plug-in didn't want to send us everything at once.
+        const size_t num_lines = bytes_read / cache_line_byte_size;
+        for (size_t i = 0; i < num_lines; ++i)
+        {
+            const addr_t line_addr = read_addr + i * cache_line_byte_size;
+            if (m_cache.find (line_addr) == m_cache.end())
+                m_cache[line_addr] = DataBufferSP (new DataBufferHeap (data.GetBytes() + i * cache_line_byte_size, cache_line_byte_size));
+        }
+        read_addr += num_lines * cache_line_byte_size;
+    }
+
+    return read_addr > addr ? read_addr - addr : 0;
+}
 
 size_t
 MemoryCache::Read (addr_t addr,  
@@ -198,13 +268,38 @@ MemoryCache::Read (addr_t addr,
             {
                 assert ((curr_addr % cache_line_byte_size) == 0);
                 std::unique_ptr<DataBufferHeap> data_buffer_heap_ap(new DataBufferHeap (cache_line_byte_size, 0));
+                // Don't hold the cache lock while we go to the process, so
+                // threads that are being unwound in parallel can keep hitting
+                // the cache while one of them fills a line.
+                const uint32_t flush_generation = m_flush_generation;
+                locker.Unlock();
                 size_t process_bytes_read = m_process.ReadMemoryFromInferior (curr_addr, 
                                                                               data_buffer_heap_ap->GetBytes(), 
                                                                               data_buffer_heap_ap->GetByteSize(), 
                                                                               error);
+                locker.Lock (m_mutex);
                 if (process_bytes_read == 0)
                     return dst_len - bytes_left;
-                
+
+                if (flush_generation != m_flush_generation)
+                {
+                    // The cache was flushed while we read, so this line may
+                    // predate a write.  Hand it to the caller, who asked
+                    // while the memory was changing, but don't cache it.
+                    if (process_bytes_read <= cache_offset)
+                        return dst_len - bytes_left;
+                    size_t curr_read_size = process_bytes_read - cache_offset;
+                    if (curr_read_size > bytes_left)
+                        curr_read_size = bytes_left;
+                    memcpy (dst_buf + dst_len - bytes_left, data_buffer_heap_ap->GetBytes() + cache_offset, curr_read_size);
+                    bytes_left -= curr_read_size;
+                    curr_addr += curr_read_size + cache_offset;
+                    cache_offset = 0;
+                    if (process_bytes_read != cache_line_byte_size)
+                        return dst_len - bytes_left;
+                    continue;
+                }
+
                 if (process_bytes_read != cache_line_byte_size)
                     data_buffer_heap_ap->SetByteSize (process_bytes_read);
                 m_cache[curr_addr] = DataBufferSP (data_buffer_heap_ap.release());
@@ -401,7 +496,14 @@ AllocatedMemoryCache::AllocatePage (uint32_t byte_size,
 {
     AllocatedBlockSP block_sp;
     const size_t page_size = 4096;
-    const size_t num_pages = (byte_size + page_size - 1) / page_size;
+    // Reserve at least this many pages at a time so that the handful of
+    // small allocations every expression makes (its argument struct, its
+    // result and any persistent variables) are carved out of one region
+    // instead of each costing a round trip to allocate inferior memory.
+    const size_t min_num_pages = 16;
+    size_t num_pages = (byte_size + page_size - 1) / page_size;
+    if (num_pages < min_num_pages)
+        num_pages = min_num_pages;
     const size_t page_byte_size = num_pages * page_size;
 
     addr_t addr = m_process.DoAllocateMemory(page_byte_size, permissions, error);
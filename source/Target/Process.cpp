@@ -11,20 +11,27 @@
 
 #include "lldb/Target/Process.h"
 
+#include <map>
+
 #include "lldb/lldb-private-log.h"
 
 #include "lldb/Breakpoint/StoppointCallbackContext.h"
 #include "lldb/Breakpoint/BreakpointLocation.h"
 #include "lldb/Core/Event.h"
 #include "lldb/Core/ConnectionFileDescriptor.h"
+#include "lldb/Core/DataBufferHeap.h"
 #include "lldb/Core/Debugger.h"
+#include "lldb/Core/Disassembler.h"
 #include "lldb/Core/Log.h"
 #include "lldb/Core/Module.h"
 #include "lldb/Symbol/Symbol.h"
+#include "lldb/Symbol/SymbolContext.h"
 #include "lldb/Core/PluginManager.h"
 #include "lldb/Core/State.h"
 #include "lldb/Core/StreamFile.h"
+#include "lldb/Expression/ClangFunction.h"
 #include "lldb/Expression/ClangUserExpression.h"
+#include "lldb/Expression/ClangUtilityFunction.h"
 #include "lldb/Interpreter/CommandInterpreter.h"
 #include "lldb/Host/Host.h"
 #include "lldb/Host/Pipe.h"
@@ -108,6 +115,8 @@ g_properties[] =
     { "python-os-plugin-path", OptionValue::eTypeFileSpec, false, true, NULL, NULL, "A path to a python OS plug-in module file that contains a OperatingSystemPlugIn class." },
     { "stop-on-sharedlibrary-events" , OptionValue::eTypeBoolean, true, false, NULL, NULL, "If true, stop when a shared library is loaded or unloaded." },
     { "detach-keeps-stopped" , OptionValue::eTypeBoolean, true, false, NULL, NULL, "If true, detach will attempt to keep the process stopped." },
+    { "unwind-threads-in-parallel" , OptionValue::eTypeBoolean, true, false, NULL, NULL, "If true, commands that need the stacks of many threads, like \"thread backtrace all\", unwind them on a pool of worker threads." },
+    { "unwind-stack-prefetch-size" , OptionValue::eTypeUInt64, false, 16 * 1024, NULL, NULL, "The number of bytes of stack memory, starting at the stack pointer, to read into the memory cache in one go when a thread is unwound. The prefetch is extended by the same amount as the unwind walks up the stack. Zero disables prefetching." },
     {  NULL                  , OptionValue::eTypeInvalid, false, 0, NULL, NULL, NULL  }
 };
 
@@ -118,7 +127,9 @@ enum {
     ePropertyUnwindOnErrorInExpressions,
     ePropertyPythonOSPluginPath,
     ePropertyStopOnSharedLibraryEvents,
-    ePropertyDetachKeepsStopped
+    ePropertyDetachKeepsStopped,
+    ePropertyUnwindThreadsInParallel,
+    ePropertyUnwindStackPrefetchSize
 };
 
 ProcessProperties::ProcessProperties (bool is_global) :
@@ -235,6 +246,27 @@ ProcessProperties::SetDetachKeepsStopped (bool stop)
     m_collection_sp->SetPropertyAtIndexAsBoolean(NULL, idx, stop);
 }
 
+bool
+ProcessProperties::GetUnwindThreadsInParallel () const
+{
+    const uint32_t idx = ePropertyUnwindThreadsInParallel;
+    return m_collection_sp->GetPropertyAtIndexAsBoolean(NULL, idx, g_properties[idx].default_uint_value != 0);
+}
+
+void
+ProcessProperties::SetUnwindThreadsInParallel (bool parallel)
+{
+    const uint32_t idx = ePropertyUnwindThreadsInParallel;
+    m_collection_sp->SetPropertyAtIndexAsBoolean(NULL, idx, parallel);
+}
+
+uint64_t
+ProcessProperties::GetUnwindStackPrefetchSize () const
+{
+    const uint32_t idx = ePropertyUnwindStackPrefetchSize;
+    return m_collection_sp->GetPropertyAtIndexAsUInt64(NULL, idx, g_properties[idx].default_uint_value);
+}
+
 void
 ProcessInstanceInfo::Dump (Stream &s, Platform *platform) const
 {
@@ -677,7 +709,16 @@ Process::Process(Target &target, Listener &listener) :
     m_image_tokens (),
     m_listener (listener),
     m_breakpoint_site_list (),
+    m_injected_condition_traps (),
+    m_injected_condition_hits (),
+    m_injected_conditions (),
     m_dynamic_checkers_ap (),
+    m_compiled_functions_mutex (Mutex::eMutexTypeRecursive),
+    m_utility_functions (),
+    m_caller_functions (),
+    m_num_functions_compiled (0),
+    m_function_compile_nsec (0),
+    m_helper_function_addresses (),
     m_unix_signals (),
     m_abi_sp (),
     m_process_input_reader (),
@@ -794,6 +835,15 @@ Process::Finalize()
     // We need to destroy the loader before the derived Process class gets destroyed
     // since it is very likely that undoing the loader will require access to the real process.
     m_dynamic_checkers_ap.reset();
+    {
+        Mutex::Locker locker (m_compiled_functions_mutex);
+        m_utility_functions.clear();
+        m_caller_functions.clear();
+        m_helper_function_addresses.clear();
+    }
+    m_injected_condition_traps.clear();
+    m_injected_condition_hits.clear();
+    m_injected_conditions.clear();
     m_abi_sp.reset();
     m_os_ap.reset();
     m_system_runtime_ap.reset();
@@ -1331,6 +1381,88 @@ Process::CreateOSPluginThread (lldb::tid_t tid, lldb::addr_t context)
     return ThreadSP();
 }
 
+namespace {
+    // Threads whose stack frames are computed by a pool of workers
+    struct ComputeStackFramesQueue
+    {
+        const std::vector<ThreadSP> *threads;
+        uint32_t max_frames;
+        Mutex mutex;
+        size_t next_index;
+    };
+}
+
+static void
+ComputeThreadStackFrames (const ThreadSP &thread_sp, uint32_t max_frames)
+{
+    if (max_frames == UINT32_MAX)
+        thread_sp->GetStackFrameCount();
+    else if (max_frames > 0)
+        thread_sp->GetStackFrameAtIndex(max_frames - 1);
+}
+
+static lldb::thread_result_t
+ComputeStackFramesThread (lldb::thread_arg_t arg)
+{
+    ComputeStackFramesQueue *queue = (ComputeStackFramesQueue *)arg;
+    while (true)
+    {
+        size_t index;
+        {
+            Mutex::Locker locker (queue->mutex);
+            if (queue->next_index >= queue->threads->size())
+                break;
+            index = queue->next_index++;
+        }
+        ComputeThreadStackFrames ((*queue->threads)[index], queue->max_frames);
+    }
+    return NULL;
+}
+
+void
+Process::ComputeStackFrames (const std::vector<ThreadSP> &threads, uint32_t max_frames)
+{
+    if (threads.empty() || max_frames == 0)
+        return;
+
+    // Only unwind in parallel when the process is stopped and nothing
+    // that can't be called from several threads at once (like a python
+    // OS plug-in) is involved in making the frames.
+    uint32_t num_workers = 0;
+    if (threads.size() > 1 && GetUnwindThreadsInParallel() && StateIsStoppedState(GetState(), true) && !m_os_ap)
+        num_workers = std::min<uint32_t>(std::max<uint32_t>(Host::GetNumberCPUS(), 1), threads.size()) - 1;
+
+    Log *log (lldb_private::GetLogIfAnyCategoriesSet (LIBLLDB_LOG_THREAD));
+    if (log)
+        log->Printf ("Process::ComputeStackFrames computing up to %u frames for %" PRIu64 " threads with %u worker threads",
+                     max_frames, (uint64_t)threads.size(), num_workers);
+
+    if (num_workers == 0)
+    {
+        for (const ThreadSP &thread_sp : threads)
+            ComputeThreadStackFrames (thread_sp, max_frames);
+        return;
+    }
+
+    ComputeStackFramesQueue queue;
+    queue.threads = &threads;
+    queue.max_frames = max_frames;
+    queue.next_index = 0;
+
+    std::vector<lldb::thread_t> workers;
+    for (uint32_t i = 0; i < num_workers; ++i)
+    {
+        lldb::thread_t worker = Host::ThreadCreate ("<lldb.process.compute-stack-frames>", ComputeStackFramesThread, &queue, NULL);
+        if (IS_VALID_LLDB_HOST_THREAD(worker))
+            workers.push_back(worker);
+    }
+
+    // Help out on this thread, and pick up anything the workers didn't
+    ComputeStackFramesThread (&queue);
+    for (lldb::thread_t worker : workers)
+        Host::ThreadJoin (worker, NULL, NULL);
+}
+
 uint32_t
 Process::GetNextThreadIndexID (uint64_t thread_id)
 {
@@ -1786,10 +1918,13 @@ Process::GetBreakpointSiteList() const
 void
 Process::DisableAllBreakpointSites ()
 {
-    m_breakpoint_site_list.ForEach([this](BreakpointSite *bp_site) -> void {
-//        bp_site->SetEnabled(true);
-        DisableBreakpointSite(bp_site);
+    std::vector<BreakpointSite *> bp_sites;
+    m_breakpoint_site_list.ForEach([&bp_sites](BreakpointSite *bp_site) -> void {
+        bp_sites.push_back(bp_site);
     });
+
+    std::vector<Error> errors;
+    DisableBreakpointSites(bp_sites, errors);
 }
 
 Error
@@ -1838,12 +1973,47 @@ Process::EnableBreakpointSiteByID (lldb::user_id_t break_id)
     return error;
 }
 
-lldb::break_id_t
-Process::CreateBreakpointSite (const BreakpointLocationSP &owner, bool use_hardware)
+Error
+Process::GetMemoryRegions (std::vector<MemoryRegionInfo> &regions)
+{
+    regions.clear();
+
+    addr_t load_addr = 0;
+    MemoryRegionInfo region_info;
+    Error error (GetMemoryRegionInfo (load_addr, region_info));
+    while (error.Success())
+    {
+        const MemoryRegionInfo::RangeType &range = region_info.GetRange();
+        if (region_info.GetReadable() == MemoryRegionInfo::eYes ||
+            region_info.GetWritable() == MemoryRegionInfo::eYes ||
+            region_info.GetExecutable() == MemoryRegionInfo::eYes)
+            regions.push_back (region_info);
+        else if (range.GetByteSize() == 1)
+        {
+            // No protections and a size of 1 used to be returned from old
+            // debugservers when we asked about a region that was past the
+            // last memory region and it indicates the end...
+            break;
+        }
+
+        // Stop when we reach the end of the address space or stop making
+        // progress.
+        if (range.GetByteSize() == 0 || range.GetRangeEnd() <= load_addr)
+            break;
+        load_addr = range.GetRangeEnd();
+        error = GetMemoryRegionInfo (load_addr, region_info);
+    }
+
+    // Running off the end of the last region is expected, only fail if we
+    // didn't find anything at all.
+    if (!regions.empty())
+        error.Clear();
+    return error;
+}
+
+bool
+Process::ShouldReportBreakpointSiteErrors ()
 {
-    addr_t load_addr = LLDB_INVALID_ADDRESS;
-    
-    bool show_error = true;
     switch (GetState())
     {
         case eStateInvalid:
@@ -1853,17 +2023,22 @@ Process::CreateBreakpointSite (const BreakpointLocationSP &owner, bool use_hardw
         case eStateLaunching:
         case eStateDetached:
         case eStateExited:
-            show_error = false;
-            break;
+            return false;
             
         case eStateStopped:
         case eStateRunning:
         case eStateStepping:
         case eStateCrashed:
         case eStateSuspended:
-            show_error = IsAlive();
-            break;
+            return IsAlive();
     }
+    return true;
+}
+
+addr_t
+Process::GetBreakpointSiteLoadAddress (const BreakpointLocationSP &owner, bool show_error)
+{
+    addr_t load_addr = LLDB_INVALID_ADDRESS;
 
     // Reset the IsIndirect flag here, in case the location changes from
     // pointing to a indirect symbol to a regular symbol.
@@ -1883,7 +2058,7 @@ Process::CreateBreakpointSite (const BreakpointLocationSP &owner, bool use_hardw
                                                                owner->GetBreakpoint().GetID(),
                                                                owner->GetID(),
                                                                error.AsCString() ? error.AsCString() : "unknown error");
-                return LLDB_INVALID_BREAK_ID;
+                return LLDB_INVALID_ADDRESS;
             }
             Address resolved_address(load_addr);
             load_addr = resolved_address.GetOpcodeLoadAddress (&m_target);
@@ -1894,6 +2069,14 @@ Process::CreateBreakpointSite (const BreakpointLocationSP &owner, bool use_hardw
     }
     else
         load_addr = owner->GetAddress().GetOpcodeLoadAddress (&m_target);
+    return load_addr;
+}
+
+lldb::break_id_t
+Process::CreateBreakpointSite (const BreakpointLocationSP &owner, bool use_hardware)
+{
+    const bool show_error = ShouldReportBreakpointSiteErrors();
+    addr_t load_addr = GetBreakpointSiteLoadAddress (owner, show_error);
     
     if (load_addr != LLDB_INVALID_ADDRESS)
     {
@@ -1906,6 +2089,8 @@ Process::CreateBreakpointSite (const BreakpointLocationSP &owner, bool use_hardw
 
         if (bp_site_sp)
         {
+            // An injected condition decides for every owner of the site.
+            RemoveInjectedBreakpointCondition (bp_site_sp.get());
             bp_site_sp->AddOwner (owner);
             owner->SetBreakpointSite (bp_site_sp);
             return bp_site_sp->GetID();
@@ -1941,6 +2126,116 @@ Process::CreateBreakpointSite (const BreakpointLocationSP &owner, bool use_hardw
 
 }
 
+size_t
+Process::CreateBreakpointSites (const std::vector<BreakpointLocationSP> &owners, bool use_hardware)
+{
+    const bool show_error = ShouldReportBreakpointSiteErrors();
+    size_t num_resolved = 0;
+
+    // Locations that land on an existing site just become owners of it.
+    // Everything else gets a new site, and all of the new sites are
+    // enabled together.
+    std::vector<BreakpointSiteSP> new_sites;
+    std::vector<std::vector<BreakpointLocationSP> > new_site_owners;
+    std::map<addr_t, size_t> new_site_index;
+    for (const BreakpointLocationSP &owner : owners)
+    {
+        const addr_t load_addr = GetBreakpointSiteLoadAddress (owner, show_error);
+        if (load_addr == LLDB_INVALID_ADDRESS)
+            continue;
+
+        BreakpointSiteSP bp_site_sp (m_breakpoint_site_list.FindByAddress (load_addr));
+        if (bp_site_sp)
+        {
+            RemoveInjectedBreakpointCondition (bp_site_sp.get());
+            bp_site_sp->AddOwner (owner);
+            owner->SetBreakpointSite (bp_site_sp);
+            ++num_resolved;
+            continue;
+        }
+
+        std::map<addr_t, size_t>::const_iterator pos = new_site_index.find (load_addr);
+        if (pos != new_site_index.end())
+        {
+            new_sites[pos->second]->AddOwner (owner);
+            new_site_owners[pos->second].push_back (owner);
+            continue;
+        }
+
+        new_site_index[load_addr] = new_sites.size();
+        new_sites.push_back (BreakpointSiteSP (new BreakpointSite (&m_breakpoint_site_list, owner, load_addr, use_hardware)));
+        new_site_owners.push_back (std::vector<BreakpointLocationSP> (1, owner));
+    }
+
+    if (new_sites.empty())
+        return num_resolved;
+
+    std::vector<BreakpointSite *> bp_sites;
+    for (const BreakpointSiteSP &bp_site_sp : new_sites)
+        bp_sites.push_back (bp_site_sp.get());
+
+    std::vector<Error> errors;
+    EnableBreakpointSites (bp_sites, errors);
+
+    for (size_t i = 0; i < new_sites.size(); ++i)
+    {
+        if (i < errors.size() && errors[i].Success())
+        {
+            m_breakpoint_site_list.Add (new_sites[i]);
+            for (const BreakpointLocationSP &owner : new_site_owners[i])
+                owner->SetBreakpointSite (new_sites[i]);
+            num_resolved += new_site_owners[i].size();
+        }
+        else if (show_error)
+        {
+            const BreakpointLocationSP &owner = new_site_owners[i].front();
+            const char *error_cstr = i < errors.size() ? errors[i].AsCString() : NULL;
+            m_target.GetDebugger().GetErrorFile()->Printf ("warning: failed to set breakpoint site at 0x%" PRIx64 " for breakpoint %i.%i: %s\n",
+                                                           new_sites[i]->GetLoadAddress(),
+                                                           owner->GetBreakpoint().GetID(),
+                                                           owner->GetID(),
+                                                           error_cstr ? error_cstr : "unknown error");
+        }
+    }
+    return num_resolved;
+}
+
+Error
+Process::EnableBreakpointSites (const std::vector<BreakpointSite *> &bp_sites, std::vector<Error> &errors)
+{
+    size_t num_failed = 0;
+    errors.clear();
+    for (BreakpointSite *bp_site : bp_sites)
+    {
+        errors.push_back (EnableBreakpointSite (bp_site));
+        if (errors.back().Fail())
+            ++num_failed;
+    }
+
+    Error error;
+    if (num_failed > 0)
+        error.SetErrorStringWithFormat ("failed to enable %" PRIu64 " of %" PRIu64 " breakpoint sites", (uint64_t)num_failed, (uint64_t)bp_sites.size());
+    return error;
+}
+
+Error
+Process::DisableBreakpointSites (const std::vector<BreakpointSite *> &bp_sites, std::vector<Error> &errors)
+{
+    size_t num_failed = 0;
+    errors.clear();
+    for (BreakpointSite *bp_site : bp_sites)
+    {
+        errors.push_back (DisableBreakpointSite (bp_site));
+        if (errors.back().Fail())
+            ++num_failed;
+    }
+
+    Error error;
+    if (num_failed > 0)
+        error.SetErrorStringWithFormat ("failed to disable %" PRIu64 " of %" PRIu64 " breakpoint sites", (uint64_t)num_failed, (uint64_t)bp_sites.size());
+    return error;
+}
+
 void
 Process::RemoveOwnerFromBreakpointSite (lldb::user_id_t owner_id, lldb::user_id_t owner_loc_id, BreakpointSiteSP &bp_site_sp)
 {
@@ -1954,6 +2249,249 @@ Process::RemoveOwnerFromBreakpointSite (lldb::user_id_t owner_id, lldb::user_id_
     }
 }
 
+Error
+Process::InjectBreakpointCondition (BreakpointSite *bp_site,
+                                    const std::shared_ptr<ClangUserExpression> &condition_sp,
+                                    addr_t function_addr,
+                                    addr_t arg_addr,
+                                    size_t arg_size,
+                                    uint32_t result_ptr_offset,
+                                    size_t result_size)
+{
+    Error error;
+    assert (bp_site != NULL);
+    Log *log(lldb_private::GetLogIfAnyCategoriesSet (LIBLLDB_LOG_BREAKPOINTS));
+    const addr_t bp_addr = bp_site->GetLoadAddress();
+
+    if (!bp_site->IsEnabled() || bp_site->IsHardware() || bp_site->IsConditionInjected())
+    {
+        error.SetErrorString ("only enabled software breakpoint sites can have a condition injected");
+        return error;
+    }
+
+    ABI *abi = GetABI().get();
+    if (abi == NULL)
+    {
+        error.SetErrorString ("no ABI plug-in for the process");
+        return error;
+    }
+
+    // Disassemble the instruction the jump will displace.  ReadMemory()
+    // hides breakpoint traps, so this sees the original instruction.
+    uint8_t insn_bytes[16];
+    const size_t bytes_read = ReadMemory (bp_addr, insn_bytes, sizeof(insn_bytes), error);
+    if (bytes_read == 0)
+        return error;
+
+    DisassemblerSP disassembler_sp (Disassembler::DisassembleBytes (GetTarget().GetArchitecture(),
+                                                                    NULL,
+                                                                    NULL,
+                                                                    Address (bp_addr),
+                                                                    insn_bytes,
+                                                                    bytes_read,
+                                                                    1,
+                                                                    false));
+    InstructionSP insn_sp;
+    if (disassembler_sp)
+        insn_sp = disassembler_sp->GetInstructionList().GetInstructionAtIndex (0);
+    if (!insn_sp)
+    {
+        error.SetErrorStringWithFormat ("couldn't disassemble the instruction at 0x%" PRIx64, bp_addr);
+        return error;
+    }
+
+    // The jump has to fit over the instruction and reach the trampoline, so
+    // ask for memory on either side of the site until it does.
+    static const int64_t g_hint_offsets[] = { -0x10000000ll, 0x10000000ll, -0x40000000ll, 0x40000000ll };
+    const size_t trampoline_size = 256;
+    const uint32_t permissions = lldb::ePermissionsReadable | lldb::ePermissionsExecutable;
+    uint8_t jump_opcode[8];
+    size_t jump_size = 0;
+    addr_t trampoline_addr = LLDB_INVALID_ADDRESS;
+    for (int64_t hint_offset : g_hint_offsets)
+    {
+        const addr_t hint_addr = (bp_addr + hint_offset) & ~(addr_t)0xfff;
+        Error alloc_error;
+        addr_t addr = DoAllocateMemoryNear (hint_addr, trampoline_size, permissions, alloc_error);
+        if (addr == LLDB_INVALID_ADDRESS)
+            continue;
+
+        jump_size = abi->GetJumpOpcode (bp_addr, addr, jump_opcode, sizeof(jump_opcode));
+        if (jump_size > 0)
+        {
+            trampoline_addr = addr;
+            break;
+        }
+        DoDeallocateMemory (addr);
+    }
+
+    if (trampoline_addr == LLDB_INVALID_ADDRESS)
+    {
+        error.SetErrorStringWithFormat ("couldn't allocate memory within reach of 0x%" PRIx64, bp_addr);
+        return error;
+    }
+
+    // The counter of the hits the code filters out.  Like the code, it is
+    // never freed.
+    const addr_t counter_addr = AllocateMemory (sizeof(uint64_t), lldb::ePermissionsReadable | lldb::ePermissionsWritable, error);
+    if (counter_addr == LLDB_INVALID_ADDRESS)
+    {
+        DoDeallocateMemory (trampoline_addr);
+        return error;
+    }
+    if (WriteScalarToMemory (counter_addr, Scalar ((uint64_t)0), sizeof(uint64_t), error) != sizeof(uint64_t))
+    {
+        DoDeallocateMemory (trampoline_addr);
+        DeallocateMemory (counter_addr);
+        return error;
+    }
+
+    std::vector<uint8_t> code;
+    addr_t trap_addr = LLDB_INVALID_ADDRESS;
+    if (jump_size > insn_sp->GetOpcode().GetByteSize() ||
+        !abi->CreateConditionTrampoline (*insn_sp,
+                                         bp_addr,
+                                         trampoline_addr,
+                                         function_addr,
+                                         arg_addr,
+                                         arg_size,
+                                         result_ptr_offset,
+                                         result_size,
+                                         counter_addr,
+                                         code,
+                                         trap_addr) ||
+        code.size() > trampoline_size)
+    {
+        DoDeallocateMemory (trampoline_addr);
+        DeallocateMemory (counter_addr);
+        error.SetErrorStringWithFormat ("the instruction at 0x%" PRIx64 " can't be replaced by a jump", bp_addr);
+        return error;
+    }
+
+    if (WriteMemory (trampoline_addr, &code[0], code.size(), error) != code.size())
+    {
+        DoDeallocateMemory (trampoline_addr);
+        DeallocateMemory (counter_addr);
+        return error;
+    }
+
+    // Swap the trap for the jump.  If the jump can't be written the site
+    // goes back to its ordinary trap.
+    DisableBreakpointSite (bp_site);
+    if (bp_site->IsEnabled())
+    {
+        DoDeallocateMemory (trampoline_addr);
+        DeallocateMemory (counter_addr);
+        error.SetErrorStringWithFormat ("couldn't remove the breakpoint trap at 0x%" PRIx64, bp_addr);
+        return error;
+    }
+
+    bp_site->SetTrapOpcode (jump_opcode, jump_size);
+    bp_site->SetConditionInjected (true);
+    error = EnableSoftwareBreakpoint (bp_site);
+    if (error.Fail())
+    {
+        bp_site->SetConditionInjected (false);
+        EnableBreakpointSite (bp_site);
+        DoDeallocateMemory (trampoline_addr);
+        DeallocateMemory (counter_addr);
+        return error;
+    }
+
+    m_injected_condition_traps[trap_addr] = bp_addr;
+    InjectedConditionHits &hits = m_injected_condition_hits[bp_addr];
+    hits.counter_addr = counter_addr;
+    hits.counted = 0;
+    m_injected_conditions.push_back (condition_sp);
+
+    if (log)
+        log->Printf ("Process::InjectBreakpointCondition (site_id = %d) addr = 0x%" PRIx64 " -- trampoline at 0x%" PRIx64 ", trap at 0x%" PRIx64,
+                     bp_site->GetID(),
+                     (uint64_t)bp_addr,
+                     (uint64_t)trampoline_addr,
+                     (uint64_t)trap_addr);
+    return error;
+}
+
+Error
+Process::RemoveInjectedBreakpointCondition (BreakpointSite *bp_site)
+{
+    Error error;
+    assert (bp_site != NULL);
+    if (!bp_site->IsConditionInjected())
+        return error;
+
+    // Count the hits filtered out so far, the counter isn't read after this.
+    // The trampoline and its entry in m_injected_condition_traps stay, a
+    // thread that is inside it still needs to find its way back here.
+    UpdateInjectedConditionHitCounts ();
+    m_injected_condition_hits.erase (bp_site->GetLoadAddress());
+    const bool was_enabled = bp_site->IsEnabled();
+    if (was_enabled)
+        DisableBreakpointSite (bp_site);
+    bp_site->SetConditionInjected (false);
+    GetSoftwareBreakpointTrapOpcode (bp_site);
+    if (was_enabled)
+        error = EnableBreakpointSite (bp_site);
+
+    Log *log(lldb_private::GetLogIfAnyCategoriesSet (LIBLLDB_LOG_BREAKPOINTS));
+    if (log)
+        log->Printf ("Process::RemoveInjectedBreakpointCondition (site_id = %d) addr = 0x%" PRIx64 " -- %s",
+                     bp_site->GetID(),
+                     (uint64_t)bp_site->GetLoadAddress(),
+                     error.AsCString("SUCCESS"));
+    return error;
+}
+
+void
+Process::UpdateInjectedConditionHitCounts ()
+{
+    std::map<addr_t, InjectedConditionHits>::iterator pos, end = m_injected_condition_hits.end();
+    for (pos = m_injected_condition_hits.begin(); pos != end; ++pos)
+    {
+        Error error;
+        const uint64_t filtered = ReadUnsignedIntegerFromMemory (pos->second.counter_addr, sizeof(uint64_t), 0, error);
+        if (error.Fail() || filtered <= pos->second.counted)
+            continue;
+
+        BreakpointSiteSP bp_site_sp (m_breakpoint_site_list.FindByAddress (pos->first));
+        if (!bp_site_sp)
+            continue;
+
+        // An injected condition's site has a single owner.
+        const uint32_t new_hits = (uint32_t)(filtered - pos->second.counted);
+        pos->second.counted = filtered;
+        bp_site_sp->IncrementHitCount (new_hits);
+        if (bp_site_sp->GetNumberOfOwners() == 1)
+            bp_site_sp->GetOwnerAtIndex(0)->IncrementHitCount (new_hits);
+    }
+}
+
+BreakpointSiteSP
+Process::ResolveInjectedConditionTrap (Thread &thread, addr_t &pc)
+{
+    BreakpointSiteSP bp_site_sp;
+    if (m_injected_condition_traps.empty())
+        return bp_site_sp;
+
+    // Depending on the stub, the PC is either at the trap or just past it.
+    std::map<addr_t, addr_t>::const_iterator pos = m_injected_condition_traps.find (pc);
+    if (pos == m_injected_condition_traps.end())
+        pos = m_injected_condition_traps.find (pc - 1);
+    if (pos == m_injected_condition_traps.end())
+        return bp_site_sp;
+
+    // The trampoline restored every register before trapping, so moving
+    // the PC back makes it look like the thread hit the site itself.
+    RegisterContextSP reg_ctx_sp (thread.GetRegisterContext());
+    if (!reg_ctx_sp || !reg_ctx_sp->SetPC (pos->second))
+        return bp_site_sp;
+
+    pc = pos->second;
+    bp_site_sp = m_breakpoint_site_list.FindByAddress (pc);
+    return bp_site_sp;
+}
+
 
 size_t
 Process::RemoveBreakpointOpcodesFromBuffer (addr_t bp_addr, size_t size, uint8_t *buf) const
@@ -1988,6 +2526,10 @@ Process::RemoveBreakpointOpcodesFromBuffer (addr_t bp_addr, size_t size, uint8_t
 size_t
 Process::GetSoftwareBreakpointTrapOpcode (BreakpointSite* bp_site)
 {
+    // A site with an injected condition keeps its jump.
+    if (bp_site->IsConditionInjected())
+        return bp_site->GetByteSize();
+
     PlatformSP platform_sp (m_target.GetPlatform());
     if (platform_sp)
         return platform_sp->GetSoftwareBreakpointTrapOpcode (m_target, bp_site);
@@ -2213,6 +2755,23 @@ Process::ReadMemory (addr_t addr, void *buf, size_t size, Error &error)
         return ReadMemoryFromInferior (addr, buf, size, error);
     }
 }
+
+size_t
+Process::GetMemoryView (addr_t addr, size_t size, DataExtractor &data, Error &error)
+{
+    data.Clear();
+    if (size == 0)
+        return 0;
+
+    DataBufferSP data_sp (new DataBufferHeap (size, 0));
+    const size_t bytes_read = ReadMemory (addr, data_sp->GetBytes(), size, error);
+    if (bytes_read == 0)
+        return 0;
+
+    data.SetByteOrder (GetByteOrder());
+    data.SetAddressByteSize (GetAddressByteSize());
+    return data.SetData (data_sp, 0, bytes_read);
+}
     
 size_t
 Process::ReadCStringFromMemory (addr_t addr, std::string &out_str, Error &error)
@@ -2340,6 +2899,14 @@ Process::ReadCStringFromMemory (addr_t addr, char *dst, size_t dst_max_len, Erro
     return total_cstr_len;
 }
 
+size_t
+Process::PrefetchMemory (addr_t addr, size_t size, Error &error)
+{
+    if (GetDisableMemoryCache())
+        return 0;
+    return m_memory_cache.Prefetch (addr, size, error);
+}
+
 size_t
 Process::ReadMemoryFromInferior (addr_t addr, void *buf, size_t size, Error &error)
 {
@@ -2626,6 +3193,152 @@ Process::SetCanJIT (bool can_jit)
     m_can_jit = (can_jit ? eCanJITYes : eCanJITNo);
 }
 
+ClangUtilityFunction *
+Process::GetUtilityFunction (const char *text,
+                             const char *name,
+                             ExecutionContext &exe_ctx,
+                             Stream &error_stream)
+{
+    if (!text || !name)
+        return NULL;
+
+    std::string key (name);
+    key.append (1, '\0');
+    key.append (text);
+
+    Mutex::Locker locker (m_compiled_functions_mutex);
+
+    UtilityFunctionMap::iterator pos = m_utility_functions.find (key);
+    if (pos != m_utility_functions.end())
+        return pos->second.get();
+
+    TimeValue start_time (TimeValue::Now());
+
+    std::shared_ptr<ClangUtilityFunction> utility_function_sp (new ClangUtilityFunction (text, name));
+    if (!utility_function_sp->Install (error_stream, exe_ctx))
+        return NULL;
+
+    const uint64_t compile_nsec = TimeValue::Now() - start_time;
+    ++m_num_functions_compiled;
+    m_function_compile_nsec += compile_nsec;
+
+    Log *log (lldb_private::GetLogIfAllCategoriesSet (LIBLLDB_LOG_EXPRESSIONS));
+    if (log)
+        log->Printf ("Process::GetUtilityFunction compiled \"%s\" in %.3f ms (%u functions compiled for this process in %.3f ms)",
+                     name,
+                     compile_nsec / 1000000.0,
+                     m_num_functions_compiled,
+                     m_function_compile_nsec / 1000000.0);
+
+    m_utility_functions[key] = utility_function_sp;
+    return utility_function_sp.get();
+}
+
+ClangFunction *
+Process::GetCallerFunction (const Address &function_address,
+                            const ClangASTType &return_type,
+                            ValueList &arg_value_list,
+                            const char *name,
+                            ExecutionContext &exe_ctx,
+                            Stream &error_stream)
+{
+    ExecutionContextScope *exe_scope = exe_ctx.GetBestExecutionContextScope();
+    if (!exe_scope || !name)
+        return NULL;
+
+    // The wrapper only depends on the types going in and out of the call.
+    std::string key (name);
+    key.append (1, '\0');
+    key.append (return_type.GetTypeName().AsCString(""));
+    for (size_t i = 0, e = arg_value_list.GetSize(); i < e; ++i)
+    {
+        key.append (1, '\0');
+        key.append (arg_value_list.GetValueAtIndex(i)->GetClangType().GetTypeName().AsCString(""));
+    }
+
+    Mutex::Locker locker (m_compiled_functions_mutex);
+
+    CallerFunctionMap::iterator pos = m_caller_functions.find (key);
+    if (pos != m_caller_functions.end())
+        return pos->second.get();
+
+    TimeValue start_time (TimeValue::Now());
+
+    std::shared_ptr<ClangFunction> caller_function_sp (new ClangFunction (*exe_scope,
+                                                                          return_type,
+                                                                          function_address,
+                                                                          arg_value_list,
+                                                                          name));
+    if (caller_function_sp->CompileFunction (error_stream) != 0)
+        return NULL;
+
+    if (!caller_function_sp->WriteFunctionWrapper (exe_ctx, error_stream))
+        return NULL;
+
+    const uint64_t compile_nsec = TimeValue::Now() - start_time;
+    ++m_num_functions_compiled;
+    m_function_compile_nsec += compile_nsec;
+
+    Log *log (lldb_private::GetLogIfAllCategoriesSet (LIBLLDB_LOG_EXPRESSIONS));
+    if (log)
+        log->Printf ("Process::GetCallerFunction compiled \"%s\" in %.3f ms (%u functions compiled for this process in %.3f ms)",
+                     name,
+                     compile_nsec / 1000000.0,
+                     m_num_functions_compiled,
+                     m_function_compile_nsec / 1000000.0);
+
+    m_caller_functions[key] = caller_function_sp;
+    return caller_function_sp.get();
+}
+
+bool
+Process::GetHelperFunctionAddress (const ConstString &name, Address &address)
+{
+    Mutex::Locker locker (m_compiled_functions_mutex);
+
+    std::map<ConstString, Address>::iterator pos = m_helper_function_addresses.find (name);
+    if (pos != m_helper_function_addresses.end())
+    {
+        address = pos->second;
+        return true;
+    }
+
+    const bool append = true;
+    const bool include_symbols = true;
+    const bool include_inlines = false;
+    SymbolContextList sc_list;
+    if (GetTarget().GetImages().FindFunctions (name,
+                                               eFunctionNameTypeFull,
+                                               include_symbols,
+                                               include_inlines,
+                                               append,
+                                               sc_list) == 0)
+        return false;
+
+    SymbolContext sc;
+    if (!sc_list.GetContextAtIndex (0, sc))
+        return false;
+
+    const uint32_t range_scope = eSymbolContextFunction | eSymbolContextSymbol;
+    const bool use_inline_block_range = false;
+    AddressRange range;
+    if (!sc.GetAddressRange (range_scope, 0, use_inline_block_range, range))
+        return false;
+
+    address = range.GetBaseAddress();
+    m_helper_function_addresses[name] = address;
+    return true;
+}
+
+void
+Process::GetCompiledFunctionStatistics (uint32_t &num_compiled,
+                                        uint64_t &compile_time_nsec)
+{
+    Mutex::Locker locker (m_compiled_functions_mutex);
+    num_compiled = m_num_functions_compiled;
+    compile_time_nsec = m_function_compile_nsec;
+}
+
 Error
 Process::DeallocateMemory (addr_t ptr)
 {
@@ -4129,9 +4842,14 @@ Process::ProcessEventData::DoOnRemoval (Event *event_ptr)
     // and > 1 for expression evaluation, and we don't want to do the breakpoint command handling then.    
     if (m_update_state != 1)
         return;
-    
+
+    // Hits that injected conditions filtered out in the process only show
+    // up in the hit counts once we read them back at a stop.
+    if (m_state == eStateStopped)
+        m_process_sp->UpdateInjectedConditionHitCounts ();
+
     m_process_sp->SetPublicState (m_state, Process::ProcessEventData::GetRestartedFromEvent(event_ptr));
-    
+
     // If this is a halt event, even if the halt stopped with some reason other than a plain interrupt (e.g. we had
     // already stopped for a breakpoint when the halt request came through) don't do the StopInfo actions, as they may
     // end up restarting the process.
@@ -5849,6 +6567,16 @@ Process::DidExec ()
     target.CleanupProcess ();
     target.ClearModules(false);
     m_dynamic_checkers_ap.reset();
+    {
+        // The JITted code was in the image that was replaced.
+        Mutex::Locker locker (m_compiled_functions_mutex);
+        m_utility_functions.clear();
+        m_caller_functions.clear();
+        m_helper_function_addresses.clear();
+    }
+    m_injected_condition_traps.clear();
+    m_injected_condition_hits.clear();
+    m_injected_conditions.clear();
     m_abi_sp.reset();
     m_system_runtime_ap.reset();
     m_os_ap.reset();
@@ -0,0 +1,346 @@
+//===-- ProcessSampler.cpp --------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "lldb/Target/ProcessSampler.h"
+
+// C Includes
+#include <inttypes.h>
+#include <string.h>
+// C++ Includes
+#include <algorithm>
+#include <memory>
+
+// Other libraries and framework includes
+// Project includes
+#include "lldb/lldb-private-log.h"
+#include "lldb/Core/Listener.h"
+#include "lldb/Core/Log.h"
+#include "lldb/Core/Module.h"
+#include "lldb/Core/State.h"
+#include "lldb/Core/Stream.h"
+#include "lldb/Core/StreamString.h"
+#include "lldb/Host/TimeValue.h"
+#include "lldb/Symbol/SymbolContext.h"
+#include "lldb/Target/Process.h"
+#include "lldb/Target/SectionLoadList.h"
+#include "lldb/Target/StopInfo.h"
+#include "lldb/Target/Target.h"
+#include "lldb/Target/Thread.h"
+
+using namespace lldb;
+using namespace lldb_private;
+
+ProcessSampler::ProcessSampler (const ProcessSP &process_sp) :
+    m_process_wp (process_sp),
+    m_stack_counts (),
+    m_frame_names (),
+    m_num_samples (0)
+{
+}
+
+ProcessSampler::~ProcessSampler ()
+{
+}
+
+void
+ProcessSampler::Clear ()
+{
+    m_stack_counts.clear();
+    m_frame_names.clear();
+    m_num_samples = 0;
+}
+
+// Describe why a thread of a process that stopped by itself stopped
+static void
+GetStopDescription (Process &process, std::string &description)
+{
+    Mutex::Locker locker (process.GetThreadList().GetMutex());
+    const uint32_t num_threads = process.GetThreadList().GetSize();
+    for (uint32_t idx = 0; idx < num_threads; ++idx)
+    {
+        ThreadSP thread_sp (process.GetThreadList().GetThreadAtIndex(idx));
+        StopInfoSP stop_info_sp (thread_sp->GetStopInfo());
+        if (stop_info_sp && stop_info_sp->IsValid() && stop_info_sp->GetStopReason() != eStopReasonNone)
+        {
+            StreamString strm;
+            strm.Printf ("thread #%u: ", thread_sp->GetIndexID());
+            const char *stop_desc = stop_info_sp->GetDescription();
+            strm.PutCString (stop_desc ? stop_desc : "stopped");
+            description = strm.GetString();
+            return;
+        }
+    }
+    description = "stopped";
+}
+
+Error
+ProcessSampler::Sample (uint32_t frequency, uint32_t duration_msec, uint32_t max_frames)
+{
+    Error error;
+    ProcessSP process_sp (m_process_wp.lock());
+    if (!process_sp)
+    {
+        error.SetErrorString ("invalid process");
+        return error;
+    }
+    if (frequency == 0 || duration_msec == 0 || max_frames == 0)
+    {
+        error.SetErrorString ("frequency, duration and maximum frame count must be greater than zero");
+        return error;
+    }
+    if (!StateIsStoppedState (process_sp->GetState(), false))
+    {
+        error.SetErrorStringWithFormat ("process must be stopped to be sampled, it is %s",
+                                        StateAsCString (process_sp->GetState()));
+        return error;
+    }
+
+    Log *log (lldb_private::GetLogIfAllCategoriesSet (LIBLLDB_LOG_PROCESS));
+
+    // The stops we cause are of no interest to anyone else, so keep the
+    // state changed events to ourselves while we sample.
+    Listener listener ("lldb.process.sampler.hijack");
+    process_sp->HijackProcessEvents (&listener);
+
+    const uint64_t interval_usec = std::max<uint64_t> (1000000 / frequency, 1);
+    TimeValue end_time (TimeValue::Now());
+    end_time.OffsetWithMicroSeconds ((uint64_t)duration_msec * 1000);
+
+    while (TimeValue::Now() < end_time)
+    {
+        {
+            Mutex::Locker locker (process_sp->GetThreadList().GetMutex());
+            const uint32_t num_threads = process_sp->GetThreadList().GetSize();
+            for (uint32_t idx = 0; idx < num_threads; ++idx)
+            {
+                const bool override_suspend = false;
+                process_sp->GetThreadList().GetThreadAtIndex(idx)->SetResumeState (eStateRunning, override_suspend);
+            }
+        }
+
+        error = process_sp->Resume();
+        if (error.Fail())
+            break;
+
+        // Let the process run for one interval, unless it stops by itself
+        // first, and only interrupt it if it didn't.
+        TimeValue interval_end (TimeValue::Now());
+        interval_end.OffsetWithMicroSeconds (interval_usec);
+        const bool wait_always = true;
+        EventSP event_sp;
+        StateType state = process_sp->WaitForProcessToStop (&interval_end, &event_sp, wait_always, &listener);
+        if (state == eStateInvalid)
+        {
+            error = process_sp->Halt();
+            if (error.Fail())
+                break;
+
+            TimeValue timeout (TimeValue::Now());
+            timeout.OffsetWithSeconds (5);
+            state = process_sp->WaitForProcessToStop (&timeout, &event_sp, wait_always, &listener);
+        }
+
+        if (state != eStateStopped)
+        {
+            error.SetErrorStringWithFormat ("sampling ended early because the process is %s", StateAsCString (state));
+            break;
+        }
+
+        // A stop we didn't cause, at a breakpoint or on a signal, maybe
+        // just ahead of our halt, is for the user to see.  Leave the
+        // process there instead of resuming it.
+        if (!Process::ProcessEventData::GetInterruptedFromEvent (event_sp.get()))
+        {
+            std::string stop_description;
+            GetStopDescription (*process_sp, stop_description);
+            error.SetErrorStringWithFormat ("sampling ended early because the process stopped, %s", stop_description.c_str());
+            break;
+        }
+
+        TakeSample (*process_sp, max_frames);
+    }
+
+    process_sp->RestoreProcessEvents ();
+
+    if (log)
+        log->Printf ("ProcessSampler::%s took %u samples at %u Hz: %s",
+                     __FUNCTION__, m_num_samples, frequency, error.Success() ? "success" : error.AsCString());
+
+    return error;
+}
+
+void
+ProcessSampler::TakeSample (Process &process, uint32_t max_frames)
+{
+    // Keep the process stopped for as short as possible, only collect
+    // the pcs now. They are symbolicated when the results are dumped.
+    std::vector<ThreadSP> threads;
+    {
+        Mutex::Locker locker (process.GetThreadList().GetMutex());
+        const uint32_t num_threads = process.GetThreadList().GetSize(false);
+        for (uint32_t idx = 0; idx < num_threads; ++idx)
+            threads.push_back (process.GetThreadList().GetThreadAtIndex(idx, false));
+    }
+
+    Stack stack;
+    for (const ThreadSP &thread_sp : threads)
+    {
+        if (!thread_sp || thread_sp->GetRawBacktrace (stack, max_frames) == 0)
+            continue;
+
+        // Return addresses point after the call, look up the call itself
+        for (size_t idx = 1; idx < stack.size(); ++idx)
+        {
+            if (stack[idx] > 0)
+                --stack[idx];
+        }
+        ++m_stack_counts[stack];
+    }
+
+    // Anything we named before may have been unloaded since
+    m_frame_names.clear();
+    ++m_num_samples;
+}
+
+void
+ProcessSampler::Symbolicate ()
+{
+    ProcessSP process_sp (m_process_wp.lock());
+    if (!process_sp)
+        return;
+
+    // Look up each distinct address once, in address order so the
+    // lookups in each module happen together.
+    std::vector<addr_t> addrs;
+    for (const StackCounts::value_type &stack_count : m_stack_counts)
+    {
+        for (addr_t addr : stack_count.first)
+        {
+            if (m_frame_names.find (addr) == m_frame_names.end())
+                addrs.push_back (addr);
+        }
+    }
+    std::sort (addrs.begin(), addrs.end());
+    addrs.erase (std::unique (addrs.begin(), addrs.end()), addrs.end());
+
+    Target &target = process_sp->GetTarget();
+    for (addr_t addr : addrs)
+    {
+        FrameName &name = m_frame_names[addr];
+
+        Address so_addr;
+        if (target.GetSectionLoadList().ResolveLoadAddress (addr, so_addr))
+        {
+            ModuleSP module_sp (so_addr.GetModule());
+            if (module_sp)
+            {
+                name.module = module_sp->GetFileSpec().GetFilename();
+                SymbolContext sc;
+                module_sp->ResolveSymbolContextForAddress (so_addr, eSymbolContextFunction | eSymbolContextSymbol, sc);
+                name.function = sc.GetFunctionName();
+            }
+        }
+
+        if (!name.function)
+        {
+            char addr_str[32];
+            ::snprintf (addr_str, sizeof(addr_str), "0x%" PRIx64, addr);
+            name.function.SetCString (addr_str);
+        }
+    }
+}
+
+namespace {
+    struct CallTreeNode
+    {
+        CallTreeNode () : count (0), module (), children () {}
+
+        uint32_t count;
+        ConstString module;
+        // CallTreeNode is still incomplete here, so hold the children by
+        // pointer.
+        std::map<ConstString, std::unique_ptr<CallTreeNode> > children;
+    };
+
+    typedef std::pair<ConstString, const CallTreeNode *> NamedCallTreeNode;
+
+    bool
+    CompareNodeCounts (const NamedCallTreeNode &lhs, const NamedCallTreeNode &rhs)
+    {
+        if (lhs.second->count != rhs.second->count)
+            return lhs.second->count > rhs.second->count;
+        return ::strcmp (lhs.first.GetCString(), rhs.first.GetCString()) < 0;
+    }
+}
+
+static void
+DumpCallTreeNode (Stream &s, const CallTreeNode &node, uint32_t depth)
+{
+    std::vector<NamedCallTreeNode> children;
+    for (const auto &child : node.children)
+        children.push_back (NamedCallTreeNode (child.first, child.second.get()));
+    std::sort (children.begin(), children.end(), CompareNodeCounts);
+
+    for (const NamedCallTreeNode &child : children)
+    {
+        s.Printf ("%*s%u %s", depth * 2, "", child.second->count, child.first.GetCString());
+        if (child.second->module)
+            s.Printf ("  (in %s)", child.second->module.GetCString());
+        s.EOL();
+        DumpCallTreeNode (s, *child.second, depth + 1);
+    }
+}
+
+void
+ProcessSampler::DumpCallTree (Stream &s)
+{
+    Symbolicate ();
+
+    CallTreeNode root;
+    for (const StackCounts::value_type &stack_count : m_stack_counts)
+    {
+        CallTreeNode *node = &root;
+        for (Stack::const_reverse_iterator pos = stack_count.first.rbegin(); pos != stack_count.first.rend(); ++pos)
+        {
+            const FrameName &name = m_frame_names[*pos];
+            std::unique_ptr<CallTreeNode> &child = node->children[name.function];
+            if (!child)
+                child.reset (new CallTreeNode);
+            node = child.get();
+            node->module = name.module;
+            node->count += stack_count.second;
+        }
+    }
+
+    s.Printf ("%u samples:\n", m_num_samples);
+    DumpCallTreeNode (s, root, 1);
+}
+
+void
+ProcessSampler::DumpCollapsedStacks (Stream &s)
+{
+    Symbolicate ();
+
+    // Different addresses in the same functions make the same line
+    std::map<std::string, uint32_t> collapsed;
+    for (const StackCounts::value_type &stack_count : m_stack_counts)
+    {
+        std::string line;
+        for (Stack::const_reverse_iterator pos = stack_count.first.rbegin(); pos != stack_count.first.rend(); ++pos)
+        {
+            if (!line.empty())
+                line.append (1, ';');
+            line.append (m_frame_names[*pos].function.GetCString());
+        }
+        collapsed[line] += stack_count.second;
+    }
+
+    for (const auto &line_count : collapsed)
+        s.Printf ("%s %u\n", line_count.first.c_str(), line_count.second);
+}
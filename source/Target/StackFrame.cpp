@@ -1327,7 +1327,6 @@ StackFrame::DumpUsingSettingsFormat (Stream *strm, const char *frame_marker)
     if (strm == NULL)
         return;
 
-    GetSymbolContext(eSymbolContextEverything);
     ExecutionContext exe_ctx (shared_from_this());
     StreamString s;
     
@@ -1338,6 +1337,8 @@ StackFrame::DumpUsingSettingsFormat (Stream *strm, const char *frame_marker)
     Target *target = exe_ctx.GetTargetPtr();
     if (target)
         frame_format = target->GetDebugger().GetFrameFormat();
+    // Only look up what the format shows, Dump() below looks up the rest
+    GetSymbolContext(Debugger::GetSymbolContextScopeForFormat (frame_format));
     if (frame_format && Debugger::FormatPrompt (frame_format, &m_sc, &exe_ctx, NULL, s))
     {
         strm->Write(s.GetData(), s.GetSize());
@@ -16,11 +16,14 @@
 #include "lldb/Breakpoint/BreakpointLocation.h"
 #include "lldb/Breakpoint/Breakpoint.h"
 #include "lldb/Core/Log.h"
+#include "lldb/Core/Module.h"
 #include "lldb/Core/StreamFile.h"
 #include "lldb/Core/SourceManager.h"
 #include "lldb/Symbol/Block.h"
 #include "lldb/Symbol/Function.h"
 #include "lldb/Symbol/Symbol.h"
+#include "lldb/Symbol/SymbolFile.h"
+#include "lldb/Symbol/SymbolVendor.h"
 #include "lldb/Target/Process.h"
 #include "lldb/Target/RegisterContext.h"
 #include "lldb/Target/StackFrame.h"
@@ -250,6 +253,21 @@ StackFrameList::SetCurrentInlinedDepth (uint32_t new_depth)
         m_current_inlined_pc = m_thread.GetRegisterContext()->GetPC();
 }
 
+// Finding the inlined frames of a concrete frame needs its block, which
+// only debug information has.  Frames in other modules are left with just
+// their pc until something asks for their symbol context.
+static bool
+ModuleCanHaveInlinedFrames (const ModuleSP &module_sp)
+{
+    if (!module_sp)
+        return false;
+    SymbolVendor *sym_vendor = module_sp->GetSymbolVendor ();
+    if (sym_vendor == NULL)
+        return false;
+    SymbolFile *sym_file = sym_vendor->GetSymbolFile ();
+    return sym_file && (sym_file->GetAbilities () & SymbolFile::Blocks) != 0;
+}
+
 void
 StackFrameList::GetFramesUpTo(uint32_t end_idx)
 {
@@ -343,6 +361,9 @@ StackFrameList::GetFramesUpTo(uint32_t end_idx)
                 m_frames.push_back (unwind_frame_sp);
             }
             
+            if (!ModuleCanHaveInlinedFrames (unwind_frame_sp->GetFrameCodeAddress().GetModule()))
+                continue;
+
             SymbolContext unwind_sc = unwind_frame_sp->GetSymbolContext (eSymbolContextBlock | eSymbolContextFunction);
             Block *unwind_block = unwind_sc.block;
             if (unwind_block)
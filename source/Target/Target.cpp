@@ -87,7 +87,11 @@ Target::Target(Debugger &debugger, const ArchSpec &target_arch, const lldb::Plat
     m_stop_hooks (),
     m_stop_hook_next_id (0),
     m_valid (true),
-    m_suppress_stop_hooks (false)
+    m_suppress_stop_hooks (false),
+    m_disassembly_mutex (Mutex::eMutexTypeNormal),
+    m_disassembly_cache (),
+    m_user_expression_mutex (Mutex::eMutexTypeNormal),
+    m_user_expression_cache ()
 {
     SetEventName (eBroadcastBitBreakpointChanged, "breakpoint-changed");
     SetEventName (eBroadcastBitModulesLoaded, "modules-loaded");
@@ -154,6 +158,10 @@ Target::CleanupProcess ()
     this->GetWatchpointList().GetListMutex(locker);
     DisableAllWatchpoints(false);
     ClearAllWatchpointHitCounts();
+    // Code may be loaded somewhere else by the next process, and
+    // compiled expressions live in this one.
+    ClearDisassemblyCache();
+    ClearUserExpressionCache();
 }
 
 void
@@ -208,6 +216,8 @@ Target::Destroy()
     m_stop_hooks.clear();
     m_stop_hook_next_id = 0;
     m_suppress_stop_hooks = false;
+    ClearDisassemblyCache();
+    ClearUserExpressionCache();
 }
 
 
@@ -1184,6 +1194,10 @@ Target::ModulesDidLoad (ModuleList &module_list)
         {
             m_process_sp->ModulesDidLoad (module_list);
         }
+        // Names in expressions could now resolve differently.
+        ClearUserExpressionCache();
+        if (m_ast_importer_ap.get())
+            m_ast_importer_ap->ClearLookupCache();
         // TODO: make event data that packages up the module_list
         BroadcastEvent (eBroadcastBitModulesLoaded, NULL);
     }
@@ -1205,6 +1219,9 @@ Target::SymbolsDidLoad (ModuleList &module_list)
         }
         
         m_breakpoint_list.UpdateBreakpoints (module_list, true, false);
+        ClearUserExpressionCache();
+        if (m_ast_importer_ap.get())
+            m_ast_importer_ap->ClearLookupCache();
         BroadcastEvent(eBroadcastBitSymbolsLoaded, NULL);
     }
 }
@@ -1214,6 +1231,22 @@ Target::ModulesDidUnload (ModuleList &module_list, bool delete_locations)
 {
     if (m_valid && module_list.GetSize())
     {
+        // Unwind rows remembered for these modules may not apply if they
+        // get loaded again.
+        const size_t num_modules = module_list.GetSize();
+        for (size_t i = 0; i < num_modules; ++i)
+        {
+            ModuleSP module_sp (module_list.GetModuleAtIndex(i));
+            ObjectFile *objfile = module_sp ? module_sp->GetObjectFile() : NULL;
+            if (objfile)
+                objfile->GetUnwindTable().ClearUnwindRowCache();
+        }
+        ClearDisassemblyCache();
+        // Expressions may have been bound to code or types that are gone.
+        ClearUserExpressionCache();
+        if (m_ast_importer_ap.get())
+            m_ast_importer_ap->ClearLookupCache();
+
         m_breakpoint_list.UpdateBreakpoints (module_list, false, delete_locations);
         // TODO: make event data that packages up the module_list
         BroadcastEvent (eBroadcastBitModulesUnloaded, NULL);
@@ -1294,6 +1327,113 @@ Target::ReadMemoryFromFileCache (const Address& addr, void *dst, size_t dst_len,
     return 0;
 }
 
+DisassemblerSP
+Target::GetDisassemblyForRange (const AddressRange &range)
+{
+    const addr_t load_addr = range.GetBaseAddress().GetLoadAddress (this);
+    if (load_addr == LLDB_INVALID_ADDRESS || range.GetByteSize() == 0)
+        return DisassemblerSP();
+
+    const std::pair<addr_t, addr_t> key (load_addr, range.GetByteSize());
+    {
+        Mutex::Locker locker (m_disassembly_mutex);
+        DisassemblyCache::const_iterator pos = m_disassembly_cache.find (key);
+        if (pos != m_disassembly_cache.end())
+            return pos->second;
+    }
+
+    ExecutionContext exe_ctx (m_process_sp.get());
+    const char *plugin_name = NULL;
+    const char *flavor = NULL;
+    const bool prefer_file_cache = true;
+    DisassemblerSP disassembler_sp (Disassembler::DisassembleRange (GetArchitecture(),
+                                                                    plugin_name,
+                                                                    flavor,
+                                                                    exe_ctx,
+                                                                    range,
+                                                                    prefer_file_cache));
+    if (disassembler_sp)
+    {
+        Mutex::Locker locker (m_disassembly_mutex);
+        // Someone else may have beaten us to it, use theirs
+        std::pair<DisassemblyCache::iterator, bool> result = m_disassembly_cache.insert (std::make_pair (key, disassembler_sp));
+        if (!result.second)
+        {
+            disassembler_sp->GetInstructionList().Clear();
+            disassembler_sp = result.first->second;
+        }
+    }
+    return disassembler_sp;
+}
+
+void
+Target::ClearDisassemblyCache ()
+{
+    DisassemblyCache disassembly_cache;
+    {
+        Mutex::Locker locker (m_disassembly_mutex);
+        disassembly_cache.swap (m_disassembly_cache);
+    }
+    // FIXME: The DisassemblerLLVMC has a reference cycle and won't go away if it has any active instructions.
+    // Clear the lists so they go away nicely.
+    for (DisassemblyCache::value_type &entry : disassembly_cache)
+    {
+        if (entry.second)
+            entry.second->GetInstructionList().Clear();
+    }
+}
+
+ClangUserExpression::ClangUserExpressionSP
+Target::TakeCachedUserExpression (const std::string &key)
+{
+    ClangUserExpression::ClangUserExpressionSP expr_sp;
+    Mutex::Locker locker (m_user_expression_mutex);
+    for (UserExpressionCache::iterator pos = m_user_expression_cache.begin(); pos != m_user_expression_cache.end(); ++pos)
+    {
+        if (pos->first == key)
+        {
+            expr_sp = pos->second;
+            m_user_expression_cache.erase (pos);
+            break;
+        }
+    }
+    return expr_sp;
+}
+
+void
+Target::CacheUserExpression (const std::string &key, const ClangUserExpression::ClangUserExpressionSP &expr_sp)
+{
+    const uint32_t max_size = GetExpressionCacheSize();
+    if (!expr_sp || max_size == 0)
+        return;
+
+    // Let go of whatever doesn't fit outside the lock, expressions can
+    // remove their JIT modules from our images when they go away.
+    UserExpressionCache evicted;
+    {
+        Mutex::Locker locker (m_user_expression_mutex);
+        for (UserExpressionCache::const_iterator pos = m_user_expression_cache.begin(); pos != m_user_expression_cache.end(); ++pos)
+        {
+            // Someone else evaluated the same expression at the same time
+            if (pos->first == key)
+                return;
+        }
+        m_user_expression_cache.push_front (std::make_pair (key, expr_sp));
+        while (m_user_expression_cache.size() > max_size)
+            evicted.splice (evicted.end(), m_user_expression_cache, --m_user_expression_cache.end());
+    }
+}
+
+void
+Target::ClearUserExpressionCache ()
+{
+    UserExpressionCache user_expression_cache;
+    {
+        Mutex::Locker locker (m_user_expression_mutex);
+        user_expression_cache.swap (m_user_expression_cache);
+    }
+}
+
 size_t
 Target::ReadMemory (const Address& addr,
                     bool prefer_file_cache,
@@ -1571,7 +1711,7 @@ Target::ReadPointerFromMemory (const Address& addr,
 }
 
 ModuleSP
-Target::GetSharedModule (const ModuleSpec &module_spec, Error *error_ptr)
+Target::GetSharedModule (const ModuleSpec &module_spec, Error *error_ptr, bool notify)
 {
     ModuleSP module_sp;
 
@@ -1702,7 +1842,12 @@ Target::GetSharedModule (const ModuleSpec &module_spec, Error *error_ptr)
                     ModuleList::RemoveSharedModuleIfOrphaned (old_module_ptr);
                 }
                 else
-                    m_images.Append(module_sp);
+                {
+                    m_images.Append(module_sp, notify);
+                    // ModuleAdded() does this for the modules it hears about.
+                    if (!notify)
+                        LoadScriptingResourceForModule(module_sp, this);
+                }
             }
             else
                 module_sp.reset();
@@ -2668,6 +2813,8 @@ g_properties[] =
     { "use-hex-immediates"                 , OptionValue::eTypeBoolean   , false, true,                       NULL, NULL, "Show immediates in disassembly as hexadecimal." },
     { "hex-immediate-style"                , OptionValue::eTypeEnum   ,    false, Disassembler::eHexStyleC,   NULL, g_hex_immediate_style_values, "Which style to use for printing hexadecimal disassembly values." },
     { "use-fast-stepping"                  , OptionValue::eTypeBoolean   , false, true,                       NULL, NULL, "Use a fast stepping algorithm based on running from branch to branch rather than instruction single-stepping." },
+    { "expression-cache-size"              , OptionValue::eTypeUInt64    , false, 64,                         NULL, NULL, "The number of compiled expressions to keep so evaluating them again in the same context doesn't recompile them. Set to 0 to always recompile expressions." },
+    { "inject-breakpoint-conditions"       , OptionValue::eTypeBoolean   , false, false,                      NULL, NULL, "Compile breakpoint conditions that only read global variables into the process, so that breakpoint hits where the condition is false don't stop the process.  Hits filtered out in the process are added to the hit counts the next time it stops.  Only supported for x86_64 processes debugged with gdb-remote." },
     { "load-script-from-symbol-file"       , OptionValue::eTypeEnum   ,    false, eLoadScriptFromSymFileWarn, NULL, g_load_script_from_sym_file_values, "Allow LLDB to load scripting resources embedded in symbol files when available." },
     { "memory-module-load-level"           , OptionValue::eTypeEnum   ,    false, eMemoryModuleLoadLevelComplete, NULL, g_memory_module_load_level_values,
         "Loading modules from memory can be slow as reading the symbol tables and other data can take a long time depending on your connection to the debug target. "
@@ -2708,6 +2855,8 @@ enum
     ePropertyUseHexImmediates,
     ePropertyHexImmediateStyle,
     ePropertyUseFastStepping,
+    ePropertyExpressionCacheSize,
+    ePropertyInjectBreakpointConditions,
     ePropertyLoadScriptFromSymbolFile,
     ePropertyMemoryModuleLoadLevel,
     ePropertyDisplayExpressionsInCrashlogs,
@@ -3104,6 +3253,20 @@ TargetProperties::GetUseFastStepping () const
     return m_collection_sp->GetPropertyAtIndexAsBoolean (NULL, idx, g_properties[idx].default_uint_value != 0);
 }
 
+uint32_t
+TargetProperties::GetExpressionCacheSize () const
+{
+    const uint32_t idx = ePropertyExpressionCacheSize;
+    return (uint32_t)m_collection_sp->GetPropertyAtIndexAsUInt64 (NULL, idx, g_properties[idx].default_uint_value);
+}
+
+bool
+TargetProperties::GetInjectBreakpointConditions () const
+{
+    const uint32_t idx = ePropertyInjectBreakpointConditions;
+    return m_collection_sp->GetPropertyAtIndexAsBoolean (NULL, idx, g_properties[idx].default_uint_value != 0);
+}
+
 bool
 TargetProperties::GetDisplayExpressionsInCrashlogs () const
 {
@@ -13,18 +13,25 @@
 #include "lldb/Breakpoint/BreakpointLocation.h"
 #include "lldb/Core/Debugger.h"
 #include "lldb/Core/Log.h"
+#include "lldb/Core/Module.h"
 #include "lldb/Core/State.h"
 #include "lldb/Core/Stream.h"
 #include "lldb/Core/StreamString.h"
 #include "lldb/Core/RegularExpression.h"
 #include "lldb/Host/Host.h"
 #include "lldb/Interpreter/OptionValueFileSpecList.h"
+#include "lldb/Symbol/FuncUnwinders.h"
 #include "lldb/Symbol/Function.h"
+#include "lldb/Symbol/ObjectFile.h"
+#include "lldb/Symbol/UnwindPlan.h"
+#include "lldb/Symbol/UnwindTable.h"
+#include "lldb/Target/ABI.h"
 #include "lldb/Target/DynamicLoader.h"
 #include "lldb/Target/ExecutionContext.h"
 #include "lldb/Target/ObjCLanguageRuntime.h"
 #include "lldb/Target/Process.h"
 #include "lldb/Target/RegisterContext.h"
+#include "lldb/Target/SectionLoadList.h"
 #include "lldb/Target/StopInfo.h"
 #include "lldb/Target/SystemRuntime.h"
 #include "lldb/Target/Target.h"
@@ -1926,6 +1933,9 @@ Thread::DumpUsingSettingsFormat (Stream &strm, uint32_t frame_idx)
     if (process == NULL)
         return;
 
+    const char *thread_format = exe_ctx.GetTargetRef().GetDebugger().GetThreadFormat();
+    assert (thread_format);
+
     StackFrameSP frame_sp;
     SymbolContext frame_sc;
     if (frame_idx != LLDB_INVALID_INDEX32)
@@ -1934,12 +1944,11 @@ Thread::DumpUsingSettingsFormat (Stream &strm, uint32_t frame_idx)
         if (frame_sp)
         {
             exe_ctx.SetFrameSP(frame_sp);
-            frame_sc = frame_sp->GetSymbolContext(eSymbolContextEverything);
+            // Only look up what the format shows
+            frame_sc = frame_sp->GetSymbolContext(Debugger::GetSymbolContextScopeForFormat (thread_format));
         }
     }
 
-    const char *thread_format = exe_ctx.GetTargetRef().GetDebugger().GetThreadFormat();
-    assert (thread_format);
     Debugger::FormatPrompt (thread_format, 
                             frame_sp ? &frame_sc : NULL,
                             &exe_ctx, 
@@ -2207,6 +2216,235 @@ Thread::GetUnwinder ()
     return m_unwinder_ap.get();
 }
 
+//------------------------------------------------------------------
+// Whether "load_addr" is in the code of a loaded module.
+//------------------------------------------------------------------
+static bool
+IsCodeAddress (Target &target, addr_t load_addr)
+{
+    Address so_addr;
+    if (load_addr == LLDB_INVALID_ADDRESS || !target.GetSectionLoadList().ResolveLoadAddress (load_addr, so_addr))
+        return false;
+    return so_addr.GetAddressClass() == eAddressClassCode;
+}
+
+//------------------------------------------------------------------
+// Ask the eh_frame of the function at "pc" whether frame zero's CFA is
+// based on the stack pointer there, in which case the function hasn't
+// set up its frame record yet, has torn it down already or never makes
+// one.  If so, return true with "return_addr" set to frame zero's return
+// address, or to LLDB_INVALID_ADDRESS if it can't be found.  The
+// FuncUnwinders and its eh_frame plan are made once per function and
+// kept by the module's UnwindTable, so no assembly is profiled here.
+//------------------------------------------------------------------
+static bool
+FrameZeroHasNoRecord (Process &process, RegisterContext &reg_ctx, addr_t pc, addr_t sp, addr_t &return_addr)
+{
+    return_addr = LLDB_INVALID_ADDRESS;
+
+    Address pc_addr;
+    if (!process.GetTarget().GetSectionLoadList().ResolveLoadAddress (pc, pc_addr))
+        return false;
+    ModuleSP module_sp (pc_addr.GetModule());
+    ObjectFile *objfile = module_sp ? module_sp->GetObjectFile() : NULL;
+    if (objfile == NULL)
+        return false;
+
+    SymbolContext sc;
+    FuncUnwindersSP func_unwinders_sp (objfile->GetUnwindTable().GetFuncUnwindersContainingAddress (pc_addr, sc));
+    if (!func_unwinders_sp)
+        return false;
+    const int offset = (int)(pc_addr.GetFileAddress() - func_unwinders_sp->GetFunctionStartAddress().GetFileAddress());
+    UnwindPlanSP plan_sp (func_unwinders_sp->GetUnwindPlanAtCallSite (offset));
+    if (!plan_sp || !plan_sp->PlanValidAtAddress (pc_addr))
+        return false;
+    UnwindPlan::RowSP row_sp (plan_sp->GetRowForFunctionOffset (offset));
+    if (!row_sp)
+        return false;
+
+    const RegisterKind kind = plan_sp->GetRegisterKind();
+    uint32_t sp_regnum;
+    if (!reg_ctx.ConvertBetweenRegisterKinds (eRegisterKindGeneric, LLDB_REGNUM_GENERIC_SP, kind, sp_regnum) ||
+        row_sp->GetCFARegister() != sp_regnum)
+        return false;
+
+    // The return address is saved relative to the CFA, or is still in its
+    // register (the link register of a leaf function on arm64).
+    uint32_t ra_regnum;
+    if (!reg_ctx.ConvertBetweenRegisterKinds (eRegisterKindGeneric, LLDB_REGNUM_GENERIC_RA, kind, ra_regnum) &&
+        !reg_ctx.ConvertBetweenRegisterKinds (eRegisterKindGeneric, LLDB_REGNUM_GENERIC_PC, kind, ra_regnum))
+        return true;
+
+    UnwindPlan::Row::RegisterLocation regloc;
+    if (row_sp->GetRegisterInfo (ra_regnum, regloc))
+    {
+        if (regloc.IsAtCFAPlusOffset())
+        {
+            Error error;
+            const addr_t cfa = sp + row_sp->GetCFAOffset();
+            const addr_t value = process.ReadPointerFromMemory (cfa + regloc.GetOffset(), error);
+            if (error.Success())
+                return_addr = value;
+        }
+    }
+    else
+    {
+        const uint32_t ra_native = reg_ctx.ConvertRegisterKindToRegisterNumber (eRegisterKindGeneric, LLDB_REGNUM_GENERIC_RA);
+        if (ra_native != LLDB_INVALID_REGNUM)
+            return_addr = reg_ctx.ReadRegisterAsUnsigned (ra_native, LLDB_INVALID_ADDRESS);
+    }
+    return true;
+}
+
+size_t
+Thread::GetRawBacktrace (std::vector<addr_t> &pcs, uint32_t max_frames)
+{
+    pcs.clear();
+    if (max_frames == 0)
+        return 0;
+
+    ProcessSP process_sp (GetProcess());
+    RegisterContextSP reg_ctx_sp (GetRegisterContext());
+    if (!process_sp || !reg_ctx_sp)
+        return 0;
+
+    const addr_t pc = reg_ctx_sp->GetPC (LLDB_INVALID_ADDRESS);
+    if (pc == LLDB_INVALID_ADDRESS)
+        return 0;
+    pcs.push_back (pc);
+
+    // Frame records of these architectures are a saved frame pointer
+    // followed by the return address, with the frame pointer register
+    // pointing at the record.
+    bool follow_frame_pointers = false;
+    switch (process_sp->GetTarget().GetArchitecture().GetMachine())
+    {
+        case llvm::Triple::x86:
+        case llvm::Triple::x86_64:
+        case llvm::Triple::aarch64:
+            follow_frame_pointers = true;
+            break;
+        default:
+            break;
+    }
+
+    ABISP abi_sp (process_sp->GetABI());
+    const uint32_t addr_byte_size = process_sp->GetAddressByteSize();
+    const addr_t sp = reg_ctx_sp->GetSP (LLDB_INVALID_ADDRESS);
+    addr_t fp = reg_ctx_sp->GetFP (LLDB_INVALID_ADDRESS);
+
+    // The frame pointer must point into the stack above the stack
+    // pointer, otherwise it hasn't been set up in frame zero.
+    bool chain_broken = !follow_frame_pointers || addr_byte_size == 0 ||
+                        sp == LLDB_INVALID_ADDRESS || fp == LLDB_INVALID_ADDRESS || fp < sp;
+
+    // Frame zero may be a leaf that never sets up a frame record, or be
+    // stopped in its prologue or epilogue, in which case the frame pointer
+    // still points at its caller's record and following it would skip the
+    // caller.  Running the unwinder on the first frames to find out would
+    // cost more than the rest of the walk, so only check what is cheap:
+    // the record has to be in the stack not far above sp and hold a return
+    // address in code, and eh_frame, where frame zero's function has it,
+    // decides whether the record is frame zero's or its caller's.
+    static const addr_t g_max_frame_record_distance = 64 * 1024 * 1024;
+    Unwind *unwinder = GetUnwinder();
+    if (!chain_broken)
+    {
+        Target &target = process_sp->GetTarget();
+        Error error;
+        if (fp - sp > g_max_frame_record_distance || (fp % addr_byte_size) != 0 ||
+            !IsCodeAddress (target, process_sp->ReadPointerFromMemory (fp + addr_byte_size, error)) || error.Fail())
+        {
+            chain_broken = true;
+        }
+        else
+        {
+            addr_t return_addr;
+            if (FrameZeroHasNoRecord (*process_sp, *reg_ctx_sp, pc, sp, return_addr))
+            {
+                if (!IsCodeAddress (target, return_addr))
+                    chain_broken = true;
+                else if (pcs.size() < max_frames)
+                    pcs.push_back (return_addr);
+            }
+        }
+    }
+
+    if (!chain_broken)
+    {
+        // Read the stack in big chunks, the frame records are then read
+        // from the memory cache.
+        const uint64_t prefetch_size = std::max<uint64_t> (process_sp->GetUnwindStackPrefetchSize(), 4096);
+        Error error;
+        addr_t prefetch_end = sp + process_sp->PrefetchMemory (sp, prefetch_size, error);
+
+        while (pcs.size() < max_frames)
+        {
+            if (fp + 2 * addr_byte_size > prefetch_end)
+                prefetch_end = fp + process_sp->PrefetchMemory (fp, prefetch_size, error);
+
+            const addr_t caller_fp = process_sp->ReadPointerFromMemory (fp, error);
+            if (error.Fail())
+            {
+                chain_broken = true;
+                break;
+            }
+            const addr_t return_addr = process_sp->ReadPointerFromMemory (fp + addr_byte_size, error);
+            if (error.Fail())
+            {
+                chain_broken = true;
+                break;
+            }
+
+            // A zero return address or frame pointer is the normal end of
+            // the chain.
+            if (return_addr == 0)
+                break;
+            if (abi_sp && !abi_sp->CodeAddressIsValid (return_addr))
+            {
+                chain_broken = true;
+                break;
+            }
+            pcs.push_back (return_addr);
+
+            if (caller_fp == 0)
+                break;
+            // The stack grows down, so callers' records are always higher
+            // up and aligned.
+            if (caller_fp <= fp || (caller_fp % addr_byte_size) != 0)
+            {
+                chain_broken = true;
+                break;
+            }
+            fp = caller_fp;
+        }
+    }
+
+    if (chain_broken && unwinder)
+    {
+        // Let the real unwinder do the whole stack. The frames found by
+        // following the chain don't tell which unwinder frame to carry on
+        // from: a frame without a record is skipped by the chain but not
+        // by the unwinder.
+        Log *log (lldb_private::GetLogIfAllCategoriesSet (LIBLLDB_LOG_UNWIND));
+        if (log)
+            log->Printf ("Thread::GetRawBacktrace th%u frame pointer chain broken at frame %" PRIu64 ", using the unwinder",
+                         GetIndexID(), (uint64_t)pcs.size());
+
+        pcs.resize (1);
+        for (uint32_t idx = 1; idx < max_frames; ++idx)
+        {
+            addr_t cfa;
+            addr_t frame_pc;
+            if (!unwinder->GetFrameInfoAtIndex (idx, cfa, frame_pc))
+                break;
+            pcs.push_back (frame_pc);
+        }
+    }
+
+    return pcs.size();
+}
+
 
 void
 Thread::Flush ()
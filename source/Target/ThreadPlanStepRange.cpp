@@ -18,7 +18,9 @@
 #include "lldb/Breakpoint/BreakpointLocation.h"
 #include "lldb/Breakpoint/BreakpointSite.h"
 #include "lldb/Core/Disassembler.h"
+#include "lldb/Core/EmulateInstruction.h"
 #include "lldb/Core/Log.h"
+#include "lldb/Core/RegisterValue.h"
 #include "lldb/Core/Stream.h"
 #include "lldb/Symbol/Function.h"
 #include "lldb/Symbol/Symbol.h"
@@ -53,7 +55,9 @@ ThreadPlanStepRange::ThreadPlanStepRange (ThreadPlanKind kind,
     m_parent_stack_id(),
     m_no_more_plans (false),
     m_first_run_event (true),
-    m_use_fast_step(false)
+    m_use_fast_step(false),
+    m_emulator_ap (),
+    m_tried_emulator (false)
 {
     m_use_fast_step = GetTarget().GetUseFastStepping();
     AddRange(range);
@@ -66,16 +70,8 @@ ThreadPlanStepRange::ThreadPlanStepRange (ThreadPlanKind kind,
 ThreadPlanStepRange::~ThreadPlanStepRange ()
 {
     ClearNextBranchBreakpoint();
-    
-    size_t num_instruction_ranges = m_instruction_ranges.size();
-    
-    // FIXME: The DisassemblerLLVMC has a reference cycle and won't go away if it has any active instructions.
-    // I'll fix that but for now, just clear the list and it will go away nicely.
-    for (size_t i = 0; i < num_instruction_ranges; i++)
-    {
-        if (m_instruction_ranges[i])
-            m_instruction_ranges[i]->GetInstructionList().Clear();
-    }
+    // The instruction lists belong to the target's disassembly cache, which
+    // clears them when it lets them go.
 }
 
 void
@@ -312,18 +308,9 @@ ThreadPlanStepRange::GetInstructionsForAddress(lldb::addr_t addr, size_t &range_
 
             if (!m_instruction_ranges[i])
             {
-                //Disassemble the address range given:
-                ExecutionContext exe_ctx (m_thread.GetProcess());
-                const char *plugin_name = NULL;
-                const char *flavor = NULL;
-                const bool prefer_file_cache = true;
-                m_instruction_ranges[i] = Disassembler::DisassembleRange(GetTarget().GetArchitecture(),
-                                                                         plugin_name,
-                                                                         flavor,
-                                                                         exe_ctx,
-                                                                         m_address_ranges[i],
-                                                                         prefer_file_cache);
-                
+                // Disassemble the address range given, or reuse the disassembly from an earlier
+                // step through the same code:
+                m_instruction_ranges[i] = GetTarget().GetDisassemblyForRange (m_address_ranges[i]);
             }
             if (!m_instruction_ranges[i])
                 return NULL;
@@ -383,6 +370,32 @@ ThreadPlanStepRange::SetNextBranchBreakpoint ()
         uint32_t branch_index;
         branch_index = instructions->GetIndexOfNextBranchInstruction (pc_index);
         
+        // If we are sitting on a branch, find out where it is going to go.  If that's still in our
+        // ranges we can run from there to the next branch, rather than single stepping over this one.
+        bool run_past_branch = false;
+        if (branch_index == pc_index)
+        {
+            lldb::addr_t next_pc = LLDB_INVALID_ADDRESS;
+            InstructionSP branch_insn_sp (instructions->GetInstructionAtIndex (pc_index));
+            if (!branch_insn_sp || !EmulateBranchAtPC (*branch_insn_sp, next_pc))
+                return false;
+            
+            size_t next_pc_index;
+            size_t next_range_index;
+            InstructionList *next_instructions = GetInstructionsForAddress (next_pc, next_range_index, next_pc_index);
+            if (next_instructions == NULL)
+                return false;
+            
+            if (log)
+                log->Printf ("ThreadPlanStepRange::SetNextBranchBreakpoint - Branch at 0x%" PRIx64 " will go to 0x%" PRIx64 ".",
+                             cur_addr,
+                             next_pc);
+            instructions = next_instructions;
+            pc_index = next_pc_index;
+            branch_index = instructions->GetIndexOfNextBranchInstruction (pc_index);
+            run_past_branch = true;
+        }
+        
         Address run_to_address;
         
         // If we didn't find a branch, run to the end of the range.
@@ -391,7 +404,15 @@ ThreadPlanStepRange::SetNextBranchBreakpoint ()
             branch_index = instructions->GetSize() - 1;
         }
         
-        if (branch_index - pc_index > 1)
+        // When running past a branch anywhere other than back to where we are will do, since
+        // the branch itself has to execute before we get there.
+        bool use_breakpoint;
+        if (run_past_branch)
+            use_breakpoint = instructions->GetInstructionAtIndex(branch_index)->GetAddress().GetLoadAddress(&GetTarget()) != cur_addr;
+        else
+            use_breakpoint = branch_index - pc_index > 1;
+        
+        if (use_breakpoint)
         {
             const bool is_internal = true;
             run_to_address = instructions->GetInstructionAtIndex(branch_index)->GetAddress();
@@ -426,6 +447,125 @@ ThreadPlanStepRange::SetNextBranchBreakpoint ()
     return false;
 }
 
+namespace {
+    struct BranchEmulationBaton
+    {
+        RegisterContext *reg_ctx;
+        Process *process;
+        uint32_t pc_reg_num;
+        bool wrote_pc;
+        lldb::addr_t next_pc;
+    };
+}
+
+static size_t
+BranchEmulationReadMemory (EmulateInstruction *instruction,
+                           void *baton,
+                           const EmulateInstruction::Context &context,
+                           lldb::addr_t addr,
+                           void *dst,
+                           size_t length)
+{
+    BranchEmulationBaton *branch_baton = (BranchEmulationBaton *) baton;
+    Error error;
+    return branch_baton->process->ReadMemory (addr, dst, length, error);
+}
+
+static size_t
+BranchEmulationWriteMemory (EmulateInstruction *instruction,
+                            void *baton,
+                            const EmulateInstruction::Context &context,
+                            lldb::addr_t addr,
+                            const void *src,
+                            size_t length)
+{
+    // The thread is going to execute the instruction for real, don't touch its memory.
+    return length;
+}
+
+static bool
+BranchEmulationReadRegister (EmulateInstruction *instruction,
+                             void *baton,
+                             const RegisterInfo *reg_info,
+                             RegisterValue &reg_value)
+{
+    BranchEmulationBaton *branch_baton = (BranchEmulationBaton *) baton;
+    const uint32_t reg_num = EmulateInstruction::GetInternalRegisterNumber (branch_baton->reg_ctx, *reg_info);
+    if (reg_num == LLDB_INVALID_REGNUM)
+        return false;
+    const RegisterInfo *thread_reg_info = branch_baton->reg_ctx->GetRegisterInfoAtIndex (reg_num);
+    if (thread_reg_info == NULL)
+        return false;
+    return branch_baton->reg_ctx->ReadRegister (thread_reg_info, reg_value);
+}
+
+static bool
+BranchEmulationWriteRegister (EmulateInstruction *instruction,
+                              void *baton,
+                              const EmulateInstruction::Context &context,
+                              const RegisterInfo *reg_info,
+                              const RegisterValue &reg_value)
+{
+    // Only note where the pc is going, the registers are left alone like memory is.
+    BranchEmulationBaton *branch_baton = (BranchEmulationBaton *) baton;
+    const uint32_t reg_num = EmulateInstruction::GetInternalRegisterNumber (branch_baton->reg_ctx, *reg_info);
+    if (reg_num != LLDB_INVALID_REGNUM && reg_num == branch_baton->pc_reg_num)
+    {
+        branch_baton->wrote_pc = true;
+        branch_baton->next_pc = reg_value.GetAsUInt64 (LLDB_INVALID_ADDRESS);
+    }
+    return true;
+}
+
+bool
+ThreadPlanStepRange::EmulateBranchAtPC (Instruction &branch_insn, lldb::addr_t &next_pc)
+{
+    if (!m_tried_emulator)
+    {
+        m_tried_emulator = true;
+        m_emulator_ap.reset (EmulateInstruction::FindPlugin (GetTarget().GetArchitecture(), eInstructionTypePCModifying, NULL));
+    }
+    if (!m_emulator_ap)
+        return false;
+
+    RegisterContextSP reg_ctx_sp (m_thread.GetRegisterContext());
+    ProcessSP process_sp (m_thread.GetProcess());
+    if (!reg_ctx_sp || !process_sp)
+        return false;
+
+    BranchEmulationBaton baton;
+    baton.reg_ctx = reg_ctx_sp.get();
+    baton.process = process_sp.get();
+    baton.pc_reg_num = reg_ctx_sp->ConvertRegisterKindToRegisterNumber (eRegisterKindGeneric, LLDB_REGNUM_GENERIC_PC);
+    baton.wrote_pc = false;
+    baton.next_pc = LLDB_INVALID_ADDRESS;
+    if (baton.pc_reg_num == LLDB_INVALID_REGNUM)
+        return false;
+
+    m_emulator_ap->SetBaton (&baton);
+    m_emulator_ap->SetCallbacks (BranchEmulationReadMemory,
+                                 BranchEmulationWriteMemory,
+                                 BranchEmulationReadRegister,
+                                 BranchEmulationWriteRegister);
+    if (!m_emulator_ap->SetInstruction (branch_insn.GetOpcode(), branch_insn.GetAddress(), &GetTarget()))
+        return false;
+    if (!m_emulator_ap->EvaluateInstruction (eEmulateInstructionOptionNone))
+        return false;
+
+    if (baton.wrote_pc)
+    {
+        if (baton.next_pc == LLDB_INVALID_ADDRESS)
+            return false;
+        next_pc = GetTarget().GetOpcodeLoadAddress (baton.next_pc);
+    }
+    else
+    {
+        // A conditional branch that isn't taken falls through
+        next_pc = branch_insn.GetAddress().GetLoadAddress (&GetTarget()) + branch_insn.GetOpcode().GetByteSize();
+    }
+    return true;
+}
+
 bool
 ThreadPlanStepRange::NextRangeBreakpointExplainsStop (lldb::StopInfoSP stop_info_sp)
 {
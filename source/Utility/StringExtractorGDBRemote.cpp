@@ -91,6 +91,7 @@ StringExtractorGDBRemote::GetServerPacketType () const
         case 'S':
             if (PACKET_MATCHES ("QStartNoAckMode"))               return eServerPacketType_QStartNoAckMode;
             if (PACKET_STARTS_WITH ("QSaveRegisterState"))        return eServerPacketType_QSaveRegisterState;
+            if (PACKET_STARTS_WITH ("QSetBreakpoints:"))          return eServerPacketType_QSetBreakpoints;
             if (PACKET_STARTS_WITH ("QSetDisableASLR:"))          return eServerPacketType_QSetDisableASLR;
             if (PACKET_STARTS_WITH ("QSetDetachOnError:"))        return eServerPacketType_QSetDetachOnError;
             if (PACKET_STARTS_WITH ("QSetSTDIN:"))                return eServerPacketType_QSetSTDIN;
@@ -110,6 +111,7 @@ StringExtractorGDBRemote::GetServerPacketType () const
             break;
 
         case 'R':
+            if (PACKET_STARTS_WITH ("QRemoveBreakpoints:"))       return eServerPacketType_QRemoveBreakpoints;
             if (PACKET_STARTS_WITH ("QRestoreRegisterState:"))    return eServerPacketType_QRestoreRegisterState;
             break;
 
@@ -160,6 +162,7 @@ StringExtractorGDBRemote::GetServerPacketType () const
         case 'M':
             if (PACKET_STARTS_WITH ("qMemoryRegionInfo:"))      return eServerPacketType_qMemoryRegionInfo;
             if (PACKET_MATCHES ("qMemoryRegionInfo"))           return eServerPacketType_qMemoryRegionInfoSupported;
+            if (PACKET_STARTS_WITH ("qMemoryRegions:"))         return eServerPacketType_qMemoryRegions;
             break;
 
         case 'P':
@@ -85,8 +85,10 @@ public:
       // debug server packages
         eServerPacketType_QEnvironmentHexEncoded,
         eServerPacketType_QListThreadsInStopReply,
+        eServerPacketType_QRemoveBreakpoints,
         eServerPacketType_QRestoreRegisterState,
         eServerPacketType_QSaveRegisterState,
+        eServerPacketType_QSetBreakpoints,
         eServerPacketType_QSetLogging,
         eServerPacketType_QSetMaxPacketSize,
         eServerPacketType_QSetMaxPayloadSize,
@@ -101,6 +103,7 @@ public:
         eServerPacketType_qGDBServerVersion,
         eServerPacketType_qMemoryRegionInfo,
         eServerPacketType_qMemoryRegionInfoSupported,
+        eServerPacketType_qMemoryRegions,
         eServerPacketType_qProcessInfo,
         eServerPacketType_qRcmd,
         eServerPacketType_qRegisterInfo,
@@ -0,0 +1,107 @@
+"""Test how many hits per second a conditional breakpoint in a hot loop can filter."""
+
+import os, sys
+import unittest2
+import lldb
+from lldbbench import *
+
+class ConditionalBreakpointHitRateCase(BenchBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    def setUp(self):
+        BenchBase.setUp(self)
+        # The default self.stopwatch is for conditions the debugger
+        # evaluates on every hit.  Create self.stopwatch2 for conditions
+        # injected into the process.
+        self.stopwatch2 = Stopwatch()
+        self.source = 'main.c'
+        self.line_to_start = line_number(self.source, '// Stop here first.')
+        self.line_to_break = line_number(self.source, '// Set breakpoint here.')
+        self.count = lldb.bmIterationCount
+        if self.count <= 0:
+            self.count = 2000
+
+    @benchmarks_test
+    def test_conditional_breakpoint_hit_rate(self):
+        """Test the hit rate of a rarely true breakpoint condition, with and without injection."""
+        self.buildDefault()
+        self.exe_name = 'a.out'
+
+        print
+        self.run_lldb_conditional_breakpoint(self.exe_name, self.count, False, self.stopwatch)
+        print "lldb evaluated condition benchmark:", self.stopwatch
+        print "hits/sec: %f" % (self.count / self.stopwatch.avg())
+        self.run_lldb_conditional_breakpoint(self.exe_name, self.count, True, self.stopwatch2)
+        print "lldb injected condition benchmark:", self.stopwatch2
+        print "hits/sec: %f" % (self.count / self.stopwatch2.avg())
+
+    def run_lldb_conditional_breakpoint(self, exe_name, count, inject, stopwatch):
+        import pexpect
+        exe = os.path.join(os.getcwd(), exe_name)
+
+        # Set self.child_prompt, which is "(lldb) ".
+        self.child_prompt = '(lldb) '
+        prompt = self.child_prompt
+
+        # So that the child gets torn down after the test.
+        self.child = pexpect.spawn('%s %s %s' % (self.lldbHere, self.lldbOption, exe))
+        child = self.child
+
+        # Turn on logging for what the child sends back.
+        if self.TraceOn():
+            child.logfile_read = sys.stdout
+
+        child.expect_exact(prompt)
+        child.sendline('settings set target.inject-breakpoint-conditions %s' % ('true' if inject else 'false'))
+        child.expect_exact(prompt)
+        log_file = os.path.join(os.getcwd(), 'conditional-breakpoint.log')
+        if os.path.exists(log_file):
+            os.remove(log_file)
+        child.sendline('log enable -f %s lldb break' % log_file)
+        child.expect_exact(prompt)
+        child.sendline('breakpoint set -f %s -l %d' % (self.source, self.line_to_start))
+        child.expect_exact(prompt)
+        child.sendline('run')
+        child.expect_exact(prompt)
+
+        # g_hits counts the iterations, so the condition is false for the
+        # first count hits and the debugger only stops after the last.
+        child.sendline("breakpoint set -f %s -l %d -c 'g_hits == %d'" % (self.source, self.line_to_break, count))
+        child.expect_exact(prompt)
+
+        # Reset the stopwatch now.
+        stopwatch.reset()
+        with stopwatch:
+            child.sendline('continue')
+            child.expect_exact(prompt, timeout=600)
+
+        child.sendline('expr g_hits')
+        child.expect_exact('= %d' % count)
+        child.expect_exact(prompt)
+
+        # Make sure the injected run measured what it claims to, and that
+        # the hits the process filtered out were still counted.
+        child.sendline('breakpoint list 2')
+        child.expect_exact('hit count = %d' % (count + 1))
+        child.expect_exact(prompt)
+        with open(log_file, 'r') as f:
+            injected = 'was injected' in f.read()
+        self.assertEqual(injected, inject, "the condition is injected only when target.inject-breakpoint-conditions is true")
+
+        child.sendline('quit')
+        try:
+            self.child.expect(pexpect.EOF)
+        except:
+            pass
+
+        # The test is about to end and if we come to here, the child process has
+        # been terminated.  Mark it so.
+        self.child = None
+
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
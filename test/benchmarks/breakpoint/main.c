@@ -0,0 +1,30 @@
+//===-- main.c --------------------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <stdio.h>
+
+int g_hits = 0;
+
+int
+main (int argc, char const *argv[])
+{
+    int i;
+    int step;
+
+    printf ("Starting the hot loop.\n"); // Stop here first.
+    for (i = 0; i < 100000000; ++i)
+    {
+        // The first instruction of this line stores a constant to the
+        // stack, which is long enough to be replaced by a jump and doesn't
+        // depend on where it runs.
+        step = 1; // Set breakpoint here.
+        g_hits += step;
+    }
+    printf ("Hits: %d\n", g_hits);
+    return 0;
+}
@@ -0,0 +1,91 @@
+"""Test how many times a second lldb evaluates the same expression, with and without the compiled expression cache."""
+
+import os, sys
+import unittest2
+import lldb
+from lldbbench import *
+
+class CachedExprsCase(BenchBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    def setUp(self):
+        BenchBase.setUp(self)
+        # The default self.stopwatch is for evaluating with the compiled
+        # expression cache, which only compiles the expression once.
+        # Create self.stopwatch2 for evaluating with the cache turned off,
+        # which compiles it every time.
+        self.stopwatch2 = Stopwatch()
+        self.source = 'main.cpp'
+        self.line_to_break = line_number(self.source, '// Set breakpoint here.')
+        self.count = lldb.bmIterationCount
+        if self.count <= 0:
+            self.count = 100
+
+    @benchmarks_test
+    def test_cached_exprs(self):
+        """Test evaluating a hot expression with and without the expression cache."""
+        self.buildDefault()
+        self.exe_name = 'a.out'
+
+        print
+        self.run_lldb_cached_exprs(self.exe_name, self.count)
+        print "lldb cached expression benchmark:", self.stopwatch
+        print "lldb uncached expression benchmark:", self.stopwatch2
+        print "evaluations/sec cached: %f, uncached: %f" % (1.0/self.stopwatch.avg(), 1.0/self.stopwatch2.avg())
+
+    def run_lldb_cached_exprs(self, exe_name, count):
+        import pexpect
+        exe = os.path.join(os.getcwd(), exe_name)
+
+        # Set self.child_prompt, which is "(lldb) ".
+        self.child_prompt = '(lldb) '
+        prompt = self.child_prompt
+
+        # So that the child gets torn down after the test.
+        self.child = pexpect.spawn('%s %s %s' % (self.lldbHere, self.lldbOption, exe))
+        child = self.child
+
+        # Turn on logging for what the child sends back.
+        if self.TraceOn():
+            child.logfile_read = sys.stdout
+
+        child.expect_exact(prompt)
+        child.sendline('breakpoint set -f %s -l %d' % (self.source, self.line_to_break))
+        child.expect_exact(prompt)
+        child.sendline('run')
+        child.expect_exact(prompt)
+        expr_cmd = 'expr ptr[j]->point.x + ptr[j]->point.y'
+
+        # Reset the stopwatches now.
+        self.stopwatch.reset()
+        self.stopwatch2.reset()
+        for cache_size, stopwatch in [(64, self.stopwatch), (0, self.stopwatch2)]:
+            child.sendline('settings set target.expression-cache-size %d' % cache_size)
+            child.expect_exact(prompt)
+            for i in range(count):
+                with stopwatch:
+                    child.sendline(expr_cmd)
+                    child.expect_exact(prompt)
+                # Every few evaluations move on to the next stop, which is
+                # in the same scope but has different values.
+                if i % 10 == 9:
+                    child.sendline('process continue')
+                    child.expect_exact(prompt)
+
+        child.sendline('quit')
+        try:
+            self.child.expect(pexpect.EOF)
+        except:
+            pass
+
+        # The test is about to end and if we come to here, the child process has
+        # been terminated.  Mark it so.
+        self.child = None
+
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
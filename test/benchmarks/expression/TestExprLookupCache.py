@@ -0,0 +1,110 @@
+"""Count the module lookups the expression parser avoids by caching name lookups across expressions."""
+
+import os, sys
+import unittest2
+import lldb
+from lldbbench import *
+
+class ExprLookupCacheCase(BenchBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    def setUp(self):
+        BenchBase.setUp(self)
+        self.source = 'main.cpp'
+        self.line_to_break = line_number(self.source, '// Set breakpoint here.')
+        self.count = lldb.bmIterationCount
+        if self.count <= 0:
+            self.count = 50
+
+    @benchmarks_test
+    def test_expr_lookup_cache(self):
+        """Test how many module lookups an expression-heavy session avoids."""
+        self.buildDefault()
+        self.exe_name = 'a.out'
+
+        print
+        self.run_lldb_expr_workload(self.exe_name, self.count)
+        print "lldb expression workload benchmark:", self.stopwatch
+        print "module lookups avoided: %d, performed: %d" % (self.lookups_avoided, self.lookups_performed)
+
+    def run_lldb_expr_workload(self, exe_name, count):
+        import pexpect
+        exe = os.path.join(os.getcwd(), exe_name)
+        log_file = os.path.join(os.getcwd(), 'expr-lookups.log')
+        if os.path.exists(log_file):
+            os.remove(log_file)
+
+        # Set self.child_prompt, which is "(lldb) ".
+        self.child_prompt = '(lldb) '
+        prompt = self.child_prompt
+
+        # So that the child gets torn down after the test.
+        self.child = pexpect.spawn('%s %s %s' % (self.lldbHere, self.lldbOption, exe))
+        child = self.child
+
+        # Turn on logging for what the child sends back.
+        if self.TraceOn():
+            child.logfile_read = sys.stdout
+
+        child.expect_exact(prompt)
+        child.sendline('breakpoint set -f %s -l %d' % (self.source, self.line_to_break))
+        child.expect_exact(prompt)
+        child.sendline('run')
+        child.expect_exact(prompt)
+
+        # The expressions name the same types over and over, but each one
+        # has different text so that none of them comes out of the compiled
+        # expression cache and every one goes through the parser.
+        exprs = ['expr ptr[%d]->point.x',
+                 'expr (Point *)&ptr[%d]->point',
+                 'expr sizeof(Data) + %d',
+                 'expr ((Data *)ptr[%d])->id']
+
+        # Reset the stopwatch now.
+        self.stopwatch.reset()
+        for i in range(count):
+            for expr in exprs:
+                with self.stopwatch:
+                    child.sendline(expr % i)
+                    child.expect_exact(prompt)
+
+        # The parser dumps its counters to the expression log; the global
+        # ones cover the whole session.
+        child.sendline('log enable -f %s lldb expr' % log_file)
+        child.expect_exact(prompt)
+        child.sendline(exprs[0] % count)
+        child.expect_exact(prompt)
+        child.sendline('log disable lldb expr')
+        child.expect_exact(prompt)
+
+        child.sendline('quit')
+        try:
+            self.child.expect(pexpect.EOF)
+        except:
+            pass
+
+        # The test is about to end and if we come to here, the child process has
+        # been terminated.  Mark it so.
+        self.child = None
+
+        self.lookups_avoided = 0
+        self.lookups_performed = 0
+        in_global_metrics = False
+        with open(log_file, 'r') as f:
+            for line in f:
+                if '-- Global metrics --' in line:
+                    in_global_metrics = True
+                elif '-- Local metrics --' in line:
+                    in_global_metrics = False
+                elif in_global_metrics and 'module lookups avoided' in line:
+                    self.lookups_avoided = int(line.split(':')[-1])
+                elif in_global_metrics and 'module lookups performed' in line:
+                    self.lookups_performed = int(line.split(':')[-1])
+
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
@@ -0,0 +1,111 @@
+"""Count the gdb-remote packets lldb sends per expression evaluation."""
+
+import os, sys
+import unittest2
+import lldb
+from lldbbench import *
+
+class ExprPacketCountCase(BenchBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    def setUp(self):
+        BenchBase.setUp(self)
+        self.source = 'main.cpp'
+        self.line_to_break = line_number(self.source, '// Set breakpoint here.')
+        self.count = lldb.bmIterationCount
+        if self.count <= 0:
+            self.count = 50
+
+    @benchmarks_test
+    def test_expr_packet_count(self):
+        """Test the number of packets, memory writes and allocations per evaluation."""
+        self.buildDefault()
+        self.exe_name = 'a.out'
+
+        print
+        self.run_lldb_expr_packet_count(self.exe_name, self.count)
+        print "lldb expression evaluation benchmark:", self.stopwatch
+        print "packets/evaluation: %f" % (float(self.packets) / self.count)
+        print "memory writes/evaluation: %f" % (float(self.writes) / self.count)
+        print "memory reads/evaluation: %f" % (float(self.reads) / self.count)
+        print "allocations/evaluation: %f" % (float(self.allocations) / self.count)
+
+    def run_lldb_expr_packet_count(self, exe_name, count):
+        import pexpect
+        exe = os.path.join(os.getcwd(), exe_name)
+        log_file = os.path.join(os.getcwd(), 'expr-packets.log')
+        if os.path.exists(log_file):
+            os.remove(log_file)
+
+        # Set self.child_prompt, which is "(lldb) ".
+        self.child_prompt = '(lldb) '
+        prompt = self.child_prompt
+
+        # So that the child gets torn down after the test.
+        self.child = pexpect.spawn('%s %s %s' % (self.lldbHere, self.lldbOption, exe))
+        child = self.child
+
+        # Turn on logging for what the child sends back.
+        if self.TraceOn():
+            child.logfile_read = sys.stdout
+
+        child.expect_exact(prompt)
+        child.sendline('breakpoint set -f %s -l %d' % (self.source, self.line_to_break))
+        child.expect_exact(prompt)
+        child.sendline('run')
+        child.expect_exact(prompt)
+
+        # Evaluate once outside the log so that one-time costs, like
+        # reserving the expression arena, don't skew the averages.
+        expr_cmd = 'expr ptr[j]->point.x + ptr[j]->point.y'
+        child.sendline(expr_cmd)
+        child.expect_exact(prompt)
+
+        child.sendline('log enable -f %s gdb-remote packets' % log_file)
+        child.expect_exact(prompt)
+
+        # Reset the stopwatch now.
+        self.stopwatch.reset()
+        for i in range(count):
+            with self.stopwatch:
+                child.sendline(expr_cmd)
+                child.expect_exact(prompt)
+
+        child.sendline('log disable gdb-remote packets')
+        child.expect_exact(prompt)
+
+        child.sendline('quit')
+        try:
+            self.child.expect(pexpect.EOF)
+        except:
+            pass
+
+        # The test is about to end and if we come to here, the child process has
+        # been terminated.  Mark it so.
+        self.child = None
+
+        self.packets = 0
+        self.writes = 0
+        self.reads = 0
+        self.allocations = 0
+        with open(log_file, 'r') as f:
+            for line in f:
+                marker = line.find('send packet: $')
+                if marker < 0:
+                    continue
+                packet = line[marker + len('send packet: $'):]
+                self.packets += 1
+                if packet.startswith('M') or packet.startswith('X'):
+                    self.writes += 1
+                elif packet.startswith('m') or packet.startswith('x'):
+                    self.reads += 1
+                elif packet.startswith('_M'):
+                    self.allocations += 1
+
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
@@ -0,0 +1,81 @@
+"""Test how long lldb takes to parse and evaluate trivial expressions."""
+
+import os, sys
+import unittest2
+import lldb
+from lldbbench import *
+
+class ExprParseTimeCase(BenchBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    def setUp(self):
+        BenchBase.setUp(self)
+        # The default self.stopwatch is for the first expression of each
+        # session, which pays for creating the shared parser state.  Create
+        # self.stopwatch2 for the expressions after it, which don't.
+        self.stopwatch2 = Stopwatch()
+        self.count = lldb.bmIterationCount
+        if self.count <= 0:
+            self.count = 100
+
+    @benchmarks_test
+    def test_expr_parse_time(self):
+        """Test parsing trivial expressions against a target with no process."""
+        self.buildDefault()
+        self.exe_name = 'a.out'
+
+        print
+        for i in range(5):
+            self.run_lldb_parse_trivial_exprs(self.exe_name, self.count)
+        print "lldb first expression benchmark:", self.stopwatch
+        print "lldb trivial expression benchmark:", self.stopwatch2
+        print "parses/sec: %f" % (1.0/self.stopwatch2.avg())
+
+    def run_lldb_parse_trivial_exprs(self, exe_name, count):
+        import pexpect
+        exe = os.path.join(os.getcwd(), exe_name)
+
+        # Set self.child_prompt, which is "(lldb) ".
+        self.child_prompt = '(lldb) '
+        prompt = self.child_prompt
+
+        # So that the child gets torn down after the test.
+        self.child = pexpect.spawn('%s %s %s' % (self.lldbHere, self.lldbOption, exe))
+        child = self.child
+
+        # Turn on logging for what the child sends back.
+        if self.TraceOn():
+            child.logfile_read = sys.stdout
+
+        child.expect_exact(prompt)
+
+        # There is no process, so every expression is interpreted and the
+        # time measured is dominated by setting up the parser and parsing.
+        # Each expression has different text so that none of them comes out
+        # of the compiled expression cache.
+        with self.stopwatch:
+            child.sendline('expr 0 + 1')
+            child.expect_exact(prompt)
+
+        for i in range(count):
+            with self.stopwatch2:
+                child.sendline('expr %d + 1' % (i + 1))
+                child.expect_exact(prompt)
+
+        child.sendline('quit')
+        try:
+            self.child.expect(pexpect.EOF)
+        except:
+            pass
+
+        # The test is about to end and if we come to here, the child process has
+        # been terminated.  Mark it so.
+        self.child = None
+
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
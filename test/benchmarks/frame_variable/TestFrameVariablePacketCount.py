@@ -0,0 +1,116 @@
+"""Count the memory read packets lldb sends to print a deep structure with 'frame variable'."""
+
+import os, sys
+import unittest2
+import lldb
+from lldbbench import *
+
+class FrameVariablePacketCountCase(BenchBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    def setUp(self):
+        BenchBase.setUp(self)
+        self.source = 'main.c'
+        self.line_to_break = line_number(self.source, '// Set breakpoint here.')
+        self.count = lldb.bmIterationCount
+        if self.count <= 0:
+            self.count = 20
+
+    @benchmarks_test
+    def test_frame_variable_packet_count(self):
+        """Test the number of memory reads per leaf value printed by 'frame variable'."""
+        self.buildDefault()
+        self.exe_name = 'a.out'
+
+        print
+        self.run_lldb_frame_variable_packet_count(self.exe_name, self.count)
+        print "lldb frame variable benchmark:", self.stopwatch
+        print "leaf values/print: %d" % self.leaves
+        print "packets/print: %f" % (float(self.packets) / self.count)
+        print "memory reads/print: %f" % (float(self.reads) / self.count)
+
+    def run_lldb_frame_variable_packet_count(self, exe_name, count):
+        import pexpect
+        exe = os.path.join(os.getcwd(), exe_name)
+        log_files = [os.path.join(os.getcwd(), 'frame-variable-packets-%d.log' % i) for i in range(count)]
+        for log_file in log_files:
+            if os.path.exists(log_file):
+                os.remove(log_file)
+
+        # Set self.child_prompt, which is "(lldb) ".
+        self.child_prompt = '(lldb) '
+        prompt = self.child_prompt
+
+        # So that the child gets torn down after the test.
+        self.child = pexpect.spawn('%s %s %s' % (self.lldbHere, self.lldbOption, exe))
+        child = self.child
+
+        # Turn on logging for what the child sends back.
+        if self.TraceOn():
+            child.logfile_read = sys.stdout
+
+        child.expect_exact(prompt)
+        child.sendline('breakpoint set -f %s -l %d' % (self.source, self.line_to_break))
+        child.expect_exact(prompt)
+        child.sendline('run')
+        child.expect_exact(prompt)
+
+        # Follow the tree's pointers three levels down so that the printed
+        # values are spread over both the stack and the heap.
+        frame_variable_cmd = 'frame variable -P 3 root'
+
+        # Print once outside the log to count the leaf values printed.
+        child.sendline(frame_variable_cmd)
+        child.expect_exact(prompt)
+        self.leaves = 0
+        for line in child.before.splitlines():
+            line = line.strip()
+            if ' = ' in line and not line.endswith('{'):
+                self.leaves += 1
+
+        # Reset the stopwatch now.  The breakpoint is in a loop and resuming
+        # the process flushes the memory cache, so each print reads the
+        # values from the process again.  Only the print is logged, not the
+        # packets sent to resume the process and report the stop.
+        self.stopwatch.reset()
+        for log_file in log_files:
+            child.sendline('continue')
+            child.expect_exact(prompt)
+            child.sendline('log enable -f %s gdb-remote packets' % log_file)
+            child.expect_exact(prompt)
+            with self.stopwatch:
+                child.sendline(frame_variable_cmd)
+                child.expect_exact(prompt)
+            child.sendline('log disable gdb-remote packets')
+            child.expect_exact(prompt)
+
+        child.sendline('quit')
+        try:
+            self.child.expect(pexpect.EOF)
+        except:
+            pass
+
+        # The test is about to end and if we come to here, the child process has
+        # been terminated.  Mark it so.
+        self.child = None
+
+        self.packets = 0
+        self.reads = 0
+        for log_file in log_files:
+            with open(log_file, 'r') as f:
+                for line in f:
+                    marker = line.find('send packet: $')
+                    if marker < 0:
+                        continue
+                    packet = line[marker + len('send packet: $'):]
+                    self.packets += 1
+                    if packet.startswith('m') or packet.startswith('x'):
+                        self.reads += 1
+
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
@@ -0,0 +1,77 @@
+//===-- main.c --------------------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <stdio.h>
+#include <stdlib.h>
+
+#define NUM_NODES 15
+#define NUM_POINTS 4
+
+struct Point
+{
+    int x;
+    int y;
+    int z;
+};
+
+struct Stats
+{
+    short min;
+    short max;
+    unsigned char flags;
+    double mean;
+    long long count;
+};
+
+// A binary tree of structs with nested structs, arrays and scalars, so that
+// printing it touches many leaves at several pointer depths.
+struct Node
+{
+    int id;
+    char tag;
+    struct Point points[NUM_POINTS];
+    struct Stats stats;
+    struct Node *left;
+    struct Node *right;
+};
+
+int
+main (int argc, char const *argv[])
+{
+    struct Node *nodes = (struct Node *) calloc (NUM_NODES, sizeof (struct Node));
+    int i, j;
+    for (i = 0; i < NUM_NODES; ++i)
+    {
+        nodes[i].id = i;
+        nodes[i].tag = 'a' + i;
+        for (j = 0; j < NUM_POINTS; ++j)
+        {
+            nodes[i].points[j].x = i + j;
+            nodes[i].points[j].y = i * j;
+            nodes[i].points[j].z = i - j;
+        }
+        nodes[i].stats.min = -i;
+        nodes[i].stats.max = i;
+        nodes[i].stats.flags = i & 3;
+        nodes[i].stats.mean = i / 2.0;
+        nodes[i].stats.count = i * 1000;
+        nodes[i].left = 2 * i + 1 < NUM_NODES ? &nodes[2 * i + 1] : NULL;
+        nodes[i].right = 2 * i + 2 < NUM_NODES ? &nodes[2 * i + 2] : NULL;
+    }
+
+    // Stop here over and over; each stop starts with an empty memory cache.
+    struct Node root;
+    for (i = 0; i < 1000; ++i)
+    {
+        root = nodes[0];
+        root.stats.count += i;
+        printf ("root has count %lld\n", root.stats.count); // Set breakpoint here.
+    }
+    free (nodes);
+    return 0;
+}
@@ -0,0 +1,81 @@
+"""Compare gdb-remote packets/sec over the shared memory connection against loopback TCP."""
+
+import os, sys, re
+import unittest2
+import lldb
+from lldbbench import *
+
+class SharedMemoryPacketSpeedBench(BenchBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    def setUp(self):
+        BenchBase.setUp(self)
+        self.source = 'main.c'
+        self.line_to_break = line_number(self.source, '// Set breakpoint here.')
+        self.count = lldb.bmIterationCount
+        if self.count <= 0:
+            self.count = 10000
+
+    @benchmarks_test
+    @skipIfDarwin # debugserver doesn't support --shared-memory, only lldb-gdbserver does
+    def test_shared_memory_vs_tcp(self):
+        """Test qSpeedTest packets/sec with shared memory vs. loopback TCP."""
+        self.buildDefault()
+        self.exe_name = 'a.out'
+
+        print
+        tcp_rate = self.run_packet_speed_test(self.exe_name, False, self.count)
+        print "loopback tcp: %f packets/sec" % tcp_rate
+        shm_rate = self.run_packet_speed_test(self.exe_name, True, self.count)
+        print "shared memory: %f packets/sec" % shm_rate
+        print "shared_memory/tcp: %f" % (shm_rate/tcp_rate)
+
+    def run_packet_speed_test(self, exe_name, use_shared_memory, count):
+        import pexpect
+        exe = os.path.join(os.getcwd(), exe_name)
+
+        # Set self.child_prompt, which is "(lldb) ".
+        self.child_prompt = '(lldb) '
+        prompt = self.child_prompt
+
+        # So that the child gets torn down after the test.
+        self.child = pexpect.spawn('%s %s %s' % (self.lldbHere, self.lldbOption, exe))
+        child = self.child
+
+        # Turn on logging for what the child sends back.
+        if self.TraceOn():
+            child.logfile_read = sys.stdout
+
+        child.expect_exact(prompt)
+        child.sendline('settings set plugin.process.gdb-remote.use-shared-memory %s' % ('true' if use_shared_memory else 'false'))
+        child.expect_exact(prompt)
+        child.sendline('breakpoint set -f %s -l %d' % (self.source, self.line_to_break))
+        child.expect_exact(prompt)
+        child.sendline('process launch --plugin gdb-remote')
+        child.expect_exact(prompt)
+
+        # Only the zero sized send and receive line matters, it measures
+        # the round trip latency of the connection.
+        child.sendline('process plugin packet speed-test %d' % count)
+        child.expect(r'qSpeedTest\(send=0 +, recv=0 +\) in [0-9.]+ sec for ([0-9.]+) packets/sec')
+        packets_per_sec = float(child.match.group(1))
+        child.expect_exact(prompt)
+
+        child.sendline('quit')
+        try:
+            self.child.expect(pexpect.EOF)
+        except:
+            pass
+
+        # The test is about to end and if we come to here, the child process has
+        # been terminated.  Mark it so.
+        self.child = None
+        return packets_per_sec
+
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
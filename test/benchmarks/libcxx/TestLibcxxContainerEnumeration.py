@@ -0,0 +1,100 @@
+"""Test how long lldb takes, and how many packets it sends, to enumerate large libc++ node based containers."""
+
+import os, sys
+import unittest2
+import lldb
+from lldbbench import *
+
+class LibcxxContainerEnumerationCase(BenchBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    def setUp(self):
+        BenchBase.setUp(self)
+        self.source = 'main.cpp'
+        self.line_to_break = line_number(self.source, '// Set breakpoint here.')
+
+    @benchmarks_test
+    @skipIfLinux # No standard locations for libc++ on Linux
+    def test_libcxx_container_enumeration(self):
+        """Test enumerating every element of a std::map, std::list and std::unordered_map."""
+        self.buildDefault()
+        self.exe_name = 'a.out'
+
+        print
+        for var in ['m', 'l', 'um']:
+            self.run_lldb_enumerate_container(self.exe_name, var)
+            print "lldb enumerate '%s' benchmark:" % var, self.stopwatch
+            print "elements: %d, packets: %d, memory reads: %d" % (self.elements, self.packets, self.reads)
+
+    def run_lldb_enumerate_container(self, exe_name, var):
+        import pexpect
+        exe = os.path.join(os.getcwd(), exe_name)
+        log_file = os.path.join(os.getcwd(), 'libcxx-%s-packets.log' % var)
+        if os.path.exists(log_file):
+            os.remove(log_file)
+
+        # Set self.child_prompt, which is "(lldb) ".
+        self.child_prompt = '(lldb) '
+        prompt = self.child_prompt
+
+        # So that the child gets torn down after the test.
+        self.child = pexpect.spawn('%s %s %s' % (self.lldbHere, self.lldbOption, exe))
+        child = self.child
+
+        # Turn on logging for what the child sends back.
+        if self.TraceOn():
+            child.logfile_read = sys.stdout
+
+        child.expect_exact(prompt)
+        child.sendline('breakpoint set -f %s -l %d' % (self.source, self.line_to_break))
+        child.expect_exact(prompt)
+        child.sendline('run')
+        child.expect_exact(prompt)
+
+        child.sendline('log enable -f %s gdb-remote packets' % log_file)
+        child.expect_exact(prompt)
+
+        # Ask for every element in order, the way printing the container
+        # does, and count the ones that came back.
+        enumerate_cmd = "script v = lldb.frame.FindVariable('%s'); print 'elements = %%d' %% len([i for i in range(v.GetNumChildren()) if v.GetChildAtIndex(i).IsValid()])" % var
+
+        # Reset the stopwatch now.
+        self.stopwatch.reset()
+        with self.stopwatch:
+            child.sendline(enumerate_cmd)
+            child.expect('elements = (\d+)', timeout=600)
+            self.elements = int(child.match.group(1))
+            child.expect_exact(prompt)
+
+        child.sendline('log disable gdb-remote packets')
+        child.expect_exact(prompt)
+
+        child.sendline('quit')
+        try:
+            self.child.expect(pexpect.EOF)
+        except:
+            pass
+
+        # The test is about to end and if we come to here, the child process has
+        # been terminated.  Mark it so.
+        self.child = None
+
+        self.packets = 0
+        self.reads = 0
+        with open(log_file, 'r') as f:
+            for line in f:
+                marker = line.find('send packet: $')
+                if marker < 0:
+                    continue
+                packet = line[marker + len('send packet: $'):]
+                self.packets += 1
+                if packet.startswith('m') or packet.startswith('x'):
+                    self.reads += 1
+
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
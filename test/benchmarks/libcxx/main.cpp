@@ -0,0 +1,30 @@
+//===-- main.cpp ------------------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <stdio.h>
+#include <list>
+#include <map>
+#include <unordered_map>
+
+#define NUM_ELEMENTS 100000
+
+int
+main (int argc, char const *argv[])
+{
+    std::map<int, int> m;
+    std::list<int> l;
+    std::unordered_map<int, int> um;
+    for (int i = 0; i < NUM_ELEMENTS; ++i)
+    {
+        m[i] = i;
+        l.push_back(i);
+        um[i] = i;
+    }
+    printf ("%zu %zu %zu\n", m.size(), l.size(), um.size()); // Set breakpoint here.
+    return 0;
+}
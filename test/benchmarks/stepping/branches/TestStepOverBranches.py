@@ -0,0 +1,86 @@
+"""Test how long it takes to step over a line that takes many branches."""
+
+import os, sys
+import unittest2
+import lldb
+from lldbbench import *
+
+class StepOverBranchesBench(BenchBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    def setUp(self):
+        BenchBase.setUp(self)
+        # The default self.stopwatch is for 'next' with fast stepping, which
+        # runs from branch to branch.
+        # Create self.stopwatch2 for 'next' with fast stepping turned off,
+        # which single steps every instruction.
+        self.stopwatch2 = Stopwatch()
+        self.source = 'main.c'
+        self.line_to_break = line_number(self.source, '// Step over this line.')
+        self.count = lldb.bmIterationCount
+        if self.count <= 0:
+            self.count = 20
+
+    @benchmarks_test
+    def test_step_over_branches(self):
+        """Test the time to 'next' over a loop on one line."""
+        self.buildDefault()
+        self.exe_name = 'a.out'
+
+        print
+        self.run_step_over_branches_bench(self.exe_name, self.count)
+        print "lldb step over branches (fast stepping) benchmark:", self.stopwatch
+        print "lldb step over branches (single stepping) benchmark:", self.stopwatch2
+
+    def run_step_over_branches_bench(self, exe_name, count):
+        import pexpect
+        exe = os.path.join(os.getcwd(), exe_name)
+
+        # Set self.child_prompt, which is "(lldb) ".
+        self.child_prompt = '(lldb) '
+        prompt = self.child_prompt
+
+        # So that the child gets torn down after the test.
+        self.child = pexpect.spawn('%s %s %s' % (self.lldbHere, self.lldbOption, exe))
+        child = self.child
+
+        # Turn on logging for what the child sends back.
+        if self.TraceOn():
+            child.logfile_read = sys.stdout
+
+        child.expect_exact(prompt)
+        child.sendline('breakpoint set -f %s -l %d' % (self.source, self.line_to_break))
+        child.expect_exact(prompt)
+        child.sendline('process launch')
+        child.expect_exact(prompt)
+
+        # Reset the stopwatches now.
+        self.stopwatch.reset()
+        self.stopwatch2.reset()
+        for use_fast_stepping, stopwatch in [('true', self.stopwatch), ('false', self.stopwatch2)]:
+            child.sendline('settings set target.use-fast-stepping %s' % use_fast_stepping)
+            child.expect_exact(prompt)
+            for i in range(count):
+                with stopwatch:
+                    child.sendline('next')
+                    child.expect_exact(prompt)
+                child.sendline('continue')
+                child.expect_exact(prompt)
+
+        child.sendline('quit')
+        try:
+            self.child.expect(pexpect.EOF)
+        except:
+            pass
+
+        # The test is about to end and if we come to here, the child process has
+        # been terminated.  Mark it so.
+        self.child = None
+
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
@@ -0,0 +1,21 @@
+#include <stdio.h>
+
+// The whole loop is on one line, so a 'next' over it has to run
+// through every branch in it without leaving the stepping range.
+int
+spin (int count)
+{
+    int sum = 0, j;
+    for (j = 0; j < count; ++j) { if (j & 1) sum += j; else sum ^= j; } // Step over this line.
+    return sum;
+}
+
+int
+main (int argc, char const *argv[])
+{
+    int total = 0, i;
+    for (i = 0; i < 100000; ++i)
+        total += spin (64);
+    printf ("total = %d\n", total);
+    return 0;
+}
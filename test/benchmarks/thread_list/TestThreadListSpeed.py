@@ -0,0 +1,90 @@
+"""Test how long 'thread list' and a backtrace of the top frame of every thread take with 1000 threads."""
+
+import os, sys
+import unittest2
+import lldb
+from lldbbench import *
+
+class ThreadListSpeedBench(BenchBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    def setUp(self):
+        BenchBase.setUp(self)
+        # The default self.stopwatch is for the default thread and frame formats,
+        # which show the line of each frame.
+        # Create self.stopwatch2 for formats with only the pc and function name,
+        # which don't need any line tables.
+        self.stopwatch2 = Stopwatch()
+        self.source = 'main.cpp'
+        self.line_to_break = line_number(self.source, '// Set breakpoint here.')
+        self.count = lldb.bmIterationCount
+        if self.count <= 0:
+            self.count = 10
+
+    @benchmarks_test
+    def test_thread_list_speed(self):
+        """Test the time of 'thread list' and 'thread backtrace all -c 1' with 1000 threads."""
+        self.buildDefault()
+        self.exe_name = 'a.out'
+
+        print
+        self.run_thread_list_bench(self.exe_name, False, self.stopwatch, self.count)
+        print "lldb thread list (default formats) benchmark:", self.stopwatch
+        self.run_thread_list_bench(self.exe_name, True, self.stopwatch2, self.count)
+        print "lldb thread list (pc and function formats) benchmark:", self.stopwatch2
+
+    def run_thread_list_bench(self, exe_name, short_formats, stopwatch, count):
+        import pexpect
+        exe = os.path.join(os.getcwd(), exe_name)
+
+        # Set self.child_prompt, which is "(lldb) ".
+        self.child_prompt = '(lldb) '
+        prompt = self.child_prompt
+
+        # So that the child gets torn down after the test.
+        self.child = pexpect.spawn('%s %s %s' % (self.lldbHere, self.lldbOption, exe))
+        child = self.child
+
+        # Turn on logging for what the child sends back.
+        if self.TraceOn():
+            child.logfile_read = sys.stdout
+
+        child.expect_exact(prompt)
+        if short_formats:
+            child.sendline('settings set thread-format "thread #${thread.index}: tid = ${thread.id%tid}{, ${frame.pc}}{ ${module.file.basename}{`${function.name}}}\\n"')
+            child.expect_exact(prompt)
+            child.sendline('settings set frame-format "frame #${frame.index}: ${frame.pc}{ ${module.file.basename}{`${function.name}}}\\n"')
+            child.expect_exact(prompt)
+        child.sendline('breakpoint set -f %s -l %d' % (self.source, self.line_to_break))
+        child.expect_exact(prompt)
+        child.sendline('process launch')
+        child.expect_exact(prompt, timeout=120)
+
+        stopwatch.reset()
+        for i in range(count):
+            # Stepping throws away the stack frames of every thread.
+            child.sendline('thread step-inst')
+            child.expect_exact(prompt, timeout=120)
+            with stopwatch:
+                child.sendline('thread list')
+                child.expect_exact(prompt, timeout=120)
+                child.sendline('thread backtrace all -c 1')
+                child.expect_exact(prompt, timeout=120)
+
+        child.sendline('quit')
+        try:
+            self.child.expect(pexpect.EOF)
+        except:
+            pass
+
+        # The test is about to end and if we come to here, the child process has
+        # been terminated.  Mark it so.
+        self.child = None
+
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
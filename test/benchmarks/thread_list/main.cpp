@@ -0,0 +1,70 @@
+//===-- main.cpp ------------------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <pthread.h>
+#include <stdio.h>
+#include <unistd.h>
+#include <atomic>
+
+#define NUM_THREADS 1000
+
+// pthread barriers aren't available everywhere, wait on a counter instead.
+// With this many threads, sleep rather than spin while waiting, so the
+// threads that are still to be created get the CPU.
+#define do_nothing() usleep (1000)
+
+#define pseudo_barrier_wait(bar) \
+    --bar;                       \
+    while (bar > 0)              \
+        do_nothing();
+
+#define pseudo_barrier_init(bar, count) (bar = count)
+
+std::atomic_int g_barrier;
+
+void *
+thread_func (void *arg)
+{
+    pseudo_barrier_wait (g_barrier);
+    while (1)
+        sleep (1);
+    return NULL;
+}
+
+int
+main (int argc, char const *argv[])
+{
+    pthread_t threads[NUM_THREADS];
+    pthread_attr_t attr;
+    int num_threads = 0;
+    int i;
+
+    // Small stacks, so this many threads fit anywhere
+    pthread_attr_init (&attr);
+    pthread_attr_setstacksize (&attr, 64 * 1024);
+
+    pseudo_barrier_init (g_barrier, NUM_THREADS + 1);
+    for (i = 0; i < NUM_THREADS; ++i)
+    {
+        if (pthread_create (&threads[i], &attr, thread_func, NULL) != 0)
+            break;
+        ++num_threads;
+    }
+    if (num_threads < NUM_THREADS)
+    {
+        printf ("Only created %d threads.\n", num_threads);
+        return 1;
+    }
+    pseudo_barrier_wait (g_barrier);
+
+    printf ("All threads are waiting.\n"); // Set breakpoint here.
+
+    for (i = 0; i < num_threads; ++i)
+        pthread_join (threads[i], NULL);
+    return 0;
+}
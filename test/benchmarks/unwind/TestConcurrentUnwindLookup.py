@@ -0,0 +1,104 @@
+"""Test how long 'thread backtrace all' takes for many threads unwinding at the same time."""
+
+import os, sys, re
+import unittest2
+import lldb
+from lldbbench import *
+
+class ConcurrentUnwindLookupBench(BenchBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    def setUp(self):
+        BenchBase.setUp(self)
+        # The default self.stopwatch is for unwinding the threads in parallel.
+        # Create self.stopwatch2 for unwinding them one after the other.
+        self.stopwatch2 = Stopwatch()
+        self.source = 'main.cpp'
+        self.line_to_break = line_number(self.source, '// Set breakpoint here.')
+        self.count = lldb.bmIterationCount
+        if self.count <= 0:
+            self.count = 30
+
+    @benchmarks_test
+    def test_concurrent_unwind_lookup(self):
+        """Test the time to backtrace all threads, unwinding in parallel and serially."""
+        self.buildDefault()
+        self.exe_name = 'a.out'
+
+        print
+        self.run_backtrace_all_bench(self.exe_name, True, self.stopwatch, self.count)
+        print "lldb backtrace all (parallel) benchmark:", self.stopwatch
+        self.run_backtrace_all_bench(self.exe_name, False, self.stopwatch2, self.count)
+        print "lldb backtrace all (serial) benchmark:", self.stopwatch2
+
+    def run_backtrace_all_bench(self, exe_name, parallel, stopwatch, count):
+        import pexpect
+        exe = os.path.join(os.getcwd(), exe_name)
+
+        # Set self.child_prompt, which is "(lldb) ".
+        self.child_prompt = '(lldb) '
+        prompt = self.child_prompt
+
+        # So that the child gets torn down after the test.
+        self.child = pexpect.spawn('%s %s %s' % (self.lldbHere, self.lldbOption, exe))
+        child = self.child
+
+        # Turn on logging for what the child sends back.
+        if self.TraceOn():
+            child.logfile_read = sys.stdout
+
+        child.expect_exact(prompt)
+        child.sendline('settings set target.process.unwind-threads-in-parallel %s' % ('true' if parallel else 'false'))
+        child.expect_exact(prompt)
+        child.sendline('breakpoint set -f %s -l %d' % (self.source, self.line_to_break))
+        child.expect_exact(prompt)
+        child.sendline('process launch')
+        child.expect_exact(prompt)
+
+        # Unwind once so all the unwind plans are made, what is timed is
+        # finding them again from many threads at once.
+        child.sendline('thread backtrace all')
+        child.expect_exact(prompt)
+        self.check_backtraces(child.before)
+
+        stopwatch.reset()
+        for i in range(count):
+            # Stepping throws away the stack frames of every thread.
+            child.sendline('thread step-inst')
+            child.expect_exact(prompt)
+            with stopwatch:
+                child.sendline('thread backtrace all')
+                child.expect_exact(prompt)
+            self.check_backtraces(child.before)
+
+        child.sendline('quit')
+        try:
+            self.child.expect(pexpect.EOF)
+        except:
+            pass
+
+        # The test is about to end and if we come to here, the child process has
+        # been terminated.  Mark it so.
+        self.child = None
+
+    def check_backtraces(self, output):
+        """Check that every worker thread's frames are found in the right functions."""
+        # From the top: recurse_a(0), recurse_b(0), recurse_a(1), ...,
+        # recurse_b(63), recurse_a(64), then thread_func.
+        expected = ['recurse_a', 'recurse_b'] * 64 + ['recurse_a', 'thread_func']
+        num_workers = 0
+        for thread_output in re.split(r'\n\s*\*?\s*thread #', output):
+            functions = re.findall(r'`(recurse_a|recurse_b|thread_func)\b', thread_output)
+            if not functions:
+                continue
+            num_workers += 1
+            self.assertTrue(functions == expected, "a worker thread's frames are in the wrong functions")
+        self.assertTrue(num_workers == 32, "all the worker threads are backtraced")
+
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
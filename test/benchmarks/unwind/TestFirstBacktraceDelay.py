@@ -0,0 +1,88 @@
+"""Test lldb's latency of the first backtrace after creating a target and launching it."""
+
+import os, sys
+import unittest2
+import lldb
+from lldbbench import *
+
+class FirstBacktraceDelayBench(BenchBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    def setUp(self):
+        BenchBase.setUp(self)
+        # The default self.stopwatch is for "first backtrace".
+        # Create self.stopwatch2 for measuring "second backtrace", which
+        # shows what is left after the unwind information is set up.
+        self.stopwatch2 = Stopwatch()
+        if lldb.bmExecutable:
+            self.exe = lldb.bmExecutable
+        else:
+            self.exe = self.lldbHere
+        if lldb.bmBreakpointSpec:
+            self.break_spec = lldb.bmBreakpointSpec
+        else:
+            self.break_spec = '-n main'
+
+        self.count = lldb.bmIterationCount
+        if self.count <= 0:
+            self.count = 30
+
+    @benchmarks_test
+    def test_first_backtrace_delay(self):
+        """Test the delay of the first backtrace after target create and process launch."""
+        print
+        self.run_first_backtrace_bench(self.exe, self.break_spec, self.count)
+        print "lldb first backtrace delay (first backtrace) benchmark:", self.stopwatch
+        print "lldb first backtrace delay (second backtrace) benchmark:", self.stopwatch2
+
+    def run_first_backtrace_bench(self, exe, break_spec, count):
+        import pexpect
+        # Set self.child_prompt, which is "(lldb) ".
+        self.child_prompt = '(lldb) '
+        prompt = self.child_prompt
+
+        # Reset the stopwatchs now.
+        self.stopwatch.reset()
+        self.stopwatch2.reset()
+        for i in range(count):
+            # So that the child gets torn down after the test.
+            self.child = pexpect.spawn('%s %s' % (self.lldbHere, self.lldbOption))
+            child = self.child
+
+            # Turn on logging for what the child sends back.
+            if self.TraceOn():
+                child.logfile_read = sys.stdout
+
+            child.sendline('target create %s' % exe)
+            child.expect_exact(prompt)
+            child.sendline('breakpoint set %s' % break_spec)
+            child.expect_exact(prompt)
+            child.sendline('process launch')
+            child.expect_exact(prompt)
+
+            with self.stopwatch:
+                # The first unwind in each module reads its call frame info.
+                child.sendline('thread backtrace')
+                child.expect_exact(prompt)
+
+            with self.stopwatch2:
+                child.sendline('thread backtrace')
+                child.expect_exact(prompt)
+
+            child.sendline('quit')
+            try:
+                self.child.expect(pexpect.EOF)
+            except:
+                pass
+
+        # The test is about to end and if we come to here, the child process has
+        # been terminated.  Mark it so.
+        self.child = None
+
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
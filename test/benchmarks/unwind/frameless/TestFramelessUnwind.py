@@ -0,0 +1,89 @@
+"""Test how long it takes to backtrace through functions that are unwound by profiling their assembly."""
+
+import os, sys
+import unittest2
+import lldb
+from lldbbench import *
+
+class FramelessUnwindBench(BenchBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    def setUp(self):
+        BenchBase.setUp(self)
+        # The default self.stopwatch is for "first backtrace", which profiles
+        # every function on the stack.
+        # Create self.stopwatch2 for the backtraces after the next stops, which
+        # reuse the UnwindPlans made for the first one.
+        self.stopwatch2 = Stopwatch()
+        self.source = 'main.c'
+        self.line_to_break = line_number(self.source, '// Set breakpoint here.')
+        self.count = lldb.bmIterationCount
+        if self.count <= 0:
+            self.count = 30
+
+    @benchmarks_test
+    def test_frameless_unwind(self):
+        """Test the time to backtrace through frameless functions without eh_frame."""
+        self.buildDefault()
+        self.exe_name = 'a.out'
+
+        print
+        self.run_frameless_unwind_bench(self.exe_name, self.count)
+        print "lldb frameless unwind (first backtrace) benchmark:", self.stopwatch
+        print "lldb frameless unwind (later backtraces) benchmark:", self.stopwatch2
+
+    def run_frameless_unwind_bench(self, exe_name, count):
+        import pexpect
+        exe = os.path.join(os.getcwd(), exe_name)
+
+        # Set self.child_prompt, which is "(lldb) ".
+        self.child_prompt = '(lldb) '
+        prompt = self.child_prompt
+
+        # Reset the stopwatchs now.
+        self.stopwatch.reset()
+        self.stopwatch2.reset()
+        for i in range(count):
+            # So that the child gets torn down after the test.
+            self.child = pexpect.spawn('%s %s %s' % (self.lldbHere, self.lldbOption, exe))
+            child = self.child
+
+            # Turn on logging for what the child sends back.
+            if self.TraceOn():
+                child.logfile_read = sys.stdout
+
+            child.expect_exact(prompt)
+            child.sendline('breakpoint set -f %s -l %d' % (self.source, self.line_to_break))
+            child.expect_exact(prompt)
+            child.sendline('process launch')
+            child.expect_exact(prompt)
+
+            with self.stopwatch:
+                child.sendline('thread backtrace')
+                child.expect_exact(prompt)
+
+            for j in range(5):
+                # Stepping throws away the stack frames, but not the UnwindPlans.
+                child.sendline('thread step-inst')
+                child.expect_exact(prompt)
+                with self.stopwatch2:
+                    child.sendline('thread backtrace')
+                    child.expect_exact(prompt)
+
+            child.sendline('quit')
+            try:
+                self.child.expect(pexpect.EOF)
+            except:
+                pass
+
+        # The test is about to end and if we come to here, the child process has
+        # been terminated.  Mark it so.
+        self.child = None
+
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
@@ -0,0 +1,57 @@
+//===-- main.c --------------------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <stdio.h>
+
+volatile int g_sink;
+
+void
+stop_here (void)
+{
+    printf ("Reached the innermost frame.\n"); // Set breakpoint here.
+}
+
+// Each function has a stack frame without a frame pointer, so unwinding
+// out of it needs its prologue profiled.
+#define FRAMELESS_FUNC(name, next)          \
+    __attribute__((noinline)) int           \
+    name (int depth)                        \
+    {                                       \
+        volatile int locals[8];             \
+        locals[depth & 7] = depth;          \
+        if (depth == 0)                     \
+            stop_here ();                   \
+        else                                \
+            g_sink = next (depth - 1);      \
+        return locals[depth & 7];           \
+    }
+
+int frameless_0 (int depth);
+
+FRAMELESS_FUNC(frameless_15, frameless_0)
+FRAMELESS_FUNC(frameless_14, frameless_15)
+FRAMELESS_FUNC(frameless_13, frameless_14)
+FRAMELESS_FUNC(frameless_12, frameless_13)
+FRAMELESS_FUNC(frameless_11, frameless_12)
+FRAMELESS_FUNC(frameless_10, frameless_11)
+FRAMELESS_FUNC(frameless_9, frameless_10)
+FRAMELESS_FUNC(frameless_8, frameless_9)
+FRAMELESS_FUNC(frameless_7, frameless_8)
+FRAMELESS_FUNC(frameless_6, frameless_7)
+FRAMELESS_FUNC(frameless_5, frameless_6)
+FRAMELESS_FUNC(frameless_4, frameless_5)
+FRAMELESS_FUNC(frameless_3, frameless_4)
+FRAMELESS_FUNC(frameless_2, frameless_3)
+FRAMELESS_FUNC(frameless_1, frameless_2)
+FRAMELESS_FUNC(frameless_0, frameless_1)
+
+int
+main (int argc, char const *argv[])
+{
+    return frameless_0 (64);
+}
@@ -0,0 +1,75 @@
+//===-- main.cpp ------------------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <pthread.h>
+#include <stdio.h>
+#include <unistd.h>
+#include <atomic>
+
+#define NUM_THREADS 32
+#define STACK_DEPTH 64
+
+// pthread barriers aren't available everywhere, spin on a counter instead.
+#define do_nothing()
+
+#define pseudo_barrier_wait(bar) \
+    --bar;                       \
+    while (bar > 0)              \
+        do_nothing();
+
+#define pseudo_barrier_init(bar, count) (bar = count)
+
+std::atomic_int g_barrier;
+
+// A few different functions on the stack, so each backtrace needs the
+// unwind plans of more than one function.
+int recurse_a (int depth);
+int recurse_b (int depth);
+
+int
+recurse_a (int depth)
+{
+    if (depth == 0)
+    {
+        pseudo_barrier_wait (g_barrier);
+        while (1)
+            sleep (1);
+    }
+    return recurse_b (depth - 1) + 1;
+}
+
+int
+recurse_b (int depth)
+{
+    return recurse_a (depth) + 1;
+}
+
+void *
+thread_func (void *arg)
+{
+    recurse_a (STACK_DEPTH);
+    return NULL;
+}
+
+int
+main (int argc, char const *argv[])
+{
+    pthread_t threads[NUM_THREADS];
+    int i;
+
+    pseudo_barrier_init (g_barrier, NUM_THREADS + 1);
+    for (i = 0; i < NUM_THREADS; ++i)
+        pthread_create (&threads[i], NULL, thread_func, NULL);
+    pseudo_barrier_wait (g_barrier);
+
+    printf ("All threads are waiting.\n"); // Set breakpoint here.
+
+    for (i = 0; i < NUM_THREADS; ++i)
+        pthread_join (threads[i], NULL);
+    return 0;
+}
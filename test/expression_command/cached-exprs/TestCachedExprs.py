@@ -0,0 +1,109 @@
+"""
+Test that expressions reused from the compiled expression cache read the
+values, and the variables, of the frame they are evaluated in.
+"""
+
+import os, sys
+import unittest2
+import lldb
+import lldbutil
+from lldbtest import *
+
+class CachedExprsTestCase(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    def setUp(self):
+        # Call super's setUp().
+        TestBase.setUp(self)
+
+        self.main_source = "main.cpp"
+        self.main_source_spec = lldb.SBFileSpec (self.main_source)
+        self.log_file = os.path.join(os.getcwd(), 'cached-exprs.log')
+        if os.path.exists(self.log_file):
+            os.remove(self.log_file)
+
+    @unittest2.skipUnless(sys.platform.startswith("darwin"), "requires Darwin")
+    @dsym_test
+    def test_cached_exprs_with_dsym(self):
+        """Test evaluating the same expression at stops with different values."""
+        self.buildDsym()
+        self.cached_exprs(64)
+
+    @dwarf_test
+    def test_cached_exprs_with_dwarf(self):
+        """Test evaluating the same expression at stops with different values."""
+        self.buildDwarf()
+        self.cached_exprs(64)
+
+    @unittest2.skipUnless(sys.platform.startswith("darwin"), "requires Darwin")
+    @dsym_test
+    def test_uncached_exprs_with_dsym(self):
+        """Test evaluating the same expression with the expression cache turned off."""
+        self.buildDsym()
+        self.cached_exprs(0)
+
+    @dwarf_test
+    def test_uncached_exprs_with_dwarf(self):
+        """Test evaluating the same expression with the expression cache turned off."""
+        self.buildDwarf()
+        self.cached_exprs(0)
+
+    def read_log(self):
+        with open(self.log_file, 'r') as f:
+            return f.read()
+
+    def evaluate_at_next_stop(self, process, breakpoint, expr, expected):
+        threads = lldbutil.get_threads_stopped_at_breakpoint (process, breakpoint)
+        self.assertTrue(len(threads) == 1)
+        frame = threads[0].GetFrameAtIndex(0)
+
+        value = frame.EvaluateExpression (expr)
+        self.assertTrue(value.IsValid() and value.GetError().Success(), "'%s' evaluated" % expr)
+        self.assertEqual(value.GetValue(), expected, "'%s' at %s" % (expr, frame.GetFunctionName()))
+
+    def cached_exprs(self, cache_size):
+        """Test evaluating the same expression at stops with different values."""
+        exe = os.path.join(os.getcwd(), "a.out")
+
+        target = self.dbg.CreateTarget(exe)
+        self.assertTrue(target, VALID_TARGET)
+
+        self.runCmd("settings set target.expression-cache-size %d" % cache_size)
+        self.addTearDownHook(lambda: self.runCmd("settings clear target.expression-cache-size"))
+        self.runCmd("log enable -f %s lldb expr" % self.log_file)
+        self.addTearDownHook(lambda: self.runCmd("log disable lldb expr"))
+
+        int_bkpt = target.BreakpointCreateBySourceRegex('Break in int_local.', self.main_source_spec)
+        double_bkpt = target.BreakpointCreateBySourceRegex('Break in double_local.', self.main_source_spec)
+        inner_bkpt = target.BreakpointCreateBySourceRegex('Break in the inner block.', self.main_source_spec)
+        for bkpt in [int_bkpt, double_bkpt, inner_bkpt]:
+            self.assertTrue(bkpt and bkpt.GetNumLocations() == 1, VALID_BREAKPOINT)
+
+        process = target.LaunchSimple (None, None, self.get_process_working_directory())
+        self.assertTrue(process, PROCESS_IS_VALID)
+
+        # Each function is called twice with different arguments, and each
+        # has a variable named 'local' of a different type.  In
+        # shadowed_local the inner 'local' hides an int with the same name.
+        expected = [(int_bkpt, '4'), (double_bkpt, '3.5'), (inner_bkpt, '11.5'),
+                    (int_bkpt, '7'), (double_bkpt, '6'), (inner_bkpt, '21.5')]
+        for bkpt, result in expected:
+            self.evaluate_at_next_stop (process, bkpt, 'local + 1', result)
+            process.Continue()
+
+        self.assertTrue(process.GetState() == lldb.eStateExited, PROCESS_EXITED)
+
+        # The second call of each function reuses the expression compiled
+        # for the first one, unless the cache is turned off.
+        reused = self.read_log().count('Reusing compiled expression')
+        if cache_size > 0:
+            self.assertEqual(reused, 3, "each function's second evaluation was reused")
+        else:
+            self.assertEqual(reused, 0, "no evaluation was reused with the cache turned off")
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
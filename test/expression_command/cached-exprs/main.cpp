@@ -0,0 +1,40 @@
+#include <stdio.h>
+
+int
+int_local (int n)
+{
+    int local = n * 3;
+    return local + 1; // Break in int_local.
+}
+
+double
+double_local (double d)
+{
+    double local = d / 2;
+    return local + 1; // Break in double_local.
+}
+
+int
+shadowed_local (int n)
+{
+    int local = n;
+    {
+        double local = n + 0.5;
+        n += (int) local; // Break in the inner block.
+    }
+    return local + n;
+}
+
+int
+main (int argc, char const *argv[])
+{
+    int total = 0;
+    for (int i = 1; i <= 2; i++)
+    {
+        total += int_local (i);
+        total += (int) double_local (i * 5);
+        total += shadowed_local (i * 10);
+    }
+    printf ("total = %d\n", total);
+    return 0;
+}
@@ -0,0 +1,49 @@
+"""
+Test that expressions with loops, floating point and aggregates are
+interpreted when there is no process to run them in.
+"""
+
+import os, time
+import unittest2
+import lldb
+from lldbtest import *
+
+class IRInterpreterTestCase(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    def test_ir_interpreter(self):
+        """Test that expressions are interpreted without a process."""
+        self.buildDefault()
+
+        self.runCmd("file a.out", CURRENT_EXECUTABLE_SET)
+
+        # Without a process none of these can be JIT compiled, so they
+        # have to be interpreted.
+        self.expect("expression (int)(3.5 * 2.0)",
+            substrs = ["(int)", "= 7"])
+
+        self.expect("expression -- int s = 0; for (int i = 0; i < 10; ++i) s += i; s",
+            substrs = ["(int)", "= 45"])
+
+        self.expect("expression -- double d = 1.0; int n = 0; while (d < 100.0) { d *= 2.5; ++n; } n",
+            substrs = ["(int)", "= 6"])
+
+        self.expect("expression -- struct P { int x; int y; } a = { 3, 4 }, b; b = a; b.x * 10 + b.y",
+            substrs = ["(int)", "= 34"])
+
+        self.expect("expression -- int r = 0; switch (7 % 3) { case 0: r = 10; break; case 1: r = 20; break; default: r = 30; } r",
+            substrs = ["(int)", "= 20"])
+
+        self.expect("expression -- int a[4]; for (int i = 0; i < 4; ++i) a[i] = i * i; a[1] + a[2] + a[3]",
+            substrs = ["(int)", "= 14"])
+
+        # Converting a double that doesn't fit is refused, not made up.
+        self.expect("expression -- double d = 1e30; (long long)d", error=True,
+            substrs = ["doesn't fit in an integer"])
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
@@ -0,0 +1,8 @@
+#include <stdio.h>
+
+int
+main (int argc, char const *argv[])
+{
+    printf ("Hello world.\n");
+    return 0;
+}
@@ -0,0 +1,121 @@
+"""
+Test breakpoint conditions that are injected into the process with
+target.inject-breakpoint-conditions.
+"""
+
+import os, sys
+import re
+import unittest2
+import lldb, lldbutil
+from lldbtest import *
+
+class BreakpointInjectedConditionsTestCase(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    @unittest2.skipUnless(sys.platform.startswith("darwin"), "requires Darwin")
+    @dsym_test
+    def test_injected_conditions_with_dsym(self):
+        """Test injected breakpoint conditions stop on the right hits and can be removed."""
+        self.buildDsym()
+        self.injected_conditions()
+
+    @skipIfFreeBSD # Conditions are only injected into processes debugged with gdb-remote
+    @skipIfLinux # Conditions are only injected into processes debugged with gdb-remote
+    @skipIfi386 # Conditions are only injected into x86_64 processes
+    @dwarf_test
+    def test_injected_conditions_with_dwarf(self):
+        """Test injected breakpoint conditions stop on the right hits and can be removed."""
+        self.buildDwarf()
+        self.injected_conditions()
+
+    def setUp(self):
+        # Call super's setUp().
+        TestBase.setUp(self)
+        self.global_line = line_number('main.c', '// Set global condition breakpoint here.')
+        self.local_line = line_number('main.c', '// Set local condition breakpoint here.')
+        self.log_file = os.path.join(os.getcwd(), 'injected-conditions.log')
+        if os.path.exists(self.log_file):
+            os.remove(self.log_file)
+
+    def read_log(self):
+        # The log is flushed after every message.
+        with open(self.log_file, 'r') as f:
+            return f.read()
+
+    def count_removals(self):
+        return len(re.findall("Process::RemoveInjectedBreakpointCondition .* -- SUCCESS", self.read_log()))
+
+    def injected_conditions(self):
+        """Test injected breakpoint conditions stop on the right hits and can be removed."""
+        exe = os.path.join(os.getcwd(), "a.out")
+        self.runCmd("file " + exe, CURRENT_EXECUTABLE_SET)
+
+        self.runCmd("settings set target.inject-breakpoint-conditions true")
+        self.addTearDownHook(lambda: self.runCmd("settings set target.inject-breakpoint-conditions false"))
+        self.runCmd("log enable -f %s lldb break" % self.log_file)
+        self.addTearDownHook(lambda: self.runCmd("log disable lldb break"))
+
+        lldbutil.run_break_set_by_file_and_line (self, "main.c", self.global_line, extra_options="-c 'g_hits == 50'", num_expected_locations=1, loc_exact=True)
+        lldbutil.run_break_set_by_file_and_line (self, "main.c", self.local_line, extra_options="-c 'local == 70'", num_expected_locations=1, loc_exact=True)
+
+        self.runCmd("run", RUN_SUCCEEDED)
+
+        # The condition on the global is evaluated by the debugger on the
+        # first hit and by the process after that, and still stops on the
+        # right hit.
+        self.expect("thread list", STOPPED_DUE_TO_BREAKPOINT,
+            substrs = ['stopped', 'stop reason = breakpoint 1.'])
+        self.expect("expr g_hits", VARIABLES_DISPLAYED_CORRECTLY,
+            substrs = ['= 50'])
+        self.assertTrue('Condition "g_hits == 50" was injected' in self.read_log(), "the condition on the global was injected")
+        # Hits the process filtered out are counted too.
+        breakpoint = self.dbg.GetSelectedTarget().GetBreakpointAtIndex(0)
+        self.assertEqual(breakpoint.GetHitCount(), 51, "every hit of the injected site was counted")
+
+        # Stepping off the site runs the instruction the jump replaced.
+        frame = self.dbg.GetSelectedTarget().GetProcess().GetSelectedThread().GetFrameAtIndex(0)
+        site_pc = frame.GetPC()
+        self.runCmd("thread step-inst")
+        frame = self.dbg.GetSelectedTarget().GetProcess().GetSelectedThread().GetFrameAtIndex(0)
+        self.assertTrue(frame.GetPC() > site_pc, "stepped off the injected site")
+        self.expect("frame variable marker", VARIABLES_DISPLAYED_CORRECTLY,
+            substrs = ['marker = 1'])
+
+        # Changing the condition removes the injected one; the new one is
+        # injected again on the next hit and stops on the right hit.
+        self.runCmd("breakpoint modify -c 'g_hits == 60' 1")
+        self.assertEqual(self.count_removals(), 1, "changing the condition removed the injected condition")
+        self.runCmd("continue")
+        self.expect("thread list", STOPPED_DUE_TO_BREAKPOINT,
+            substrs = ['stopped', 'stop reason = breakpoint 1.'])
+        self.expect("expr g_hits", VARIABLES_DISPLAYED_CORRECTLY,
+            substrs = ['= 60'])
+        self.assertTrue('Condition "g_hits == 60" was injected' in self.read_log(), "the changed condition was injected")
+        self.assertEqual(breakpoint.GetHitCount(), 61, "every hit of the injected site was counted")
+
+        # Setting an ignore count removes it too.
+        self.runCmd("breakpoint modify -i 1 1")
+        self.assertEqual(self.count_removals(), 2, "setting the ignore count removed the injected condition")
+        self.runCmd("breakpoint disable 1")
+
+        # The condition on the local isn't injected, since it depends on the
+        # frame, and is still evaluated by the debugger.
+        self.runCmd("continue")
+        self.expect("thread list", STOPPED_DUE_TO_BREAKPOINT,
+            substrs = ['stopped', 'stop reason = breakpoint 2.'])
+        self.expect("frame variable local", VARIABLES_DISPLAYED_CORRECTLY,
+            substrs = ['local = 70'])
+
+        self.assertTrue('Condition "local == 70" can\'t be injected' in self.read_log(), "the condition on the local wasn't injected")
+
+        self.runCmd("breakpoint delete 2")
+        self.runCmd("continue")
+        self.assertTrue(self.dbg.GetSelectedTarget().GetProcess().GetState() == lldb.eStateExited, PROCESS_EXITED)
+
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
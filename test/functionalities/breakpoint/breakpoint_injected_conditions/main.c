@@ -0,0 +1,28 @@
+//===-- main.c --------------------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <stdio.h>
+
+int g_hits = 0;
+
+int
+main (int argc, char const *argv[])
+{
+    int marker = 0;
+    for (int i = 0; i < 100; i++)
+    {
+        int local = i;
+        g_hits = i;
+        // Storing a constant to a local is one instruction that is long
+        // enough to be replaced by a jump.
+        marker = 1; // Set global condition breakpoint here.
+        marker = local + 1; // Set local condition breakpoint here.
+    }
+    printf ("%d %d\n", g_hits, marker);
+    return 0;
+}
@@ -0,0 +1,75 @@
+"""
+Test that the modules listed in the NT_FILE note of an ELF core are each
+loaded once, at the address they were mapped at.
+"""
+
+import os, sys
+import glob
+import subprocess
+import unittest2
+import lldb
+from lldbtest import *
+
+class ElfCoreModulesTestCase(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    @unittest2.skipUnless(sys.platform.startswith("linux"), "requires Linux core files")
+    @dwarf_test
+    def test_elf_core_modules_with_dwarf(self):
+        """Test that the modules in the NT_FILE note of an ELF core are loaded once."""
+        self.buildDwarf()
+        self.elf_core_modules()
+
+    def make_core(self, exe):
+        """Crash the program and return the core file the kernel wrote for it."""
+        with open('/proc/sys/kernel/core_pattern', 'r') as f:
+            core_pattern = f.read().strip()
+        if core_pattern.startswith('|') or '/' in core_pattern:
+            self.skipTest("core files aren't written to the current directory (core_pattern is '%s')" % core_pattern)
+
+        for core in glob.glob(os.path.join(os.getcwd(), 'core*')):
+            os.remove(core)
+
+        env = dict(os.environ)
+        env[self.dylibPath] = os.getcwd()
+        process = subprocess.Popen([exe], cwd=os.getcwd(), env=env)
+        process.wait()
+
+        cores = glob.glob(os.path.join(os.getcwd(), 'core*'))
+        if len(cores) != 1:
+            self.skipTest("the kernel didn't write a core file")
+        self.addTearDownHook(lambda: os.remove(cores[0]))
+        return cores[0]
+
+    def elf_core_modules(self):
+        """Test that the modules in the NT_FILE note of an ELF core are loaded once."""
+        exe = os.path.join(os.getcwd(), "a.out")
+        core = self.make_core(exe)
+
+        self.runCmd("target create -c %s %s" % (core, exe))
+        target = self.dbg.GetSelectedTarget()
+        self.assertTrue(target.GetProcess().IsValid(), "the core was loaded")
+
+        # The executable was already in the target and libfoo comes from the
+        # note, neither of them may be there twice.
+        names = [module.GetFileSpec().GetFilename() for module in target.module_iter()]
+        self.assertEqual(names.count("a.out"), 1, "a.out is in the target once: %s" % names)
+        self.assertEqual(names.count("libfoo.so"), 1, "libfoo.so is in the target once: %s" % names)
+
+        self.expect("image list", substrs = ['libfoo.so'])
+
+        # libfoo is loaded where the process had it mapped, so its code can
+        # be found by address.
+        foo = target.FindFunctions("foo").GetContextAtIndex(0).GetSymbol()
+        self.assertTrue(foo.IsValid(), "found foo")
+        foo_addr = foo.GetStartAddress().GetLoadAddress(target)
+        self.assertNotEqual(foo_addr, lldb.LLDB_INVALID_ADDRESS, "foo has a load address")
+        self.expect("image lookup -a 0x%x" % foo_addr, substrs = ['libfoo.so', 'foo'])
+
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
@@ -0,0 +1,7 @@
+#include "foo.h"
+
+int
+foo (int x)
+{
+    return x + 1;
+}
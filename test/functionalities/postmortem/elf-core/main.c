@@ -0,0 +1,24 @@
+//===-- main.c --------------------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <stdlib.h>
+#include <sys/resource.h>
+#include "foo.h"
+
+int
+main (int argc, char const *argv[])
+{
+    // Make sure the kernel writes a core file, which lists every file the
+    // process has mapped, libfoo included, in its NT_FILE note.
+    struct rlimit limit = { RLIM_INFINITY, RLIM_INFINITY };
+    setrlimit (RLIMIT_CORE, &limit);
+
+    if (foo (argc) > 0)
+        abort ();
+    return 0;
+}
@@ -0,0 +1,120 @@
+"""
+Test the 'process sample' command and the SBProcess.Sample() API.
+"""
+
+import os, time
+import unittest2
+import lldb
+from lldbtest import *
+import lldbutil
+
+class ProcessSampleTestCase(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    @unittest2.skipUnless(sys.platform.startswith("darwin"), "requires Darwin")
+    @dsym_test
+    def test_process_sample_with_dsym(self):
+        """Test that 'process sample' finds the busy functions."""
+        self.buildDsym()
+        self.process_sample()
+
+    @dwarf_test
+    def test_process_sample_with_dwarf(self):
+        """Test that 'process sample' finds the busy functions."""
+        self.buildDwarf()
+        self.process_sample()
+
+    @python_api_test
+    @dwarf_test
+    def test_sample_api_with_dwarf(self):
+        """Test that SBProcess.Sample() writes a call tree and collapsed stacks."""
+        self.buildDwarf()
+        self.sample_api()
+
+    @python_api_test
+    @dwarf_test
+    def test_sample_stops_at_breakpoint_with_dwarf(self):
+        """Test that sampling stops at a breakpoint and reports it."""
+        self.buildDwarf()
+        self.sample_stops_at_breakpoint()
+
+    def setUp(self):
+        # Call super's setUp().
+        TestBase.setUp(self)
+        # Find the line number to break inside main().
+        self.line = line_number('main.c', '// Set break point at this line.')
+
+    def launch(self):
+        exe = os.path.join(os.getcwd(), "a.out")
+        self.runCmd("file " + exe, CURRENT_EXECUTABLE_SET)
+
+        lldbutil.run_break_set_by_file_and_line (self, "main.c", self.line, num_expected_locations=1)
+
+        self.runCmd("run", RUN_SUCCEEDED)
+
+        self.expect("thread list", STOPPED_DUE_TO_BREAKPOINT,
+            substrs = ["stop reason = breakpoint 1."])
+
+        # Don't stop at the breakpoint while sampling.
+        self.runCmd("breakpoint disable")
+
+    def process_sample(self):
+        """Test that 'process sample' finds the busy functions."""
+        self.launch()
+
+        self.expect("process sample -f 50 -d 500", "Call tree shows the busy functions",
+            substrs = ["samples:", "main", "spin_outer", "spin_inner"])
+
+        # Collapsed stacks have the outermost frame first and a count last.
+        self.runCmd("process sample -f 50 -d 500 -c")
+        lines = [line for line in self.res.GetOutput().splitlines() if "spin_inner" in line]
+        self.assertTrue(len(lines) > 0)
+        for line in lines:
+            (stack, count) = line.rsplit(" ", 1)
+            self.assertTrue(int(count) > 0)
+            functions = stack.split(";")
+            self.assertTrue(functions.index("spin_outer") < functions.index("spin_inner"))
+
+        # The process is left stopped.
+        process = self.dbg.GetSelectedTarget().GetProcess()
+        self.assertTrue(process.GetState() == lldb.eStateStopped)
+
+    def sample_api(self):
+        """Test that SBProcess.Sample() writes a call tree and collapsed stacks."""
+        self.launch()
+
+        process = self.dbg.GetSelectedTarget().GetProcess()
+        call_tree = lldb.SBStream()
+        collapsed_stacks = lldb.SBStream()
+        error = process.Sample(50, 500, 64, call_tree, collapsed_stacks)
+        self.assertTrue(error.Success(), error.GetCString())
+        self.assertTrue("spin_inner" in call_tree.GetData())
+        self.assertTrue("main;" in collapsed_stacks.GetData())
+        self.assertTrue(process.GetState() == lldb.eStateStopped)
+
+    def sample_stops_at_breakpoint(self):
+        """Test that sampling stops at a breakpoint and reports it."""
+        self.launch()
+
+        target = self.dbg.GetSelectedTarget()
+        bkpt = target.BreakpointCreateByName("spin_inner")
+        self.assertTrue(bkpt and bkpt.GetNumLocations() == 1, VALID_BREAKPOINT)
+
+        process = target.GetProcess()
+        call_tree = lldb.SBStream()
+        collapsed_stacks = lldb.SBStream()
+        error = process.Sample(50, 5000, 64, call_tree, collapsed_stacks)
+        self.assertTrue(error.Fail(), "sampling ended early")
+        self.assertTrue("breakpoint %d.1" % bkpt.GetID() in error.GetCString(), error.GetCString())
+
+        # The process is left stopped at the breakpoint.
+        self.assertTrue(process.GetState() == lldb.eStateStopped)
+        threads = lldbutil.get_threads_stopped_at_breakpoint(process, bkpt)
+        self.assertTrue(len(threads) == 1, "stopped at the breakpoint")
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
@@ -0,0 +1,33 @@
+//===-- main.c --------------------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <stdio.h>
+
+volatile unsigned long g_counter = 0;
+
+void
+spin_inner (void)
+{
+    for (int i = 0; i < 1000; ++i)
+        g_counter += i;
+}
+
+void
+spin_outer (void)
+{
+    spin_inner ();
+}
+
+int
+main (int argc, char const *argv[])
+{
+    printf ("Starting to spin.\n"); // Set break point at this line.
+    while (1)
+        spin_outer ();
+    return 0;
+}
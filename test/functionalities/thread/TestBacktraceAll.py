@@ -0,0 +1,79 @@
+"""
+Test that unwinding all threads in parallel gives the same backtraces as
+unwinding them one at a time.
+"""
+
+import os, re, time
+import unittest2
+import lldb
+from lldbtest import *
+import lldbutil
+
+class BacktraceAllTestCase(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    @unittest2.skipUnless(sys.platform.startswith("darwin"), "requires Darwin")
+    @dsym_test
+    def test_with_dsym(self):
+        """Test that parallel and serial 'thread backtrace all' agree."""
+        self.buildDsym()
+        self.backtrace_all_test()
+
+    @dwarf_test
+    def test_with_dwarf(self):
+        """Test that parallel and serial 'thread backtrace all' agree."""
+        self.buildDwarf()
+        self.backtrace_all_test()
+
+    def setUp(self):
+        # Call super's setUp().
+        TestBase.setUp(self)
+        # Find the line number to break inside main().
+        self.line = line_number('main.c', '// Set break point at this line.')
+
+    def backtrace_all(self, parallel):
+        """Launch to the breakpoint and return the function names in each frame of 'bt all'."""
+        self.runCmd("settings set target.process.unwind-threads-in-parallel %s" % ("true" if parallel else "false"))
+        self.runCmd("run", RUN_SUCCEEDED)
+        self.expect("thread list", STOPPED_DUE_TO_BREAKPOINT,
+            substrs = ["stop reason = breakpoint 1."])
+
+        self.runCmd("thread backtrace all")
+        output = self.res.GetOutput()
+        self.assertTrue(output.count("thread #") == self.dbg.GetSelectedTarget().GetProcess().GetNumThreads())
+        functions = re.findall(r"frame #\d+: 0x[0-9a-fA-F]+ \S+`(\S+)", output)
+        self.runCmd("process kill")
+        return functions
+
+    def backtrace_all_test(self):
+        """Test that parallel and serial 'thread backtrace all' agree."""
+        exe = os.path.join(os.getcwd(), "a.out")
+        self.runCmd("file " + exe, CURRENT_EXECUTABLE_SET)
+        self.addTearDownHook(lambda: self.runCmd("settings clear target.process.unwind-threads-in-parallel", check=False))
+
+        lldbutil.run_break_set_by_file_and_line (self, "main.c", self.line, num_expected_locations=1)
+
+        # Threads and frames must come out in the same order whichever
+        # way they were unwound.
+        serial_functions = self.backtrace_all(False)
+        parallel_functions = self.backtrace_all(True)
+        self.assertTrue(len(serial_functions) > 0)
+        self.assertTrue(serial_functions == parallel_functions)
+
+        # The SB API unwinds all threads at once and hands back every stack.
+        self.runCmd("run", RUN_SUCCEEDED)
+        process = self.dbg.GetSelectedTarget().GetProcess()
+        num_threads = process.GetNumThreads()
+        self.assertTrue(process.ComputeAllThreadStacks() == num_threads)
+        stacks = process.thread_stacks
+        self.assertTrue(len(stacks) == num_threads)
+        for thread, frames in zip(process.threads, stacks):
+            self.assertTrue(len(frames) > 0)
+            self.assertTrue(len(frames) == thread.GetNumFrames())
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
@@ -0,0 +1,98 @@
+"""
+Test unwinding through functions without eh_frame, whose UnwindPlans are
+made by profiling their prologues: one without a stack frame, one that
+only pushes registers, one with a large stack frame and one that saves a
+register into a frame set up with a frame pointer and then stores only the
+low half of it.
+"""
+
+import os, sys
+import unittest2
+import lldb
+import lldbutil
+from lldbtest import *
+
+class PrologueUnwindTestCase(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    @unittest2.skipUnless(sys.platform.startswith("darwin"), "requires Darwin")
+    @dsym_test
+    def test_prologue_unwind_with_dsym(self):
+        """Test unwinding through profiled prologues."""
+        self.buildDsym()
+        self.prologue_unwind()
+
+    @dwarf_test
+    def test_prologue_unwind_with_dwarf(self):
+        """Test unwinding through profiled prologues."""
+        self.buildDwarf()
+        self.prologue_unwind()
+
+    def setUp(self):
+        # Call super's setUp().
+        TestBase.setUp(self)
+
+    def prologue_unwind(self):
+        """Test unwinding through profiled prologues."""
+        if self.getArchitecture() != 'x86_64':
+            self.skipTest("the prologues are written in x86_64 assembly")
+
+        exe = os.path.join(os.getcwd(), "a.out")
+        target = self.dbg.CreateTarget(exe)
+        self.assertTrue(target, VALID_TARGET)
+
+        # Stop on the first instruction of the innermost function.
+        bkpt = target.BreakpointCreateByName('frameless')
+        self.assertTrue(bkpt and bkpt.GetNumLocations() == 1, VALID_BREAKPOINT)
+
+        process = target.LaunchSimple (None, None, self.get_process_working_directory())
+        self.assertTrue(process, PROCESS_IS_VALID)
+
+        threads = lldbutil.get_threads_stopped_at_breakpoint (process, bkpt)
+        self.assertTrue(len(threads) == 1)
+        thread = threads[0]
+
+        names = [thread.GetFrameAtIndex(i).GetFunctionName() for i in range(5)]
+        self.assertEqual(names, ['frameless', 'push_only', 'large_frame', 'saves_regs', 'main'],
+                         "backtrace through the profiled prologues")
+
+        frames = [thread.GetFrameAtIndex(i) for i in range(5)]
+        def reg(frame, name):
+            value = frame.FindRegister(name)
+            self.assertTrue(value.IsValid(), "%s is available in %s" % (name, frame.GetFunctionName()))
+            return value.GetValueAsUnsigned()
+
+        # The stack pointer of each caller is just above the callee's frame:
+        # the return address, then three pushed registers, then 0x2008
+        # bytes of locals and the return address.
+        self.assertEqual(frames[1].GetSP() - frames[0].GetSP(), 8, "frameless has no frame")
+        self.assertEqual(frames[2].GetSP() - frames[1].GetSP(), 32, "push_only pushed three registers")
+        self.assertEqual(frames[3].GetSP() - frames[2].GetSP(), 0x2010, "large_frame's locals")
+        self.assertEqual(frames[4].GetSP(), frames[3].GetFP() + 16, "saves_regs' frame pointer")
+
+        # push_only saved %rbx, which saves_regs had set, before changing it.
+        self.assertEqual(reg(frames[0], 'rbx'), 0x3333)
+        self.assertEqual(reg(frames[1], 'rbx'), 0x3333)
+        self.assertEqual(reg(frames[2], 'rbx'), 0x1111)
+        self.assertEqual(reg(frames[3], 'rbx'), 0x1111)
+
+        # saves_regs saved main's %rbx with the movq, not the movl after it.
+        error = lldb.SBError()
+        saved_rbx = process.ReadUnsignedFromMemory(frames[3].GetFP() - 8, 8, error)
+        self.assertTrue(error.Success(), "read the saved rbx")
+        self.assertEqual(reg(frames[4], 'rbx'), saved_rbx, "rbx in main")
+
+        # Nothing changes %r12, which push_only saved.
+        r12 = reg(frames[0], 'r12')
+        for frame in frames[1:]:
+            self.assertEqual(reg(frame, 'r12'), r12, "r12 in %s" % frame.GetFunctionName())
+
+        process.Continue()
+        self.assertTrue(process.GetState() == lldb.eStateExited, PROCESS_EXITED)
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
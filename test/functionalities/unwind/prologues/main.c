@@ -0,0 +1,89 @@
+//===-- main.c --------------------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <stdio.h>
+
+#if defined(__x86_64__)
+
+#if defined(__APPLE__)
+#define FUNC_BEGIN(name) ".globl _" #name "\n_" #name ":\n"
+#define FUNC_END(name)
+#else
+#define FUNC_BEGIN(name) ".globl " #name "\n.type " #name ",@function\n" #name ":\n"
+#define FUNC_END(name) ".size " #name ", .-" #name "\n"
+#endif
+
+int saves_regs (void);
+
+// Hand written prologues, so that the instructions the unwinder profiles
+// are known exactly.  saves_regs calls large_frame, which calls
+// push_only, which calls frameless.
+__asm__ (
+    ".text\n"
+
+    // No stack frame at all
+    FUNC_BEGIN(frameless)
+    "    movl $42, %eax\n"
+    "    ret\n"
+    FUNC_END(frameless)
+
+    // Saves registers with pushes and doesn't move the stack otherwise
+    FUNC_BEGIN(push_only)
+    "    pushq %rbx\n"
+    "    pushq %r12\n"
+    "    pushq %r13\n"
+    "    movq $0x3333, %rbx\n"
+    "    call frameless\n"
+    "    popq %r13\n"
+    "    popq %r12\n"
+    "    popq %rbx\n"
+    "    ret\n"
+    FUNC_END(push_only)
+
+    // A stack frame too large for an 8-bit immediate, without a frame pointer
+    FUNC_BEGIN(large_frame)
+    "    subq $0x2008, %rsp\n"
+    "    call push_only\n"
+    "    addq $0x2008, %rsp\n"
+    "    ret\n"
+    FUNC_END(large_frame)
+
+    // A frame pointer and %rbx saved with a movq into the frame.  The
+    // movl after it only stores the low half of %rbx, so it doesn't save
+    // the register again.
+    FUNC_BEGIN(saves_regs)
+    "    pushq %rbp\n"
+    "    movq %rsp, %rbp\n"
+    "    subq $16, %rsp\n"
+    "    movq %rbx, -8(%rbp)\n"
+    "    movq $-1, -16(%rbp)\n"
+    "    movl %ebx, -16(%rbp)\n"
+    "    movq $0x1111, %rbx\n"
+    "    call large_frame\n"
+    "    movq -8(%rbp), %rbx\n"
+    "    leave\n"
+    "    ret\n"
+    FUNC_END(saves_regs)
+);
+
+#else
+
+int
+saves_regs (void)
+{
+    return 42;
+}
+
+#endif
+
+int
+main (int argc, char const *argv[])
+{
+    printf ("saves_regs returned %d\n", saves_regs ());
+    return 0;
+}
@@ -0,0 +1,75 @@
+"""
+Test that printing objects with 'po' reuses the functions the process
+compiled for it instead of compiling them again.
+"""
+
+import os, time
+import unittest2
+import lldb, lldbutil
+from lldbtest import *
+
+class ObjCPoCompileCountTestCase(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    @unittest2.skipUnless(sys.platform.startswith("darwin"), "requires Darwin")
+    @python_api_test
+    @dsym_test
+    def test_po_compile_count_with_dsym(self):
+        """Test that a second 'po' doesn't compile any more functions."""
+        if self.getArchitecture() == 'i386':
+            self.skipTest("requires Objective-C 2.0 runtime")
+        self.buildDsym()
+        self.po_compile_count()
+
+    @unittest2.skipUnless(sys.platform.startswith("darwin"), "requires Darwin")
+    @python_api_test
+    @dwarf_test
+    def test_po_compile_count_with_dwarf(self):
+        """Test that a second 'po' doesn't compile any more functions."""
+        if self.getArchitecture() == 'i386':
+            self.skipTest("requires Objective-C 2.0 runtime")
+        self.buildDwarf()
+        self.po_compile_count()
+
+    def setUp(self):
+        # Call super's setUp().
+        TestBase.setUp(self)
+        self.source_name = 'main.m'
+
+    def po_compile_count(self):
+        """Test that a second 'po' doesn't compile any more functions."""
+        exe = os.path.join(os.getcwd(), "a.out")
+
+        target = self.dbg.CreateTarget (exe)
+        self.assertTrue(target, VALID_TARGET)
+
+        bkpt = target.BreakpointCreateBySourceRegex ("Set a breakpoint here.", lldb.SBFileSpec (self.source_name))
+        self.assertTrue(bkpt and
+                        bkpt.GetNumLocations() == 1,
+                        VALID_BREAKPOINT)
+
+        process = target.LaunchSimple (None, None, self.get_process_working_directory())
+        self.assertTrue(process.GetState() == lldb.eStateStopped,
+                        PROCESS_STOPPED)
+
+        threads = lldbutil.get_threads_stopped_at_breakpoint (process, bkpt)
+        self.assertTrue (len(threads) == 1)
+
+        # The first 'po' compiles the functions that read the class tables
+        # and call the object's description method.
+        self.expect("po str", substrs = ['Hello 5'])
+        num_compiled = process.GetNumCompiledFunctions()
+        self.assertTrue(num_compiled > 0, "the first 'po' compiled its functions")
+
+        # The second one, and one of another class, reuse them.
+        self.expect("po str", substrs = ['Hello 5'])
+        self.assertEqual(process.GetNumCompiledFunctions(), num_compiled, "the second 'po' compiled no functions")
+        self.expect("po array", substrs = ['Hello 5', 'world'])
+        self.assertEqual(process.GetNumCompiledFunctions(), num_compiled, "printing another object compiled no functions")
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
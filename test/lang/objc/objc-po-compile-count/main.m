@@ -0,0 +1,11 @@
+#import <Foundation/Foundation.h>
+
+int main ()
+{
+  NSAutoreleasePool *pool = [[NSAutoreleasePool alloc] init];
+  NSString *str = [NSString stringWithFormat: @"Hello %d", 5];
+  NSArray *array = [NSArray arrayWithObjects: str, @"world", nil];
+  NSLog (@"Array has %lu objects.", (unsigned long) [array count]); // Set a breakpoint here.
+  [pool drain];
+  return 0;
+}
@@ -107,6 +107,48 @@ class ThreadAPITestCase(TestBase):
         self.setTearDownCleanup(dictionary=d)
         self.step_over_3_times(self.exe_name)
 
+    @unittest2.skipUnless(sys.platform.startswith("darwin"), "requires Darwin")
+    @python_api_test
+    @dsym_test
+    def test_get_raw_backtrace_with_dsym(self):
+        """Test Python SBThread.GetRawBacktrace() API."""
+        # We build a different executable than the default buildDsym() does.
+        d = {'CXX_SOURCES': 'main2.cpp', 'EXE': self.exe_name}
+        self.buildDsym(dictionary=d)
+        self.setTearDownCleanup(dictionary=d)
+        self.get_raw_backtrace(self.exe_name)
+
+    @python_api_test
+    @dwarf_test
+    def test_get_raw_backtrace_with_dwarf(self):
+        """Test Python SBThread.GetRawBacktrace() API."""
+        # We build a different executable than the default buildDwarf() does.
+        d = {'CXX_SOURCES': 'main2.cpp', 'EXE': self.exe_name}
+        self.buildDwarf(dictionary=d)
+        self.setTearDownCleanup(dictionary=d)
+        self.get_raw_backtrace(self.exe_name)
+
+    @unittest2.skipUnless(sys.platform.startswith("darwin"), "requires Darwin")
+    @python_api_test
+    @dsym_test
+    def test_get_raw_backtrace_from_frameless_leaf_with_dsym(self):
+        """Test Python SBThread.GetRawBacktrace() API from a leaf function without a frame record."""
+        # We build a different executable than the default buildDsym() does.
+        d = {'CXX_SOURCES': 'main2.cpp', 'EXE': self.exe_name}
+        self.buildDsym(dictionary=d)
+        self.setTearDownCleanup(dictionary=d)
+        self.get_raw_backtrace_from_frameless_leaf(self.exe_name)
+
+    @python_api_test
+    @dwarf_test
+    def test_get_raw_backtrace_from_frameless_leaf_with_dwarf(self):
+        """Test Python SBThread.GetRawBacktrace() API from a leaf function without a frame record."""
+        # We build a different executable than the default buildDwarf() does.
+        d = {'CXX_SOURCES': 'main2.cpp', 'EXE': self.exe_name}
+        self.buildDwarf(dictionary=d)
+        self.setTearDownCleanup(dictionary=d)
+        self.get_raw_backtrace_from_frameless_leaf(self.exe_name)
+
     def setUp(self):
         # Call super's setUp().
         TestBase.setUp(self)
@@ -166,6 +208,66 @@ class ThreadAPITestCase(TestBase):
         self.expect(stop_description, exe=False,
             startstr = 'breakpoint')
 
+    def get_raw_backtrace(self, exe_name):
+        """Test Python SBThread.GetRawBacktrace() API."""
+        exe = os.path.join(os.getcwd(), exe_name)
+
+        target = self.dbg.CreateTarget(exe)
+        self.assertTrue(target, VALID_TARGET)
+
+        breakpoint = target.BreakpointCreateByLocation("main2.cpp", self.step_out_of_malloc)
+        self.assertTrue(breakpoint, VALID_BREAKPOINT)
+
+        # Launch the process, and do not stop at the entry point.
+        process = target.LaunchSimple (None, None, self.get_process_working_directory())
+
+        thread = get_stopped_thread(process, lldb.eStopReasonBreakpoint)
+        self.assertTrue(thread.IsValid(), "There should be a thread stopped due to breakpoint")
+
+        # Due to the typemap magic (see lldb.swig), we pass in the maximum
+        # number of pcs and get a Python list back. We are stopped in b()
+        # called from a() called from main(), which all have frame pointers.
+        pcs = thread.GetRawBacktrace(64)
+        self.assertTrue(len(pcs) >= 3)
+        for idx in range(3):
+            self.assertTrue(pcs[idx] == thread.GetFrameAtIndex(idx).GetPC(),
+                            "raw pc %d should match the pc of the frame" % idx)
+
+        pcs = thread.GetRawBacktrace(2)
+        self.assertTrue(len(pcs) == 2)
+
+    def get_raw_backtrace_from_frameless_leaf(self, exe_name):
+        """Test Python SBThread.GetRawBacktrace() API from a leaf function without a frame record."""
+        exe = os.path.join(os.getcwd(), exe_name)
+
+        target = self.dbg.CreateTarget(exe)
+        self.assertTrue(target, VALID_TARGET)
+
+        # Stop on the first instruction of the leaf function c(), before it
+        # has pushed a frame record. The frame pointer still points at b()'s
+        # record there, so following it alone would skip b().
+        contexts = target.FindFunctions('c')
+        self.assertTrue(contexts.GetSize() == 1)
+        leaf_addr = contexts.GetContextAtIndex(0).GetFunction().GetStartAddress().GetLoadAddress(target)
+        breakpoint = target.BreakpointCreateByAddress(leaf_addr)
+        self.assertTrue(breakpoint, VALID_BREAKPOINT)
+
+        # Launch the process, and do not stop at the entry point.
+        process = target.LaunchSimple (None, None, self.get_process_working_directory())
+
+        thread = get_stopped_thread(process, lldb.eStopReasonBreakpoint)
+        self.assertTrue(thread.IsValid(), "There should be a thread stopped due to breakpoint")
+        self.assertTrue(thread.GetFrameAtIndex(0).GetPC() == leaf_addr)
+
+        # We are stopped in c() called from b() called from a() called from
+        # main(); every one of them must be in the raw backtrace exactly once.
+        pcs = thread.GetRawBacktrace(64)
+        self.assertTrue(len(pcs) >= 4)
+        for idx in range(4):
+            self.assertTrue(pcs[idx] == thread.GetFrameAtIndex(idx).GetPC(),
+                            "raw pc %d should match the pc of the frame" % idx)
+        self.assertTrue(thread.GetFrameAtIndex(1).GetFunctionName().startswith('b'))
+
     def step_out_of_malloc_into_function_b(self, exe_name):
         """Test Python SBThread.StepOut() API to step out of a malloc call where the call site is at function b()."""
         exe = os.path.join(os.getcwd(), exe_name)
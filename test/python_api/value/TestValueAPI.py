@@ -68,6 +68,15 @@ class ValueAPITestCase(TestBase):
         self.assertTrue(days_of_week.GetNumChildren() == 7, VALID_VARIABLE)
         self.DebugSBValue(days_of_week)
 
+        # Get a window of its children at once, it should match getting
+        # them one by one.  Windows are cut short at the last child.
+        window = days_of_week.GetChildrenAtIndexRange(2, 3)
+        self.assertTrue(window.GetSize() == 3)
+        for i in range(3):
+            self.assertTrue(window.GetValueAtIndex(i).GetSummary() == days_of_week.GetChildAtIndex(2 + i).GetSummary())
+        self.assertTrue(days_of_week.GetChildrenAtIndexRange(5, 10).GetSize() == 2)
+        self.assertTrue(days_of_week.GetChildrenAtIndexRange(7, 1).GetSize() == 0)
+
         # Get global variable 'weekdays'.
         list = target.FindGlobalVariables('weekdays', 1)
         weekdays = list.GetValueAtIndex(0)
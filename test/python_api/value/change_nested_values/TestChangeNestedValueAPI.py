@@ -0,0 +1,127 @@
+"""
+Test that setting a member of a nested struct with SBValue.SetValueFromCString
+is seen by its parents and siblings, and that they see the process change it.
+"""
+
+import os, time
+import re
+import unittest2
+import lldb, lldbutil
+from lldbtest import *
+
+class ChangeNestedValueAPITestCase(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    @unittest2.skipUnless(sys.platform.startswith("darwin"), "requires Darwin")
+    @python_api_test
+    @dsym_test
+    def test_change_nested_value_with_dsym(self):
+        """Exercise SBValue::SetValueFromCString on a member of a nested struct."""
+        self.buildDsym()
+        self.change_nested_value_api()
+
+    @python_api_test
+    @dwarf_test
+    def test_change_nested_value_with_dwarf(self):
+        """Exercise SBValue::SetValueFromCString on a member of a nested struct."""
+        self.buildDwarf()
+        self.change_nested_value_api()
+
+    def setUp(self):
+        # Call super's setUp().
+        TestBase.setUp(self)
+        self.line = line_number('main.c', '// Stop here and set values')
+
+    def check_int(self, value, expected, what):
+        error = lldb.SBError()
+        actual_value = value.GetValueAsSigned (error, 0)
+        self.assertTrue (error.Success(), "Got a value for %s" % what)
+        self.assertTrue (actual_value == expected, "%s is %d, expected %d" % (what, actual_value, expected))
+
+    def check_rect_bytes(self, rect_value, expected):
+        # The members of r, in the order they are laid out.
+        error = lldb.SBError()
+        data = rect_value.GetData()
+        for i in range(len(expected)):
+            actual_value = data.GetSignedInt32 (error, i * 4)
+            self.assertTrue (error.Success(), "Read member %d from the bytes of r" % i)
+            self.assertTrue (actual_value == expected[i], "Member %d of r is %d, expected %d" % (i, actual_value, expected[i]))
+
+    def change_nested_value_api(self):
+        """Exercise SBValue::SetValueFromCString on a member of a nested struct."""
+        exe = os.path.join(os.getcwd(), "a.out")
+
+        # Create a target by the debugger.
+        target = self.dbg.CreateTarget(exe)
+        self.assertTrue(target, VALID_TARGET)
+
+        # Create the breakpoint inside the loop in 'main'.
+        breakpoint = target.BreakpointCreateByLocation('main.c', self.line)
+        self.assertTrue(breakpoint, VALID_BREAKPOINT)
+
+        # Now launch the process, and do not stop at entry point.
+        process = target.LaunchSimple (None, None, self.get_process_working_directory())
+        self.assertTrue(process, PROCESS_IS_VALID)
+
+        self.assertTrue(process.GetState() == lldb.eStateStopped)
+        thread = lldbutil.get_stopped_thread(process, lldb.eStopReasonBreakpoint)
+        self.assertTrue(thread.IsValid(), "There should be a thread stopped due to breakpoint")
+        frame0 = thread.GetFrameAtIndex(0)
+        self.assertTrue (frame0.IsValid(), "Got a valid frame.")
+
+        # Read the whole struct and every member first, so that the members'
+        # bytes come from the struct's.
+        r_value = frame0.FindVariable ("r")
+        self.assertTrue (r_value.IsValid(), "Got the SBValue for r")
+        origin_value = r_value.GetChildMemberWithName ("origin")
+        origin_x_value = origin_value.GetChildMemberWithName ("x")
+        origin_y_value = origin_value.GetChildMemberWithName ("y")
+        size_x_value = r_value.GetChildMemberWithName ("size").GetChildMemberWithName ("x")
+        id_value = r_value.GetChildMemberWithName ("id")
+        self.check_rect_bytes (r_value, [1, 2, 3, 4, 5])
+        self.check_int (origin_x_value, 1, "r.origin.x")
+        self.check_int (origin_y_value, 2, "r.origin.y")
+        self.check_int (size_x_value, 3, "r.size.x")
+
+        # Change a member two levels down.
+        result = origin_y_value.SetValueFromCString ("42")
+        self.assertTrue (result, "Success setting r.origin.y.")
+        self.check_int (origin_y_value, 42, "r.origin.y")
+
+        # Its parents, its sibling and its parent's sibling read the new
+        # bytes, as do values fetched again from the frame.
+        self.check_rect_bytes (r_value, [1, 42, 3, 4, 5])
+        self.check_int (origin_x_value, 1, "r.origin.x")
+        self.check_int (size_x_value, 3, "r.size.x")
+        error = lldb.SBError()
+        self.assertTrue (origin_value.GetData().GetSignedInt32 (error, 4) == 42, "r.origin has the new bytes")
+        self.check_int (frame0.FindVariable ("r").GetChildMemberWithName ("origin").GetChildMemberWithName ("y"), 42, "r.origin.y from the frame")
+        self.check_int (frame0.EvaluateExpression ("r.origin.y"), 42, "r.origin.y in the process")
+
+        # The process changes other members on the next pass through the
+        # loop, and the values read earlier see that.
+        process.Continue()
+        self.assertTrue(process.GetState() == lldb.eStateStopped)
+        thread = lldbutil.get_stopped_thread(process, lldb.eStopReasonBreakpoint)
+        self.assertTrue(thread.IsValid(), "There should be a thread stopped due to breakpoint")
+        self.check_rect_bytes (r_value, [1, 42, 13, 4, 6])
+        self.check_int (size_x_value, 13, "r.size.x after continuing")
+        self.check_int (id_value, 6, "r.id after continuing")
+        self.check_int (origin_y_value, 42, "r.origin.y after continuing")
+
+        # And after stepping over the line that changes r.size.x.
+        thread.StepOver()
+        self.check_rect_bytes (r_value, [1, 42, 23, 4, 6])
+        self.check_int (size_x_value, 23, "r.size.x after stepping")
+        self.check_int (origin_y_value, 42, "r.origin.y after stepping")
+
+        breakpoint.SetEnabled(False)
+        process.Continue()
+        self.assertTrue(process.GetState() == lldb.eStateExited, PROCESS_EXITED)
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
@@ -0,0 +1,30 @@
+#include <stdio.h>
+
+struct point
+{
+  int x;
+  int y;
+};
+
+struct rect
+{
+  struct point origin;
+  struct point size;
+  int id;
+};
+
+int main ()
+{
+  struct rect r = {{1, 2}, {3, 4}, 5};
+  int i;
+
+  for (i = 0; i < 2; i++)
+    {
+      r.size.x += 10; // Stop here and set values
+      r.id++;
+    }
+
+  printf ("Rect - %d, %d, %d, %d, %d\n",
+          r.origin.x, r.origin.y, r.size.x, r.size.y, r.id);
+  return 0;
+}
@@ -0,0 +1,99 @@
+import unittest2
+
+import gdbremote_testcase
+from lldbtest import *
+
+class TestGdbRemoteMemoryRegions(gdbremote_testcase.GdbRemoteTestCaseBase):
+
+    def get_code_address_and_stop(self):
+        procs = self.prep_debug_monitor_and_inferior(
+            inferior_args=["get-code-address-hex:hello", "sleep:5"])
+
+        self.test_sequence.add_log_lines(
+            [
+             # Start running after initial stop.
+             "read packet: $c#00",
+             # Match output line that prints the code address within the inferior.
+             { "type":"output_match", "regex":r"^code address: 0x([0-9a-fA-F]+)\r\n$", "capture":{ 1:"code_address"} },
+             # Now stop the inferior.
+             "read packet: {}".format(chr(03)),
+             # And wait for the stop notification.
+             {"direction":"send", "regex":r"^\$T([0-9a-fA-F]{2})thread:([0-9a-fA-F]+);", "capture":{1:"stop_signo", 2:"stop_thread_id"} }],
+            True)
+
+        context = self.expect_gdbremote_sequence()
+        self.assertIsNotNone(context)
+        self.assertIsNotNone(context.get("code_address"))
+        return int(context.get("code_address"), 16)
+
+    def read_memory_regions(self):
+        regions = []
+        next_address = 0
+        while next_address is not None:
+            self.reset_test_sequence()
+            self.test_sequence.add_log_lines(
+                ["read packet: $qMemoryRegions:{0:x}#00".format(next_address),
+                 {"direction":"send", "regex":r"^\$(.*)#[0-9a-fA-F]{2}$", "capture":{1:"regions_response"} }],
+                True)
+            context = self.expect_gdbremote_sequence()
+            self.assertIsNotNone(context)
+
+            response = context.get("regions_response")
+            self.assertIsNotNone(response)
+            self.assertFalse(response.startswith("E"))
+
+            next_address = None
+            if response == "OK":
+                break
+            for key_val in response.split(";"):
+                if len(key_val) < 1:
+                    continue
+                (key, val) = key_val.split(":", 1)
+                if key == "start":
+                    regions.append({"start":int(val, 16)})
+                elif key == "size":
+                    regions[-1]["size"] = int(val, 16)
+                elif key == "permissions":
+                    regions[-1]["permissions"] = val
+                elif key == "next":
+                    next_address = int(val, 16)
+        return regions
+
+    def qMemoryRegions_lists_code_region(self):
+        code_address = self.get_code_address_and_stop()
+        regions = self.read_memory_regions()
+        self.assertTrue(len(regions) > 0)
+
+        # Regions must be complete, sorted and non-overlapping.
+        prev_end = 0
+        for region in regions:
+            self.assertTrue("size" in region)
+            self.assertTrue("permissions" in region)
+            self.assertTrue(region["start"] >= prev_end)
+            prev_end = region["start"] + region["size"]
+
+        # The code address must be in a readable, executable region.
+        code_regions = [region for region in regions if region["start"] <= code_address < region["start"] + region["size"]]
+        self.assertEquals(len(code_regions), 1)
+        self.assertTrue("r" in code_regions[0]["permissions"])
+        self.assertTrue("x" in code_regions[0]["permissions"])
+
+        # And it must agree with what qMemoryRegionInfo says about it.
+        self.reset_test_sequence()
+        self.add_query_memory_region_packets(code_address)
+        context = self.expect_gdbremote_sequence()
+        self.assertIsNotNone(context)
+        mem_region_dict = self.parse_memory_region_packet(context)
+        self.assertEquals(int(mem_region_dict["start"], 16), code_regions[0]["start"])
+        self.assertEquals(int(mem_region_dict["size"], 16), code_regions[0]["size"])
+
+    @llgs_test
+    @dwarf_test
+    def test_qMemoryRegions_lists_code_region_llgs_dwarf(self):
+        self.init_llgs_test()
+        self.buildDwarf()
+        self.set_inferior_startup_launch()
+        self.qMemoryRegions_lists_code_region()
+
+if __name__ == '__main__':
+    unittest2.main()
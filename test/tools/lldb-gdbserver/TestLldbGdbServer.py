@@ -1351,6 +1351,78 @@ class LldbGdbServerTestCase(gdbremote_testcase.GdbRemoteTestCaseBase):
         self.set_inferior_startup_launch()
         self.software_breakpoint_set_and_remove_work()
 
+    def breakpoint_batch_set_and_remove_work(self):
+        # Start up the inferior.
+        procs = self.prep_debug_monitor_and_inferior(
+            inferior_args=["get-code-address-hex:hello", "sleep:1", "call-function:hello"])
+
+        # Run the process
+        self.test_sequence.add_log_lines(
+            [# Start running after initial stop.
+             "read packet: $c#00",
+             # Match output line that prints the memory address of the function call entry point.
+             # Note we require launch-only testing so we can get inferior otuput.
+             { "type":"output_match", "regex":r"^code address: 0x([0-9a-fA-F]+)\r\n$", "capture":{ 1:"function_address"} },
+             # Now stop the inferior.
+             "read packet: {}".format(chr(03)),
+             # And wait for the stop notification.
+             {"direction":"send", "regex":r"^\$T([0-9a-fA-F]{2})thread:([0-9a-fA-F]+);", "capture":{1:"stop_signo", 2:"stop_thread_id"} }],
+            True)
+
+        # Run the packet stream.
+        context = self.expect_gdbremote_sequence()
+        self.assertIsNotNone(context)
+
+        # Grab the function address.
+        self.assertIsNotNone(context.get("function_address"))
+        function_address = int(context.get("function_address"), 16)
+
+        # Set a breakpoint on the function and one at an unmapped address in
+        # one packet.  The stub replies with a result per entry, in order.
+        # Note this might need to be switched per platform (ARM, mips, etc.).
+        BREAKPOINT_KIND = 1
+        self.reset_test_sequence()
+        self.test_sequence.add_log_lines(
+            ["read packet: $QSetBreakpoints:0,{0:x},{1};0,0,{1}#00".format(function_address, BREAKPOINT_KIND),
+             {"direction":"send", "regex":r"^\$OK;E09#[0-9a-fA-F]{2}$"},
+             # The breakpoint that was set must be hit.
+             "read packet: $c#00",
+             {"direction":"send", "regex":r"^\$T([0-9a-fA-F]{2})thread:([0-9a-fA-F]+);", "capture":{1:"stop_signo", 2:"stop_thread_id"} },
+            ], True)
+
+        context = self.expect_gdbremote_sequence()
+        self.assertIsNotNone(context)
+
+        # Verify the stop signal reported was the breakpoint signal number.
+        stop_signo = context.get("stop_signo")
+        self.assertIsNotNone(stop_signo)
+        self.assertEquals(int(stop_signo,16), signal.SIGTRAP)
+
+        # Ensure we did not receive any output, the function must not have run.
+        self.assertEquals(len(context["O_content"]), 0)
+
+        # Removing the breakpoint works and removing one that was never set
+        # fails, in one packet.  Then the function runs to completion.
+        self.reset_test_sequence()
+        self.test_sequence.add_log_lines(
+            ["read packet: $QRemoveBreakpoints:0,{0:x},{1};0,0,{1}#00".format(function_address, BREAKPOINT_KIND),
+             {"direction":"send", "regex":r"^\$OK;E09#[0-9a-fA-F]{2}$"},
+             "read packet: $c#00",
+             { "type":"output_match", "regex":r"^hello, world\r\n$" },
+             {"direction":"send", "regex":r"^\$W00(.*)#[0-9a-fA-F]{2}$" },
+            ], True)
+
+        context = self.expect_gdbremote_sequence()
+        self.assertIsNotNone(context)
+
+    @llgs_test
+    @dwarf_test
+    def test_breakpoint_batch_set_and_remove_work_llgs_dwarf(self):
+        self.init_llgs_test()
+        self.buildDwarf()
+        self.set_inferior_startup_launch()
+        self.breakpoint_batch_set_and_remove_work()
+
     def qSupported_returns_known_stub_features(self):
         # Start up the stub and start/prep the inferior.
         procs = self.prep_debug_monitor_and_inferior()
@@ -1441,6 +1513,70 @@ class LldbGdbServerTestCase(gdbremote_testcase.GdbRemoteTestCaseBase):
         self.set_inferior_startup_launch()
         self.written_M_content_reads_back_correctly()
 
+    def memory_across_page_boundaries_reads_back_correctly(self):
+        # Start up the inferior.
+        procs = self.prep_debug_monitor_and_inferior(
+            inferior_args=["get-heap-address-hex:", "sleep:5"])
+
+        # Run the process
+        self.test_sequence.add_log_lines(
+            [
+             # Start running after initial stop.
+             "read packet: $c#00",
+             # Match output line that prints the memory address of the heap buffer within the inferior.
+             # Note we require launch-only testing so we can get inferior otuput.
+             { "type":"output_match", "regex":r"^heap address: 0x([0-9a-fA-F]+)\r\n$", "capture":{ 1:"heap_address"} },
+             # Now stop the inferior.
+             "read packet: {}".format(chr(03)),
+             # And wait for the stop notification.
+             {"direction":"send", "regex":r"^\$T([0-9a-fA-F]{2})thread:([0-9a-fA-F]+);", "capture":{1:"stop_signo", 2:"stop_thread_id"} }],
+            True)
+
+        context = self.expect_gdbremote_sequence()
+        self.assertIsNotNone(context)
+
+        # Grab the address.
+        self.assertIsNotNone(context.get("heap_address"))
+        heap_address = int(context.get("heap_address"), 16)
+
+        # The heap buffer is three pages long, so it holds a range that
+        # starts just before a page boundary and runs past the next one.
+        PAGE_SIZE = 4096
+        page_boundary = (heap_address + PAGE_SIZE) & ~(PAGE_SIZE - 1)
+        for (address, length) in [(page_boundary - 16, 32), (page_boundary - 16, PAGE_SIZE + 32)]:
+            contents = "".join([chr((address + i) % 251) for i in range(length)])
+
+            self.reset_test_sequence()
+            self.test_sequence.add_log_lines(
+                ["read packet: $M{0:x},{1:x}:{2}#00".format(address, length, contents.encode("hex")),
+                 "send packet: $OK#00",
+                 "read packet: $m{0:x},{1:x}#00".format(address, length),
+                 {"direction":"send", "regex":r"^\$(.+)#[0-9a-fA-F]{2}$", "capture":{1:"read_contents"} },
+                ], True)
+
+            context = self.expect_gdbremote_sequence()
+            self.assertIsNotNone(context)
+
+            # Ensure what we read from inferior memory is what we wrote.
+            self.assertIsNotNone(context.get("read_contents"))
+            self.assertEquals(context.get("read_contents").decode("hex"), contents)
+
+    @debugserver_test
+    @dsym_test
+    def test_memory_across_page_boundaries_reads_back_correctly_debugserver_dsym(self):
+        self.init_debugserver_test()
+        self.buildDsym()
+        self.set_inferior_startup_launch()
+        self.memory_across_page_boundaries_reads_back_correctly()
+
+    @llgs_test
+    @dwarf_test
+    def test_memory_across_page_boundaries_reads_back_correctly_llgs_dwarf(self):
+        self.init_llgs_test()
+        self.buildDwarf()
+        self.set_inferior_startup_launch()
+        self.memory_across_page_boundaries_reads_back_correctly()
+
     def P_writes_all_gpr_registers(self):
         # Start inferior debug session, grab all register info.
         procs = self.prep_debug_monitor_and_inferior(inferior_args=["sleep:2"])
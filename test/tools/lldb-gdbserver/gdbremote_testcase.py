@@ -650,6 +650,7 @@ class GdbRemoteTestCaseBase(TestBase):
         "QStartNoAckMode",
         "QThreadSuffixSupported",
         "QListThreadsInStopReply",
+        "QSetBreakpoints",
         "qXfer:auxv:read",
         "qXfer:libraries:read",
         "qXfer:libraries-svr4:read",
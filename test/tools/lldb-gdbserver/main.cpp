@@ -291,9 +291,10 @@ int main (int argc, char **argv)
         }
         else if (std::strstr (argv[i], GET_HEAP_ADDRESS_COMMAND))
         {
-			// Create a byte array if not already present.
+			// Create a byte array if not already present.  It spans a few
+			// pages so tests can access memory across page boundaries.
 			if (!heap_array_up)
-				heap_array_up.reset (new uint8_t[32]);
+				heap_array_up.reset (new uint8_t[3 * 4096]);
 
 			pthread_mutex_lock (&g_print_mutex);
             printf ("heap address: %p\n", heap_array_up.get ());
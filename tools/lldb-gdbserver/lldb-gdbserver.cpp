@@ -29,6 +29,7 @@
 #include "lldb/Core/Error.h"
 #include "lldb/Core/ConnectionFileDescriptor.h"
 #include "lldb/Core/ConnectionMachPort.h"
+#include "lldb/Core/ConnectionSharedMemory.h"
 #include "lldb/Core/Debugger.h"
 #include "lldb/Core/PluginManager.h"
 #include "lldb/Core/StreamFile.h"
@@ -79,6 +80,7 @@ static struct option g_long_options[] =
     { "native-regs",        no_argument,        NULL,               'r' },  // Specify to use the native registers instead of the gdb defaults for the architecture.  NOTE: this is a do-nothing arg as it's behavior is default now.  FIXME remove call from lldb-platform.
     { "reverse-connect",    no_argument,        NULL,               'R' },  // Specifies that llgs attaches to the client address:port rather than llgs listening for a connection from address on port.
     { "setsid",             no_argument,        NULL,               'S' },  // Call setsid() to make llgs run in its own session.
+    { "shared-memory",      required_argument,  NULL,               'm' },  // Attach to a shared memory connection created by a client on the same host instead of using [HOST]:PORT.
     { NULL,                 0,                  NULL,               0   }
 };
 
@@ -120,7 +122,7 @@ signal_handler(int signo)
 static void
 display_usage (const char *progname)
 {
-    fprintf(stderr, "Usage:\n  %s [--log-file log-file-path] [--log-flags flags] [--lldb-command command]* [--platform platform_name] [--setsid] [--named-pipe named-pipe-path] [--native-regs] [--attach pid] [[HOST]:PORT] "
+    fprintf(stderr, "Usage:\n  %s [--log-file log-file-path] [--log-flags flags] [--lldb-command command]* [--platform platform_name] [--setsid] [--named-pipe named-pipe-path] [--native-regs] [--attach pid] [--shared-memory name | [HOST]:PORT] "
             "[-- PROGRAM ARG1 ARG2 ...]\n", progname);
     exit(0);
 }
@@ -324,11 +326,25 @@ JoinListenThread ()
 }
 
 void
-ConnectToRemote (GDBRemoteCommunicationServer &gdb_server, bool reverse_connect, const char *const host_and_port, const char *const progname, const char *const named_pipe_path)
+ConnectToRemote (GDBRemoteCommunicationServer &gdb_server, bool reverse_connect, const char *const host_and_port, const char *const progname, const char *const named_pipe_path, const char *const shared_memory_name)
 {
     Error error;
 
-    if (host_and_port && host_and_port[0])
+    if (shared_memory_name && shared_memory_name[0])
+    {
+        // llgs will attach to the shared memory region the client created.
+        std::unique_ptr<ConnectionSharedMemory> connection_up (new ConnectionSharedMemory ());
+        if (connection_up->Open (false, shared_memory_name, 0, &error) != eConnectionStatusSuccess)
+        {
+            fprintf (stderr, "error: failed to attach to shared memory connection '%s': %s\n", shared_memory_name, error.AsCString ());
+            exit (-1);
+        }
+
+        // We're connected.
+        printf ("Connection established.\n");
+        gdb_server.SetConnection (connection_up.release());
+    }
+    else if (host_and_port && host_and_port[0])
     {
         // Parse out host and port.
         std::string final_host_and_port;
@@ -506,6 +522,7 @@ main (int argc, char *argv[])
     std::string platform_name;
     std::string attach_target;
     std::string named_pipe_path;
+    std::string shared_memory_name;
     bool reverse_connect = false;
 
     initialize_lldb_gdbserver ();
@@ -596,6 +613,11 @@ main (int argc, char *argv[])
             reverse_connect = true;
             break;
 
+        case 'm': // shared memory connection name
+            if (optarg && optarg[0])
+                shared_memory_name = optarg;
+            break;
+
 #ifndef _WIN32
         case 'S':
             // Put llgs into a new session. Terminals group processes
@@ -649,7 +671,8 @@ main (int argc, char *argv[])
     argc -= optind;
     argv += optind;
 
-    if (argc == 0)
+    // A shared memory connection replaces the [HOST]:PORT argument
+    if (argc == 0 && shared_memory_name.empty())
     {
         display_usage(progname);
         exit(255);
@@ -664,9 +687,13 @@ main (int argc, char *argv[])
     const bool is_platform = false;
     GDBRemoteCommunicationServer gdb_server (is_platform, platform_sp, debugger_sp);
 
-    const char *const host_and_port = argv[0];
-    argc -= 1;
-    argv += 1;
+    const char *host_and_port = NULL;
+    if (shared_memory_name.empty())
+    {
+        host_and_port = argv[0];
+        argc -= 1;
+        argv += 1;
+    }
 
     // Any arguments left over are for the the program that we need to launch. If there
     // are no arguments, then the GDB server will start up and wait for an 'A' packet
@@ -680,7 +707,7 @@ main (int argc, char *argv[])
     // Print version info.
     printf("%s-%s", LLGS_PROGRAM_NAME, LLGS_VERSION_STR);
 
-    ConnectToRemote (gdb_server, reverse_connect, host_and_port, progname, named_pipe_path.c_str ());
+    ConnectToRemote (gdb_server, reverse_connect, host_and_port, progname, named_pipe_path.c_str (), shared_memory_name.c_str ());
 
     terminate_lldb_gdbserver ();
 